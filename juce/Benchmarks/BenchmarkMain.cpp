@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+    BenchmarkMain.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Console entry point for the headless component benchmarks.
+
+    Usage:
+      ShmuiBenchmarks [--frames N] [--warmup N] [--filter TEXT]
+                      [--label TEXT] [--output FILE.json]
+                      [--baseline FILE.json] [--threshold PERCENT]
+      ShmuiBenchmarks --math [--filter TEXT] [--label TEXT] [--output FILE.json]
+      ShmuiBenchmarks --check [--filter TEXT] [--label TEXT] [--output FILE.json]
+
+    Results go to --output as JSON (stdout if omitted), one line of
+    progress per case to stderr. With --baseline, every case is compared
+    to the earlier run by mean and p99; the exit code is 1 if any mean
+    got slower by more than --threshold percent (default 10).
+
+    --math runs the fast-math suite instead: error and ns per value for
+    each Interpolation fast function against the standard library, and
+    for the batch smoothing helpers against scalar loops. The exit code
+    is 1 if any error exceeds its documented bound.
+
+    --check runs the self-checks instead: renderers and detectors compared
+    against stored references, plus timings of the code they exercise.
+    The exit code is 1 if any check is over its limit.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ComponentBenchmarks.h"
+#include "FastMathBenchmarks.h"
+#include "SelfChecks.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+namespace
+{
+    void printResult(const shmui::PaintTimings& result)
+    {
+        std::cerr << result.getKey() << "  mean " << juce::String(result.meanMs, 3)
+                  << " ms  p99 " << juce::String(result.p99Ms, 3)
+                  << " ms  max " << juce::String(result.maxMs, 3) << " ms" << std::endl;
+    }
+
+    /** Print the change per case; returns the number of mean regressions over the threshold. */
+    int compareToBaseline(const std::vector<shmui::PaintTimings>& baseline,
+                          const std::vector<shmui::PaintTimings>& results, double thresholdPercent)
+    {
+        std::map<juce::String, shmui::PaintTimings> previous;
+        for (const auto& entry : baseline)
+            previous[entry.getKey()] = entry;
+
+        auto change = [](double before, double after)
+        {
+            return before > 0.0 ? (after - before) / before * 100.0 : 0.0;
+        };
+
+        int numRegressions = 0;
+
+        for (const auto& result : results)
+        {
+            const auto it = previous.find(result.getKey());
+            if (it == previous.end())
+            {
+                std::cerr << result.getKey() << "  (new)" << std::endl;
+                continue;
+            }
+
+            const double meanChange = change(it->second.meanMs, result.meanMs);
+            const double p99Change = change(it->second.p99Ms, result.p99Ms);
+            const bool regressed = meanChange > thresholdPercent;
+
+            if (regressed)
+                ++numRegressions;
+
+            std::cerr << (regressed ? "SLOWER " : "       ") << result.getKey()
+                      << "  mean " << juce::String(meanChange, 1) << "%"
+                      << "  p99 " << juce::String(p99Change, 1) << "%" << std::endl;
+        }
+
+        return numRegressions;
+    }
+
+    void printMathResult(const shmui::MathTimings& result)
+    {
+        std::cerr << (result.isWithinBound() ? "       " : "ERROR  ") << result.getKey()
+                  << "  max " << (result.relative ? "rel " : "abs ") << result.maxError
+                  << " (bound " << result.errorBound << ")"
+                  << "  fast " << juce::String(result.fastNs, 2) << " ns"
+                  << "  std " << juce::String(result.referenceNs, 2) << " ns" << std::endl;
+    }
+
+    void printCheckResult(const shmui::CheckResult& result)
+    {
+        const char* status = result.skipped ? "SKIP   " : (result.passed() ? "       " : "FAIL   ");
+
+        std::cerr << status << result.getKey() << "  " << result.value << " " << result.unit;
+
+        if (!result.isTiming && !result.skipped)
+        {
+            std::cerr << " (limit ";
+            if (result.hasLowerLimit())
+                std::cerr << result.lowerLimit << "..";
+            std::cerr << result.limit << ")";
+        }
+
+        std::cerr << std::endl;
+    }
+
+    /** Write JSON to the output path (stdout if empty); false if the file could not be written. */
+    bool writeOutput(const juce::String& json, const juce::String& outputPath)
+    {
+        if (outputPath.isEmpty())
+        {
+            std::cout << json << std::endl;
+            return true;
+        }
+
+        if (juce::File::getCurrentWorkingDirectory().getChildFile(outputPath).replaceWithText(json))
+            return true;
+
+        std::cerr << "Could not write " << outputPath << std::endl;
+        return false;
+    }
+
+    int runMath(const juce::ArgumentList& args)
+    {
+        shmui::FastMathBenchmarks::Options options;
+        options.filter = args.getValueForOption("--filter");
+
+        shmui::FastMathBenchmarks benchmarks(options);
+        const auto results = benchmarks.runAll(printMathResult);
+
+        const auto json = shmui::FastMathBenchmarks::toJSON(results, options, args.getValueForOption("--label"));
+        if (!writeOutput(json, args.getValueForOption("--output")))
+            return 2;
+
+        const bool allWithinBounds = std::all_of(results.begin(), results.end(),
+                                                 [](const shmui::MathTimings& result) { return result.isWithinBound(); });
+        return allWithinBounds ? 0 : 1;
+    }
+
+    int runChecks(const juce::ArgumentList& args)
+    {
+        shmui::SelfChecks::Options options;
+        options.filter = args.getValueForOption("--filter");
+
+        shmui::SelfChecks checks(options);
+        const auto results = checks.runAll(printCheckResult);
+
+        const auto json = shmui::SelfChecks::toJSON(results, options, args.getValueForOption("--label"));
+        if (!writeOutput(json, args.getValueForOption("--output")))
+            return 2;
+
+        const bool allPassed = std::all_of(results.begin(), results.end(),
+                                           [](const shmui::CheckResult& result) { return result.passed(); });
+        return allPassed ? 0 : 1;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--math"))
+        return runMath(args);
+
+    if (args.containsOption("--check"))
+        return runChecks(args);
+
+    shmui::ComponentBenchmarks::Options options;
+    if (args.containsOption("--frames"))
+        options.numFrames = juce::jmax(1, args.getValueForOption("--frames").getIntValue());
+    if (args.containsOption("--warmup"))
+        options.warmupFrames = juce::jmax(0, args.getValueForOption("--warmup").getIntValue());
+    options.filter = args.getValueForOption("--filter");
+
+    shmui::ComponentBenchmarks benchmarks(options);
+    const auto results = benchmarks.runAll(printResult);
+
+    const auto json = shmui::ComponentBenchmarks::toJSON(results, options, args.getValueForOption("--label"));
+    if (!writeOutput(json, args.getValueForOption("--output")))
+        return 2;
+
+    const auto baselinePath = args.getValueForOption("--baseline");
+    if (baselinePath.isEmpty())
+        return 0;
+
+    const auto baseline = shmui::ComponentBenchmarks::fromJSON(
+        juce::File::getCurrentWorkingDirectory().getChildFile(baselinePath).loadFileAsString());
+
+    if (baseline.empty())
+    {
+        std::cerr << "No results in " << baselinePath << std::endl;
+        return 2;
+    }
+
+    const double threshold = args.containsOption("--threshold")
+                                 ? args.getValueForOption("--threshold").getDoubleValue()
+                                 : 10.0;
+
+    return compareToBaseline(baseline, results, threshold) > 0 ? 1 : 0;
+}
@@ -0,0 +1,574 @@
+/*
+  ==============================================================================
+
+    ComponentBenchmarks.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Headless paint() benchmark cases.
+
+  ==============================================================================
+*/
+
+#include "ComponentBenchmarks.h"
+#include "../Source/Audio/AudioAnalyzer.h"
+#include "../Source/Components/BarVisualizer.h"
+#include "../Source/Components/LevelMeter.h"
+#include "../Source/Components/MatrixDisplay.h"
+#include "../Source/Components/OrbVisualizer.h"
+#include "../Source/Components/TransportBar.h"
+#include "../Source/Components/WaveformEditor.h"
+#include "../Source/Components/WaveformVisualizer.h"
+#include "../Source/Controls/ClipButton.h"
+#include "../Source/Controls/IconButton.h"
+#include "../Source/Icons/IconCache.h"
+#include "../Source/Utils/Interpolation.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace shmui
+{
+
+namespace
+{
+    /** Delta used to step animated components between frames. */
+    constexpr double kFrameSeconds = 1.0 / 60.0;
+
+    /** Bumped when the JSON layout changes. */
+    constexpr int kSchemaVersion = 1;
+
+    struct Size { int width; int height; };
+
+    // Small, typical and full-screen-width layouts per component shape
+    const std::vector<Size> kWideSizes      { { 240, 48 },  { 800, 160 },  { 1920, 360 } };
+    const std::vector<Size> kStripSizes     { { 480, 40 },  { 960, 56 },   { 1920, 72 } };
+    const std::vector<Size> kMeterSizes     { { 24, 160 },  { 64, 400 },   { 160, 1000 } };
+    const std::vector<Size> kPanelSizes     { { 160, 80 },  { 480, 240 },  { 1280, 640 } };
+    const std::vector<Size> kButtonSizes    { { 80, 60 },   { 160, 120 },  { 320, 240 } };
+    const std::vector<Size> kOrbSizes       { { 96, 96 },   { 240, 240 },  { 480, 480 } };
+
+    /**
+     * Advance one frame of a component's animation, without a message loop
+     * or a window on screen.
+     */
+    template <typename ComponentType>
+    void stepFrame(ComponentType& component)
+    {
+        component.advanceFrameForTesting(kFrameSeconds);
+    }
+
+    std::vector<float> makeNoise(int numValues, uint32_t seed, float minValue = 0.0f, float maxValue = 1.0f)
+    {
+        Interpolation::SeedRandom rng(seed);
+        std::vector<float> values(static_cast<size_t>(numValues));
+
+        for (auto& value : values)
+            value = minValue + rng.next() * (maxValue - minValue);
+
+        return values;
+    }
+
+    double percentile(const std::vector<double>& sortedValues, double fraction)
+    {
+        if (sortedValues.empty())
+            return 0.0;
+
+        const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortedValues.size())));
+        return sortedValues[juce::jlimit<size_t>(1, sortedValues.size(), rank) - 1];
+    }
+}
+
+//==============================================================================
+ComponentBenchmarks::ComponentBenchmarks(const Options& options)
+    : m_options(options)
+{
+}
+
+std::vector<PaintTimings> ComponentBenchmarks::runAll(const std::function<void(const PaintTimings&)>& log)
+{
+    m_results.clear();
+    m_log = log;
+
+    benchmarkWaveforms();
+    benchmarkWaveformEditor();
+    benchmarkBarVisualizer();
+    benchmarkMatrixDisplay();
+    benchmarkLevelMeter();
+    benchmarkOrbVisualizer();
+    benchmarkTransportBar();
+    benchmarkClipButton();
+    benchmarkIconGrid();
+
+    m_log = nullptr;
+    return m_results;
+}
+
+void ComponentBenchmarks::run(const juce::String& component, const juce::String& variant,
+                              juce::Component& target, int width, int height, const FrameUpdate& update)
+{
+    PaintTimings timings;
+    timings.component = component;
+    timings.variant = variant;
+    timings.width = width;
+    timings.height = height;
+
+    if (m_options.filter.isNotEmpty() && !timings.getKey().containsIgnoreCase(m_options.filter))
+        return;
+
+    target.setBounds(0, 0, width, height);
+
+    // Software image so results do not depend on a GPU or a window
+    juce::Image image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+
+    const int numFrames = juce::jmax(1, m_options.numFrames);
+    std::vector<double> frameMs;
+    frameMs.reserve(static_cast<size_t>(numFrames));
+
+    for (int frame = -m_options.warmupFrames; frame < numFrames; ++frame)
+    {
+        if (update)
+            update(frame);
+
+        image.clear(image.getBounds());
+        juce::Graphics g(image);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        target.paintEntireComponent(g, true);
+        const auto endTicks = juce::Time::getHighResolutionTicks();
+
+        if (frame >= 0)
+            frameMs.push_back(juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1000.0);
+    }
+
+    std::sort(frameMs.begin(), frameMs.end());
+
+    double totalMs = 0.0;
+    for (const double ms : frameMs)
+        totalMs += ms;
+
+    timings.numFrames = numFrames;
+    timings.meanMs = totalMs / static_cast<double>(numFrames);
+    timings.p99Ms = percentile(frameMs, 0.99);
+    timings.maxMs = frameMs.back();
+
+    m_results.push_back(timings);
+
+    if (m_log)
+        m_log(timings);
+}
+
+//==============================================================================
+void ComponentBenchmarks::benchmarkWaveforms()
+{
+    for (const int numPoints : { 64, 1024, 16384 })
+    {
+        const juce::String variant = "points=" + juce::String(numPoints);
+
+        for (const auto& size : kWideSizes)
+        {
+            // Static waveform, data replaced every frame
+            {
+                WaveformVisualizer waveform;
+                auto data = makeNoise(numPoints, 1);
+
+                run("WaveformVisualizer", variant, waveform, size.width, size.height, [&](int)
+                {
+                    std::rotate(data.begin(), data.begin() + 1, data.end());
+                    waveform.setData(data);
+                });
+            }
+
+            // Scrubber with a moving playhead
+            {
+                AudioScrubberVisualizer scrubber;
+                scrubber.setData(makeNoise(numPoints, 2));
+                scrubber.setDuration(60.0f);
+
+                run("AudioScrubberVisualizer", variant, scrubber, size.width, size.height, [&](int frame)
+                {
+                    scrubber.setCurrentTime(static_cast<float>(std::fmod((frame + 1000) * kFrameSeconds, 60.0)));
+                });
+            }
+        }
+    }
+
+    // Scrolling waveform: density is set by the bar pitch
+    for (const float barWidth : { 1.0f, 4.0f, 12.0f })
+    {
+        const juce::String variant = "barWidth=" + juce::String(barWidth, 0);
+
+        for (const auto& size : kWideSizes)
+        {
+            ScrollingWaveformVisualizer scrolling;
+            WaveformStyle style;
+            style.barWidth = barWidth;
+            style.barGap = juce::jmax(1.0f, barWidth * 0.5f);
+            scrolling.setStyle(style);
+            scrolling.setSpeed(120.0f);
+
+            run("ScrollingWaveformVisualizer", variant, scrolling, size.width, size.height, [&](int)
+            {
+                stepFrame(scrolling);
+            });
+        }
+    }
+
+    // Live waveform: density is the history length
+    for (const int historySize : { 64, 256, 1024 })
+    {
+        const juce::String variant = "history=" + juce::String(historySize);
+
+        for (const auto& size : kWideSizes)
+        {
+            AudioAnalyzer analyzer;
+            LiveWaveformVisualizer live;
+            live.setAudioAnalyzer(&analyzer);
+            live.setHistorySize(historySize);
+            live.setUpdateRate(17);     // One history entry per 60 Hz frame
+            live.setActive(true);
+
+            const auto samples = makeNoise(512, 3, -0.5f, 0.5f);
+            auto pushAndStep = [&]
+            {
+                analyzer.pushSamples(samples.data(), static_cast<int>(samples.size()));
+                stepFrame(live);
+            };
+
+            // Start with a full history
+            for (int i = 0; i < historySize; ++i)
+                pushAndStep();
+
+            run("LiveWaveformVisualizer", variant, live, size.width, size.height, [&](int)
+            {
+                pushAndStep();
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkWaveformEditor()
+{
+    for (const int numPeaks : { 1024, 32768, 524288 })
+    {
+        WaveformData data;
+        data.minValues = makeNoise(numPeaks, 4, -1.0f, 0.0f);
+        data.maxValues = makeNoise(numPeaks, 5, 0.0f, 1.0f);
+        data.sampleRate = 48000;
+        data.numChannels = 2;
+        data.totalSamples = static_cast<int64_t>(numPeaks) * 256;
+        data.isValid = true;
+
+        const juce::String variant = "peaks=" + juce::String(numPeaks);
+
+        for (const auto& size : kWideSizes)
+        {
+            WaveformEditor editor;
+            editor.setWaveformData(data);
+            editor.setTrimPointsNormalized(0.05f, 0.95f);
+            editor.setFadeInSamples(data.totalSamples / 20);
+            editor.setFadeOutSamples(data.totalSamples / 20);
+
+            run("WaveformEditor", variant, editor, size.width, size.height, [&](int frame)
+            {
+                editor.setPlayheadNormalized(static_cast<float>((frame + m_options.warmupFrames) % 1000) / 1000.0f);
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkBarVisualizer()
+{
+    for (const int barCount : { 16, 64, 256 })
+    {
+        const juce::String variant = "bars=" + juce::String(barCount);
+
+        for (const auto& size : kWideSizes)
+        {
+            BarVisualizer bars;
+            bars.setBarCount(barCount);
+
+            // Pre-made band sets, cycled so the data cost stays out of the timing
+            std::vector<std::vector<float>> bandSets;
+            for (uint32_t i = 0; i < 8; ++i)
+                bandSets.push_back(makeNoise(barCount, 10 + i));
+
+            run("BarVisualizer", variant, bars, size.width, size.height, [&](int frame)
+            {
+                bars.setVolumeBands(bandSets[static_cast<size_t>(frame + m_options.warmupFrames) % bandSets.size()]);
+                stepFrame(bars);
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkMatrixDisplay()
+{
+    struct Grid { int rows; int cols; };
+
+    for (const auto grid : { Grid { 8, 32 }, Grid { 16, 64 }, Grid { 32, 128 } })
+    {
+        const juce::String dims = juce::String(grid.rows) + "x" + juce::String(grid.cols);
+
+        std::vector<Frame> patterns;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            const auto cells = makeNoise(grid.rows * grid.cols, 20 + i);
+            Frame pattern(static_cast<size_t>(grid.rows));
+
+            for (int row = 0; row < grid.rows; ++row)
+                pattern[static_cast<size_t>(row)].assign(cells.begin() + row * grid.cols,
+                                                         cells.begin() + (row + 1) * grid.cols);
+
+            patterns.push_back(std::move(pattern));
+        }
+
+        std::vector<std::vector<float>> levelSets;
+        for (uint32_t i = 0; i < 8; ++i)
+            levelSets.push_back(makeNoise(grid.cols, 30 + i));
+
+        for (const auto& size : kPanelSizes)
+        {
+            {
+                MatrixDisplay matrix;
+                matrix.setSize(grid.rows, grid.cols);
+
+                run("MatrixDisplay", "pattern=" + dims, matrix, size.width, size.height, [&](int frame)
+                {
+                    matrix.setPattern(patterns[static_cast<size_t>(frame + m_options.warmupFrames) % patterns.size()]);
+                });
+            }
+
+            {
+                MatrixDisplay matrix;
+                matrix.setSize(grid.rows, grid.cols);
+
+                run("MatrixDisplay", "vu=" + dims, matrix, size.width, size.height, [&](int frame)
+                {
+                    matrix.setLevels(levelSets[static_cast<size_t>(frame + m_options.warmupFrames) % levelSets.size()]);
+                });
+            }
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkLevelMeter()
+{
+    for (const int numChannels : { 1, 2, 8 })
+    {
+        const juce::String variant = "channels=" + juce::String(numChannels);
+
+        std::vector<std::vector<float>> levelSets;
+        for (uint32_t i = 0; i < 8; ++i)
+            levelSets.push_back(makeNoise(numChannels, 40 + i, 0.0f, 1.2f));
+
+        for (const auto& size : kMeterSizes)
+        {
+            LevelMeter meter(numChannels);
+
+            // Wider than tall for the multichannel cases
+            const int width = size.width * numChannels;
+
+            run("LevelMeter", variant, meter, width, size.height, [&](int frame)
+            {
+                meter.setLevels(levelSets[static_cast<size_t>(frame + m_options.warmupFrames) % levelSets.size()]);
+                stepFrame(meter);
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkOrbVisualizer()
+{
+    // CPU renderer only; the OpenGL path does not paint into an image
+    const auto volumes = makeNoise(64, 50);
+
+    for (const float scale : { 0.25f, 0.5f, 1.0f })
+    {
+        const juce::String variant = "software,scale=" + juce::String(scale, 2);
+
+        for (const auto& size : kOrbSizes)
+        {
+            OrbVisualizer orb;
+            orb.setRenderBackend(OrbRenderBackend::Software);
+            orb.setSoftwareResolutionScale(scale);
+            orb.setVolumeMode(OrbVolumeMode::Manual);
+
+            run("OrbVisualizer", variant, orb, size.width, size.height, [&](int frame)
+            {
+                const auto index = static_cast<size_t>(frame + m_options.warmupFrames);
+                orb.setInputVolume(volumes[index % volumes.size()]);
+                orb.setOutputVolume(volumes[(index + 17) % volumes.size()]);
+                stepFrame(orb);
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkTransportBar()
+{
+    const std::pair<TimeDisplayFormat, const char*> formats[] =
+    {
+        { TimeDisplayFormat::MinutesSeconds, "MinutesSeconds" },
+        { TimeDisplayFormat::Bars,           "Bars" },
+        { TimeDisplayFormat::Samples,        "Samples" },
+        { TimeDisplayFormat::Timecode,       "Timecode" }
+    };
+
+    for (const auto& format : formats)
+    {
+        const juce::String variant = juce::String("format=") + format.second;
+
+        for (const auto& size : kStripSizes)
+        {
+            TransportBar transport;
+            transport.setTimeFormat(format.first);
+            transport.setTempo(120.0);
+            transport.setDurationSeconds(3600.0);
+            transport.setPlaying(true);
+
+            run("TransportBar", variant, transport, size.width, size.height, [&](int frame)
+            {
+                transport.setPositionSeconds((frame + m_options.warmupFrames) * kFrameSeconds);
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkClipButton()
+{
+    const std::pair<ClipButton::State, const char*> states[] =
+    {
+        { ClipButton::State::Empty,   "Empty" },
+        { ClipButton::State::Loaded,  "Loaded" },
+        { ClipButton::State::Playing, "Playing" }
+    };
+
+    for (const auto& state : states)
+    {
+        const juce::String variant = juce::String("state=") + state.second;
+
+        for (const auto& size : kButtonSizes)
+        {
+            ClipButton clip(1);
+
+            if (state.first != ClipButton::State::Empty)
+            {
+                clip.setClipName("Benchmark Clip With A Long Name");
+                clip.setClipColor(juce::Colour(0xFF3B82F6));
+                clip.setClipDuration(93.5);
+                clip.setKeyboardShortcut("Q");
+                clip.setLoopEnabled(true);
+                clip.setFadeInEnabled(true);
+                clip.setFadeOutEnabled(true);
+            }
+
+            clip.setClipState(state.first);
+
+            run("ClipButton", variant, clip, size.width, size.height, [&](int frame)
+            {
+                if (state.first == ClipButton::State::Playing)
+                    clip.setPlaybackProgress(static_cast<float>((frame + m_options.warmupFrames) % 600) / 600.0f);
+
+                stepFrame(clip);
+            });
+        }
+    }
+}
+
+void ComponentBenchmarks::benchmarkIconGrid()
+{
+    // 200 icon buttons in one parent, drawn as vectors and from the icon atlas
+    constexpr int kColumns = 20;
+    constexpr int kRows = 10;
+
+    juce::SharedResourcePointer<IconCache> iconCache;
+    const bool wasAtlasEnabled = iconCache->isAtlasEnabled();
+
+    for (const int cellSize : { 24, 32, 48 })
+    {
+        juce::Component grid;
+        std::vector<std::unique_ptr<IconButton>> buttons;
+
+        for (int i = 0; i < kColumns * kRows; ++i)
+        {
+            auto button = std::make_unique<IconButton>(static_cast<IconType>(i % static_cast<int>(IconType::NumIcons)),
+                                                       ButtonStyle::Ghost);
+            button->setBounds((i % kColumns) * cellSize, (i / kColumns) * cellSize, cellSize, cellSize);
+            grid.addAndMakeVisible(*button);
+            buttons.push_back(std::move(button));
+        }
+
+        for (const bool useAtlas : { false, true })
+        {
+            iconCache->setAtlasEnabled(useAtlas);
+
+            const juce::String variant = juce::String("icons=200,") + (useAtlas ? "atlas" : "vector");
+            run("IconButtonGrid", variant, grid, kColumns * cellSize, kRows * cellSize, nullptr);
+        }
+    }
+
+    iconCache->setAtlasEnabled(wasAtlasEnabled);
+}
+
+//==============================================================================
+juce::String ComponentBenchmarks::toJSON(const std::vector<PaintTimings>& results, const Options& options,
+                                         const juce::String& label)
+{
+    juce::Array<juce::var> cases;
+
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("key", result.getKey());
+        entry->setProperty("component", result.component);
+        entry->setProperty("variant", result.variant);
+        entry->setProperty("width", result.width);
+        entry->setProperty("height", result.height);
+        entry->setProperty("frames", result.numFrames);
+        entry->setProperty("meanMs", result.meanMs);
+        entry->setProperty("p99Ms", result.p99Ms);
+        entry->setProperty("maxMs", result.maxMs);
+        cases.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("schema", kSchemaVersion);
+    root->setProperty("label", label);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("juce", juce::SystemStats::getJUCEVersion());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("frames", options.numFrames);
+    root->setProperty("warmupFrames", options.warmupFrames);
+    root->setProperty("results", cases);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+std::vector<PaintTimings> ComponentBenchmarks::fromJSON(const juce::String& json)
+{
+    std::vector<PaintTimings> results;
+
+    const auto root = juce::JSON::parse(json);
+    const auto* cases = root.getProperty("results", juce::var()).getArray();
+    if (cases == nullptr)
+        return results;
+
+    for (const auto& entry : *cases)
+    {
+        PaintTimings timings;
+        timings.component = entry.getProperty("component", juce::var()).toString();
+        timings.variant = entry.getProperty("variant", juce::var()).toString();
+        timings.width = entry.getProperty("width", 0);
+        timings.height = entry.getProperty("height", 0);
+        timings.numFrames = entry.getProperty("frames", 0);
+        timings.meanMs = entry.getProperty("meanMs", 0.0);
+        timings.p99Ms = entry.getProperty("p99Ms", 0.0);
+        timings.maxMs = entry.getProperty("maxMs", 0.0);
+        results.push_back(timings);
+    }
+
+    return results;
+}
+
+} // namespace shmui
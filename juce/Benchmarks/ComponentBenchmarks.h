@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    ComponentBenchmarks.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Headless paint() benchmarks for the shmui components. Every case
+    renders into a software juce::Image at several sizes and data
+    densities; results are written as JSON so runs can be diffed.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Paint timings for one component, variant and size.
+ */
+struct PaintTimings
+{
+    juce::String component;     ///< Component class, e.g. "LevelMeter"
+    juce::String variant;       ///< Data density, e.g. "channels=8"
+    int width = 0;
+    int height = 0;
+    int numFrames = 0;
+    double meanMs = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+
+    /** Key that identifies the case across runs. */
+    juce::String getKey() const
+    {
+        return component + "/" + variant + "/" + juce::String(width) + "x" + juce::String(height);
+    }
+};
+
+//==============================================================================
+/**
+ * @brief Headless render benchmark suite.
+ *
+ * Each case creates the component off screen, gives it data, then for
+ * every frame updates the data (untimed), clears the image (untimed) and
+ * times paintEntireComponent() into a software image, so children such
+ * as the TransportBar buttons are included. Animated components are
+ * stepped with a fixed 60 Hz delta between frames instead of running the
+ * FrameClock, which never ticks components that are not on screen.
+ *
+ * Needs a JUCE message manager (juce::ScopedJuceInitialiser_GUI) and
+ * must run on the message thread.
+ */
+class ComponentBenchmarks
+{
+public:
+    //==============================================================================
+    struct Options
+    {
+        int numFrames = 300;        ///< Timed frames per case
+        int warmupFrames = 20;      ///< Untimed frames before measuring
+        juce::String filter;        ///< Only run cases whose key contains this (empty = all)
+    };
+
+    //==============================================================================
+    explicit ComponentBenchmarks(const Options& options);
+
+    /**
+     * @brief Run every case that matches the filter.
+     *
+     * @param log Called with each result as it completes (optional)
+     */
+    std::vector<PaintTimings> runAll(const std::function<void(const PaintTimings&)>& log = nullptr);
+
+    /**
+     * @brief Serialise results, with machine details, as JSON.
+     *
+     * @param label Free text stored with the run, e.g. a commit hash
+     */
+    static juce::String toJSON(const std::vector<PaintTimings>& results, const Options& options,
+                               const juce::String& label);
+
+    /**
+     * @brief Read results written by toJSON() (empty if the text is not a results file).
+     */
+    static std::vector<PaintTimings> fromJSON(const juce::String& json);
+
+private:
+    //==============================================================================
+    using FrameUpdate = std::function<void(int frame)>;
+
+    void run(const juce::String& component, const juce::String& variant,
+             juce::Component& target, int width, int height, const FrameUpdate& update);
+
+    void benchmarkWaveforms();
+    void benchmarkWaveformEditor();
+    void benchmarkBarVisualizer();
+    void benchmarkMatrixDisplay();
+    void benchmarkLevelMeter();
+    void benchmarkOrbVisualizer();
+    void benchmarkTransportBar();
+    void benchmarkClipButton();
+    void benchmarkIconGrid();
+
+    //==============================================================================
+    Options m_options;
+    std::vector<PaintTimings> m_results;
+    std::function<void(const PaintTimings&)> m_log;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ComponentBenchmarks)
+};
+
+} // namespace shmui
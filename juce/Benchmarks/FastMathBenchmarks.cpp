@@ -0,0 +1,338 @@
+/*
+  ==============================================================================
+
+    FastMathBenchmarks.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Fast-math accuracy and throughput cases.
+
+  ==============================================================================
+*/
+
+#include "FastMathBenchmarks.h"
+#include "../Source/Utils/Interpolation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace shmui
+{
+
+namespace
+{
+    /** Bumped when the JSON layout changes. */
+    constexpr int kSchemaVersion = 1;
+
+    constexpr float kTwoPi = juce::MathConstants<float>::twoPi;
+
+    /** Keeps results alive so timed loops are not optimised away. */
+    volatile float sink = 0.0f;
+
+    juce::String formatRange(float low, float high)
+    {
+        return juce::String(low) + ".." + juce::String(high);
+    }
+}
+
+//==============================================================================
+FastMathBenchmarks::FastMathBenchmarks(const Options& options)
+    : m_options(options)
+{
+}
+
+std::vector<MathTimings> FastMathBenchmarks::runAll(const std::function<void(const MathTimings&)>& log)
+{
+    m_results.clear();
+    m_log = log;
+
+    const auto numValues = static_cast<size_t>(juce::jmax(1, m_options.numValues));
+    m_input.resize(numValues);
+    m_output.resize(numValues);
+
+    // Bounds as documented in Interpolation.h
+    run("fastLog2", 1.0e-30f, 1.0e30f, true, false, 2.0e-5,
+        [](float x) { return Interpolation::fastLog2(x); },
+        [](float x) { return std::log2(x); },
+        [](double x) { return std::log2(x); });
+
+    run("fastLog10", 1.0e-30f, 1.0e30f, true, false, 1.0e-5,
+        [](float x) { return Interpolation::fastLog10(x); },
+        [](float x) { return std::log10(x); },
+        [](double x) { return std::log10(x); });
+
+    run("fastGainToDb", 1.0e-6f, 10.0f, true, false, 2.0e-4,
+        [](float x) { return Interpolation::fastGainToDb(x); },
+        [](float x) { return 20.0f * std::log10(x); },
+        [](double x) { return 20.0 * std::log10(x); });
+
+    run("fastExp2", -126.0f, 127.0f, false, true, 2.0e-7,
+        [](float x) { return Interpolation::fastExp2(x); },
+        [](float x) { return std::exp2(x); },
+        [](double x) { return std::exp2(x); });
+
+    run("fastExp", -80.0f, 80.0f, false, true, 5.0e-6,
+        [](float x) { return Interpolation::fastExp(x); },
+        [](float x) { return std::exp(x); },
+        [](double x) { return std::exp(x); });
+
+    run("fastSinCycles", -1000.0f, 1000.0f, false, false, 1.0e-6,
+        [](float x) { return Interpolation::fastSinCycles(x); },
+        [](float x) { return std::sin(x * kTwoPi); },
+        [](double x) { return std::sin(2.0 * juce::MathConstants<double>::pi * std::fmod(x, 1.0)); });
+
+    for (const float high : { kTwoPi, 1000.0f })
+    {
+        const double bound = high > 10.0f ? 1.5e-4 : 2.0e-6;
+
+        run("fastSin", -high, high, false, false, bound,
+            [](float x) { return Interpolation::fastSin(x); },
+            [](float x) { return std::sin(x); },
+            [](double x) { return std::sin(x); });
+
+        run("fastCos", -high, high, false, false, bound,
+            [](float x) { return Interpolation::fastCos(x); },
+            [](float x) { return std::cos(x); },
+            [](double x) { return std::cos(x); });
+    }
+
+    run("fastRsqrt", 1.0e-30f, 1.0e30f, true, true, 5.0e-6,
+        [](float x) { return Interpolation::fastRsqrt(x); },
+        [](float x) { return 1.0f / std::sqrt(x); },
+        [](double x) { return 1.0 / std::sqrt(x); });
+
+    runSeedRandom();
+
+    // Batch smoothing and easing at a few meters' worth, a spectrum and a long history
+    for (const int size : { 16, 256, 4096 })
+    {
+        runBatch("smooth", size,
+            [](float* current, const float* target, int n) { Interpolation::smooth(current, target, 0.2f, n); },
+            [](float current, float target) { return Interpolation::smooth(current, target, 0.2f); });
+
+        runBatch("smoothAttackRelease", size,
+            [](float* current, const float* target, int n) { Interpolation::smoothAttackRelease(current, target, 0.5f, 0.05f, n); },
+            [](float current, float target) { return Interpolation::smooth(current, target, target > current ? 0.5f : 0.05f); });
+
+        runBatch("lerp", size,
+            [](float* current, const float* target, int n) { Interpolation::lerp(current, current, target, 0.3f, n); },
+            [](float current, float target) { return Interpolation::lerp(current, target, 0.3f); });
+
+        runBatch("ease(easeOutQuad)", size,
+            [](float* current, const float*, int n) { Interpolation::ease(current, n, Interpolation::easeOutQuad); },
+            [](float current, float) { return Interpolation::easeOutQuad(current); });
+    }
+
+    m_log = nullptr;
+    return m_results;
+}
+
+//==============================================================================
+template <typename Function>
+double FastMathBenchmarks::timePasses(Function&& pass) const
+{
+    double bestSeconds = 0.0;
+
+    for (int i = 0; i < juce::jmax(1, m_options.numPasses); ++i)
+    {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        pass();
+        const auto endTicks = juce::Time::getHighResolutionTicks();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(endTicks - startTicks);
+        bestSeconds = i == 0 ? seconds : std::min(bestSeconds, seconds);
+    }
+
+    return bestSeconds * 1.0e9 / static_cast<double>(m_input.size());
+}
+
+template <typename Fast, typename Reference, typename Exact>
+void FastMathBenchmarks::run(const juce::String& function, float low, float high, bool logSpaced,
+                             bool relative, double errorBound, Fast fast, Reference reference, Exact exact)
+{
+    MathTimings timings;
+    timings.function = function;
+    timings.range = formatRange(low, high);
+    timings.relative = relative;
+    timings.errorBound = errorBound;
+
+    if (m_options.filter.isNotEmpty() && !timings.getKey().containsIgnoreCase(m_options.filter))
+        return;
+
+    // Inputs spread evenly (or evenly in log space) over the range
+    const int numValues = static_cast<int>(m_input.size());
+    const double logLow = logSpaced ? std::log(static_cast<double>(low)) : 0.0;
+    const double logHigh = logSpaced ? std::log(static_cast<double>(high)) : 0.0;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const double t = numValues > 1 ? static_cast<double>(i) / (numValues - 1) : 0.0;
+        m_input[static_cast<size_t>(i)] = logSpaced ? static_cast<float>(std::exp(logLow + (logHigh - logLow) * t))
+                                                    : static_cast<float>(low + (high - low) * t);
+    }
+
+    for (const float x : m_input)
+    {
+        const double expected = exact(static_cast<double>(x));
+        const double error = std::abs(static_cast<double>(fast(x)) - expected);
+        timings.maxError = std::max(timings.maxError, relative ? error / std::abs(expected) : error);
+    }
+
+    float* out = m_output.data();
+    const float* in = m_input.data();
+
+    timings.fastNs = timePasses([&]
+    {
+        for (int i = 0; i < numValues; ++i)
+            out[i] = fast(in[i]);
+
+        sink = out[numValues / 2];
+    });
+
+    timings.referenceNs = timePasses([&]
+    {
+        for (int i = 0; i < numValues; ++i)
+            out[i] = reference(in[i]);
+
+        sink = out[numValues / 2];
+    });
+
+    m_results.push_back(timings);
+
+    if (m_log)
+        m_log(timings);
+}
+
+void FastMathBenchmarks::runSeedRandom()
+{
+    MathTimings timings;
+    timings.function = "SeedRandom::fill";
+    timings.range = "next()";
+    timings.errorBound = 0.0;   // Must match next() exactly
+
+    if (m_options.filter.isNotEmpty() && !timings.getKey().containsIgnoreCase(m_options.filter))
+        return;
+
+    const int numValues = static_cast<int>(m_output.size());
+    float* out = m_output.data();
+
+    Interpolation::SeedRandom batch(1234);
+    Interpolation::SeedRandom single(1234);
+    batch.fill(out, numValues);
+
+    for (int i = 0; i < numValues; ++i)
+        timings.maxError = std::max(timings.maxError, static_cast<double>(std::abs(out[i] - single.next())));
+
+    timings.fastNs = timePasses([&]
+    {
+        batch.fill(out, numValues);
+        sink = out[numValues / 2];
+    });
+
+    timings.referenceNs = timePasses([&]
+    {
+        for (int i = 0; i < numValues; ++i)
+            out[i] = single.next();
+
+        sink = out[numValues / 2];
+    });
+
+    m_results.push_back(timings);
+
+    if (m_log)
+        m_log(timings);
+}
+
+template <typename Batch, typename Scalar>
+void FastMathBenchmarks::runBatch(const juce::String& function, int size, Batch batch, Scalar scalar)
+{
+    MathTimings timings;
+    timings.function = function;
+    timings.range = "n=" + juce::String(size);
+    timings.errorBound = 1.0e-6;   // Same arithmetic; only contraction into FMAs may differ
+
+    if (m_options.filter.isNotEmpty() && !timings.getKey().containsIgnoreCase(m_options.filter))
+        return;
+
+    // Current values in m_output, targets in m_input, both 0-1
+    const int numValues = static_cast<int>(m_input.size());
+    const int n = juce::jmin(size, numValues);
+    const int numCalls = juce::jmax(1, numValues / n);
+    float* current = m_output.data();
+    const float* target = m_input.data();
+
+    Interpolation::SeedRandom random(99);
+    random.fill(m_input.data(), numValues);
+    random.fill(current, n);
+
+    std::vector<float> expected(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i)
+        expected[static_cast<size_t>(i)] = scalar(current[i], target[i]);
+
+    batch(current, target, n);
+
+    for (int i = 0; i < n; ++i)
+        timings.maxError = std::max(timings.maxError,
+                                    static_cast<double>(std::abs(current[i] - expected[static_cast<size_t>(i)])));
+
+    // Every pass covers about numValues elements, in calls of size n
+    timings.fastNs = timePasses([&]
+    {
+        for (int call = 0; call < numCalls; ++call)
+            batch(current, target + (call * n) % (numValues - n + 1), n);
+
+        sink = current[n / 2];
+    }) * numValues / (numCalls * n);
+
+    timings.referenceNs = timePasses([&]
+    {
+        for (int call = 0; call < numCalls; ++call)
+        {
+            const float* callTarget = target + (call * n) % (numValues - n + 1);
+
+            for (int i = 0; i < n; ++i)
+                current[i] = scalar(current[i], callTarget[i]);
+        }
+
+        sink = current[n / 2];
+    }) * numValues / (numCalls * n);
+
+    m_results.push_back(timings);
+
+    if (m_log)
+        m_log(timings);
+}
+
+//==============================================================================
+juce::String FastMathBenchmarks::toJSON(const std::vector<MathTimings>& results, const Options& options,
+                                        const juce::String& label)
+{
+    juce::Array<juce::var> cases;
+
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("key", result.getKey());
+        entry->setProperty("function", result.function);
+        entry->setProperty("range", result.range);
+        entry->setProperty("relative", result.relative);
+        entry->setProperty("maxError", result.maxError);
+        entry->setProperty("errorBound", result.errorBound);
+        entry->setProperty("fastNs", result.fastNs);
+        entry->setProperty("referenceNs", result.referenceNs);
+        cases.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("schema", kSchemaVersion);
+    root->setProperty("suite", "fastMath");
+    root->setProperty("label", label);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("values", options.numValues);
+    root->setProperty("passes", options.numPasses);
+    root->setProperty("results", cases);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+} // namespace shmui
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    FastMathBenchmarks.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Accuracy checks and throughput timings for the fast-math functions in
+    Utils/Interpolation.h, each against the standard-library call it
+    replaces on the visual paths, and for the batch smoothing and easing
+    helpers against loops of their scalar versions.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Accuracy and speed of one fast-math function over one input range.
+ */
+struct MathTimings
+{
+    juce::String function;      ///< e.g. "fastGainToDb"
+    juce::String range;         ///< Input range, e.g. "1e-6..10"
+    bool relative = false;      ///< Error is relative rather than absolute
+    double maxError = 0.0;      ///< Largest error against a double-precision reference (or the scalar helper)
+    double errorBound = 0.0;    ///< Bound documented in Interpolation.h
+    double fastNs = 0.0;        ///< Nanoseconds per value, fast version
+    double referenceNs = 0.0;   ///< Nanoseconds per value, standard library (or scalar loop)
+
+    /** True if the measured error is within the documented bound. */
+    bool isWithinBound() const { return maxError <= errorBound; }
+
+    /** Key that identifies the case across runs. */
+    juce::String getKey() const { return function + "/" + range; }
+};
+
+//==============================================================================
+/**
+ * @brief Fast-math accuracy and throughput suite.
+ *
+ * Every case fills an array with inputs spread over its range, measures
+ * the largest error of the fast function against a double-precision
+ * result, then times array loops of the fast function and of the float
+ * standard-library call (best of several passes). Loops are written the
+ * way the components use the functions, so the compiler may vectorize
+ * them. Batch cases call the array helper on arrays of a fixed size
+ * (range "n=256") and compare it with a per-element loop of the scalar
+ * helper. Runs without a message manager.
+ */
+class FastMathBenchmarks
+{
+public:
+    //==============================================================================
+    struct Options
+    {
+        int numValues = 1 << 16;    ///< Inputs per case
+        int numPasses = 50;         ///< Timed passes per function (best is kept)
+        juce::String filter;        ///< Only run cases whose key contains this (empty = all)
+    };
+
+    //==============================================================================
+    explicit FastMathBenchmarks(const Options& options);
+
+    /**
+     * @brief Run every case that matches the filter.
+     *
+     * @param log Called with each result as it completes (optional)
+     */
+    std::vector<MathTimings> runAll(const std::function<void(const MathTimings&)>& log = nullptr);
+
+    /**
+     * @brief Serialise results, with machine details, as JSON.
+     */
+    static juce::String toJSON(const std::vector<MathTimings>& results, const Options& options,
+                               const juce::String& label);
+
+private:
+    //==============================================================================
+    template <typename Fast, typename Reference, typename Exact>
+    void run(const juce::String& function, float low, float high, bool logSpaced,
+             bool relative, double errorBound, Fast fast, Reference reference, Exact exact);
+
+    void runSeedRandom();
+
+    template <typename Batch, typename Scalar>
+    void runBatch(const juce::String& function, int size, Batch batch, Scalar scalar);
+
+    template <typename Function>
+    double timePasses(Function&& pass) const;
+
+    //==============================================================================
+    Options m_options;
+    std::vector<MathTimings> m_results;
+    std::function<void(const MathTimings&)> m_log;
+    std::vector<float> m_input;
+    std::vector<float> m_output;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FastMathBenchmarks)
+};
+
+} // namespace shmui
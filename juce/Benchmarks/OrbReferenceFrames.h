@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    OrbReferenceFrames.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Reference frames of the orb shader for checking OrbSoftwareRenderer.
+    Each frame is 48x48, rendered by the OrbRenderService fragment shader
+    (Mesa llvmpipe, GL_LINEAR noise texture, no blending) with the uniforms
+    from getUniforms(). Only the premultiplied red channel is stored, top
+    row first, base64 encoded. The colours are a grey ramp, so red carries
+    the full shading.
+
+    Regenerate these if the shader math changes on purpose.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Components/OrbSoftwareRenderer.h"
+
+namespace shmui
+{
+
+/**
+ * @brief Stored shader output used by the --check suite.
+ */
+namespace OrbReferenceFrames
+{
+
+/** Width and height of every frame. */
+constexpr int kSize = 48;
+
+/** Number of stored frames. */
+constexpr int kNumFrames = 4;
+
+/**
+ * @brief Uniforms the given frame was rendered with.
+ *
+ * Frame 0 is the defaults; the others cover idle and loud volumes, large
+ * times and the inverted mode.
+ */
+inline OrbUniforms getUniforms(int index)
+{
+    OrbUniforms uniforms;
+    uniforms.color1 = juce::Colour(0xFF555555);
+    uniforms.color2 = juce::Colour(0xFFAAAAAA);
+
+    switch (index)
+    {
+        case 1:
+            uniforms.time = 12.5f;
+            uniforms.animation = 3.2f;
+            uniforms.inputVolume = 0.6f;
+            uniforms.outputVolume = 0.3f;
+            uniforms.offsets = { 0.3f, 1.1f, 2.0f, 0.7f, 1.5f, 2.6f, 0.2f };
+            break;
+
+        case 2:
+            uniforms.time = 47.0f;
+            uniforms.animation = 9.5f;
+            uniforms.inputVolume = 0.2f;
+            uniforms.outputVolume = 0.9f;
+            uniforms.offsets = { 2.9f, 0.4f, 1.7f, 3.1f, 0.9f, 2.2f, 1.3f };
+            uniforms.inverted = true;
+            break;
+
+        case 3:
+            uniforms.time = 103.0f;
+            uniforms.animation = 20.0f;
+            uniforms.inputVolume = 1.0f;
+            uniforms.outputVolume = 1.0f;
+            uniforms.offsets = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 0.5f };
+            break;
+
+        default:
+            break;
+    }
+
+    return uniforms;
+}
+
+/** Base64 red channel per frame, kSize * kSize bytes once decoded. */
+inline const char* const kRedChannel[kNumFrames] =
+{
+    // Frame 0
+    "//////////705tXGuK2mpaampqWkpJ6enp6en6CgoKCgpbXC0uPy/f/////////////////////57NvKu6+npaWlpJ2cnJyc"
+    "nJycnZ6foJ+gprPC1+j3///////////////////////98uLQv7KopaWfnZyampqampmam5yen5+hqLfI2+78////////////"
+    "////////////+OnXxbWqn5+enJqYmJiYl5aWlpeZm5ygrLvP4/T//////////////////////////vHfzLWmnpyal5SSkY+O"
+    "jIqJiYqMkJKZqcDX6/v///////////////////////////nlzbWglZGOi4iGhISEg4KCg4WIi46WqcPe9P//////////////"
+    "//////////////7v1rujk4yJhYOBgYKDgoGBgoSHi4+bsczo+//////////////////////////////65Mitl42IhIGAgYKD"
+    "goGAgIKGipGivdrz////////////////////////////////8ti6n4+Ig4B/gIKDgoGAgIGFipaty+n9////////////////"
+    "/v///////////////unKq5SIg4B/gIKDgoGAf4GFjJ673Pf/////////////////9Pj8//////////////ndu52Kg39+gIGD"
+    "goF/foCFkKrM7v//////////////////5Orw9fr////////////xz6uPhH9+gIGDgoF/foCGmrvh/P///////////////vv4"
+    "0NXZ4enx+P//////////57+ahX9+f4GDgoB/fYGKqdH1/////////////ffx7OfkvbzBx83U4O75////////+9muioB9f4GD"
+    "goB+fYKVv+v///////////nt4dnX08/NsKyvsrOzvcvd7/z///////TJmYJ9foCDgoB+fYWq2//////////35tXHvLi5vbu6"
+    "oaKjpJ+boKi1x93z///////qtod9foCCgn99fpHI+P//////+OLMu6+loJ2irq2tnZ2enZWPkZSZorHG4fn/////25x/fYCC"
+    "gn98ga/s//////7kyLOkm5aTkY+UnaWlm5ubmpCLi4yNkJWdrsns/////seFfH+CgX58j9n/////7cmunZWQjYyLioqNl6Gh"
+    "mpqal42JiYqKi4yNkZqv0/r///iofX6CgX5+vv////3SrZmRjYuKiomJiYiJkqCgmZmZlYuIiImJiYqKi4yPmbXp///phn2B"
+    "gXyS+P//57GXjouKiomJiIiIiIeHj5ifmZmZkoiHh4eIiIiJiYqKi42Zxf//zXyBgHzg///AloyKiomJiIiIh4eHh4aGjZee"
+    "mJiXjoaGhoaHh4eHiIiIiYqKjJzv/5KAf6T/7JmLiomJiIiHh4eGhoaGhoaFjJael5eUiYWFhYWFhYaGhoaGh4eIiYqLrf99"
+    "fP+ni4mIh4eGhoaGhYWFhYWFhYWEi5WXl5aPhYSEhISEhISEhISFhYWFhYaGh4r//4mHhoWFhYSEhISEhISEhISEhISEi5WW"
+    "lpSJhISEhISEhISEhISEhIWFhYWGh4n//4mHhoWFhISEhISEhISEhISEg4OEjJaWl5KHhYWFhYWFhYWGhoaGh4eIiImLpf+O"
+    "jv+oi4mIh4eGhoaFhYWFhYWFhYSFjpaXnpCGhoaGhoaGh4eHh4iIiYmKjJjm/72QkND/7pmLiomIiIeHh4aGhoaGhoWGjpeX"
+    "npCHh4eHh4eIiIiIiYmKi4yVu/3/942RkY3////Bl4yKiomJiIiIh4eHh4aGj5iYn5KIh4iIiIiJiYmKiouNla3f////qo6S"
+    "kY66////6LKXjouKiomJiIiIiIeHkJmZoKCKiIiJiYmKiouMj5anyfX////XjY+Sko+S6f////3TrpmRjYuKiYmJiIiIkJma"
+    "oaGOiYqKi4uMjpKZpr/j/v////SmjpCSko+Ntv7/////78qvnpWQjYyLioqKkpuboqKUjY2Nj5GVnKi82PT//////8mRjpCT"
+    "kpCOmNv///////7mybSlnJaTkI+Pl5+fpaanlpOWm6KuvdPs/f//////5qiNj5GTkpCOjrj1////////+eTNvK+moJyboqen"
+    "ra6wp6WrtMLT5/j////////4xZaOj5GTkpGPjaDX///////////459bIvbWxtba6uLu/v8PK1+b1/v/////////grY+OkJGT"
+    "kpGPjpS98P////////////rt4dbQz8zNyc7U2+Lr9Pz///////////PInY2PkJKTk5GQjo+q2f7//////////////fbw6+jk"
+    "3uTq8fb8/////////////uC1lY6PkJKTk5GQj46dxe///////////////////vz58PT5/f//////////////882nkI6PkZKT"
+    "k5GQj46Xtd79////////////////////+/7////////////////+5L+ej4+QkZKTk5KQj46Tq8/y////////////////////"
+    "///////////////////11rSZjo+QkZKTk5KRkI+Ro8Pm/v/////////////////////////////////////ry6yWjo+QkZKT"
+    "k5KRkI+Qnrrb9/////////////////////////////////////rhwqaUj4+QkZKTk5KRkI+Qm7PS7///////////////////"
+    "//////////////////TZvKOUj5CRkZKTk5KRkI+QmrDM6f3//////////////////////////////////+/UuKGUj5CRkpKT"
+    "k5KRkJCTn7TM5fn//////////////////////////////////OvUuqKUj5CRkpKTk5OUlpmdqLjM4vb/////////////////"
+    "////////////////+ejTvquclJOTlJWXmZudn6Ciq7zO4fP/////////////////////////////////+OfSwLGln52dnp+h"
+    "oqKioaepsb3N4PH+////////////////////////////////9ufVxbeoo6GioqOkqaiop6ess7/O3/D9////////////////",
+
+    // Frame 1
+    "//////z27+ji3NjV0tHOy8jFxMLCwsPExMTDxMXJztbg6vX9/////////fr39fLw//////rz6+Td19PQzczJxsPBwL+/wLa3"
+    "uLi3t7jGy9Pe6fT9//////779/Pv7Onn/////vjx6ODZ08/LycjFwsCxr6+wsrW3uLi3t7a5vsjV6PX+/////fjz7ejk4N7d"
+    "/////fjv5t7W0MvIxsW3tLCura2usbS3uLi3t7a3vcfU5PP////89u7n4d3Y1dTT/////ffv5dzUzcnGubi2s6+tq6utsLO1"
+    "tbOys7W2u8bU5fX///vz6eHb1tHOzczM/////vbu5dvSy7u5uLi3tLCsq6qopaKgoJ2cnqGot8bV6Pj/+e3l3NXQy8nHxsbG"
+    "//////ju5NvSwLq3t7i4tLCropmRjIuOk5KSkZCUpL7Y7Pv569zP0MvHxcPCwsLC//////rw5dTJv7m3t7e1r6OWi4J/gYaN"
+    "k5KRkJCPmLPW8fjq2MvCvMTCwcDAv7/A//////z05NbKwLm2sKegmo+Ef35+gIWLkpKRkI+PmbLX8erXyL65tbO/v76+vr6+"
+    "///////26drMwrmpnJSSko2Ff31+f4OKkpKRkI+Pnbvc4tPGvLe0srG+vr29vb29///////88OHSxK+YkJGSkpCHgH1+f4KI"
+    "kZKRkI+Qo8fYw7S2tbKxsbCwvb28vLy8////////+Oraw6SSj5CRkpKLgn1+f4GHkJKRj46Trs3DpZihrrGxsLCvvLy8vLy8"
+    "//////////XjxqeWj4+QkZKOhH59foCGj5KRj46Yu8GnlIyPnq2wsK+vr7y8u7u7//////////7v1LegkY+PkJGRiH99fn+F"
+    "jpKQj42hvKuUjIqJjZyrr6+urru7u7u7///////////86c6zm4+PkJGSjYJ9fn+EjpKQjo+vrpaMiomIh4qZqa6urru7u7u8"
+    "/////////////erOsJiOj5CRkYd9fX+DjpGPjpmumYyKiYiHhoWIl6etra67vLy8/v7////////////u0LGYjo+QkY6AfX+C"
+    "jpGPjaacjIqJh4eGhYSEhpaprq68vLy99PT19vj7/f//////9dq4mo2PkJKGfH6Bj5COlp6NioiHhoWFhIOEhIiara+vvb29"
+    "5ubm5+jr7Ozw9/3////qxZ6Nj5CPfn6Aj5CNn46KiIeGhYSDhISFhYaMoa+wvb2+2NfW1tfY1c3P1t/p8/3/+tamjY+Rh32A"
+    "kY+WkIqIhoWEg4SFhYaGhoeHlauwvr6/zMrJyMjIv7GwtLm/x9Li9P/xu46PkXx/ko6UioeGhIOEhYWGh4eHiIiIjKKxsr/A"
+    "wsC/vr28rJqZmpudoKStucvk/uOXj4t/kZeKh4WDhYWGh4eIiIiIiYmJipyxs8HDu7q5uLi0oJKRkZGRkZKTlJacqsb0xY99"
+    "j4qFhIWGh4iIiImJiYqKiouMjJuyt8XIt7e2tbWtlY2MjIyLi4uLi4uMjI2QlcSPioWIiYmKioqKiouLjIyNjpCRlKO6v8PQ"
+    "tbS0s7KijIqJiYmJiYmJiYmJiYiIh4SNjv/AnZSQj46Ojo2Oj4+QkZKUlqi8wcTRwLOysbCciYiIiIiIiIiHh4eGhYSEho7/"
+    "kY71///13sm6sKmnpqampqeprr/N0NPev7GxsK+biIeHh4aGhoaFhYSEhIaIjv//jpKOvf/////+9u3l3trV0tDP0tzi5Obt"
+    "vrCwr6+fiYaGhYWFhYSEhISFh4mO3P//jZKRjqfx//////////369vPx8fP19fX4vb2vr6+ljoWFhISEhISFhYaIiY6/////"
+    "jZGTkI6h3v//////////////////////vLyurq6smIaEhISEhYWGh4iJjrH7////kJCTkpCOodb+////////////////////"
+    "vLy8rq6upI+EhYWGhoeIiYqPquz/////l4+Sk5GPjqbV+v//////////////////vLu7rq2urZ+MhoaHiIiJi5Cn3///////"
+    "oI6Rk5KRj5Gu1/n/////////////////u7u7u66ur62djIeIiYqNlKrX/v//////rI6QkpOSkI+ZuN78////////////////"
+    "vLy8vK+vr6+tnY6Ji4+asdj6////////uI+QkZOTkZCSpcfq////////////////vLy8vLyvsLCwrqCTkp+43fn/////////"
+    "xpaPkZKTkpGRnbjZ9v//////////////vb29vb2wsLGys7Osqr3e+P//////////0qGPkJKTk5KRmrDN6///////////////"
+    "vr6+vr6/srS2ub/Hz+L4////////////3rCVkJGSk5KSmq3H5Pv/////////////wMDAwMHCw7q+xc/d7fr/////////////"
+    "6r+gk5GSk5OVna7F4Pf/////////////xMTExcbIys7M1uPy/P//////////////9dKynpaUlJeao7PI4Pb/////////////"
+    "ysrLzM7R1tzk6vb+/////////////////ePFr6Gcm56jrbvO5fj/////////////0tPU1tre5Oz0+///////////////////"
+    "//PZwrOrp6qwucfb7vz/////////////3d7g4+jt8/n+//////////////////////3s2Mi+ur3Fz9zq+P//////////////"
+    "6evu8fX6/v/////////////////////////67ODY1tne5ez2/P//////////////9ff6/P//////////////////////////"
+    "/////PXv7Ovt8/f8/////////////////f/////////////////////////////////////7+vn5+/7/////////////////"
+    "////////////////////////////////////////////////////////////////////////////////////////////////"
+    "////////////////////////////////////////////////////////////////////////////////////////////////",
+
+    // Frame 2
+    "EAwJCxIcKDQ/R01QUVBQT1hXV1dXWFhaX2JiYF5cUU9OTk1MS0hEPjctIxgOBgEAGhYREBMaJTE9Rk1QUVBZWFhXV1dXWFha"
+    "YWVlZGJfW1hXTk5OTUtHQTkvJBkOBgEAJiEcFxccIy46RExQWllZWFhXV1dYW15kb3R2dXFrZF1ZV1dPT01JQzswJRkOBgEA"
+    "My4pIh4fJCw3QktZWlpZWVhYWl1iZ2xyfICBgHx2cGpjXFhYWE5KRDswJBcOBgEAPjs2MSomJyw1P09YWlpZWl1iZmptb3B1"
+    "foGCgHx3cW5taGBZWFdLRDsvIhcNBAAAR0VBPTcxLS80QkxWWl1hZmptbm1ub3F3foKDgXx2cW5tbmphWVhSRDksIRYKAgAA"
+    "TUxKR0M9NzQ7QElUYmpucHBvbm5ub3F4gIODgHx2cG5tbm9rYVhSSDYrHxEGAQAAUVBPTUtIQ0NAQUlbbHJycXBvb25ubnJ5"
+    "gYODgHt0b25ubm9wa19QRTkoGQwDAAAAVFNSUVBOS05JR1BgbXNycXFwb25tbnJ6goSDf3lzbm1ub3BwcWhTQjUkEgYAAAAB"
+    "VlVUU1NSWVZSVVxhaXFzcnFwb25tbnJ7goSDf3hxbm5vb3BxcmxZQSwaCwIAAgUIV1ZWVVRcW1pdZWVjZm5zcnJxcG9ubnJ8"
+    "g4SCfXZvbW5vcHFxcWpaPSIQBAMHCw8TV1dXVlZeXV5ob2xpZ2txc3JxcG9ubnF8hISCfHRubm9wcXFyb2VPNBgICA4TGBwg"
+    "WFdXV19fXmZxc3FubGpudHNycW9ubXF9hISBenFtbm9wcXJyalhAJBEPFx4hJiouWFhYV2BfYm93dXRycG5tcXRycXBvbXB9"
+    "hIOAd29ub3BxcnNuXUQrGxkjKjAwNDc5WVhYYGBganZ4d3Z1c3Fvb3NzcnFvbm99hYN/dG1ucHFyc3BgRy8jIi88QEBDP0JD"
+    "WVlZYWFlcnl4eHd3dnRycXF0c3Fwbm59hYN8cG5vcXJzcmJIMysvPEZRVlFNSEhJWVlZYmJteHp5eXh4d3Z0cnJydHJwb258"
+    "hIJ4bm9wcnNyYkg4NT9LVFtgZF9USkpLWlpaYmh1e3t6enl5eHd3dXNyc3Nxb217hIFzbnBxc3NgSD1CT1pgZGZnaGZbUktL"
+    "WlpaZHB7fHt7e3p6eXl4d3Z0c3VzcG56hH9ub3Fzc11IRlFeZGZnZ2hoaGlhVktLWlpaa3h9fHx8fHt7e3p5eXh3dHN1cm93"
+    "hHlucXNyWEtTYWZnZ2hoaGlpaWlmWkxMWlpacn19fX19fXx8fHt7enp5d3VzdHByg3Bwc25SVmRnZ2hoaGlpaWlqamppXkxM"
+    "WVlZeHx8fHx9fX19fX18fHt7enh2c3Jug29zZFZmZ2hoaWlpampqampqa2trYlZNWVlZe3t7e3t7fHx8fHx9fX19fHt6eHRv"
+    "eXNXZ2hpaWpqa2tsbGxsbGxsbGxsZFhNWFhYenp6enp6enp6e3t7e3t7e3x8fXt0c2hqbnFzdHV1dXV0dHNzcnFwb29vZ1lO"
+    "UlNTdXZ2dnd3d3d3d3d3d3Z2dXRxazd0aHp7fHx8fHt7enl4d3Z1c3JxcG9uY1dNT1BQcXFycnJycnFxcG9ubGliUjUJAHRv"
+    "AGh3eXp6e3t8fHx8fHt6eXh2dHNxZFhOSktLamtsbGtramhlYVtRRDIYAgAkdG9xFRVoc3d4eXp6ent7e3t7e3p5eHZzZFpQ"
+    "QEFBXF1dXFpXUUxEOiwcCwAAA0B0cW1yPQBGaHF2d3h5eXp6ent7e3t6enh0ZVtRMzMyRkVFQj03LyYaDgQAAAATTnRxb29y"
+    "UQADWWhudHd3eHl5eXp6enp6enl0ZF1SJCMhICsoJB4WDQYBAAAAASFVdHJwbnBzXAAAHl9obXJ1d3h4eHl5eXp6enpzY11T"
+    "FBMQDhEOCgUBAAAAAAAHK1hzcnFvbnBzYgIAADNiaGxwdHZ3eHh4eXl5eXlwYV5UBwUEAgEAAAAAAAAAAA0wWHNycW9ub3Fz"
+    "ZA0AAAo/Ymhrb3J1dnd4eHh5eXltYF5UAAAAAAAAAAAAAAAAETFWcXNxcG9tb3FzZhkAAAAXRWFoam5xc3V2d3h4eHZoX15U"
+    "AAAAAAAAAAAAAAESMVJuc3Jwb25ucHFzZiIAAAABIEZeZ2ptcHJ0dXZ3d3JkXlVTAAAAAAAAAAAAARIuTWpzcnFwbm1vcHJz"
+    "ZSkAAAAABiZFW2VpbG5xcnR1dWtfXVNSAAAAAAAAAAACEClGZXJycXBvbm5vcHJzZC4BAAAAAAonQlVhZ2ptb3BxbmJaUVFQ"
+    "AAAAAAAAAAIPJT9eb3JxcG9ubW5vcXJzYjEDAAAAAAANJTxNWmFlZ2lqYldVTUxLAAAAAAAAAQwgOFRqcnFxcG9ubm9wcXJy"
+    "XzIGAAAAAAAADSI1RE5UWFtZUExFRURDAAAAAAAABxYtR2BucnFwb25tbm9wcXJvXDIIAAAAAAAAAAscKjY+RERBPjo6Ojo5"
+    "AAAAAAADDx8xRl9ucXBwb25tbm9wcXJsWTAJAAAAAAAAAAAHEh0mLC0sKSssLCwrAAAAAAEIFSY1RVZlbXBvbm5ub3BxcnJo"
+    "Uy4KAAAAAAAAAAAAAgkQFRkaGxwcHBwcAAAAAAMNGSs7SVNaYWlubm1ub3BxcnBjTisKAAAAAAAAAAAAAAADBwoNDxAPDg0N"
+    "AAAAAQcRHSw/S1NYWV1kaWtub3BxcWxcRyYJAAAAAAAAAAAAAAAAAAEDBQYGBQQDAAAAAgkTIS87TFNYWFhZW19iZWZmZV5N"
+    "OB0HAAAAAAAAAAAAAAAAAAAAAAABAAAAAAAAAwsWIzA8RUtXWFhXV1dYWVpaWFBCLhgFAAAAAAAAAAAAAAAAAAAAAAAAAAAA"
+    "AAAABAwYJTE8REpOWFdXV1dYWFlZVUw+KRMDAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAABQ4ZJTA6Q0hMTk5OV1dYWFhWUEY3"
+    "Ig8CAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAABQ4ZJC84QEZKTE1OTk9YV1ZRSj8wHAsBAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+
+    // Frame 3
+    "///9+fTu6eTg3NrY19fW1tbW19rd4eTl5OLe2tfV1dXV1dXV1tbX2dvf4+jt8/j9///9+fPt5+Le2tjX1tbV1dXV1dfa3d/g"
+    "4N7b19XU1NTV1dXV1dXW2Nrd4uft8vj9///++PPs5uHc2dfW1dXV1dXU1NXX2tvc3NvY1dTU1NXV1dXV1dXV19nd4efs8/n9"
+    "///++fPs5uDb2NbV1dXV1dXU1NTV19jZ2dfW1NTU1NXV1dXV1dXV1tjc4eft9Pr+////+vTt5uDb19XV1dXV1dXV1NTDxMXG"
+    "xsXDw8PD1NXV1dXV1dTU1tjc4ejv9fv/////+/Xu5uDb19XU1dXV1dXExMPDwsLDwsLCw8PExMTF1dXV1dTU1djc4+rw9/z/"
+    "/////ffw6OHb19XU1NXV1cXExMPDwcDAv729v8LExMXFxcTV1NTU1dne5ezz+f7///////rz6+Pc19XU1NXExcXExMTDvbOq"
+    "op2fo6m0wMXFxcTExNTU1trg5+71+/////////z27ube2NXU1MTExMTCvrivoZKIhYaMkJKZqL3FxMTEw8PU193j6/L5/v//"
+    "///////68urh2tbUvLOtqqqnopuUjYSBgoaNkJGSlanCxMTDw8PF2uDn7/b8///////////89u7m3teyoJWSkpKTk5KQjYSA"
+    "gIaNkJGSk5i1xMPDw8PIz+Ts9Pv///////38+/r59vDp1bucj4+QkZKTk5KRjoV+f4aOkZKTk5KivMPDwsXM1uHy+f//////"
+    "+/j29PPy8e7h0LKZkI+PkJGSk5KRj4V+foaPkZKTk5KUqb7Cw8nT3ur4/v//////9vPw7evq6eDbxq6glI6PkJGSk5OSkIZ9"
+    "foeQkZOTkpGQlqm9x9Hd6fX9//7+/f398u3q5+Ti1dXMtqqjmZCOj5CRkpOSkYd9foiQkpOTkZCPjpOsydzq9Pn5+fj39vb3"
+    "7ejk4d7Pzcy7pKGfm5WOjo+QkZOTkYl9fomRkpOSkZCOjpSoyuTw8u/s8O/u7u/v6eXg3drKyMewmJmZl5WRjY2PkJKTkot9"
+    "foyRk5KRkI6NlKjB0dzi5ODe3ebm5+fo5+Ld2snHxsWsl5eXl5WRj4yNj5GTko59fo6Sk5GQjo2VrMDJyL+/y9PS0t/f4OHi"
+    "5eDc2cfGxsSplZaWl5eWko2LjZCRk5F+f5CTkpCOjZivvLy0q6ShrcLKy9ra29zd5d/b2MbFxcOolJWVlpaXl5SOi42QkpKA"
+    "gZGTkI6NnbCzq6GcmpmYmrDFx8fX19jZ5eDc2MfGxcOolJSUlJWVlpeWkYqNkZODhJORjo6krKObmpiXlpWUlKG9xcXV1dbX"
+    "5+Ld2sjGxsOplZSUlJSUlJWWl5WMjZKKipKOk6aempiVk5KRkI+Pj5e1w8PU1NTV6uXg3MrHx8KnlpaWlZWVlZSUlJWWko2S"
+    "kY6hm5eTkI6NjIyLi4uLi5OzwcHT09PT7+nk387KyL+jl5eXl5eXl5aWlpaVlJWNjpeNi4qKiomJiYmJiYmJiZe3v8DS0tLS"
+    "/Pj08OPe2cmtopyXlJGPjYyLi4yNkJaZmoSGh4eIiIiIiIiIiYmJi6a/wMDS0tLT//77+PDs59a8rqOclpKQkZKTlZaUlZmR"
+    "j5qHhYSFhoaGh4eHh4eHlrW/v7+/0dLS//////348eDDsaOalpaWlpaVlJSWmf6Okp2ajIaFhISFhYaGhoaJpL2+vr6+0dHR"
+    "///////68eDAqZyXlpaVlZSUlZeZ1smPk46+mpCIhoWEhISFhYWTsr6+vr6+0NDR//////716du9n5eVlZSUlJWWl5nC/5iQ"
+    "k4+WvZqTjIiGhYWEhIafu729vb6+0NDQ//////z15dnEo5WUlJSVlZeYmrz95o6Qk5COvbWalo+Kh4aFhY6tvb29vb3Q0NDQ"
+    "//////vz49jNtJmUlJWWl5idvfL/wo6Qk5GPndOwm5eSjYmHhpq4vb29vb3P0NDQ//////v05NnRxq6ZlpaXmaTC7f/6rY6R"
+    "k5KPkMXXr5yYlJCMj6u+vr29vb3Pz9DQ//////z17t3V0Mawnp2hsMzt///ooo+Rk5KQjq3l0a+emZaSoLrAv7++vr7Q0NDQ"
+    "//////748uTd19TMvbTB2PH////Zno+Rk5KRj6HV8M6xoZqetMTDwsHAwNHR0dHR///////89/Ln4t/f3dzn+P/////Rno+R"
+    "k5ORj53H9uzNtKizxMfFxMPCwtPS0tLT/////////Pny7+3u8/n///////vOoZCRk5ORkJ7A7f/p0cfMzcrIx8bF1dTU1NXV"
+    "///////////9+vr9//////////nQp5ORkpOSkqG/6P/97+Tc1tHNy8nY19fX19jZ//////////////////////////nVsJqS"
+    "kpOSl6jK7P///vTq4NrW0tDc29vb29zd//////////////////////////vdu6SZlZaXpcHe8/////727eXf3OPh4ODg4OHi"
+    "//////////////////////////7mybKkn6Oxxdno9//////++PHq7ero5uXl5ebn///////////////////////////y28i9"
+    "vsbR2uPv+/////////r49PHw7uzs6+zt///////////////////////////88OTe3N3f5Oz2/v/////////++/j29fPy8vLy"
+    "////////////////////////////+/Pt6ejq7vX8//////////////78+vr4+Pj4//////////////////////////////z3"
+    "9PP1+Pz///////////////////79/f39/////////////////////////////////f39////////////////////////////"
+    "////////////////////////////////////////////////////////////////////////////////////////////////"
+    "////////////////////////////////////////////////////////////////////////////////////////////////",
+};
+
+/**
+ * @brief Decode a frame's red channel (empty if the index is out of range).
+ */
+inline juce::MemoryBlock getRedChannel(int index)
+{
+    juce::MemoryOutputStream decoded;
+
+    if (juce::isPositiveAndBelow(index, kNumFrames))
+        juce::Base64::convertFromBase64(decoded, kRedChannel[index]);
+
+    return decoded.getMemoryBlock();
+}
+
+} // namespace OrbReferenceFrames
+
+} // namespace shmui
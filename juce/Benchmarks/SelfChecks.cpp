@@ -0,0 +1,851 @@
+/*
+  ==============================================================================
+
+    SelfChecks.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Self-check cases.
+
+  ==============================================================================
+*/
+
+#include "SelfChecks.h"
+#include "OrbReferenceFrames.h"
+#include "../Source/Audio/TruePeakDetector.h"
+#include "../Source/Components/LevelMeter.h"
+#include "../Source/Components/OrbSoftwareRenderer.h"
+#include "../Source/Components/QuadRenderService.h"
+#include "../Source/Utils/FrameClock.h"
+#include "../Source/Utils/Interpolation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace shmui
+{
+
+namespace
+{
+    /** Bumped when the JSON layout changes. */
+    constexpr int kSchemaVersion = 1;
+
+    /** Keeps results alive so timed loops are not optimised away. */
+    volatile float sink = 0.0f;
+
+    template <typename Value>
+    Value percentile(const std::vector<Value>& sortedValues, double fraction)
+    {
+        if (sortedValues.empty())
+            return {};
+
+        const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortedValues.size())));
+        return sortedValues[juce::jlimit<size_t>(1, sortedValues.size(), rank) - 1];
+    }
+
+    /** Desktop window that counts the frames the FrameClock gives it. */
+    class FrameProbe : public juce::Component,
+                       private FrameClockClient
+    {
+    public:
+        void start() { startFrames(); }
+
+        int getNumFrames() const { return m_numFrames; }
+        double getLastDeltaSeconds() const { return m_lastDeltaSeconds; }
+
+        /** Arrival time of the last frame, and the time since the one before it. */
+        double getLastFrameMs() const { return m_lastFrameMs; }
+        double getLastFrameGapMs() const { return m_lastFrameMs - m_previousFrameMs; }
+
+    private:
+        bool advanceFrame(double deltaSeconds) override
+        {
+            ++m_numFrames;
+            m_lastDeltaSeconds = deltaSeconds;
+            m_previousFrameMs = m_lastFrameMs;
+            m_lastFrameMs = juce::Time::getMillisecondCounterHiRes();
+            return true;
+        }
+
+        juce::Component* getFrameComponent() override { return this; }
+
+        int m_numFrames = 0;
+        double m_lastDeltaSeconds = 0.0;
+        double m_lastFrameMs = 0.0;
+        double m_previousFrameMs = 0.0;
+    };
+
+    /**
+     * Keeps the message thread serving other threads (an OpenGL context
+     * locks it to paint components) until done() or the timeout.
+     */
+    bool runMessageLoopUntil(const std::function<bool()>& done, double timeoutMs)
+    {
+        const double endMs = juce::Time::getMillisecondCounterHiRes() + timeoutMs;
+
+        while (!done())
+        {
+            if (juce::Time::getMillisecondCounterHiRes() > endMs)
+                return false;
+
+           #if JUCE_MODAL_LOOPS_PERMITTED
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+           #else
+            juce::Thread::sleep(10);
+           #endif
+        }
+
+        return true;
+    }
+}
+
+//==============================================================================
+SelfChecks::SelfChecks(const Options& options)
+    : m_options(options)
+{
+}
+
+std::vector<CheckResult> SelfChecks::runAll(const std::function<void(const CheckResult&)>& log)
+{
+    m_results.clear();
+    m_log = log;
+
+    checkOrbSoftwareRenderer();
+    checkTruePeakDetector();
+    checkLevelMeterBallistics();
+    checkBallistics();
+    checkFrameClock();
+    checkQuadRenderService();
+
+    m_log = nullptr;
+    return m_results;
+}
+
+bool SelfChecks::isSelected(const juce::String& check) const
+{
+    return m_options.filter.isEmpty() || check.containsIgnoreCase(m_options.filter);
+}
+
+void SelfChecks::add(const CheckResult& result)
+{
+    m_results.push_back(result);
+
+    if (m_log)
+        m_log(result);
+}
+
+//==============================================================================
+void SelfChecks::checkOrbSoftwareRenderer()
+{
+    if (!isSelected("OrbSoftwareRenderer"))
+        return;
+
+    // Full resolution, so the only differences are texture filtering and
+    // float precision (about 1 level on llvmpipe)
+    OrbSoftwareRenderer renderer;
+    renderer.setResolutionScale(1.0f);
+
+    constexpr int size = OrbReferenceFrames::kSize;
+
+    for (int index = 0; index < OrbReferenceFrames::kNumFrames; ++index)
+    {
+        const auto reference = OrbReferenceFrames::getRedChannel(index);
+        const auto* expected = static_cast<const uint8_t*>(reference.getData());
+
+        CheckResult mean;
+        mean.check = "OrbSoftwareRenderer";
+        mean.variant = "frame=" + juce::String(index);
+        mean.measure = "meanError";
+        mean.unit = "levels";
+        mean.limit = 2.0;
+
+        CheckResult p99 = mean;
+        p99.measure = "p99Error";
+        p99.limit = 8.0;
+
+        if (reference.getSize() != static_cast<size_t>(size * size))
+        {
+            // A corrupt table is a failure, not a skip
+            mean.value = p99.value = 255.0;
+            add(mean);
+            add(p99);
+            continue;
+        }
+
+        const auto& image = renderer.render(OrbReferenceFrames::getUniforms(index), size, size);
+        const juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::readOnly);
+
+        std::vector<int> errors;
+        errors.reserve(static_cast<size_t>(size * size));
+        double totalError = 0.0;
+
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                // Premultiplied, like the shader output
+                const auto* pixel = reinterpret_cast<const juce::PixelARGB*>(bitmap.getPixelPointer(x, y));
+                const int error = std::abs(static_cast<int>(pixel->getRed()) - static_cast<int>(expected[y * size + x]));
+
+                errors.push_back(error);
+                totalError += error;
+            }
+        }
+
+        std::sort(errors.begin(), errors.end());
+
+        mean.value = totalError / static_cast<double>(errors.size());
+        p99.value = percentile(errors, 0.99);
+
+        add(mean);
+        add(p99);
+    }
+}
+
+void SelfChecks::checkTruePeakDetector()
+{
+    if (!isSelected("TruePeakDetector"))
+        return;
+
+    // True-peak accuracy required by EBU Tech 3341 (BS.1770 compliance tests)
+    constexpr double kOverReadDb = 0.2;
+    constexpr double kUnderReadDb = -0.4;
+
+    // Tones as a fraction of the base rate (the sample rate, capped at 48 kHz,
+    // so higher rates see the same audio band rather than ultrasonic tones)
+    struct Tone
+    {
+        double fraction;
+        double phaseDegrees;
+        double truePeakDb;
+    };
+
+    const Tone tones[] =
+    {
+        { 0.25, 0.0, 0.0 },            // Sample peak is the true peak
+        { 0.25, 45.0, 0.0 },           // Samples at -3.01 dBFS
+        { 0.25, 60.0, 0.0 },           // Samples at -1.25 dBFS
+        { 0.25, 67.5, 0.0 },           // Samples at -0.69 dBFS
+        { 1.0 / 6.0, 0.0, 0.0 },       // Samples at -1.25 dBFS
+
+        // Inter-sample overs: every sample below 0 dBFS, true peak above
+        { 0.25, 45.0, 2.0 },           // Samples at -1.01 dBFS
+        { 1.0 / 6.0, 0.0, 1.0 }        // Samples at -0.25 dBFS
+    };
+
+    constexpr int kBlockSize = 61;      // Odd, so block edges fall on every phase
+    constexpr int kSettleSamples = 2 * TruePeakDetector::kTapsPerPhase;
+
+    for (const double sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        const double baseRate = juce::jmin(sampleRate, 48000.0);
+        const auto numSamples = static_cast<int>(sampleRate / 2);
+        std::vector<float> signal(static_cast<size_t>(numSamples));
+
+        TruePeakDetector detector;
+        detector.prepare(sampleRate, 1);
+
+        for (const auto& tone : tones)
+        {
+            const double amplitude = juce::Decibels::decibelsToGain(tone.truePeakDb);
+            const double cyclesPerSample = tone.fraction * baseRate / sampleRate;
+            const double phase = juce::degreesToRadians(tone.phaseDegrees);
+
+            for (int i = 0; i < numSamples; ++i)
+                signal[static_cast<size_t>(i)] = static_cast<float>(
+                    amplitude * std::sin(juce::MathConstants<double>::twoPi * cyclesPerSample * i + phase));
+
+            detector.reset();
+            float peak = 0.0f;
+
+            for (int start = 0; start < numSamples; start += kBlockSize)
+            {
+                const int count = juce::jmin(kBlockSize, numSamples - start);
+                const float blockPeak = detector.process(0, signal.data() + start, count);
+
+                // Skip the filter's start-up transient
+                if (start >= kSettleSamples)
+                    peak = juce::jmax(peak, blockPeak);
+            }
+
+            CheckResult result;
+            result.check = "TruePeakDetector";
+            result.variant = "rate=" + juce::String(static_cast<int>(sampleRate))
+                           + ",sine=" + juce::String(tone.fraction * baseRate, 0) + "Hz"
+                           + ",phase=" + juce::String(tone.phaseDegrees, 1)
+                           + ",peak=" + juce::String(tone.truePeakDb, 0) + "dBTP";
+            result.measure = "error";
+            result.unit = "dB";
+            result.value = TruePeakDetector::toDBTP(peak) - tone.truePeakDb;
+            result.limit = kOverReadDb;
+            result.lowerLimit = kUnderReadDb;
+            add(result);
+        }
+
+        // process() cost for one channel, best of several passes over noise
+        constexpr int kTimingBlockSize = 512;
+        Interpolation::SeedRandom rng(60);
+        for (auto& sample : signal)
+            sample = rng.next() * 2.0f - 1.0f;
+
+        double bestSeconds = std::numeric_limits<double>::max();
+
+        for (int pass = 0; pass < 10; ++pass)
+        {
+            detector.reset();
+            float peak = 0.0f;
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            for (int start = 0; start + kTimingBlockSize <= numSamples; start += kTimingBlockSize)
+                peak = juce::jmax(peak, detector.process(0, signal.data() + start, kTimingBlockSize));
+            const auto endTicks = juce::Time::getHighResolutionTicks();
+
+            sink = peak;
+            bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(endTicks - startTicks));
+        }
+
+        const int numTimedSamples = numSamples / kTimingBlockSize * kTimingBlockSize;
+
+        CheckResult timing;
+        timing.check = "TruePeakDetector";
+        timing.variant = "rate=" + juce::String(static_cast<int>(sampleRate))
+                       + ",oversampling=" + juce::String(detector.getOversamplingFactor());
+        timing.measure = "processPerChannel";
+        timing.unit = "ns/sample";
+        timing.value = bestSeconds * 1.0e9 / numTimedSamples;
+        timing.isTiming = true;
+        add(timing);
+    }
+}
+
+void SelfChecks::checkLevelMeterBallistics()
+{
+    if (!isSelected("LevelMeter"))
+        return;
+
+    const std::pair<MeterBallistics, const char*> types[] =
+    {
+        { MeterBallistics::Peak,      "Peak" },
+        { MeterBallistics::VU,        "VU" },
+        { MeterBallistics::PPM,       "PPM" },
+        { MeterBallistics::TruePeak,  "TruePeak" },
+        { MeterBallistics::PPMTypeII, "PPMTypeII" },
+        { MeterBallistics::Nordic,    "Nordic" },
+        { MeterBallistics::BBC,       "BBC" }
+    };
+
+    // IEC 60268-10 measures integration time with 5 kHz tone bursts; at
+    // -6 dBFS the steady reading stays on scale. Tones start and stop
+    // off the frame grid, and audio arrives in small blocks as from a device
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 64;
+    constexpr double kToneHz = 5000.0;
+    constexpr float kToneGain = 0.5f;
+    constexpr float kMinDb = -80.0f;
+    constexpr float kMaxDb = 6.0f;
+    constexpr float kFallDb = -20.0f;
+    const int onset = juce::roundToInt(0.1 * kSampleRate) + 37;
+
+    struct Reading
+    {
+        double seconds;
+        float dB;
+    };
+
+    // Displayed level after every frame for a tone from onset to end
+    auto run = [&](MeterBallistics type, int frameRate, int end, double totalSeconds)
+    {
+        LevelMeter meter;
+        meter.setDBRange(kMinDb, kMaxDb);
+        meter.setBallistics(type);
+        meter.prepare(kSampleRate);
+
+        const int totalSamples = juce::roundToInt(totalSeconds * kSampleRate);
+        std::vector<float> block(static_cast<size_t>(kBlockSize));
+        std::vector<Reading> readings;
+        int position = 0;
+
+        for (int frame = 1;; ++frame)
+        {
+            const int frameEnd = juce::roundToInt(frame * kSampleRate / frameRate);
+            if (frameEnd > totalSamples)
+                break;
+
+            while (position < frameEnd)
+            {
+                const int numSamples = juce::jmin(kBlockSize, frameEnd - position);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const int k = position + i;
+                    block[static_cast<size_t>(i)] = k >= onset && k < end
+                        ? kToneGain * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * kToneHz * (k - onset) / kSampleRate + 0.2))
+                        : 0.0f;
+                }
+
+                meter.pushSamples(0, block.data(), numSamples);
+                position += numSamples;
+            }
+
+            meter.advanceFrameForTesting(1.0 / frameRate);
+            readings.push_back({ frameEnd / kSampleRate, kMinDb + meter.getDisplayLevel(0) * (kMaxDb - kMinDb) });
+        }
+
+        return readings;
+    };
+
+    auto highest = [](const std::vector<Reading>& readings)
+    {
+        float dB = kMinDb;
+        for (const auto& reading : readings)
+            dB = juce::jmax(dB, reading.dB);
+        return dB;
+    };
+
+    for (const auto& type : types)
+    {
+        const auto spec = BallisticsSpec::forType(type.first);
+
+        // Reading of the steady tone, which bursts and rise are relative to
+        const float steadyDb = run(type.first, 60, std::numeric_limits<int>::max(), 1.0).back().dB;
+
+        // Time from the end of a tone to steadyDb + kFallDb
+        const double nominalFallMs = spec.fallDBPerSecond > 0.0f ? -kFallDb / spec.fallDBPerSecond * 1000.0
+                                                                 : spec.releaseMs * std::log(10.0) * -kFallDb / 20.0;
+
+        for (const int frameRate : { 30, 60, 144 })
+        {
+            const juce::String variant = juce::String("type=") + type.second + ",rate=" + juce::String(frameRate) + "Hz";
+
+            // Tone bursts read as the integration time specifies, whatever the refresh rate
+            for (const int burstMs : { 5, 10 })
+            {
+                const auto readings = run(type.first, frameRate, onset + juce::roundToInt(burstMs * kSampleRate / 1000.0), 0.4);
+
+                CheckResult burst;
+                burst.check = "LevelMeter";
+                burst.variant = variant;
+                burst.measure = "burst" + juce::String(burstMs) + "msError";
+                burst.unit = "dB";
+                burst.value = highest(readings) - steadyDb - spec.getBurstReadingDB(static_cast<float>(burstMs));
+                burst.lowerLimit = -0.5;
+                burst.limit = 0.5;
+                add(burst);
+            }
+
+            // A one-second tone: the rise follows the attack curve and the
+            // fall takes its nominal time
+            const int end = onset + juce::roundToInt(1.0 * kSampleRate) + 11;
+            const double endSeconds = end / kSampleRate;
+            const auto readings = run(type.first, frameRate, end, endSeconds + nominalFallMs * 0.001 + 0.5);
+
+            double riseError = 0.0;
+            double fallMs = -1.0;
+
+            for (size_t i = 0; i < readings.size(); ++i)
+            {
+                const auto& reading = readings[i];
+                const double sinceOnsetMs = (reading.seconds - onset / kSampleRate) * 1000.0;
+
+                if (sinceOnsetMs > 0.0 && reading.seconds < endSeconds)
+                {
+                    const double nominalDb = spec.getBurstReadingDB(static_cast<float>(sinceOnsetMs));
+                    if (nominalDb > -10.0)
+                        riseError = juce::jmax(riseError, std::abs(reading.dB - steadyDb - nominalDb));
+                }
+
+                // Crossing time, interpolated between the frames either side
+                if (fallMs < 0.0 && i > 0 && reading.seconds > endSeconds && reading.dB - steadyDb <= kFallDb)
+                {
+                    const auto& before = readings[i - 1];
+                    const double fraction = (steadyDb + kFallDb - before.dB) / (reading.dB - before.dB);
+                    fallMs = (before.seconds + (reading.seconds - before.seconds) * fraction - endSeconds) * 1000.0;
+                }
+            }
+
+            CheckResult rise;
+            rise.check = "LevelMeter";
+            rise.variant = variant;
+            rise.measure = "riseError";
+            rise.unit = "dB";
+            rise.value = riseError;
+            rise.limit = 0.5;
+            add(rise);
+
+            CheckResult fall;
+            fall.check = "LevelMeter";
+            fall.variant = variant;
+            fall.measure = "fallTimeError";
+            fall.unit = "ms";
+            fall.value = fallMs >= 0.0 ? fallMs - nominalFallMs : nominalFallMs;
+            fall.lowerLimit = -5.0;
+            fall.limit = 5.0;
+            add(fall);
+        }
+    }
+}
+
+void SelfChecks::checkBallistics()
+{
+    if (!isSelected("BallisticsSpec"))
+        return;
+
+    const std::pair<MeterBallistics, const char*> types[] =
+    {
+        { MeterBallistics::Peak,      "Peak" },
+        { MeterBallistics::VU,        "VU" },
+        { MeterBallistics::PPM,       "PPM" },
+        { MeterBallistics::TruePeak,  "TruePeak" },
+        { MeterBallistics::PPMTypeII, "PPMTypeII" },
+        { MeterBallistics::Nordic,    "Nordic" },
+        { MeterBallistics::BBC,       "BBC" }
+    };
+
+    for (const auto& type : types)
+    {
+        const auto spec = BallisticsSpec::forType(type.first);
+
+        for (const int frameRate : { 30, 60, 144 })
+        {
+            const juce::String variant = juce::String("type=") + type.second + ",rate=" + juce::String(frameRate) + "Hz";
+
+            // The array apply() must match the scalar one bit for bit
+            constexpr int kNumValues = 256;
+            const auto coefficients = spec.getCoefficients(1.0 / frameRate);
+
+            Interpolation::SeedRandom rng(static_cast<uint32_t>(70 + frameRate));
+            std::vector<float> inputs(kNumValues), batch(kNumValues), scalar(kNumValues);
+            for (int i = 0; i < kNumValues; ++i)
+            {
+                inputs[static_cast<size_t>(i)] = rng.next() * 1.2f;
+                batch[static_cast<size_t>(i)] = scalar[static_cast<size_t>(i)] = rng.next() * 1.2f;
+            }
+
+            int mismatches = 0;
+
+            for (int frame = 0; frame < 32; ++frame)
+            {
+                BallisticsSpec::apply(coefficients, batch.data(), inputs.data(), kNumValues);
+
+                for (int i = 0; i < kNumValues; ++i)
+                {
+                    auto& value = scalar[static_cast<size_t>(i)];
+                    value = BallisticsSpec::apply(coefficients, value, inputs[static_cast<size_t>(i)]);
+
+                    if (std::memcmp(&value, &batch[static_cast<size_t>(i)], sizeof(float)) != 0)
+                        ++mismatches;
+                }
+
+                // New inputs on alternate frames, so rising and falling paths both run
+                if (frame % 2 == 1)
+                    for (auto& input : inputs)
+                        input = rng.next() * 1.2f;
+            }
+
+            CheckResult identity;
+            identity.check = "BallisticsSpec";
+            identity.variant = variant;
+            identity.measure = "batchMismatches";
+            identity.unit = "values";
+            identity.value = mismatches;
+            identity.limit = 0.0;
+            add(identity);
+        }
+    }
+}
+
+void SelfChecks::checkFrameClock()
+{
+    if (!isSelected("FrameClock"))
+        return;
+
+    CheckResult showing;
+    showing.check = "FrameClock";
+    showing.variant = "hiddenClient";
+    showing.measure = "framesWhileShowing";
+    showing.unit = "frames";
+
+    CheckResult hidden = showing;
+    hidden.measure = "framesWhileHidden";
+
+    CheckResult suspended = showing;
+    suspended.measure = "suspendedWhileHidden";
+    suspended.unit = "clients";
+
+    CheckResult resume = showing;
+    resume.measure = "resumeDeltaShortfall";
+    resume.unit = "ms";
+
+    // Visibility needs a real window; headless machines skip the check
+    if (juce::Desktop::getInstance().getDisplays().getPrimaryDisplay() == nullptr)
+    {
+        for (auto* result : { &showing, &hidden, &suspended, &resume })
+        {
+            result->skipped = true;
+            add(*result);
+        }
+        return;
+    }
+
+    constexpr int kFramesPerPhase = 10;
+
+    FrameProbe probe;
+    probe.setBounds(0, 0, 64, 64);
+    probe.setVisible(true);
+    probe.addToDesktop(juce::ComponentPeer::windowIsTemporary | juce::ComponentPeer::windowIgnoresKeyPresses);
+    probe.start();
+
+    // No message loop runs during the checks, so the clock is ticked by hand
+    const juce::SharedResourcePointer<FrameClock> clock;
+
+    auto runFrames = [&clock]
+    {
+        for (int i = 0; i < kFramesPerPhase; ++i)
+        {
+            juce::Thread::sleep(5);
+            clock->tickForTesting();
+        }
+    };
+
+    runFrames();
+    const int framesShowing = probe.getNumFrames();
+
+    probe.setVisible(false);
+    runFrames();
+
+    const int framesHidden = probe.getNumFrames() - framesShowing;
+    const int numSuspended = clock->getStats().numSuspended;
+
+    // The first frame back covers the whole time since the frame before
+    // hiding, as measured by the probe itself
+    probe.setVisible(true);
+    clock->tickForTesting();
+
+    const bool resumed = probe.getNumFrames() > framesShowing + framesHidden;
+    const double gapMs = probe.getLastFrameGapMs();
+    const double deltaMs = probe.getLastDeltaSeconds() * 1000.0;
+
+    showing.value = framesShowing;
+    showing.lowerLimit = 1.0;
+    showing.limit = kFramesPerPhase;
+    add(showing);
+
+    hidden.value = framesHidden;
+    hidden.limit = 0.0;
+    add(hidden);
+
+    suspended.value = numSuspended;
+    suspended.lowerLimit = 1.0;
+    suspended.limit = 1.0;
+    add(suspended);
+
+    // Both times are taken within microseconds of the ticks; 1 ms covers a
+    // badly timed preemption, while a delta of one frame falls ~50 ms short
+    resume.value = resumed ? juce::jmax(0.0, gapMs - deltaMs)
+                           : juce::Time::getMillisecondCounterHiRes() - probe.getLastFrameMs();
+    resume.limit = 1.0;
+    add(resume);
+
+    probe.removeFromDesktop();
+}
+
+void SelfChecks::checkQuadRenderService()
+{
+    if (!isSelected("QuadRenderService"))
+        return;
+
+    CheckResult mean;
+    mean.check = "QuadRenderService";
+    mean.variant = "fixedBatch";
+    mean.measure = "meanError";
+    mean.unit = "levels";
+    mean.limit = 2.0;
+
+    CheckResult p99 = mean;
+    p99.measure = "p99Error";
+    p99.limit = 12.0;
+
+    auto skip = [this, &mean, &p99]
+    {
+        for (auto* result : { &mean, &p99 })
+        {
+            result->skipped = true;
+            add(*result);
+        }
+    };
+
+    // An OpenGL context needs a window; headless machines skip the check
+    if (juce::Desktop::getInstance().getDisplays().getPrimaryDisplay() == nullptr)
+    {
+        skip();
+        return;
+    }
+
+   #if JUCE_LINUX
+    // Mesa's llvmpipe, so the result does not depend on the GPU (unless set otherwise)
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+   #endif
+
+    // The client hangs over its parent's edges, so clipping by ancestors is
+    // checked along with the shapes
+    juce::Component host;
+    juce::Component parent;
+    juce::Component client;
+    host.setBounds(0, 0, 160, 120);
+    parent.setBounds(8, 6, 140, 104);
+    client.setBounds(-10, -4, 170, 120);
+    host.addAndMakeVisible(parent);
+    parent.addAndMakeVisible(client);
+
+    // Rectangles, rounded rectangles, a circle and ellipses, solid and
+    // gradient fills, on and off the pixel grid
+    QuadBatch batch;
+    batch.addRectangle({ 4.0f, 4.0f, 40.0f, 20.0f }, juce::Colour(0xffe6331a));
+    batch.addRoundedRectangle({ 50.5f, 6.25f, 50.0f, 30.0f }, 8.0f, juce::Colour(0xcc1a99e6));
+    batch.addEllipse({ 8.0f, 30.0f, 50.0f, 26.0f }, juce::Colour(0xff334dff));
+    batch.addEllipse({ 104.3f, 8.6f, 30.0f, 30.0f }, juce::Colour(0xffffff33));
+
+    Quad linear;
+    linear.bounds = { 70.0f, 40.0f, 60.0f, 24.0f };
+    linear.cornerRadius = 4.0f;
+    linear.fill = Quad::Fill::Linear;
+    linear.colour = juce::Colour(0xffff0000);
+    linear.colour2 = juce::Colour(0xff0000ff);
+    linear.gradientStart = { 70.0f, 40.0f };
+    linear.gradientEnd = { 130.0f, 64.0f };
+    batch.add(linear);
+
+    Quad radial;
+    radial.bounds = { 20.0f, 60.0f, 60.0f, 40.0f };
+    radial.cornerRadius = 12.0f;
+    radial.fill = Quad::Fill::Radial;
+    radial.colour = juce::Colours::white;
+    radial.colour2 = juce::Colour(0x80008000);
+    radial.gradientStart = { 50.0f, 80.0f };
+    radial.gradientEnd = { 80.0f, 80.0f };
+    radial.clip = { 30, 70, 40, 20 };
+    batch.add(radial);
+
+    Quad radialEllipse;
+    radialEllipse.bounds = { 90.0f, 70.0f, 75.0f, 30.0f };
+    radialEllipse.isEllipse = true;
+    radialEllipse.fill = Quad::Fill::Radial;
+    radialEllipse.colour = juce::Colour(0xffe6661a);
+    radialEllipse.colour2 = juce::Colour(0x331a1a1a);
+    radialEllipse.gradientStart = { 127.0f, 85.0f };
+    radialEllipse.gradientEnd = { 160.0f, 85.0f };
+    batch.add(radialEllipse);
+
+    host.setVisible(true);
+    host.addToDesktop(juce::ComponentPeer::windowIsTemporary | juce::ComponentPeer::windowIgnoresKeyPresses);
+
+    auto service = std::make_unique<QuadRenderService>(host);
+    service->submit(client, batch);
+    service->requestCaptureForTesting();
+
+    juce::Image rendered;
+    const bool finished = runMessageLoopUntil([&service, &rendered]
+    {
+        rendered = service->getCapturedFrameForTesting();
+        return rendered.isValid() || !service->isAvailable();
+    }, 5000.0);
+
+    const bool available = service->isAvailable();
+    service.reset();
+    host.removeFromDesktop();
+
+    // No frame at all (no usable context, or the GL thread never got the message thread)
+    if (!finished)
+    {
+        skip();
+        return;
+    }
+
+    // The shader failed to build
+    if (!available)
+    {
+        mean.value = p99.value = 255.0;
+        add(mean);
+        add(p99);
+        return;
+    }
+
+    // The same batch through juce::Graphics, as the client would paint it
+    // itself, at the context's scale
+    juce::Image reference(juce::Image::ARGB, rendered.getWidth(), rendered.getHeight(), true);
+
+    {
+        juce::Graphics g(reference);
+        g.addTransform(juce::AffineTransform::scale(static_cast<float>(rendered.getWidth()) / static_cast<float>(host.getWidth())));
+        g.reduceClipRegion(FrameClock::getVisibleArea(client, host));
+        g.setOrigin(host.getLocalPoint(&client, juce::Point<int>()));
+        batch.paint(g);
+    }
+
+    // Largest premultiplied channel difference per pixel
+    const juce::Image::BitmapData glData(rendered, juce::Image::BitmapData::readOnly);
+    const juce::Image::BitmapData cpuData(reference, juce::Image::BitmapData::readOnly);
+    std::vector<int> errors;
+    errors.reserve(static_cast<size_t>(rendered.getWidth() * rendered.getHeight()));
+    double sum = 0.0;
+
+    for (int y = 0; y < rendered.getHeight(); ++y)
+    {
+        for (int x = 0; x < rendered.getWidth(); ++x)
+        {
+            const auto* a = reinterpret_cast<const juce::PixelARGB*>(glData.getPixelPointer(x, y));
+            const auto* b = reinterpret_cast<const juce::PixelARGB*>(cpuData.getPixelPointer(x, y));
+
+            const int error = juce::jmax(std::abs(a->getAlpha() - b->getAlpha()), std::abs(a->getRed() - b->getRed()),
+                                         std::abs(a->getGreen() - b->getGreen()), std::abs(a->getBlue() - b->getBlue()));
+            errors.push_back(error);
+            sum += error;
+        }
+    }
+
+    std::sort(errors.begin(), errors.end());
+
+    mean.value = errors.empty() ? 0.0 : sum / static_cast<double>(errors.size());
+    p99.value = percentile(errors, 0.99);
+    add(mean);
+    add(p99);
+}
+
+//==============================================================================
+juce::String SelfChecks::toJSON(const std::vector<CheckResult>& results, const Options& options,
+                                const juce::String& label)
+{
+    juce::Array<juce::var> cases;
+
+    for (const auto& result : results)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("key", result.getKey());
+        entry->setProperty("check", result.check);
+        entry->setProperty("variant", result.variant);
+        entry->setProperty("measure", result.measure);
+        entry->setProperty("unit", result.unit);
+        entry->setProperty("value", result.value);
+        entry->setProperty("limit", result.limit);
+        if (result.hasLowerLimit())
+            entry->setProperty("lowerLimit", result.lowerLimit);
+        entry->setProperty("timing", result.isTiming);
+        entry->setProperty("skipped", result.skipped);
+        entry->setProperty("passed", result.passed());
+        cases.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("schema", kSchemaVersion);
+    root->setProperty("suite", "check");
+    root->setProperty("label", label);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("filter", options.filter);
+    root->setProperty("results", cases);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+} // namespace shmui
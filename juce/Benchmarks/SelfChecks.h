@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    SelfChecks.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Correctness checks for code whose output cannot be judged by eye:
+    renderers and detectors compared against stored references or known
+    signals, each reported as a measured value against a limit.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief One measured quantity of one check.
+ */
+struct CheckResult
+{
+    juce::String check;         ///< What is checked, e.g. "OrbSoftwareRenderer"
+    juce::String variant;       ///< Case, e.g. "frame=2"
+    juce::String measure;       ///< Quantity, e.g. "meanError"
+    juce::String unit;          ///< e.g. "levels", "dB", "ns/sample"
+    double value = 0.0;
+    double limit = 0.0;         ///< Largest passing value (unused for timings)
+    double lowerLimit = std::numeric_limits<double>::lowest();  ///< Smallest passing value, for signed errors
+    bool isTiming = false;      ///< Reported only, never fails
+    bool skipped = false;       ///< Could not run here, e.g. no display
+
+    /** True if the value has a lower limit as well as an upper one. */
+    bool hasLowerLimit() const { return lowerLimit > std::numeric_limits<double>::lowest(); }
+
+    /** True unless the value is outside its limits. */
+    bool passed() const { return isTiming || skipped || (value <= limit && value >= lowerLimit); }
+
+    /** Key that identifies the result across runs. */
+    juce::String getKey() const { return check + "/" + variant + "/" + measure; }
+};
+
+//==============================================================================
+/**
+ * @brief Self-check suite run by ShmuiBenchmarks --check.
+ *
+ * Every check compares an implementation against a reference (stored
+ * frames, a known signal or a second code path) and records the error as
+ * a CheckResult with its limit. Checks may add timings of the code they
+ * exercise; those are reported but never fail.
+ *
+ * Needs a JUCE message manager (juce::ScopedJuceInitialiser_GUI) and
+ * must run on the message thread.
+ */
+class SelfChecks
+{
+public:
+    //==============================================================================
+    struct Options
+    {
+        juce::String filter;        ///< Only run checks whose name contains this (empty = all)
+    };
+
+    //==============================================================================
+    explicit SelfChecks(const Options& options);
+
+    /**
+     * @brief Run every check that matches the filter.
+     *
+     * @param log Called with each result as it completes (optional)
+     */
+    std::vector<CheckResult> runAll(const std::function<void(const CheckResult&)>& log = nullptr);
+
+    /**
+     * @brief Serialise results, with machine details, as JSON.
+     */
+    static juce::String toJSON(const std::vector<CheckResult>& results, const Options& options,
+                               const juce::String& label);
+
+private:
+    //==============================================================================
+    bool isSelected(const juce::String& check) const;
+    void add(const CheckResult& result);
+
+    void checkOrbSoftwareRenderer();
+    void checkTruePeakDetector();
+    void checkLevelMeterBallistics();
+    void checkBallistics();
+    void checkFrameClock();
+    void checkQuadRenderService();
+
+    //==============================================================================
+    Options m_options;
+    std::vector<CheckResult> m_results;
+    std::function<void(const CheckResult&)> m_log;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SelfChecks)
+};
+
+} // namespace shmui
@@ -10,6 +10,8 @@
 */
 
 #include "AudioAnalyzer.h"
+#include "../Utils/Profiling.h"
+#include "../Utils/Interpolation.h"
 
 namespace shmui
 {
@@ -37,6 +39,14 @@ AudioAnalyzer::AudioAnalyzer(AnalysisMode mode)
     fftData.resize(fftSize * 2, 0.0f);
     fifo.resize(fftSize, 0.0f);
     smoothedFrequencyData.resize(fftSize / 2, 0.0f);
+
+    // Hann window, computed once
+    window.resize(fftSize);
+    for (int i = 0; i < fftSize; ++i)
+    {
+        window[i] = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi *
+                                            i / static_cast<float>(fftSize - 1)));
+    }
 }
 
 //==============================================================================
@@ -44,6 +54,8 @@ AudioAnalyzer::AudioAnalyzer(AnalysisMode mode)
 
 void AudioAnalyzer::pushSamples(const float* samples, int numSamples)
 {
+    SHMUI_PROFILE_SCOPE("AudioAnalyzer::pushSamples");
+
     // Calculate RMS for level metering
     const float rms = calculateRMS(samples, numSamples);
 
@@ -120,6 +132,8 @@ void AudioAnalyzer::processBlock(const juce::AudioBuffer<float>& buffer)
 
 void AudioAnalyzer::getFrequencyData(std::vector<float>& outData) const
 {
+    SHMUI_PROFILE_SCOPE("AudioAnalyzer::getFrequencyData");
+
     const juce::SpinLock::ScopedLockType lock(dataLock);
 
     outData = smoothedFrequencyData;
@@ -137,6 +151,8 @@ void AudioAnalyzer::getFrequencyData(std::vector<float>& outData) const
 
 void AudioAnalyzer::getMirroredFrequencyData(std::vector<float>& outData) const
 {
+    SHMUI_PROFILE_SCOPE("AudioAnalyzer::getMirroredFrequencyData");
+
     // Get the frequency data first
     std::vector<float> freqData;
     getFrequencyData(freqData);
@@ -188,6 +204,8 @@ void AudioAnalyzer::getFrequencyBands(std::vector<float>& outBands,
                                       int loPass,
                                       int hiPass) const
 {
+    SHMUI_PROFILE_SCOPE("AudioAnalyzer::getFrequencyBands");
+
     // Implementation from bar-visualizer.tsx splitIntoBands function
     outBands.resize(numBands);
 
@@ -213,7 +231,7 @@ void AudioAnalyzer::getFrequencyBands(std::vector<float>& outBands,
                 // We convert to dB-like range for normalization
                 const float magnitude = smoothedFrequencyData[j];
                 const float dbValue = magnitude > 0.0f ?
-                    20.0f * std::log10(magnitude) : kMinDb;
+                    Interpolation::fastGainToDb(magnitude) : kMinDb;
                 sum += normalizeDb(dbValue);
                 count++;
             }
@@ -288,6 +306,8 @@ float AudioAnalyzer::smoothValue(float current, float target, float factor)
 
 void AudioAnalyzer::performFFT()
 {
+    SHMUI_PROFILE_SCOPE("AudioAnalyzer::performFFT");
+
     // Copy FIFO data to FFT buffer
     std::copy(fifo.begin(), fifo.end(), fftData.begin());
 
@@ -295,18 +315,14 @@ void AudioAnalyzer::performFFT()
     std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
 
     // Apply window function (Hann window)
-    for (int i = 0; i < fftSize; ++i)
-    {
-        const float window = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi *
-                                                      i / static_cast<float>(fftSize - 1)));
-        fftData[i] *= window;
-    }
+    juce::FloatVectorOperations::multiply(fftData.data(), window.data(), fftSize);
 
     // Perform FFT
     fft->performFrequencyOnlyForwardTransform(fftData.data());
 
     // Update smoothed data
     updateSmoothedData();
+    analysisCount.fetch_add(1, std::memory_order_release);
 }
 
 void AudioAnalyzer::updateSmoothedData()
@@ -316,23 +332,15 @@ void AudioAnalyzer::updateSmoothedData()
     const float smooth = smoothingTimeConstant.load(std::memory_order_relaxed);
     const int numBins = fftSize / 2;
 
-    for (int i = 0; i < numBins; ++i)
-    {
-        // Get magnitude from FFT output
-        // fft->performFrequencyOnlyForwardTransform gives us real magnitudes
-        const float magnitude = fftData[i];
-
-        // Normalize to 0-1 range (divide by FFT size for proper scaling)
-        const float normalizedMagnitude = magnitude / static_cast<float>(fftSize);
+    // fft->performFrequencyOnlyForwardTransform gives us real magnitudes.
+    // Normalize by the FFT size and scale like Web Audio's
+    // getByteFrequencyData (0-255), back to 0-1, in place
+    float* const magnitudes = fftData.data();
+    juce::FloatVectorOperations::multiply(magnitudes, 2.0f / static_cast<float>(fftSize), numBins);
+    juce::FloatVectorOperations::clip(magnitudes, magnitudes, 0.0f, 1.0f, numBins);
 
-        // Scale to 0-255 range like Web Audio's getByteFrequencyData
-        // then normalize back to 0-1
-        const float scaledValue = juce::jlimit(0.0f, 1.0f, normalizedMagnitude * 2.0f);
-
-        // Apply smoothing
-        smoothedFrequencyData[i] = smoothedFrequencyData[i] * smooth +
-                                   scaledValue * (1.0f - smooth);
-    }
+    // Apply smoothing
+    Interpolation::smooth(smoothedFrequencyData.data(), magnitudes, 1.0f - smooth, numBins);
 }
 
 } // namespace shmui
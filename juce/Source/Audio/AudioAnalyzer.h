@@ -106,7 +106,7 @@ public:
     void processBlock(const juce::AudioBuffer<float>& buffer);
 
     //==============================================================================
-    // UI Thread Methods (call from paint/timerCallback)
+    // UI Thread Methods (call from paint or a frame callback)
 
     /**
      * @brief Get normalized frequency data (0-1 range).
@@ -190,6 +190,15 @@ public:
      */
     int getFrequencyBinCount() const { return fftSize / 2; }
 
+    /**
+     * @brief Get the number of FFT frames analysed so far.
+     *
+     * Incremented once per analysis hop (every getFFTSize() samples).
+     * UI code can compare against a previously read value to find out how
+     * many new spectra arrived since the last frame. Wraps around.
+     */
+    uint32_t getAnalysisCount() const { return analysisCount.load(std::memory_order_acquire); }
+
     //==============================================================================
     // Static Utility Functions
 
@@ -238,6 +247,7 @@ private:
     // FFT Buffers (audio thread writes)
     std::vector<float> fftData;           // Time domain -> Frequency domain
     std::vector<float> fifo;              // Input sample FIFO
+    std::vector<float> window;            // Hann window, fftSize samples
     int fifoIndex = 0;
     bool fftDataReady = false;
 
@@ -245,6 +255,7 @@ private:
     std::vector<float> smoothedFrequencyData;
     std::atomic<float> smoothedRMS{0.0f};
     std::atomic<float> peakLevel{0.0f};
+    std::atomic<uint32_t> analysisCount{0};
 
     // Configuration
     std::atomic<float> smoothingTimeConstant{kDefaultSmoothing};
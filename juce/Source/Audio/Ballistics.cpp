@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    Ballistics.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of meter timing and the per-sample integrator.
+
+  ==============================================================================
+*/
+
+#include "Ballistics.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+BallisticsSpec BallisticsSpec::forType(MeterBallistics type)
+{
+    BallisticsSpec spec;
+
+    switch (type)
+    {
+        case MeterBallistics::Peak:
+        case MeterBallistics::TruePeak:
+            spec.fallDBPerSecond = 20.0f / 1.7f;
+            break;
+
+        case MeterBallistics::VU:
+            // 99% of the steady reading in 300ms, same time back down
+            spec.attackMs = 300.0f / std::log(100.0f);
+            spec.releaseMs = spec.attackMs;
+            spec.averaging = true;
+            break;
+
+        case MeterBallistics::PPM:
+            spec.attackMs = integrationTimeFor(10.0f, -1.0f);
+            spec.fallDBPerSecond = 20.0f / 1.5f;
+            break;
+
+        case MeterBallistics::PPMTypeII:
+        case MeterBallistics::BBC:
+            spec.attackMs = integrationTimeFor(10.0f, -2.0f);
+            spec.fallDBPerSecond = 24.0f / 2.8f;
+            break;
+
+        case MeterBallistics::Nordic:
+            spec.attackMs = integrationTimeFor(5.0f, -1.0f);
+            spec.fallDBPerSecond = 20.0f / 1.7f;
+            break;
+    }
+
+    return spec;
+}
+
+float BallisticsSpec::integrationTimeFor(float burstMs, float readingDB)
+{
+    // A burst of length t reaches 1 - exp(-t / tau) of the steady reading
+    return -burstMs / std::log(1.0f - juce::Decibels::decibelsToGain(readingDB));
+}
+
+float BallisticsSpec::getBurstReadingDB(float burstMs) const
+{
+    if (attackMs <= 0.0f)
+        return 0.0f;
+
+    return juce::Decibels::gainToDecibels(1.0f - std::exp(-burstMs / attackMs), -200.0f);
+}
+
+BallisticsSpec::Coefficients BallisticsSpec::getCoefficients(double elapsedSeconds) const
+{
+    const double ms = juce::jmax(0.0, elapsedSeconds) * 1000.0;
+    Coefficients c;
+
+    c.attack = attackMs > 0.0f ? static_cast<float>(1.0 - std::exp(-ms / attackMs)) : 1.0f;
+
+    if (fallDBPerSecond > 0.0f)
+        c.fall = static_cast<float>(std::pow(10.0, -fallDBPerSecond * ms * 0.001 / 20.0));
+    else
+        c.release = releaseMs > 0.0f ? static_cast<float>(1.0 - std::exp(-ms / releaseMs)) : 1.0f;
+
+    return c;
+}
+
+//==============================================================================
+PeakIntegrator::Settings PeakIntegrator::makeSettings(const BallisticsSpec& spec, double sampleRate)
+{
+    Settings settings;
+
+    if (sampleRate <= 0.0)
+        return settings;
+
+    // Same factors as BallisticsSpec::getCoefficients(), in double: a
+    // per-sample fall is too close to 1 for float at high sample rates
+    const double ms = 1000.0 / sampleRate;
+
+    settings.attack = spec.attackMs > 0.0f ? 1.0 - std::exp(-ms / spec.attackMs) : 1.0;
+
+    if (spec.fallDBPerSecond > 0.0f)
+        settings.fall = std::pow(10.0, -spec.fallDBPerSecond * ms * 0.001 / 20.0);
+    else
+        settings.release = spec.releaseMs > 0.0f ? 1.0 - std::exp(-ms / spec.releaseMs) : 1.0;
+
+    settings.envelopeDecay = std::exp(-ms / kEnvelopeMs);
+    settings.averaging = spec.averaging;
+    settings.inputScale = spec.averaging ? juce::MathConstants<double>::halfPi : 1.0;
+    settings.enabled = true;
+    return settings;
+}
+
+//==============================================================================
+float PeakIntegrator::process(const Settings& settings, const float* samples, int numSamples)
+{
+    double current = value;
+    double highest = numSamples > 0 ? 0.0 : current;
+
+    if (settings.averaging)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            current = step(settings, current, std::abs(static_cast<double>(samples[i])) * settings.inputScale);
+            highest = juce::jmax(highest, current);
+        }
+    }
+    else
+    {
+        double env = envelope;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            env = juce::jmax(std::abs(static_cast<double>(samples[i])), env * settings.envelopeDecay);
+            current = step(settings, current, env);
+            highest = juce::jmax(highest, current);
+        }
+
+        envelope = env;
+    }
+
+    value = current;
+    return static_cast<float>(highest);
+}
+
+float PeakIntegrator::processPeak(const Settings& settings, float peak, int numSamples)
+{
+    double current = value;
+    double highest = numSamples > 0 ? 0.0 : current;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        current = step(settings, current, peak);
+        highest = juce::jmax(highest, current);
+    }
+
+    value = current;
+    envelope = peak;
+    return static_cast<float>(highest);
+}
+
+void PeakIntegrator::limit(float maxGain)
+{
+    value = juce::jmin(value, static_cast<double>(maxGain));
+    envelope = juce::jmin(envelope, static_cast<double>(maxGain));
+}
+
+void PeakIntegrator::reset()
+{
+    value = 0.0;
+    envelope = 0.0;
+}
+
+} // namespace shmui
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    Ballistics.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Meter ballistics: standard timing for peak, VU and PPM meters, and the
+    per-sample integrator that runs it on the audio signal.
+
+    Thread-safe design: BallisticsSpec is a plain value; each
+    PeakIntegrator belongs to one audio thread and never allocates.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Meter ballistics type.
+ */
+enum class MeterBallistics
+{
+    Peak,       ///< Instant attack, 20 dB in 1.7s fall (IEC 60268-18 digital peak)
+    VU,         ///< VU meter, average-responding, 99% of reading in 300ms (IEC 60268-17)
+    PPM,        ///< Type I PPM: 10ms to -1 dB, 20 dB in 1.5s fall (IEC 60268-10, DIN 45406)
+    TruePeak,   ///< Peak ballistics on the oversampled true peak (dBTP, ITU-R BS.1770)
+    PPMTypeII,  ///< Type IIb PPM: 10ms to -2 dB, 24 dB in 2.8s fall (IEC 60268-10, EBU)
+    Nordic,     ///< Nordic N9 PPM: 5ms to -1 dB, 20 dB in 1.7s fall (IEC 60268-10 Type I)
+    BBC         ///< Type IIa PPM: Type II timing as used on the BBC 1-7 scale (IEC 60268-10)
+};
+
+//==============================================================================
+/**
+ * @brief Time-based meter ballistics.
+ *
+ * Describes how a displayed level follows its input in real time. The
+ * level is kept as a linear gain:
+ * - Rising input is integrated exponentially with attackMs.
+ * - Falling input either falls at a constant fallDBPerSecond (PPM, peak)
+ *   or, when that is 0, returns exponentially with releaseMs (VU).
+ *
+ * Audio fed as samples is integrated per sample by PeakIntegrator, which
+ * is what gives tone bursts their specified readings. Levels that only
+ * arrive once per frame are integrated per frame with getCoefficients()
+ * and apply(); that is exact for steady input at any refresh rate.
+ */
+struct BallisticsSpec
+{
+    float attackMs = 0.0f;            ///< Rise time constant, 0 for instant attack
+    float releaseMs = 0.0f;           ///< Exponential return time constant (used when fallDBPerSecond is 0)
+    float fallDBPerSecond = 0.0f;     ///< Constant fall rate in dB per second, 0 for exponential return
+    bool averaging = false;           ///< Integrate the rectified signal (sine-calibrated) instead of its peaks
+
+    /** Per-frame factors for one elapsed time step. */
+    struct Coefficients
+    {
+        float attack = 1.0f;          ///< Fraction of a rise covered this frame
+        float release = 0.0f;         ///< Fraction of an exponential return covered this frame
+        float fall = 1.0f;            ///< Gain factor of a constant-rate fall this frame
+    };
+
+    /**
+     * @brief Get the standard timing for a ballistics type.
+     */
+    static BallisticsSpec forType(MeterBallistics type);
+
+    /**
+     * @brief Time constant that gives a reading of readingDB for a tone
+     *        burst of burstMs (the way IEC 60268-10 specifies integration time).
+     */
+    static float integrationTimeFor(float burstMs, float readingDB);
+
+    /**
+     * @brief Nominal reading of a tone burst, in dB relative to the steady tone.
+     *
+     * The inverse of integrationTimeFor(); 0 for instant attack.
+     */
+    float getBurstReadingDB(float burstMs) const;
+
+    /**
+     * @brief Exact per-frame factors for an elapsed time.
+     */
+    Coefficients getCoefficients(double elapsedSeconds) const;
+
+    /**
+     * @brief Advance a displayed gain towards an input gain by one frame.
+     */
+    static float apply(const Coefficients& c, float displayGain, float inputGain)
+    {
+        // Rising and falling differ only in the start point and factor; selecting
+        // those before the arithmetic keeps the array version free of branches
+        const float fallen = juce::jmax(inputGain, displayGain * c.fall);
+        const bool rising = inputGain > displayGain;
+        const float start = rising ? displayGain : fallen;
+        const float factor = rising ? c.attack : c.release;
+        return start + (inputGain - start) * factor;
+    }
+
+    /**
+     * @brief Advance every displayed gain towards its input gain by one frame.
+     *
+     * Same result as the scalar apply() per element, in one vectorized loop.
+     */
+    static void apply(const Coefficients& c, float* displayGains, const float* inputGains, int numValues)
+    {
+        for (int i = 0; i < numValues; ++i)
+            displayGains[i] = apply(c, displayGains[i], inputGains[i]);
+    }
+
+    bool operator==(const BallisticsSpec& other) const
+    {
+        return attackMs == other.attackMs && releaseMs == other.releaseMs
+            && fallDBPerSecond == other.fallDBPerSecond && averaging == other.averaging;
+    }
+
+    bool operator!=(const BallisticsSpec& other) const { return !operator==(other); }
+};
+
+//==============================================================================
+/**
+ * @brief Runs a BallisticsSpec on the audio signal of one channel.
+ *
+ * IEC 60268-10 defines a PPM's integration time by its reading for a tone
+ * burst (10 ms reads -1 dB on a Type I meter). A display that integrates
+ * once per frame holds each frame's peak for the whole frame, so the same
+ * burst counts as 33 ms of input at 30 Hz and 7 ms at 144 Hz. This
+ * integrator steps the ballistics once per sample instead:
+ * - Peak timing integrates a peak envelope that decays with a 1 ms time
+ *   constant, so the rise is fed between the peaks of a tone.
+ * - Averaging timing (VU) integrates the rectified signal, scaled by pi / 2
+ *   so a steady sine reads its peak.
+ *
+ * The fall or release runs here too, so the next rise starts from the
+ * right level. process() returns the highest value reached in the block;
+ * a meter shows that and only lets the display fall on its own clock
+ * while no audio arrives.
+ *
+ * One instance per channel, used by one audio thread at a time.
+ */
+class PeakIntegrator
+{
+public:
+    //==============================================================================
+    /** Per-sample factors for one timing and sample rate. */
+    struct Settings
+    {
+        double attack = 1.0;          ///< Fraction of a rise covered per sample
+        double release = 0.0;         ///< Fraction of an exponential return covered per sample
+        double fall = 1.0;            ///< Gain factor of a constant-rate fall per sample
+        double envelopeDecay = 0.0;   ///< Peak envelope factor per sample
+        double inputScale = 1.0;      ///< Gain on rectified samples when averaging
+        bool averaging = false;
+        bool enabled = false;         ///< False until made for a sample rate
+    };
+
+    /** Peak envelope time constant. */
+    static constexpr double kEnvelopeMs = 1.0;
+
+    /**
+     * @brief Compute the per-sample factors (message thread).
+     */
+    static Settings makeSettings(const BallisticsSpec& spec, double sampleRate);
+
+    //==============================================================================
+    /**
+     * @brief Integrate a block of samples.
+     *
+     * @return The highest integrated gain in the block (the current value if empty)
+     */
+    float process(const Settings& settings, const float* samples, int numSamples);
+
+    /**
+     * @brief Integrate a block known only by its peak, held for numSamples.
+     *
+     * For precomputed block peaks and true peaks; the rise is then only as
+     * fine as the block.
+     */
+    float processPeak(const Settings& settings, float peak, int numSamples);
+
+    /**
+     * @brief Lower the integrated value to at most maxGain.
+     *
+     * Used when the display has fallen on its own while no audio arrived,
+     * so the next block starts from the displayed level.
+     */
+    void limit(float maxGain);
+
+    /**
+     * @brief Return to silence.
+     */
+    void reset();
+
+    /**
+     * @brief Get the integrated gain after the last block.
+     */
+    float getValue() const { return static_cast<float>(value); }
+
+private:
+    static double step(const Settings& settings, double current, double input)
+    {
+        if (input > current)
+            return current + (input - current) * settings.attack;
+
+        const double fallen = juce::jmax(input, current * settings.fall);
+        return fallen + (input - fallen) * settings.release;
+    }
+
+    double value = 0.0;
+    double envelope = 0.0;
+};
+
+} // namespace shmui
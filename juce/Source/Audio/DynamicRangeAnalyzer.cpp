@@ -0,0 +1,515 @@
+/*
+  ==============================================================================
+
+    DynamicRangeAnalyzer.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the dynamic-range statistics engine.
+
+  ==============================================================================
+*/
+
+#include "DynamicRangeAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace shmui
+{
+
+namespace
+{
+    float gainToDB(double gain)
+    {
+        return gain > 0.0 ? static_cast<float>(20.0 * std::log10(gain)) : DynamicRangeStats::kSilence;
+    }
+
+    float energyToDB(double energy)
+    {
+        return energy > 0.0 ? static_cast<float>(10.0 * std::log10(energy)) : DynamicRangeStats::kSilence;
+    }
+
+    /** Difference of two levels, 0 if either is silent. */
+    float levelDifference(float a, float b)
+    {
+        return std::isfinite(a) && std::isfinite(b) ? a - b : 0.0f;
+    }
+
+    /** DR of one channel from its reference peak and the mean energy of its loudest blocks. */
+    float channelDR(float peak, double loudestEnergy)
+    {
+        return levelDifference(gainToDB(peak), energyToDB(loudestEnergy));
+    }
+
+    /** Number of loudest blocks that count towards the DR RMS. */
+    int loudestBlockCount(int numBlocks)
+    {
+        return juce::jmax(1, static_cast<int>(numBlocks * DynamicRangeAnalyzer::kLoudestFraction));
+    }
+}
+
+//==============================================================================
+
+DynamicRangeAnalyzer::DynamicRangeAnalyzer() = default;
+
+void DynamicRangeAnalyzer::prepare(double newSampleRate, int newNumChannels, bool measureTruePeak)
+{
+    numChannels = juce::jmax(0, newNumChannels);
+    sampleRate = newSampleRate;
+    samplesPerBlock = juce::jmax(1, juce::roundToInt(newSampleRate * kBlockSeconds));
+    truePeakEnabled = measureTruePeak;
+
+    const auto size = static_cast<size_t>(numChannels);
+    blockPeak.assign(size, 0.0f);
+    blockTruePeak.assign(size, 0.0f);
+    blockSumSquares.assign(size, 0.0);
+
+    rmsHistogram.assign(size * kHistogramBins, 0);
+    rmsEnergies.assign(size * kHistogramBins, 0.0);
+    highestPeak.assign(size, 0.0f);
+    secondPeak.assign(size, 0.0f);
+    totalSumSquares.assign(size, 0.0);
+
+    windowMeanSquares.assign(size * kMaxWindowBlocks, 0.0);
+    windowPeaks.assign(size * kMaxWindowBlocks, 0.0f);
+    windowTruePeaks.assign(size * kMaxWindowBlocks, 0.0f);
+    windowLoudnessEnergies.assign(kMaxWindowBlocks, 0.0);
+    sortScratch.assign(kMaxWindowBlocks, 0.0f);
+
+    loudnessAnalyzer.prepare(newSampleRate, juce::jmin(numChannels, LoudnessAnalyzer::kMaxChannels));
+
+    if (truePeakEnabled)
+        truePeakDetector.prepare(newSampleRate, numChannels);
+
+    clearMeasurements();
+    slots = {};
+    sequence.store(0, std::memory_order_release);
+    resetRequested.store(false, std::memory_order_relaxed);
+}
+
+void DynamicRangeAnalyzer::setWindowSeconds(double seconds)
+{
+    windowBlocks.store(juce::jlimit(1, kMaxWindowBlocks, juce::roundToInt(seconds / kBlockSeconds)),
+                       std::memory_order_relaxed);
+}
+
+void DynamicRangeAnalyzer::reset()
+{
+    resetRequested.store(true, std::memory_order_release);
+}
+
+void DynamicRangeAnalyzer::clearMeasurements()
+{
+    std::fill(blockPeak.begin(), blockPeak.end(), 0.0f);
+    std::fill(blockTruePeak.begin(), blockTruePeak.end(), 0.0f);
+    std::fill(blockSumSquares.begin(), blockSumSquares.end(), 0.0);
+    blockSamples = 0;
+
+    std::fill(rmsHistogram.begin(), rmsHistogram.end(), 0u);
+    std::fill(rmsEnergies.begin(), rmsEnergies.end(), 0.0);
+    std::fill(highestPeak.begin(), highestPeak.end(), 0.0f);
+    std::fill(secondPeak.begin(), secondPeak.end(), 0.0f);
+    std::fill(totalSumSquares.begin(), totalSumSquares.end(), 0.0);
+    maxPeak = 0.0f;
+    maxTruePeak = 0.0f;
+    totalSamples = 0;
+    numBlocks = 0;
+
+    windowIndex = 0;
+    windowFilled = 0;
+
+    loudnessAnalyzer.resetIntegration();
+
+    if (truePeakEnabled)
+        truePeakDetector.reset();
+}
+
+//==============================================================================
+// Audio Thread Methods
+
+void DynamicRangeAnalyzer::process(const float* const* channels, int numInputChannels, int numSamples)
+{
+    if (resetRequested.exchange(false, std::memory_order_acquire))
+    {
+        clearMeasurements();
+        publish();
+    }
+
+    if (numChannels == 0 || numSamples <= 0)
+        return;
+
+    const int count = juce::jmin(numInputChannels, numChannels);
+    loudnessAnalyzer.process(channels, count, numSamples);
+
+    // Missing channels measure as silence
+    int offset = 0;
+    while (offset < numSamples)
+    {
+        const int length = juce::jmin(numSamples - offset, samplesPerBlock - blockSamples);
+
+        for (int ch = 0; ch < count; ++ch)
+        {
+            const float* samples = channels[ch] + offset;
+            float peak = blockPeak[static_cast<size_t>(ch)];
+            double sum = 0.0;
+
+            for (int i = 0; i < length; ++i)
+            {
+                const float sample = samples[i];
+                peak = juce::jmax(peak, std::abs(sample));
+                sum += static_cast<double>(sample) * sample;
+            }
+
+            blockPeak[static_cast<size_t>(ch)] = peak;
+            blockSumSquares[static_cast<size_t>(ch)] += sum;
+
+            if (truePeakEnabled)
+            {
+                const float truePeak = truePeakDetector.process(ch, samples, length);
+                blockTruePeak[static_cast<size_t>(ch)] = juce::jmax(blockTruePeak[static_cast<size_t>(ch)], truePeak);
+            }
+        }
+
+        blockSamples += length;
+        offset += length;
+
+        if (blockSamples >= samplesPerBlock)
+        {
+            finishBlock();
+            publish();
+        }
+    }
+}
+
+void DynamicRangeAnalyzer::processBlock(const juce::AudioBuffer<float>& buffer)
+{
+    process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+void DynamicRangeAnalyzer::finishBlock()
+{
+    if (blockSamples == 0)
+        return;
+
+    const double invSamples = 1.0 / blockSamples;
+    const size_t ringOffset = static_cast<size_t>(windowIndex * numChannels);
+
+    // Short-term loudness spans 3 s, the same as one block
+    const float shortTerm = loudnessAnalyzer.getShortTermLoudness();
+    windowLoudnessEnergies[static_cast<size_t>(windowIndex)] =
+        std::isfinite(shortTerm) ? LoudnessAnalyzer::loudnessToEnergy(shortTerm) : 0.0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto c = static_cast<size_t>(ch);
+        const double meanSquare = blockSumSquares[c] * invSamples;
+        const float peak = blockPeak[c];
+        const float truePeak = truePeakEnabled ? juce::jmax(peak, blockTruePeak[c]) : peak;
+
+        // DR meters scale block RMS by sqrt 2, so a full-scale sine reads 0 dB
+        const double drEnergy = 2.0 * meanSquare;
+        const size_t bin = c * kHistogramBins + static_cast<size_t>(histogramBin(energyToDB(drEnergy)));
+        ++rmsHistogram[bin];
+        rmsEnergies[bin] += drEnergy;
+
+        if (peak > highestPeak[c])
+        {
+            secondPeak[c] = highestPeak[c];
+            highestPeak[c] = peak;
+        }
+        else if (peak > secondPeak[c])
+        {
+            secondPeak[c] = peak;
+        }
+
+        totalSumSquares[c] += blockSumSquares[c];
+        maxPeak = juce::jmax(maxPeak, peak);
+        maxTruePeak = juce::jmax(maxTruePeak, truePeak);
+
+        windowMeanSquares[ringOffset + c] = meanSquare;
+        windowPeaks[ringOffset + c] = peak;
+        windowTruePeaks[ringOffset + c] = truePeak;
+
+        blockPeak[c] = 0.0f;
+        blockTruePeak[c] = 0.0f;
+        blockSumSquares[c] = 0.0;
+    }
+
+    totalSamples += blockSamples;
+    ++numBlocks;
+    windowIndex = (windowIndex + 1) % kMaxWindowBlocks;
+    windowFilled = juce::jmin(windowFilled + 1, kMaxWindowBlocks);
+    blockSamples = 0;
+}
+
+int DynamicRangeAnalyzer::histogramBin(float dB)
+{
+    if (!std::isfinite(dB))
+        return 0;
+
+    return juce::jlimit(0, kHistogramBins - 1, static_cast<int>((dB - kHistogramMin) / kHistogramStep));
+}
+
+float DynamicRangeAnalyzer::programmeDR() const
+{
+    if (numBlocks == 0 || numChannels == 0)
+        return 0.0f;
+
+    const int loudest = loudestBlockCount(numBlocks);
+    double sum = 0.0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const size_t base = static_cast<size_t>(ch) * kHistogramBins;
+
+        // Walk down from the loudest bin; a partly used bin contributes its mean energy
+        int remaining = loudest;
+        double energy = 0.0;
+
+        for (int bin = kHistogramBins - 1; bin >= 0 && remaining > 0; --bin)
+        {
+            const uint32_t blocks = rmsHistogram[base + static_cast<size_t>(bin)];
+            if (blocks == 0)
+                continue;
+
+            const int taken = juce::jmin(remaining, static_cast<int>(blocks));
+            energy += rmsEnergies[base + static_cast<size_t>(bin)] * taken / blocks;
+            remaining -= taken;
+        }
+
+        // The second-highest peak keeps a single click from inflating the score
+        const float peak = numBlocks > 1 ? secondPeak[static_cast<size_t>(ch)] : highestPeak[static_cast<size_t>(ch)];
+        sum += channelDR(peak, energy / loudest);
+    }
+
+    return static_cast<float>(sum / numChannels);
+}
+
+float DynamicRangeAnalyzer::windowDR() const
+{
+    const int count = juce::jmin(windowFilled, windowBlocks.load(std::memory_order_relaxed));
+    if (count == 0 || numChannels == 0)
+        return 0.0f;
+
+    const int loudest = loudestBlockCount(count);
+    auto& energies = sortScratch;
+    double sum = 0.0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float highest = 0.0f;
+        float second = 0.0f;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const int block = (windowIndex - 1 - i + kMaxWindowBlocks) % kMaxWindowBlocks;
+            const size_t index = static_cast<size_t>(block * numChannels + ch);
+            const float peak = windowPeaks[index];
+
+            energies[static_cast<size_t>(i)] = static_cast<float>(2.0 * windowMeanSquares[index]);
+
+            if (peak > highest)
+            {
+                second = highest;
+                highest = peak;
+            }
+            else if (peak > second)
+            {
+                second = peak;
+            }
+        }
+
+        std::partial_sort(energies.begin(), energies.begin() + loudest, energies.begin() + count, std::greater<float>());
+
+        double energy = 0.0;
+        for (int i = 0; i < loudest; ++i)
+            energy += energies[static_cast<size_t>(i)];
+
+        sum += channelDR(count > 1 ? second : highest, energy / loudest);
+    }
+
+    return static_cast<float>(sum / numChannels);
+}
+
+void DynamicRangeAnalyzer::publish()
+{
+    Published next;
+
+    // Programme
+    {
+        auto& stats = next.programme;
+        double sumSquares = 0.0;
+        for (const double s : totalSumSquares)
+            sumSquares += s;
+
+        const double samples = static_cast<double>(totalSamples) * juce::jmax(1, numChannels);
+
+        stats.peakDB = gainToDB(maxPeak);
+        stats.truePeakDB = truePeakEnabled ? gainToDB(maxTruePeak) : stats.peakDB;
+        stats.rmsDB = totalSamples > 0 ? energyToDB(sumSquares / samples) : DynamicRangeStats::kSilence;
+        stats.crestFactorDB = levelDifference(stats.peakDB, stats.rmsDB);
+        stats.loudness = loudnessAnalyzer.getIntegratedLoudness();
+        stats.peakToLoudnessRatio = levelDifference(stats.truePeakDB, stats.loudness);
+        stats.drScore = programmeDR();
+        stats.numBlocks = numBlocks;
+        stats.lengthSeconds = totalSamples / sampleRate;
+    }
+
+    // Window
+    {
+        auto& stats = next.window;
+        const int count = juce::jmin(windowFilled, windowBlocks.load(std::memory_order_relaxed));
+        float peak = 0.0f;
+        float truePeak = 0.0f;
+        double meanSquare = 0.0;
+        double loudnessEnergy = 0.0;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const int block = (windowIndex - 1 - i + kMaxWindowBlocks) % kMaxWindowBlocks;
+            const size_t base = static_cast<size_t>(block * numChannels);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                peak = juce::jmax(peak, windowPeaks[base + static_cast<size_t>(ch)]);
+                truePeak = juce::jmax(truePeak, windowTruePeaks[base + static_cast<size_t>(ch)]);
+                meanSquare += windowMeanSquares[base + static_cast<size_t>(ch)];
+            }
+
+            loudnessEnergy += windowLoudnessEnergies[static_cast<size_t>(block)];
+        }
+
+        if (count > 0)
+        {
+            stats.peakDB = gainToDB(peak);
+            stats.truePeakDB = gainToDB(truePeak);
+            stats.rmsDB = energyToDB(meanSquare / (count * juce::jmax(1, numChannels)));
+            stats.crestFactorDB = levelDifference(stats.peakDB, stats.rmsDB);
+            stats.loudness = LoudnessAnalyzer::energyToLoudness(loudnessEnergy / count);
+            stats.peakToLoudnessRatio = levelDifference(stats.truePeakDB, stats.loudness);
+            stats.drScore = windowDR();
+            stats.numBlocks = count;
+            stats.lengthSeconds = count * kBlockSeconds;
+        }
+    }
+
+    const uint64_t seq = sequence.load(std::memory_order_relaxed) + 1;
+    slots[static_cast<size_t>(seq & 1)] = next;
+    sequence.store(seq, std::memory_order_release);
+}
+
+//==============================================================================
+// UI Thread Methods
+
+DynamicRangeStats DynamicRangeAnalyzer::getProgrammeStats() const
+{
+    for (;;)
+    {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        const DynamicRangeStats stats = slots[static_cast<size_t>(before & 1)].programme;
+
+        // If a block was published meanwhile, the writer may be refilling this slot
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            return stats;
+    }
+}
+
+DynamicRangeStats DynamicRangeAnalyzer::getWindowStats() const
+{
+    for (;;)
+    {
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        const DynamicRangeStats stats = slots[static_cast<size_t>(before & 1)].window;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            return stats;
+    }
+}
+
+//==============================================================================
+// Offline Analysis
+
+void DynamicRangeAnalyzer::finish()
+{
+    finishBlock();
+    publish();
+}
+
+DynamicRangeStats DynamicRangeAnalyzer::analyzeFile(const juce::File& file, bool measureTruePeak)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->numChannels == 0)
+        return {};
+
+    const int numFileChannels = static_cast<int>(reader->numChannels);
+    constexpr int kChunkSamples = 65536;
+
+    DynamicRangeAnalyzer analyzer;
+    analyzer.prepare(reader->sampleRate, numFileChannels, measureTruePeak);
+
+    juce::AudioBuffer<float> buffer(numFileChannels, kChunkSamples);
+
+    for (int64_t position = 0; position < reader->lengthInSamples; position += kChunkSamples)
+    {
+        const int numSamples = static_cast<int>(juce::jmin<int64_t>(kChunkSamples, reader->lengthInSamples - position));
+        if (!reader->read(&buffer, 0, numSamples, position, true, true))
+            return {};
+
+        analyzer.process(buffer.getArrayOfReadPointers(), numFileChannels, numSamples);
+    }
+
+    analyzer.finish();
+    return analyzer.getProgrammeStats();
+}
+
+std::vector<DynamicRangeStats> DynamicRangeAnalyzer::analyzeFiles(const std::vector<juce::File>& files,
+                                                                  int numThreads, bool measureTruePeak)
+{
+    std::vector<DynamicRangeStats> results(files.size());
+    if (files.empty())
+        return results;
+
+    const int workers = numThreads > 0 ? numThreads : juce::SystemStats::getNumCpus();
+    juce::ThreadPool pool(juce::jlimit(1, static_cast<int>(files.size()), workers));
+
+    std::atomic<int> remaining{static_cast<int>(files.size())};
+    juce::WaitableEvent allFilesDone;
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        pool.addJob([&, i]
+        {
+            results[i] = analyzeFile(files[i], measureTruePeak);
+
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                allFilesDone.signal();
+        });
+    }
+
+    allFilesDone.wait();
+    return results;
+}
+
+int DynamicRangeAnalyzer::getAlbumDR(const std::vector<DynamicRangeStats>& tracks)
+{
+    int sum = 0;
+    int count = 0;
+
+    for (const auto& track : tracks)
+    {
+        if (track.isValid())
+        {
+            sum += track.getRoundedDR();
+            ++count;
+        }
+    }
+
+    return count > 0 ? juce::roundToInt(static_cast<double>(sum) / count) : 0;
+}
+
+} // namespace shmui
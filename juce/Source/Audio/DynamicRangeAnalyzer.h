@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    DynamicRangeAnalyzer.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Dynamic-range statistics: crest factor, peak-to-loudness ratio (PLR)
+    and a DR score, for the whole programme and a sliding window.
+
+    Thread-safe design: Audio thread writes, UI thread reads published
+    snapshots. Offline analysis of files runs on a thread pool.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LoudnessAnalyzer.h"
+#include "TruePeakDetector.h"
+#include <array>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Dynamic-range readings for a stretch of audio.
+ */
+struct DynamicRangeStats
+{
+    static constexpr float kSilence = -std::numeric_limits<float>::infinity();
+
+    float peakDB = kSilence;                ///< Highest sample peak (dBFS)
+    float truePeakDB = kSilence;            ///< Highest true peak (dBTP), equals peakDB if not measured
+    float rmsDB = kSilence;                 ///< RMS over all channels (dBFS)
+    float crestFactorDB = 0.0f;             ///< peakDB - rmsDB
+    float loudness = kSilence;              ///< Integrated (programme) or ungated (window) loudness, LUFS
+    float peakToLoudnessRatio = 0.0f;       ///< PLR: truePeakDB - loudness
+    float drScore = 0.0f;                   ///< DR score, unrounded (mean over channels)
+    int numBlocks = 0;                      ///< DR blocks measured
+    double lengthSeconds = 0.0;             ///< Audio measured
+
+    /** DR score as usually quoted (rounded, e.g. "DR12"). */
+    int getRoundedDR() const { return juce::roundToInt(drScore); }
+
+    /** True once at least one DR block has been measured. */
+    bool isValid() const { return numBlocks > 0; }
+};
+
+//==============================================================================
+/**
+ * @brief Streaming dynamic-range statistics engine.
+ *
+ * Audio is cut into 3 s blocks. For every channel and block the engine
+ * records the block peak and the block RMS (scaled by sqrt 2, as DR
+ * meters do) into constant-memory state: a histogram of block RMS with
+ * the summed energy per bin, the two highest block peaks, and a short
+ * ring of recent blocks for the window. From those it derives:
+ * - DR score: per channel, the second-highest block peak over the RMS of
+ *   the loudest 20% of blocks, averaged over channels
+ * - Crest factor: highest peak over programme RMS
+ * - PLR: highest true peak over integrated loudness (EBU R128)
+ *
+ * Programme figures cover everything since prepare()/reset(); window
+ * figures cover the last getWindowBlocks() blocks and use the ungated
+ * short-term loudness of those blocks.
+ *
+ * Thread Safety:
+ * - prepare() on the message thread, before playback
+ * - Audio thread calls process() / processBlock(); no allocation or locks
+ * - Any thread calls getProgrammeStats() / getWindowStats() / reset()
+ *
+ * For files use analyzeFile() or analyzeFiles(), which run the same
+ * engine offline and include the final partial block.
+ */
+class DynamicRangeAnalyzer
+{
+public:
+    //==============================================================================
+    /** DR block length. */
+    static constexpr double kBlockSeconds = 3.0;
+
+    /** Fraction of loudest blocks used for the DR RMS. */
+    static constexpr double kLoudestFraction = 0.2;
+
+    /** Block RMS histogram range and resolution (dB). */
+    static constexpr float kHistogramMin = -120.0f;
+    static constexpr float kHistogramMax = 12.0f;
+    static constexpr float kHistogramStep = 0.05f;
+    static constexpr int kHistogramBins = 2640;
+
+    /** Longest window, in blocks. */
+    static constexpr int kMaxWindowBlocks = 40;
+
+    //==============================================================================
+    DynamicRangeAnalyzer();
+    ~DynamicRangeAnalyzer() = default;
+
+    /**
+     * @brief Set up for a sample rate and channel count.
+     *
+     * Allocates; call from prepareToPlay(). Clears all measurements.
+     *
+     * @param measureTruePeak Oversample for true peak (used for PLR)
+     */
+    void prepare(double sampleRate, int numChannels, bool measureTruePeak = true);
+
+    /**
+     * @brief Set the window length in seconds (rounded to whole blocks, default 30 s).
+     *
+     * Safe during playback; applies from the next block.
+     */
+    void setWindowSeconds(double seconds);
+
+    /**
+     * @brief Get the window length in blocks.
+     */
+    int getWindowBlocks() const { return windowBlocks.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Audio Thread Methods
+
+    /**
+     * @brief Measure a block of audio.
+     */
+    void process(const float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * @brief Measure a JUCE audio buffer.
+     */
+    void processBlock(const juce::AudioBuffer<float>& buffer);
+
+    //==============================================================================
+    // UI Thread Methods
+
+    /**
+     * @brief Statistics since prepare() or the last reset (updated every block).
+     */
+    DynamicRangeStats getProgrammeStats() const;
+
+    /**
+     * @brief Statistics over the window.
+     */
+    DynamicRangeStats getWindowStats() const;
+
+    /**
+     * @brief Number of published updates; compare to skip unchanged readouts.
+     */
+    uint64_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Restart all statistics (applied at the start of the next processed block).
+     */
+    void reset();
+
+    //==============================================================================
+    // Offline Analysis
+
+    /**
+     * @brief Count the final partial block and publish (offline use, after the last process()).
+     */
+    void finish();
+
+    /**
+     * @brief Analyze an audio file on the calling thread.
+     *
+     * @return Programme statistics, invalid if the file could not be read
+     */
+    static DynamicRangeStats analyzeFile(const juce::File& file, bool measureTruePeak = true);
+
+    /**
+     * @brief Analyze files in parallel, one file per worker.
+     *
+     * Blocks until all files are done.
+     *
+     * @param numThreads Worker threads, or -1 for one per CPU
+     * @return One result per file, in order
+     */
+    static std::vector<DynamicRangeStats> analyzeFiles(const std::vector<juce::File>& files,
+                                                       int numThreads = -1, bool measureTruePeak = true);
+
+    /**
+     * @brief Album DR: the mean of the tracks' rounded DR scores, rounded.
+     */
+    static int getAlbumDR(const std::vector<DynamicRangeStats>& tracks);
+
+private:
+    //==============================================================================
+    struct Published
+    {
+        DynamicRangeStats programme;
+        DynamicRangeStats window;
+    };
+
+    void finishBlock();
+    void clearMeasurements();
+    void publish();
+    float programmeDR() const;
+    float windowDR() const;
+    static int histogramBin(float dB);
+
+    //==============================================================================
+    int numChannels = 0;
+    double sampleRate = 44100.0;
+    int samplesPerBlock = 0;
+    std::atomic<int> windowBlocks{10};
+    bool truePeakEnabled = false;
+
+    // Current block, per channel
+    std::vector<float> blockPeak;
+    std::vector<float> blockTruePeak;
+    std::vector<double> blockSumSquares;
+    int blockSamples = 0;
+
+    // Programme state: RMS histograms (count and energy per bin), two highest block peaks
+    std::vector<uint32_t> rmsHistogram;       // numChannels * kHistogramBins
+    std::vector<double> rmsEnergies;
+    std::vector<float> highestPeak;
+    std::vector<float> secondPeak;
+    std::vector<double> totalSumSquares;
+    float maxPeak = 0.0f;
+    float maxTruePeak = 0.0f;
+    int64_t totalSamples = 0;
+    int numBlocks = 0;
+
+    // Ring of the last kMaxWindowBlocks blocks, numChannels entries per block
+    std::vector<double> windowMeanSquares;
+    std::vector<float> windowPeaks;
+    std::vector<float> windowTruePeaks;
+    std::vector<double> windowLoudnessEnergies;
+    mutable std::vector<float> sortScratch;                                  // windowDR() work space (audio thread)
+    int windowIndex = 0;
+    int windowFilled = 0;
+
+    LoudnessAnalyzer loudnessAnalyzer;
+    TruePeakDetector truePeakDetector;
+
+    // Published snapshots (two slots, sequence-guarded like MeterHub)
+    std::array<Published, 2> slots;
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<bool> resetRequested{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DynamicRangeAnalyzer)
+};
+
+} // namespace shmui
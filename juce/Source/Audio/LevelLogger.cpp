@@ -0,0 +1,557 @@
+/*
+  ==============================================================================
+
+    LevelLogger.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the level logger and log reader.
+
+  ==============================================================================
+*/
+
+#include "LevelLogger.h"
+#include <cmath>
+#include <cstring>
+
+namespace shmui
+{
+
+//==============================================================================
+// LevelLogFormat
+
+juce::File LevelLogFormat::getLevelFile(const juce::File& file, int level)
+{
+    return level == 0 ? file : file.getSiblingFile(file.getFileName() + "." + juce::String(level));
+}
+
+bool LevelLogFormat::isValidHeader(const Header& header)
+{
+    const Header reference;
+    return std::memcmp(header.magic, reference.magic, sizeof(header.magic)) == 0
+        && header.numChannels > 0
+        && header.levelFactor == static_cast<uint32_t>(kLevelFactor)
+        && header.intervalMs > 0.0;
+}
+
+int16_t LevelLogFormat::encode(float dB)
+{
+    if (!(dB > kSilenceDB))   // Also catches -inf and NaN
+        dB = kSilenceDB;
+
+    return static_cast<int16_t>(juce::roundToInt(juce::jmin(dB, 327.0f) * 100.0f));
+}
+
+void LevelLogFormat::merge(int16_t* accumulated, const int16_t* record, int numValues)
+{
+    // Values come in (min, max) pairs; kNoData is the smallest int16, so max needs no special case
+    for (int i = 0; i < numValues; i += 2)
+    {
+        if (record[i] != kNoData)
+            accumulated[i] = accumulated[i] == kNoData ? record[i] : juce::jmin(accumulated[i], record[i]);
+
+        accumulated[i + 1] = juce::jmax(accumulated[i + 1], record[i + 1]);
+    }
+}
+
+//==============================================================================
+// LevelLogger
+
+LevelLogger::LevelLogger()
+    : juce::Thread("LevelLogger")
+{
+}
+
+LevelLogger::~LevelLogger()
+{
+    close();
+}
+
+bool LevelLogger::open(const juce::File& file, int newNumChannels, double sampleRate, double newIntervalMs)
+{
+    close();
+
+    numChannels = juce::jmax(1, newNumChannels);
+    valuesPerRecord = LevelLogFormat::valuesPerRecord(numChannels);
+    intervalMs = juce::jmax(1.0, newIntervalMs);
+    intervalSamples = juce::jmax(1, juce::roundToInt(sampleRate * intervalMs * 0.001));
+
+    peaks.assign(static_cast<size_t>(numChannels), 0.0f);
+    sumSquares.assign(static_cast<size_t>(numChannels), 0.0);
+    samplesInRecord = 0;
+
+    queue.setTotalSize(kQueueCapacity);
+    queue.reset();
+    queueStorage.assign(static_cast<size_t>(kQueueCapacity * valuesPerRecord), 0);
+    queueIndices.assign(static_cast<size_t>(kQueueCapacity), 0);
+    droppedRecords.store(0, std::memory_order_relaxed);
+
+    for (int level = 0; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        pending[static_cast<size_t>(level)].assign(static_cast<size_t>(valuesPerRecord), LevelLogFormat::kNoData);
+        pendingCounts[static_cast<size_t>(level)] = 0;
+    }
+
+    carry.assign(static_cast<size_t>(valuesPerRecord), 0);
+    noDataRecord.assign(static_cast<size_t>(valuesPerRecord), LevelLogFormat::kNoData);
+
+    if (!resumeLog(file))
+        startNewLog(file, juce::Time::currentTimeMillis());
+
+    for (auto& stream : streams)
+    {
+        if (stream == nullptr || stream->failedToOpen())
+        {
+            for (auto& s : streams)
+                s.reset();
+            return false;
+        }
+    }
+
+    recording.store(true, std::memory_order_release);
+    startThread();
+    return true;
+}
+
+void LevelLogger::close()
+{
+    if (!recording.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    // The writer drains the queue before it exits
+    stopThread(2000);
+
+    // Records dropped at the very end still count as logged time
+    if (streams[0] != nullptr)
+        appendNoDataUntil(nextRecordIndex);
+
+    for (auto& stream : streams)
+    {
+        if (stream != nullptr)
+            stream->flush();
+        stream.reset();
+    }
+}
+
+//==============================================================================
+bool LevelLogger::resumeLog(const juce::File& file)
+{
+    const auto baseFile = LevelLogFormat::getLevelFile(file, 0);
+    if (!baseFile.existsAsFile())
+        return false;
+
+    LevelLogFormat::Header header;
+    {
+        juce::FileInputStream input(baseFile);
+        if (!input.openedOk()
+            || input.read(&header, sizeof(header)) != static_cast<int>(sizeof(header))
+            || !LevelLogFormat::isValidHeader(header)
+            || header.numChannels != static_cast<uint32_t>(numChannels)
+            || std::abs(header.intervalMs - intervalMs) > 1.0e-6)
+            return false;
+    }
+
+    const int64_t recordBytes = LevelLogFormat::bytesPerRecord(numChannels);
+    std::array<int64_t, LevelLogFormat::kNumLevels> counts{};
+
+    for (int level = 0; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        const auto levelFile = LevelLogFormat::getLevelFile(file, level);
+        const auto i = static_cast<size_t>(level);
+
+        if (levelFile.existsAsFile() && levelFile.getSize() >= LevelLogFormat::kHeaderSize)
+        {
+            // Continue after the last complete record, dropping a partly written one
+            counts[i] = (levelFile.getSize() - LevelLogFormat::kHeaderSize) / recordBytes;
+            streams[i] = std::make_unique<juce::FileOutputStream>(levelFile);
+            streams[i]->setPosition(LevelLogFormat::kHeaderSize + counts[i] * recordBytes);
+            streams[i]->truncate();
+        }
+        else
+        {
+            levelFile.deleteFile();
+            streams[i] = std::make_unique<juce::FileOutputStream>(levelFile);
+            writeHeader(level, header.startTimeMs);
+        }
+
+        if (streams[i]->failedToOpen())
+            return false;
+    }
+
+    // Rebuild each level's partial record from the tail of the level below
+    for (int level = 1; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        const auto below = static_cast<size_t>(level - 1);
+        const auto i = static_cast<size_t>(level);
+        streams[below]->flush();
+
+        juce::FileInputStream input(LevelLogFormat::getLevelFile(file, level - 1));
+        input.setPosition(LevelLogFormat::kHeaderSize + counts[i] * LevelLogFormat::kLevelFactor * recordBytes);
+
+        for (int64_t index = counts[i] * LevelLogFormat::kLevelFactor; index < counts[below]; ++index)
+        {
+            if (input.read(carry.data(), static_cast<int>(recordBytes)) != static_cast<int>(recordBytes))
+                break;
+
+            LevelLogFormat::merge(pending[i].data(), carry.data(), valuesPerRecord);
+
+            if (++pendingCounts[i] == LevelLogFormat::kLevelFactor)
+            {
+                streams[i]->write(pending[i].data(), static_cast<size_t>(recordBytes));
+                std::fill(pending[i].begin(), pending[i].end(), LevelLogFormat::kNoData);
+                pendingCounts[i] = 0;
+                ++counts[i];
+            }
+        }
+    }
+
+    // Records resume at the current wall-clock time; the writer fills the gap
+    writtenRecords = counts[0];
+    nextRecordIndex = juce::jmax(writtenRecords,
+                                 static_cast<int64_t>((juce::Time::currentTimeMillis() - header.startTimeMs) / intervalMs));
+    return true;
+}
+
+void LevelLogger::startNewLog(const juce::File& file, int64_t startTimeMs)
+{
+    for (int level = 0; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        const auto levelFile = LevelLogFormat::getLevelFile(file, level);
+        levelFile.deleteFile();
+
+        streams[static_cast<size_t>(level)] = std::make_unique<juce::FileOutputStream>(levelFile);
+        writeHeader(level, startTimeMs);
+    }
+
+    writtenRecords = 0;
+    nextRecordIndex = 0;
+}
+
+void LevelLogger::writeHeader(int level, int64_t startTimeMs)
+{
+    auto& stream = streams[static_cast<size_t>(level)];
+    if (stream == nullptr || stream->failedToOpen())
+        return;
+
+    LevelLogFormat::Header header;
+    header.numChannels = static_cast<uint32_t>(numChannels);
+    header.level = static_cast<uint32_t>(level);
+    header.intervalMs = intervalMs;
+    header.startTimeMs = startTimeMs;
+    stream->write(&header, sizeof(header));
+}
+
+//==============================================================================
+// Audio Thread Methods
+
+void LevelLogger::process(const float* const* channels, int numInputChannels, int numSamples)
+{
+    if (!recording.load(std::memory_order_acquire) || channels == nullptr)
+        return;
+
+    const int count = juce::jmin(numInputChannels, numChannels);
+    int offset = 0;
+
+    while (offset < numSamples)
+    {
+        const int length = juce::jmin(numSamples - offset, intervalSamples - samplesInRecord);
+
+        for (int ch = 0; ch < count; ++ch)
+        {
+            const float* samples = channels[ch] + offset;
+            float peak = peaks[static_cast<size_t>(ch)];
+            double sum = 0.0;
+
+            for (int i = 0; i < length; ++i)
+            {
+                peak = juce::jmax(peak, std::abs(samples[i]));
+                sum += static_cast<double>(samples[i]) * samples[i];
+            }
+
+            peaks[static_cast<size_t>(ch)] = peak;
+            sumSquares[static_cast<size_t>(ch)] += sum;
+        }
+
+        offset += length;
+        samplesInRecord += length;
+
+        if (samplesInRecord >= intervalSamples)
+            emitRecord();
+    }
+}
+
+void LevelLogger::processBlock(const juce::AudioBuffer<float>& buffer)
+{
+    process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+void LevelLogger::emitRecord()
+{
+    int start1, size1, start2, size2;
+    queue.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+    {
+        // Writer is behind; the record index gap is logged as no data
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        int16_t* dest = queueStorage.data() + start1 * valuesPerRecord;
+        queueIndices[static_cast<size_t>(start1)] = nextRecordIndex;
+
+        if (const auto* loudness = loudnessSource.load(std::memory_order_acquire))
+        {
+            dest[0] = dest[1] = LevelLogFormat::encode(loudness->getMomentaryLoudness());
+            dest[2] = dest[3] = LevelLogFormat::encode(loudness->getShortTermLoudness());
+        }
+        else
+        {
+            std::fill(dest, dest + LevelLogFormat::kLoudnessValues, LevelLogFormat::kNoData);
+        }
+
+        const double invLength = 1.0 / juce::jmax(1, samplesInRecord);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto i = static_cast<size_t>(ch);
+            int16_t* values = dest + LevelLogFormat::kLoudnessValues + ch * LevelLogFormat::kValuesPerChannel;
+
+            const float peakDB = peaks[i] > 0.0f ? 20.0f * std::log10(peaks[i]) : LevelLogFormat::kSilenceDB;
+            const double meanSquare = sumSquares[i] * invLength;
+            const float rmsDB = meanSquare > 0.0 ? static_cast<float>(10.0 * std::log10(meanSquare)) : LevelLogFormat::kSilenceDB;
+
+            values[0] = values[1] = LevelLogFormat::encode(peakDB);
+            values[2] = values[3] = LevelLogFormat::encode(rmsDB);
+        }
+
+        queue.finishedWrite(1);
+    }
+
+    ++nextRecordIndex;
+    std::fill(peaks.begin(), peaks.end(), 0.0f);
+    std::fill(sumSquares.begin(), sumSquares.end(), 0.0);
+    samplesInRecord = 0;
+}
+
+//==============================================================================
+// Writer Thread Methods
+
+void LevelLogger::run()
+{
+    const int waitMs = juce::jmax(10, juce::roundToInt(intervalMs * 4.0));
+
+    while (!threadShouldExit())
+    {
+        drainQueue();
+        wait(waitMs);
+    }
+
+    drainQueue();
+}
+
+void LevelLogger::drainQueue()
+{
+    int start1, size1, start2, size2;
+    queue.prepareToRead(queue.getNumReady(), start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return;
+
+    auto appendRange = [this](int start, int size)
+    {
+        for (int slot = start; slot < start + size; ++slot)
+        {
+            appendNoDataUntil(queueIndices[static_cast<size_t>(slot)]);
+            appendRecord(queueStorage.data() + slot * valuesPerRecord);
+        }
+    };
+
+    appendRange(start1, size1);
+    appendRange(start2, size2);
+    queue.finishedRead(size1 + size2);
+
+    for (auto& stream : streams)
+        stream->flush();
+}
+
+void LevelLogger::appendRecord(const int16_t* record)
+{
+    streams[0]->write(record, static_cast<size_t>(valuesPerRecord) * sizeof(int16_t));
+    ++writtenRecords;
+    mergeIntoLevel(1, record);
+}
+
+void LevelLogger::appendNoDataUntil(int64_t recordIndex)
+{
+    while (writtenRecords < recordIndex)
+        appendRecord(noDataRecord.data());
+}
+
+void LevelLogger::mergeIntoLevel(int level, const int16_t* record)
+{
+    for (; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        const auto i = static_cast<size_t>(level);
+        LevelLogFormat::merge(pending[i].data(), record, valuesPerRecord);
+
+        if (++pendingCounts[i] < LevelLogFormat::kLevelFactor)
+            return;
+
+        // Level record complete: write it and carry it up
+        streams[i]->write(pending[i].data(), static_cast<size_t>(valuesPerRecord) * sizeof(int16_t));
+        carry.swap(pending[i]);
+        std::fill(pending[i].begin(), pending[i].end(), LevelLogFormat::kNoData);
+        pendingCounts[i] = 0;
+        record = carry.data();
+    }
+}
+
+//==============================================================================
+// LevelLogReader
+
+bool LevelLogReader::open(const juce::File& file)
+{
+    LevelLogFormat::Header header;
+    juce::FileInputStream input(LevelLogFormat::getLevelFile(file, 0));
+
+    if (!input.openedOk()
+        || input.read(&header, sizeof(header)) != static_cast<int>(sizeof(header))
+        || !LevelLogFormat::isValidHeader(header))
+        return false;
+
+    logFile = file;
+    numChannels = static_cast<int>(header.numChannels);
+    valuesPerRecord = LevelLogFormat::valuesPerRecord(numChannels);
+    intervalMs = header.intervalMs;
+    startTimeMs = header.startTimeMs;
+
+    for (auto& mapping : mappings)
+        mapping.reset();
+    mappedSizes.fill(0);
+
+    refreshMappings();
+    return true;
+}
+
+double LevelLogReader::getLengthSeconds()
+{
+    refreshMappings();
+    return static_cast<double>(getNumRecords(0)) * intervalMs * 0.001;
+}
+
+void LevelLogReader::refreshMappings()
+{
+    for (int level = 0; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        const auto i = static_cast<size_t>(level);
+        const auto levelFile = LevelLogFormat::getLevelFile(logFile, level);
+        const int64_t size = levelFile.existsAsFile() ? levelFile.getSize() : 0;
+
+        // Remap only when the writer has appended since the last query
+        if (size == mappedSizes[i])
+            continue;
+
+        mappings[i] = std::make_unique<juce::MemoryMappedFile>(levelFile, juce::MemoryMappedFile::readOnly);
+        if (mappings[i]->getData() == nullptr)
+            mappings[i].reset();
+
+        mappedSizes[i] = size;
+    }
+}
+
+int64_t LevelLogReader::getNumRecords(int level) const
+{
+    const auto& mapping = mappings[static_cast<size_t>(level)];
+    if (mapping == nullptr || mapping->getSize() < static_cast<size_t>(LevelLogFormat::kHeaderSize))
+        return 0;
+
+    return static_cast<int64_t>(mapping->getSize() - LevelLogFormat::kHeaderSize)
+           / LevelLogFormat::bytesPerRecord(numChannels);
+}
+
+const int16_t* LevelLogReader::getRecord(int level, int64_t index) const
+{
+    const auto* data = static_cast<const char*>(mappings[static_cast<size_t>(level)]->getData());
+    return reinterpret_cast<const int16_t*>(data + LevelLogFormat::kHeaderSize
+                                            + index * LevelLogFormat::bytesPerRecord(numChannels));
+}
+
+int LevelLogReader::query(LevelLogField field, int channel, double startSeconds, double endSeconds,
+                          int numBuckets, LevelLogRange* dest)
+{
+    if (dest == nullptr || numBuckets <= 0 || valuesPerRecord == 0 || endSeconds <= startSeconds)
+        return -1;
+
+    int valueIndex = 0;
+    switch (field)
+    {
+        case LevelLogField::Loudness:           valueIndex = 0; break;
+        case LevelLogField::ShortTermLoudness:  valueIndex = 2; break;
+        case LevelLogField::Peak:
+        case LevelLogField::RMS:
+            if (channel < 0 || channel >= numChannels)
+                return -1;
+            valueIndex = LevelLogFormat::kLoudnessValues + channel * LevelLogFormat::kValuesPerChannel
+                       + (field == LevelLogField::RMS ? 2 : 0);
+            break;
+    }
+
+    refreshMappings();
+
+    const double bucketSeconds = (endSeconds - startSeconds) / numBuckets;
+    std::array<double, LevelLogFormat::kNumLevels> recordSeconds{};
+    std::array<int64_t, LevelLogFormat::kNumLevels> numRecords{};
+
+    for (int level = 0; level < LevelLogFormat::kNumLevels; ++level)
+    {
+        recordSeconds[static_cast<size_t>(level)] = intervalMs * 0.001 * std::pow(double(LevelLogFormat::kLevelFactor), level);
+        numRecords[static_cast<size_t>(level)] = getNumRecords(level);
+    }
+
+    // Coarsest level whose records are no longer than a bucket
+    int topLevel = 0;
+    while (topLevel + 1 < LevelLogFormat::kNumLevels
+           && recordSeconds[static_cast<size_t>(topLevel + 1)] <= bucketSeconds
+           && numRecords[static_cast<size_t>(topLevel + 1)] > 0)
+        ++topLevel;
+
+    for (int bucket = 0; bucket < numBuckets; ++bucket)
+    {
+        const double bucketEnd = startSeconds + (bucket + 1) * bucketSeconds;
+        double from = startSeconds + bucket * bucketSeconds;
+        int16_t minValue = LevelLogFormat::kNoData;
+        int16_t maxValue = LevelLogFormat::kNoData;
+
+        // Coarse records first; the recent tail not yet merged upwards comes from finer levels
+        for (int level = topLevel; level >= 0 && from < bucketEnd; --level)
+        {
+            const auto i = static_cast<size_t>(level);
+            const double seconds = recordSeconds[i];
+
+            if (numRecords[i] == 0 || from >= numRecords[i] * seconds)
+                continue;
+
+            const int64_t first = juce::jmax(int64_t(0), static_cast<int64_t>(std::floor(from / seconds)));
+            const int64_t last = juce::jmin(numRecords[i],
+                                            juce::jmax(first + 1, static_cast<int64_t>(std::ceil(bucketEnd / seconds))));
+
+            for (int64_t index = first; index < last; ++index)
+            {
+                const int16_t* record = getRecord(level, index);
+                if (record[valueIndex] != LevelLogFormat::kNoData)
+                    minValue = minValue == LevelLogFormat::kNoData ? record[valueIndex] : juce::jmin(minValue, record[valueIndex]);
+                maxValue = juce::jmax(maxValue, record[valueIndex + 1]);
+            }
+
+            from = last * seconds;
+        }
+
+        dest[bucket] = minValue == LevelLogFormat::kNoData
+                           ? LevelLogRange{}
+                           : LevelLogRange{ LevelLogFormat::decode(minValue), LevelLogFormat::decode(maxValue), true };
+    }
+
+    return topLevel;
+}
+
+} // namespace shmui
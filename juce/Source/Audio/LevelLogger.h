@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    LevelLogger.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Long-term level logging: per-channel peak and RMS plus programme
+    loudness, stored as a compact min/max pyramid on disk.
+
+    Thread-safe design: the audio thread measures and queues fixed-size
+    records lock-free; a background thread appends them to the log files.
+    Logs are read with LevelLogReader, also while they are being written.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LoudnessAnalyzer.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Value logged by LevelLogger.
+ */
+enum class LevelLogField
+{
+    Peak,               ///< Per-channel sample peak (dBFS)
+    RMS,                ///< Per-channel RMS (dBFS)
+    Loudness,           ///< Momentary loudness (LUFS), channel ignored
+    ShortTermLoudness   ///< Short-term loudness (LUFS), channel ignored
+};
+
+/**
+ * @brief Minimum and maximum of a field over a time range.
+ */
+struct LevelLogRange
+{
+    float minDB = 0.0f;
+    float maxDB = 0.0f;
+    bool hasData = false;   ///< False where nothing was logged (e.g. logger not running)
+};
+
+//==============================================================================
+/**
+ * @brief On-disk layout shared by LevelLogger and LevelLogReader.
+ *
+ * A log is one append-only file per pyramid level: the base file holds
+ * one record per interval (100ms by default), and "<file>.1", "<file>.2"
+ * ... hold records covering kLevelFactor times the previous level. Each
+ * file starts with a 64-byte header; records follow back to back, so
+ * record i of any level sits at a fixed offset.
+ *
+ * A record is a run of int16 values in hundredths of a dB (host byte
+ * order): momentary loudness min/max, short-term loudness min/max, then
+ * peak min/max and RMS min/max for each channel. 24 hours of stereo at
+ * 100ms take about 21 MB, plus a fifteenth for the upper levels.
+ */
+struct LevelLogFormat
+{
+    static constexpr int kNumLevels = 5;              ///< 100ms, 1.6s, 25.6s, 6.8min, 1.8h
+    static constexpr int kLevelFactor = 16;           ///< Records merged per level step
+    static constexpr int kHeaderSize = 64;
+    static constexpr int kValuesPerChannel = 4;       ///< Peak min/max, RMS min/max
+    static constexpr int kLoudnessValues = 4;         ///< Momentary min/max, short-term min/max
+    static constexpr int16_t kNoData = -32768;
+    static constexpr float kSilenceDB = -200.0f;      ///< Logged for digital silence
+
+    /** File header (native layout, padded to kHeaderSize). */
+    struct Header
+    {
+        char magic[8] = { 'S', 'H', 'M', 'L', 'V', 'L', '0', '1' };
+        uint32_t numChannels = 0;
+        uint32_t level = 0;
+        uint32_t levelFactor = kLevelFactor;
+        uint32_t reserved = 0;
+        double intervalMs = 0.0;                      ///< Level 0 record interval
+        int64_t startTimeMs = 0;                      ///< Wall-clock time of record 0 (ms since epoch)
+        uint8_t padding[24] = {};
+    };
+
+    static int valuesPerRecord(int numChannels) { return kLoudnessValues + kValuesPerChannel * numChannels; }
+    static int bytesPerRecord(int numChannels) { return valuesPerRecord(numChannels) * static_cast<int>(sizeof(int16_t)); }
+    static juce::File getLevelFile(const juce::File& file, int level);
+    static bool isValidHeader(const Header& header);
+
+    static int16_t encode(float dB);
+    static float decode(int16_t value) { return value * 0.01f; }
+
+    /** Merge a record into an accumulated one (min of mins, max of maxes, ignoring kNoData). */
+    static void merge(int16_t* accumulated, const int16_t* record, int numValues);
+};
+
+static_assert(sizeof(LevelLogFormat::Header) == LevelLogFormat::kHeaderSize, "Level log header must be 64 bytes");
+
+//==============================================================================
+/**
+ * @brief Background level logger.
+ *
+ * Call process() from the audio thread with every block. Each interval
+ * the logger turns the block peaks and energy of every channel (and the
+ * loudness of an optional LoudnessAnalyzer) into one compact record and
+ * queues it lock-free; a background thread appends it to the base file
+ * and merges it into the coarser pyramid levels, so hours of history
+ * cost only a few bytes per interval and the audio thread never touches
+ * the disk.
+ *
+ * Opening an existing compatible log continues it: the time it was not
+ * running is filled with no-data records so record times stay
+ * startTime + index * interval.
+ */
+class LevelLogger : private juce::Thread
+{
+public:
+    //==============================================================================
+    /** Default record interval (matches the loudness update rate). */
+    static constexpr double kDefaultIntervalMs = 100.0;
+
+    /** Records the audio thread can queue ahead of the writer. */
+    static constexpr int kQueueCapacity = 512;
+
+    //==============================================================================
+    LevelLogger();
+    ~LevelLogger() override;
+
+    /**
+     * @brief Start logging to a file.
+     *
+     * Allocates and starts the writer thread; call while process() is not
+     * running (e.g. from prepareToPlay()). Continues the log if the file
+     * holds one with the same channel count and interval, otherwise
+     * replaces it.
+     *
+     * @return False if the file could not be opened
+     */
+    bool open(const juce::File& file, int numChannels, double sampleRate,
+              double intervalMs = kDefaultIntervalMs);
+
+    /**
+     * @brief Flush and close the log (stops the writer thread).
+     */
+    void close();
+
+    /**
+     * @brief Check if a log is open.
+     */
+    bool isOpen() const { return recording.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Log loudness from an analyzer (not owned, may be nullptr).
+     *
+     * Its momentary and short-term readings are sampled once per record.
+     */
+    void setLoudnessSource(const LoudnessAnalyzer* analyzer) { loudnessSource.store(analyzer); }
+
+    /**
+     * @brief Records lost because the writer fell behind (logged as no data).
+     */
+    uint64_t getDroppedRecordCount() const { return droppedRecords.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Audio Thread Methods
+
+    /**
+     * @brief Measure a block (extra channels are ignored).
+     */
+    void process(const float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * @brief Measure an AudioBuffer.
+     */
+    void processBlock(const juce::AudioBuffer<float>& buffer);
+
+private:
+    //==============================================================================
+    void run() override;
+    void emitRecord();
+    void drainQueue();
+    void appendRecord(const int16_t* record);
+    void appendNoDataUntil(int64_t recordIndex);
+    void mergeIntoLevel(int level, const int16_t* record);
+    bool resumeLog(const juce::File& file);
+    void startNewLog(const juce::File& file, int64_t startTimeMs);
+    void writeHeader(int level, int64_t startTimeMs);
+
+    //==============================================================================
+    int numChannels = 0;
+    int valuesPerRecord = 0;
+    double intervalMs = kDefaultIntervalMs;
+    int intervalSamples = 0;
+    std::atomic<bool> recording{false};
+    std::atomic<const LoudnessAnalyzer*> loudnessSource{nullptr};
+
+    // Audio thread accumulation for the current record
+    std::vector<float> peaks;
+    std::vector<double> sumSquares;
+    int samplesInRecord = 0;
+
+    // Record queue (audio thread -> writer thread)
+    juce::AbstractFifo queue{kQueueCapacity};
+    std::vector<int16_t> queueStorage;
+    std::vector<int64_t> queueIndices;                                      // Record index of each queued record
+    int64_t nextRecordIndex = 0;                                            // Audio thread
+    std::atomic<uint64_t> droppedRecords{0};
+
+    // Writer state (writer thread, or message thread while stopped)
+    std::array<std::unique_ptr<juce::FileOutputStream>, LevelLogFormat::kNumLevels> streams;
+    std::array<std::vector<int16_t>, LevelLogFormat::kNumLevels> pending;   // Partial upper-level records
+    std::array<int, LevelLogFormat::kNumLevels> pendingCounts{};
+    std::vector<int16_t> carry;                                             // Completed record moving up a level
+    std::vector<int16_t> noDataRecord;
+    int64_t writtenRecords = 0;                                             // Level 0 records in the file
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelLogger)
+};
+
+//==============================================================================
+/**
+ * @brief Reads a level log written by LevelLogger.
+ *
+ * Level files are memory-mapped, so a query touches only the records it
+ * needs: query() picks the coarsest pyramid level that still gives every
+ * output bucket at least one record, which bounds a 24-hour graph to a
+ * few thousand records whatever the log length. Works on a log that is
+ * still being written; new records become visible at the next query.
+ */
+class LevelLogReader
+{
+public:
+    //==============================================================================
+    LevelLogReader() = default;
+    ~LevelLogReader() = default;
+
+    /**
+     * @brief Open a log.
+     *
+     * @return False if the file is not a level log
+     */
+    bool open(const juce::File& file);
+
+    /**
+     * @brief Get number of logged channels.
+     */
+    int getNumChannels() const { return numChannels; }
+
+    /**
+     * @brief Get base record interval in seconds.
+     */
+    double getIntervalSeconds() const { return intervalMs * 0.001; }
+
+    /**
+     * @brief Wall-clock time of the first record.
+     */
+    juce::Time getStartTime() const { return juce::Time(startTimeMs); }
+
+    /**
+     * @brief Logged duration in seconds.
+     */
+    double getLengthSeconds();
+
+    /**
+     * @brief Min/max of a field over equal time buckets.
+     *
+     * @param field Value to read
+     * @param channel Channel for Peak / RMS
+     * @param startSeconds Range start, relative to getStartTime()
+     * @param endSeconds Range end
+     * @param numBuckets Number of buckets (e.g. graph width in pixels)
+     * @param dest Receives numBuckets ranges
+     * @return Pyramid level used, or -1 if nothing could be read
+     */
+    int query(LevelLogField field, int channel, double startSeconds, double endSeconds,
+              int numBuckets, LevelLogRange* dest);
+
+private:
+    //==============================================================================
+    void refreshMappings();
+    int64_t getNumRecords(int level) const;
+    const int16_t* getRecord(int level, int64_t index) const;
+
+    //==============================================================================
+    juce::File logFile;
+    int numChannels = 0;
+    int valuesPerRecord = 0;
+    double intervalMs = 0.0;
+    int64_t startTimeMs = 0;
+
+    std::array<std::unique_ptr<juce::MemoryMappedFile>, LevelLogFormat::kNumLevels> mappings;
+    std::array<int64_t, LevelLogFormat::kNumLevels> mappedSizes{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelLogReader)
+};
+
+} // namespace shmui
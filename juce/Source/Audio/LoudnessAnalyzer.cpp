@@ -0,0 +1,359 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyzer.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the EBU R128 / BS.1770 loudness engine.
+
+  ==============================================================================
+*/
+
+#include "LoudnessAnalyzer.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+
+LoudnessAnalyzer::LoudnessAnalyzer()
+{
+    channelWeights.fill(1.0f);
+}
+
+void LoudnessAnalyzer::prepare(double sampleRate, int newNumChannels)
+{
+    numChannels = juce::jlimit(0, kMaxChannels, newNumChannels);
+    samplesPerStep = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    // K-weighting filters for this sample rate (BS.1770-4 stage 1 and 2,
+    // re-derived from the analogue prototypes so any rate is exact)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    momentaryHistogram.assign(kHistogramBins, 0);
+    shortTermHistogram.assign(kHistogramBins, 0);
+
+    momentaryEnergies.assign(kHistogramBins, 0.0);
+    shortTermEnergies.assign(kHistogramBins, 0.0);
+
+    resetRequested.store(false, std::memory_order_relaxed);
+    clearMeasurements();
+
+    shelfZ1.fill(0.0);
+    shelfZ2.fill(0.0);
+    highPassZ1.fill(0.0);
+    highPassZ2.fill(0.0);
+    steps.fill(0.0);
+    stepIndex = 0;
+    stepsFilled = 0;
+    stepEnergy = 0.0;
+    stepSamples = 0;
+    momentary.store(kSilence, std::memory_order_relaxed);
+    shortTerm.store(kSilence, std::memory_order_relaxed);
+}
+
+void LoudnessAnalyzer::setChannelWeight(int channel, float weight)
+{
+    if (channel >= 0 && channel < kMaxChannels)
+        channelWeights[static_cast<size_t>(channel)] = juce::jmax(0.0f, weight);
+}
+
+//==============================================================================
+// Audio Thread Methods
+
+void LoudnessAnalyzer::process(const float* const* channels, int numInputChannels, int numSamples)
+{
+    if (samplesPerStep == 0)
+        return;
+
+    if (resetRequested.exchange(false, std::memory_order_acquire))
+        clearMeasurements();
+
+    const int channelCount = juce::jmin(numInputChannels, numChannels);
+    int offset = 0;
+
+    while (offset < numSamples)
+    {
+        // Process up to the next 100 ms boundary, one channel at a time
+        const int chunk = juce::jmin(numSamples - offset, samplesPerStep - stepSamples);
+
+        for (int ch = 0; ch < channelCount; ++ch)
+        {
+            const float weight = channelWeights[static_cast<size_t>(ch)];
+            if (weight == 0.0f || channels[ch] == nullptr)
+                continue;
+
+            const float* const input = channels[ch] + offset;
+            double s1 = shelfZ1[static_cast<size_t>(ch)], s2 = shelfZ2[static_cast<size_t>(ch)];
+            double h1 = highPassZ1[static_cast<size_t>(ch)], h2 = highPassZ2[static_cast<size_t>(ch)];
+            double sum = 0.0;
+
+            for (int i = 0; i < chunk; ++i)
+            {
+                const double x = input[i];
+
+                const double y = shelf.b0 * x + s1;
+                s1 = shelf.b1 * x - shelf.a1 * y + s2;
+                s2 = shelf.b2 * x - shelf.a2 * y;
+
+                const double z = highPass.b0 * y + h1;
+                h1 = highPass.b1 * y - highPass.a1 * z + h2;
+                h2 = highPass.b2 * y - highPass.a2 * z;
+
+                sum += z * z;
+            }
+
+            shelfZ1[static_cast<size_t>(ch)] = s1;
+            shelfZ2[static_cast<size_t>(ch)] = s2;
+            highPassZ1[static_cast<size_t>(ch)] = h1;
+            highPassZ2[static_cast<size_t>(ch)] = h2;
+            stepEnergy += static_cast<double>(weight) * sum;
+        }
+
+        stepSamples += chunk;
+        offset += chunk;
+
+        if (stepSamples >= samplesPerStep)
+            finishStep();
+    }
+}
+
+void LoudnessAnalyzer::processBlock(const juce::AudioBuffer<float>& buffer)
+{
+    process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+//==============================================================================
+// UI Thread Methods
+
+void LoudnessAnalyzer::resetIntegration()
+{
+    resetRequested.store(true, std::memory_order_release);
+}
+
+//==============================================================================
+// Static Utility Functions
+
+float LoudnessAnalyzer::energyToLoudness(double energy)
+{
+    if (energy <= 0.0)
+        return kSilence;
+
+    return static_cast<float>(-0.691 + 10.0 * std::log10(energy));
+}
+
+double LoudnessAnalyzer::loudnessToEnergy(float loudness)
+{
+    return std::pow(10.0, (static_cast<double>(loudness) + 0.691) / 10.0);
+}
+
+//==============================================================================
+// Private Methods
+
+void LoudnessAnalyzer::finishStep()
+{
+    steps[static_cast<size_t>(stepIndex)] = stepEnergy / static_cast<double>(samplesPerStep);
+    stepIndex = (stepIndex + 1) % kShortTermSteps;
+    stepsFilled = juce::jmin(stepsFilled + 1, kShortTermSteps);
+    stepEnergy = 0.0;
+    stepSamples = 0;
+
+    stepsSinceReset.fetch_add(1, std::memory_order_relaxed);
+
+    // Momentary: last 4 steps (400 ms, 75% overlap)
+    if (stepsFilled >= kMomentarySteps)
+    {
+        double energy = 0.0;
+        for (int i = 1; i <= kMomentarySteps; ++i)
+            energy += steps[static_cast<size_t>((stepIndex - i + kShortTermSteps) % kShortTermSteps)];
+
+        energy /= kMomentarySteps;
+        const float loudness = energyToLoudness(energy);
+        momentary.store(loudness, std::memory_order_relaxed);
+
+        if (loudness >= kAbsoluteGate)
+        {
+            const auto bin = static_cast<size_t>(histogramBin(loudness));
+            ++momentaryHistogram[bin];
+            momentaryEnergies[bin] += energy;
+            updateIntegrated();
+        }
+
+        if (loudness > maxMomentary.load(std::memory_order_relaxed))
+            maxMomentary.store(loudness, std::memory_order_relaxed);
+    }
+
+    // Short-term: all 30 steps (3 s)
+    if (stepsFilled >= kShortTermSteps)
+    {
+        double energy = 0.0;
+        for (const double step : steps)
+            energy += step;
+
+        energy /= kShortTermSteps;
+        const float loudness = energyToLoudness(energy);
+        shortTerm.store(loudness, std::memory_order_relaxed);
+
+        if (loudness >= kAbsoluteGate)
+        {
+            const auto bin = static_cast<size_t>(histogramBin(loudness));
+            ++shortTermHistogram[bin];
+            shortTermEnergies[bin] += energy;
+            updateLoudnessRange();
+        }
+
+        if (loudness > maxShortTerm.load(std::memory_order_relaxed))
+            maxShortTerm.store(loudness, std::memory_order_relaxed);
+    }
+}
+
+void LoudnessAnalyzer::clearMeasurements()
+{
+    std::fill(momentaryHistogram.begin(), momentaryHistogram.end(), 0u);
+    std::fill(shortTermHistogram.begin(), shortTermHistogram.end(), 0u);
+    std::fill(momentaryEnergies.begin(), momentaryEnergies.end(), 0.0);
+    std::fill(shortTermEnergies.begin(), shortTermEnergies.end(), 0.0);
+
+    integrated.store(kSilence, std::memory_order_relaxed);
+    loudnessRange.store(0.0f, std::memory_order_relaxed);
+    maxMomentary.store(kSilence, std::memory_order_relaxed);
+    maxShortTerm.store(kSilence, std::memory_order_relaxed);
+    stepsSinceReset.store(0, std::memory_order_relaxed);
+}
+
+void LoudnessAnalyzer::updateIntegrated()
+{
+    // Absolute-gated mean (everything in the histogram is above -70 LUFS)
+    uint64_t count = 0;
+    double energy = 0.0;
+
+    for (int i = 0; i < kHistogramBins; ++i)
+    {
+        const uint32_t n = momentaryHistogram[static_cast<size_t>(i)];
+        count += n;
+        energy += momentaryEnergies[static_cast<size_t>(i)];
+    }
+
+    if (count == 0)
+    {
+        integrated.store(kSilence, std::memory_order_relaxed);
+        return;
+    }
+
+    // Relative gate: -10 LU below the absolute-gated mean
+    const float relativeGate = energyToLoudness(energy / static_cast<double>(count)) - 10.0f;
+    const int firstBin = firstBinAbove(relativeGate);
+
+    count = 0;
+    energy = 0.0;
+
+    for (int i = firstBin; i < kHistogramBins; ++i)
+    {
+        const uint32_t n = momentaryHistogram[static_cast<size_t>(i)];
+        count += n;
+        energy += momentaryEnergies[static_cast<size_t>(i)];
+    }
+
+    integrated.store(count > 0 ? energyToLoudness(energy / static_cast<double>(count)) : kSilence,
+                     std::memory_order_relaxed);
+}
+
+void LoudnessAnalyzer::updateLoudnessRange()
+{
+    uint64_t count = 0;
+    double energy = 0.0;
+
+    for (int i = 0; i < kHistogramBins; ++i)
+    {
+        const uint32_t n = shortTermHistogram[static_cast<size_t>(i)];
+        count += n;
+        energy += shortTermEnergies[static_cast<size_t>(i)];
+    }
+
+    if (count == 0)
+        return;
+
+    // Relative gate: -20 LU below the absolute-gated mean
+    const float relativeGate = energyToLoudness(energy / static_cast<double>(count)) - 20.0f;
+    const int firstBin = firstBinAbove(relativeGate);
+
+    uint64_t gatedCount = 0;
+    for (int i = firstBin; i < kHistogramBins; ++i)
+        gatedCount += shortTermHistogram[static_cast<size_t>(i)];
+
+    if (gatedCount == 0)
+    {
+        loudnessRange.store(0.0f, std::memory_order_relaxed);
+        return;
+    }
+
+    // 10th and 95th percentiles by walking the cumulative counts
+    const uint64_t lowRank = static_cast<uint64_t>(std::llround(static_cast<double>(gatedCount - 1) * 0.10));
+    const uint64_t highRank = static_cast<uint64_t>(std::llround(static_cast<double>(gatedCount - 1) * 0.95));
+
+    int lowBin = -1;
+    int highBin = -1;
+    uint64_t cumulative = 0;
+
+    for (int i = firstBin; i < kHistogramBins && highBin < 0; ++i)
+    {
+        cumulative += shortTermHistogram[static_cast<size_t>(i)];
+
+        if (lowBin < 0 && cumulative > lowRank)
+            lowBin = i;
+        if (cumulative > highRank)
+            highBin = i;
+    }
+
+    loudnessRange.store(histogramBinCentre(highBin) - histogramBinCentre(lowBin),
+                        std::memory_order_relaxed);
+}
+
+int LoudnessAnalyzer::histogramBin(float loudness)
+{
+    const int bin = static_cast<int>(std::floor((loudness - kHistogramMin) / kHistogramStep));
+    return juce::jlimit(0, kHistogramBins - 1, bin);
+}
+
+int LoudnessAnalyzer::firstBinAbove(float loudness)
+{
+    const int bin = histogramBin(loudness);
+    return histogramBinCentre(bin) >= loudness ? bin : bin + 1;
+}
+
+float LoudnessAnalyzer::histogramBinCentre(int bin)
+{
+    return kHistogramMin + (static_cast<float>(bin) + 0.5f) * kHistogramStep;
+}
+
+} // namespace shmui
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyzer.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    EBU R128 / ITU-R BS.1770 loudness engine: K-weighting, momentary,
+    short-term and gated integrated loudness, and loudness range (LRA).
+
+    Thread-safe design: Audio thread writes, UI thread reads via atomic operations.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace shmui
+{
+
+/**
+ * @brief K-weighted loudness meter engine (EBU R128, ITU-R BS.1770-4).
+ *
+ * The audio is K-weighted per channel, squared and summed with channel
+ * weights into 100 ms steps. From those steps it derives:
+ * - Momentary loudness: 400 ms window, updated every 100 ms
+ * - Short-term loudness: 3 s window, updated every 100 ms
+ * - Integrated loudness: momentary blocks gated at -70 LUFS absolute and
+ *   -10 LU relative
+ * - Loudness range (LRA, EBU Tech 3342): 10th to 95th percentile of
+ *   short-term values gated at -70 LUFS absolute and -20 LU relative
+ *
+ * Gating works on 0.1 LU histograms (block count and summed energy per
+ * bin) instead of stored blocks, so memory is fixed no matter how long
+ * the programme runs. Only blocks in the bin that straddles a relative
+ * gate are classified to within 0.1 LU.
+ *
+ * Thread Safety:
+ * - prepare() on the message thread, before playback
+ * - Audio thread calls process() / processBlock(); no allocation or locks
+ * - UI thread calls get*() methods and resetIntegration()
+ */
+class LoudnessAnalyzer
+{
+public:
+    //==============================================================================
+    /** Maximum number of channels. */
+    static constexpr int kMaxChannels = 64;
+
+    /** Reading returned before a window has filled, or for silence. */
+    static constexpr float kSilence = -std::numeric_limits<float>::infinity();
+
+    /** Absolute gate in LUFS. */
+    static constexpr float kAbsoluteGate = -70.0f;
+
+    /** Histogram range and resolution (LUFS). */
+    static constexpr float kHistogramMin = -70.0f;
+    static constexpr float kHistogramMax = 10.0f;
+    static constexpr float kHistogramStep = 0.1f;
+    static constexpr int kHistogramBins = 800;
+
+    /** Window lengths in 100 ms steps. */
+    static constexpr int kMomentarySteps = 4;
+    static constexpr int kShortTermSteps = 30;
+
+    //==============================================================================
+    LoudnessAnalyzer();
+    ~LoudnessAnalyzer() = default;
+
+    /**
+     * @brief Set up filters and buffers for a sample rate and channel count.
+     *
+     * Allocates; call from prepareToPlay(). Clears all measurements.
+     */
+    void prepare(double sampleRate, int numChannels);
+
+    /**
+     * @brief Set a channel's weight in the sum.
+     *
+     * BS.1770 uses 1.0 for front channels, 1.41 for surrounds and 0 for
+     * LFE. All channels default to 1.0.
+     */
+    void setChannelWeight(int channel, float weight);
+
+    //==============================================================================
+    // Audio Thread Methods
+
+    /**
+     * @brief Measure a block of audio.
+     *
+     * @param channels One pointer per channel
+     * @param numChannels Channel count (extra channels beyond prepare() are ignored)
+     * @param numSamples Samples per channel
+     */
+    void process(const float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * @brief Measure a JUCE audio buffer.
+     */
+    void processBlock(const juce::AudioBuffer<float>& buffer);
+
+    //==============================================================================
+    // UI Thread Methods
+
+    /** Momentary loudness in LUFS. */
+    float getMomentaryLoudness() const { return momentary.load(std::memory_order_relaxed); }
+
+    /** Short-term loudness in LUFS. */
+    float getShortTermLoudness() const { return shortTerm.load(std::memory_order_relaxed); }
+
+    /** Gated integrated loudness in LUFS since the last reset. */
+    float getIntegratedLoudness() const { return integrated.load(std::memory_order_relaxed); }
+
+    /** Loudness range in LU since the last reset. */
+    float getLoudnessRange() const { return loudnessRange.load(std::memory_order_relaxed); }
+
+    /** Highest momentary loudness since the last reset. */
+    float getMaxMomentaryLoudness() const { return maxMomentary.load(std::memory_order_relaxed); }
+
+    /** Highest short-term loudness since the last reset. */
+    float getMaxShortTermLoudness() const { return maxShortTerm.load(std::memory_order_relaxed); }
+
+    /** Measured time since the last reset, in seconds. */
+    double getIntegrationTime() const
+    {
+        return static_cast<double>(stepsSinceReset.load(std::memory_order_relaxed)) * 0.1;
+    }
+
+    /**
+     * @brief Restart integrated loudness, LRA and maxima.
+     *
+     * Takes effect at the start of the next processed block, on the audio
+     * thread, so it is safe to call during playback.
+     */
+    void resetIntegration();
+
+    //==============================================================================
+    // Static Utility Functions
+
+    /** Convert a mean square (weighted) energy to LUFS. */
+    static float energyToLoudness(double energy);
+
+    /** Convert LUFS to a mean square (weighted) energy. */
+    static double loudnessToEnergy(float loudness);
+
+private:
+    //==============================================================================
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    void finishStep();
+    void clearMeasurements();
+    void updateIntegrated();
+    void updateLoudnessRange();
+
+    static int histogramBin(float loudness);
+    static int firstBinAbove(float loudness);
+    static float histogramBinCentre(int bin);
+
+    //==============================================================================
+    int numChannels = 0;
+    int samplesPerStep = 0;
+
+    // K-weighting: high shelf then RLB high pass
+    Biquad shelf, highPass;
+
+    // Per-channel filter state and weights (transposed direct form II)
+    std::array<double, kMaxChannels> shelfZ1{}, shelfZ2{};
+    std::array<double, kMaxChannels> highPassZ1{}, highPassZ2{};
+    std::array<float, kMaxChannels> channelWeights{};
+
+    // Current 100 ms step
+    double stepEnergy = 0.0;
+    int stepSamples = 0;
+
+    // Last kShortTermSteps step energies
+    std::array<double, kShortTermSteps> steps{};
+    int stepIndex = 0;
+    int stepsFilled = 0;
+
+    // Gating histograms (fixed size, audio thread only)
+    std::vector<uint32_t> momentaryHistogram;
+    std::vector<uint32_t> shortTermHistogram;
+    std::vector<double> momentaryEnergies;
+    std::vector<double> shortTermEnergies;
+
+    // Published readings
+    std::atomic<float> momentary{kSilence};
+    std::atomic<float> shortTerm{kSilence};
+    std::atomic<float> integrated{kSilence};
+    std::atomic<float> loudnessRange{0.0f};
+    std::atomic<float> maxMomentary{kSilence};
+    std::atomic<float> maxShortTerm{kSilence};
+    std::atomic<uint64_t> stepsSinceReset{0};
+
+    std::atomic<bool> resetRequested{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessAnalyzer)
+};
+
+} // namespace shmui
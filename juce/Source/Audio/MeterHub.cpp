@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    MeterHub.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the central meter store.
+
+  ==============================================================================
+*/
+
+#include "MeterHub.h"
+#include <cmath>
+#include <cstring>
+
+namespace shmui
+{
+
+//==============================================================================
+
+void MeterHub::prepare(int newNumEntries, double sampleRate, bool enableTruePeak)
+{
+    numEntries = juce::jmax(0, newNumEntries);
+    truePeakEnabled = enableTruePeak;
+    windowSamples = juce::jmax(1, juce::roundToInt(sampleRate * windowMs * 0.001));
+
+    const auto size = static_cast<size_t>(numEntries);
+
+    slots.assign(size * 2, MeterSnapshot{});
+    for (auto& slotSequence : slotSequences)
+        slotSequence.store(0, std::memory_order_relaxed);
+    sequence.store(0, std::memory_order_release);
+    lastPublishTicks.store(0, std::memory_order_relaxed);
+
+    blockPeak.assign(size, 0.0f);
+    blockTruePeak.assign(size, 0.0f);
+    blockMeanSquare.assign(size, 0.0f);
+    windowPeak.assign(size, 0.0f);
+    windowTruePeak.assign(size, 0.0f);
+    previousPeak.assign(size, 0.0f);
+    previousTruePeak.assign(size, 0.0f);
+    windowSumSquares.assign(size, 0.0);
+    previousSumSquares.assign(size, 0.0);
+    clipCounts.assign(size, 0);
+    windowLength = 0;
+    previousLength = 0;
+
+    ballisticsSpec = requestedBallistics;
+    integratorSettings = PeakIntegrator::makeSettings(ballisticsSpec, sampleRate);
+    integrators.assign(size, PeakIntegrator{});
+    blockIntegratedPeak.assign(size, 0.0f);
+    windowIntegratedPeak.assign(size, 0.0f);
+    previousIntegratedPeak.assign(size, 0.0f);
+    integratePending.assign(size, 0);
+    blockStarted = false;
+
+    if (truePeakEnabled)
+        truePeakDetector.prepare(sampleRate, numEntries);
+
+    clipResetRequested.store(false, std::memory_order_relaxed);
+}
+
+void MeterHub::setClipThreshold(float dB)
+{
+    clipThresholdLinear.store(juce::Decibels::decibelsToGain(dB), std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Audio Thread Methods
+
+void MeterHub::beginBlock()
+{
+    if (blockStarted)
+        return;
+
+    blockStarted = true;
+
+    // After a gap the integrators hold whatever they had when audio stopped;
+    // readers have meanwhile let their meters fall, so start again from silence
+    if (isStale())
+        for (auto& integrator : integrators)
+            integrator.reset();
+}
+
+void MeterHub::measure(int index, const float* samples, int numSamples)
+{
+    if (index < 0 || index >= numEntries || samples == nullptr || numSamples <= 0)
+        return;
+
+    const float clipLevel = clipThresholdLinear.load(std::memory_order_relaxed);
+    float peak = 0.0f;
+    float sumSquares = 0.0f;
+    uint32_t clipped = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float magnitude = std::abs(samples[i]);
+        peak = juce::jmax(peak, magnitude);
+        sumSquares += samples[i] * samples[i];
+        clipped += magnitude >= clipLevel ? 1u : 0u;
+    }
+
+    beginBlock();
+
+    const auto i = static_cast<size_t>(index);
+    blockPeak[i] = peak;
+    blockMeanSquare[i] = sumSquares / static_cast<float>(numSamples);
+    blockTruePeak[i] = truePeakEnabled ? truePeakDetector.process(index, samples, numSamples) : peak;
+    blockIntegratedPeak[i] = integratorSettings.enabled ? integrators[i].process(integratorSettings, samples, numSamples)
+                                                        : peak;
+    integratePending[i] = 0;
+    clipCounts[i] += clipped;
+}
+
+void MeterHub::measureBuffer(const juce::AudioBuffer<float>& buffer, int firstIndex)
+{
+    const int count = juce::jmin(buffer.getNumChannels(), numEntries - firstIndex);
+
+    for (int ch = 0; ch < count; ++ch)
+    {
+        measure(firstIndex + ch, buffer.getReadPointer(ch), buffer.getNumSamples());
+    }
+}
+
+void MeterHub::setEntry(int index, float peak, float rms, int clippedSamples, float truePeak)
+{
+    if (index < 0 || index >= numEntries)
+        return;
+
+    beginBlock();
+
+    const auto i = static_cast<size_t>(index);
+    blockPeak[i] = peak;
+    blockMeanSquare[i] = rms * rms;
+    blockTruePeak[i] = truePeak >= 0.0f ? truePeak : peak;
+    integratePending[i] = 1;
+    clipCounts[i] += static_cast<uint32_t>(juce::jmax(0, clippedSamples));
+}
+
+void MeterHub::publish(int numSamples)
+{
+    if (numEntries == 0)
+        return;
+
+    if (clipResetRequested.exchange(false, std::memory_order_acquire))
+        std::fill(clipCounts.begin(), clipCounts.end(), 0u);
+
+    // Fill the slot readers are not on, bracketed by its seqlock, then flip
+    const uint64_t next = sequence.load(std::memory_order_relaxed) + 1;
+    MeterSnapshot* const dest = slots.data() + (next & 1) * static_cast<size_t>(numEntries);
+
+    auto& slotSequence = slotSequences[next & 1];
+    const uint64_t slotVersion = slotSequence.load(std::memory_order_relaxed);
+    slotSequence.store(slotVersion + 1, std::memory_order_relaxed);
+
+    // Keeps the slot writes below from becoming visible before the odd value
+    std::atomic_thread_fence(std::memory_order_release);
+
+    windowLength += juce::jmax(0, numSamples);
+    const double totalLength = static_cast<double>(juce::jmax(1, windowLength + previousLength));
+
+    for (int index = 0; index < numEntries; ++index)
+    {
+        const auto i = static_cast<size_t>(index);
+
+        // setEntry() peaks are integrated now that the block length is known
+        if (integratePending[i] != 0)
+        {
+            blockIntegratedPeak[i] = integratorSettings.enabled
+                                         ? integrators[i].processPeak(integratorSettings, blockPeak[i], numSamples)
+                                         : blockPeak[i];
+            integratePending[i] = 0;
+        }
+
+        windowPeak[i] = juce::jmax(windowPeak[i], blockPeak[i]);
+        windowTruePeak[i] = juce::jmax(windowTruePeak[i], blockTruePeak[i]);
+        windowIntegratedPeak[i] = juce::jmax(windowIntegratedPeak[i], blockIntegratedPeak[i]);
+        windowSumSquares[i] += static_cast<double>(blockMeanSquare[i]) * numSamples;
+
+        // Current and previous window, so a peak stays visible for at least a full window
+        dest[i].peak = juce::jmax(previousPeak[i], windowPeak[i]);
+        dest[i].truePeak = juce::jmax(previousTruePeak[i], windowTruePeak[i]);
+        dest[i].rms = static_cast<float>(std::sqrt((previousSumSquares[i] + windowSumSquares[i]) / totalLength));
+        dest[i].integrated = integratorSettings.enabled ? integrators[i].getValue() : blockIntegratedPeak[i];
+        dest[i].integratedPeak = juce::jmax(previousIntegratedPeak[i], windowIntegratedPeak[i]);
+        dest[i].clipCount = clipCounts[i];
+
+        blockPeak[i] = 0.0f;
+        blockTruePeak[i] = 0.0f;
+        blockMeanSquare[i] = 0.0f;
+        blockIntegratedPeak[i] = 0.0f;
+    }
+
+    blockStarted = false;
+
+    slotSequence.store(slotVersion + 2, std::memory_order_release);
+    lastPublishTicks.store(juce::Time::getHighResolutionTicks(), std::memory_order_relaxed);
+    sequence.store(next, std::memory_order_release);
+
+    // Roll the window
+    if (windowLength >= windowSamples)
+    {
+        std::swap(previousPeak, windowPeak);
+        std::swap(previousTruePeak, windowTruePeak);
+        std::swap(previousIntegratedPeak, windowIntegratedPeak);
+        std::swap(previousSumSquares, windowSumSquares);
+        std::fill(windowPeak.begin(), windowPeak.end(), 0.0f);
+        std::fill(windowTruePeak.begin(), windowTruePeak.end(), 0.0f);
+        std::fill(windowIntegratedPeak.begin(), windowIntegratedPeak.end(), 0.0f);
+        std::fill(windowSumSquares.begin(), windowSumSquares.end(), 0.0);
+        previousLength = windowLength;
+        windowLength = 0;
+    }
+}
+
+//==============================================================================
+// UI Thread Methods
+
+uint64_t MeterHub::read(int firstIndex, int count, MeterSnapshot* dest) const
+{
+    firstIndex = juce::jlimit(0, numEntries, firstIndex);
+    count = juce::jlimit(0, numEntries - firstIndex, count);
+
+    for (;;)
+    {
+        const uint64_t published = sequence.load(std::memory_order_acquire);
+
+        if (published == 0 || count == 0)
+        {
+            std::fill(dest, dest + count, MeterSnapshot{});
+            return published;
+        }
+
+        const auto& slotSequence = slotSequences[published & 1];
+        const uint64_t before = slotSequence.load(std::memory_order_acquire);
+
+        // The writer has come round to this slot again and is filling it
+        if ((before & 1) != 0)
+            continue;
+
+        const MeterSnapshot* const source = slots.data() + (published & 1) * static_cast<size_t>(numEntries);
+        std::memcpy(dest, source + firstIndex, sizeof(MeterSnapshot) * static_cast<size_t>(count));
+
+        // Unchanged counter: no write to this slot overlapped the copy
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slotSequence.load(std::memory_order_relaxed) == before)
+            return published;
+    }
+}
+
+double MeterHub::getSecondsSincePublish() const
+{
+    if (sequence.load(std::memory_order_acquire) == 0)
+        return -1.0;
+
+    const int64_t elapsed = juce::Time::getHighResolutionTicks() - lastPublishTicks.load(std::memory_order_relaxed);
+    return juce::Time::highResolutionTicksToSeconds(juce::jmax<int64_t>(0, elapsed));
+}
+
+bool MeterHub::isStale() const
+{
+    const double seconds = getSecondsSincePublish();
+    return seconds < 0.0 || seconds * 1000.0 > staleMs;
+}
+
+MeterSnapshot MeterHub::read(int index) const
+{
+    MeterSnapshot snapshot;
+    if (index >= 0 && index < numEntries)
+        read(index, 1, &snapshot);
+    return snapshot;
+}
+
+} // namespace shmui
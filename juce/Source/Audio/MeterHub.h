@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    MeterHub.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Central meter store: the audio engine measures every track once per
+    block and publishes all of them as one snapshot; meters, bridges and
+    waveforms read from it by index.
+
+    Thread-safe design: one audio thread writes, any number of UI readers,
+    synchronised by a seqlock on each of two snapshot slots.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Ballistics.h"
+#include "TruePeakDetector.h"
+#include <atomic>
+#include <vector>
+
+namespace shmui
+{
+
+/**
+ * @brief Published meter values for one hub entry.
+ *
+ * Peak, true peak and RMS cover a sliding window (see
+ * MeterHub::setWindowMilliseconds()) so a reader polling at frame rate
+ * sees every peak even though blocks are published much faster.
+ *
+ * The integrated values are the hub's ballistics (MeterHub::setBallistics())
+ * run per sample: its latest value, and its highest value in the window.
+ */
+struct MeterSnapshot
+{
+    float peak = 0.0f;           ///< Sample peak (linear)
+    float truePeak = 0.0f;       ///< Oversampled true peak (linear), equals peak if disabled
+    float rms = 0.0f;            ///< RMS (linear)
+    float integrated = 0.0f;     ///< Ballistics output at the end of the block (linear)
+    float integratedPeak = 0.0f; ///< Highest ballistics output in the window (linear)
+    uint32_t clipCount = 0;      ///< Clipped samples since prepare()/resetClipCounts(), wraps
+};
+
+//==============================================================================
+
+/**
+ * @brief One-writer, many-reader store of meter values for all tracks.
+ *
+ * Each entry is one channel; a stereo track uses two adjacent entries.
+ * The audio thread measures entries with measure() (or sets precomputed
+ * values with setEntry()) and then calls publish() once per block. All
+ * entries live in one contiguous array of MeterSnapshot, double-buffered,
+ * so a block costs a few atomic stores instead of several atomics per
+ * channel, and readers pull consistent values for all of their entries in
+ * one copy.
+ *
+ * Each slot has its own seqlock counter: the writer makes it odd, issues a
+ * release fence, fills the slot and makes it even again with a release
+ * store. A reader copies the slot between two loads of that counter and
+ * retries if it was odd or changed, which keeps copies whole on weakly
+ * ordered CPUs too. The writer always fills the slot readers are not
+ * pointed at, so a reader only retries if two blocks were published
+ * during its copy.
+ *
+ * Each entry also runs a PeakIntegrator with the hub's ballistics, so
+ * meters with the same timing get tone-burst readings that do not depend
+ * on how often they poll.
+ *
+ * When publishing stops (transport stopped, device closed), read() keeps
+ * returning the last published values. isStale() reports this once no
+ * block has arrived for the stale time; the bound components then treat
+ * the hub as silent and let their meters fall.
+ *
+ * Bind UI components with LevelMeter::setMeterSource(),
+ * MeterBridge::setMeterSource() or LiveWaveformVisualizer::setMeterSource().
+ */
+class MeterHub
+{
+public:
+    //==============================================================================
+    /** Default window for peak / RMS values. */
+    static constexpr double kDefaultWindowMs = 20.0;
+
+    /** Default time without publish() after which the hub is stale. */
+    static constexpr double kDefaultStaleMs = 250.0;
+
+    //==============================================================================
+    MeterHub() = default;
+    ~MeterHub() = default;
+
+    /**
+     * @brief Allocate entries and configure measurement.
+     *
+     * Allocates; call from prepareToPlay() while no reader or writer is
+     * active. Resets all values and clip counts.
+     *
+     * @param numEntries Number of meter channels
+     * @param sampleRate Sample rate of the measured audio
+     * @param enableTruePeak Measure true peak (costs an oversampling filter per entry)
+     */
+    void prepare(int numEntries, double sampleRate, bool enableTruePeak = false);
+
+    /**
+     * @brief Set the peak / RMS window (applied at the next prepare()).
+     */
+    void setWindowMilliseconds(double milliseconds) { windowMs = juce::jmax(1.0, milliseconds); }
+
+    /**
+     * @brief Set the ballistics integrated per sample (applied at the next prepare()).
+     *
+     * Default: MeterBallistics::Peak. Meters show the integrated values
+     * when their own timing matches.
+     */
+    void setBallistics(const BallisticsSpec& spec) { requestedBallistics = spec; }
+
+    /**
+     * @brief Get the ballistics the integrated values use (set by the last prepare()).
+     */
+    const BallisticsSpec& getBallisticsSpec() const { return ballisticsSpec; }
+
+    /**
+     * @brief Check if the integrated values are measured (after prepare()).
+     */
+    bool isIntegrating() const { return integratorSettings.enabled; }
+
+    /**
+     * @brief Set how long the hub may go without publish() before it is stale.
+     *
+     * Should exceed the longest audio block the host may use.
+     */
+    void setStaleMilliseconds(double milliseconds) { staleMs = juce::jmax(1.0, milliseconds); }
+
+    /**
+     * @brief Clip threshold in dBFS (default 0). Audio thread reads it per block.
+     */
+    void setClipThreshold(float dB);
+
+    /**
+     * @brief Get number of entries.
+     */
+    int getNumEntries() const { return numEntries; }
+
+    /**
+     * @brief Check if true peak is measured.
+     */
+    bool isTruePeakEnabled() const { return truePeakEnabled; }
+
+    //==============================================================================
+    // Audio Thread Methods
+
+    /**
+     * @brief Measure a channel of audio into an entry.
+     *
+     * Call once per entry per block (a second call replaces the block's
+     * peak and RMS, but the integrator has then run over both), then
+     * publish().
+     */
+    void measure(int index, const float* samples, int numSamples);
+
+    /**
+     * @brief Measure every channel of a buffer into consecutive entries.
+     */
+    void measureBuffer(const juce::AudioBuffer<float>& buffer, int firstIndex = 0);
+
+    /**
+     * @brief Set an entry from values computed elsewhere.
+     *
+     * The peak is integrated over the block length given to publish(), so
+     * its rise is only as fine as the block.
+     *
+     * @param peak Block peak (linear)
+     * @param rms Block RMS (linear)
+     * @param clippedSamples Clipped samples in the block
+     * @param truePeak Block true peak (linear), or negative to use peak
+     */
+    void setEntry(int index, float peak, float rms, int clippedSamples, float truePeak = -1.0f);
+
+    /**
+     * @brief Publish all entries as one snapshot.
+     *
+     * @param numSamples Block length, advances the peak / RMS window
+     */
+    void publish(int numSamples);
+
+    //==============================================================================
+    // UI Thread Methods
+
+    /**
+     * @brief Copy a range of entries from the latest snapshot.
+     *
+     * After publishing stops, this keeps returning the last snapshot;
+     * check isStale() to tell frozen values from live ones.
+     *
+     * @return The sequence number read (the copy is at least this recent),
+     *         0 if nothing has been published
+     */
+    uint64_t read(int firstIndex, int count, MeterSnapshot* dest) const;
+
+    /**
+     * @brief Read one entry from the latest snapshot.
+     */
+    MeterSnapshot read(int index) const;
+
+    /**
+     * @brief Number of snapshots published so far.
+     *
+     * Readers can compare this to skip work when nothing changed.
+     */
+    uint64_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Seconds since the last publish(), or a negative value if none.
+     */
+    double getSecondsSincePublish() const;
+
+    /**
+     * @brief Check if nothing has been published within the stale time.
+     *
+     * True before the first publish() as well.
+     */
+    bool isStale() const;
+
+    /**
+     * @brief Zero all clip counts (applied by the audio thread at the next publish()).
+     */
+    void resetClipCounts() { clipResetRequested.store(true, std::memory_order_release); }
+
+private:
+    //==============================================================================
+    void beginBlock();
+
+    //==============================================================================
+    int numEntries = 0;
+    bool truePeakEnabled = false;
+    double windowMs = kDefaultWindowMs;
+    double staleMs = kDefaultStaleMs;
+    int windowSamples = 0;
+    std::atomic<float> clipThresholdLinear{1.0f};
+    BallisticsSpec requestedBallistics = BallisticsSpec::forType(MeterBallistics::Peak);
+    BallisticsSpec ballisticsSpec = requestedBallistics;
+    PeakIntegrator::Settings integratorSettings;
+
+    // Two snapshot slots back to back: slot s holds entries [s * numEntries, (s + 1) * numEntries)
+    std::vector<MeterSnapshot> slots;
+    std::atomic<uint64_t> slotSequences[2] {};     // Odd while the writer fills the slot
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<int64_t> lastPublishTicks{0};
+
+    // Writer state, one array per field (audio thread only)
+    std::vector<float> blockPeak, blockTruePeak, blockMeanSquare;
+    std::vector<float> windowPeak, windowTruePeak, previousPeak, previousTruePeak;
+    std::vector<double> windowSumSquares, previousSumSquares;
+    std::vector<uint32_t> clipCounts;
+    std::vector<PeakIntegrator> integrators;
+    std::vector<float> blockIntegratedPeak, windowIntegratedPeak, previousIntegratedPeak;
+    std::vector<uint8_t> integratePending;                   // setEntry() peaks waiting for the block length
+    int windowLength = 0;
+    int previousLength = 0;
+    bool blockStarted = false;
+
+    TruePeakDetector truePeakDetector;
+    std::atomic<bool> clipResetRequested{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterHub)
+};
+
+} // namespace shmui
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    StereoSampleRing.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the stereo sample ring.
+
+  ==============================================================================
+*/
+
+#include "StereoSampleRing.h"
+#include <cstring>
+
+namespace shmui
+{
+
+//==============================================================================
+StereoSampleRing::StereoSampleRing()
+{
+    prepare(kDefaultCapacity);
+}
+
+void StereoSampleRing::prepare(int minCapacity)
+{
+    capacity = juce::nextPowerOfTwo(juce::jmax(64, minCapacity));
+    mask = capacity - 1;
+
+    leftSamples.assign(static_cast<size_t>(capacity), 0.0f);
+    rightSamples.assign(static_cast<size_t>(capacity), 0.0f);
+    writingPosition.store(0, std::memory_order_relaxed);
+    writePosition.store(0, std::memory_order_release);
+}
+
+//==============================================================================
+// Audio Thread Methods
+
+void StereoSampleRing::push(const float* left, const float* right, int numFrames)
+{
+    if (left == nullptr || numFrames <= 0 || capacity == 0)
+        return;
+
+    if (right == nullptr)
+        right = left;
+
+    const uint64_t position = writePosition.load(std::memory_order_relaxed);
+
+    // A block longer than the ring only leaves its tail
+    const int skip = juce::jmax(0, numFrames - capacity);
+    const int count = numFrames - skip;
+    const int start = static_cast<int>((position + static_cast<uint64_t>(skip)) & static_cast<uint64_t>(mask));
+    const int firstPart = juce::jmin(count, capacity - start);
+
+    // Announce the frames about to be overwritten before touching them, so
+    // a reader copying those slots meanwhile knows to drop them
+    writingPosition.store(position + static_cast<uint64_t>(numFrames), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(leftSamples.data() + start, left + skip, sizeof(float) * static_cast<size_t>(firstPart));
+    std::memcpy(rightSamples.data() + start, right + skip, sizeof(float) * static_cast<size_t>(firstPart));
+
+    if (firstPart < count)
+    {
+        const int secondPart = count - firstPart;
+        std::memcpy(leftSamples.data(), left + skip + firstPart, sizeof(float) * static_cast<size_t>(secondPart));
+        std::memcpy(rightSamples.data(), right + skip + firstPart, sizeof(float) * static_cast<size_t>(secondPart));
+    }
+
+    writePosition.store(position + static_cast<uint64_t>(numFrames), std::memory_order_release);
+}
+
+void StereoSampleRing::pushBuffer(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    push(buffer.getReadPointer(0),
+         numChannels > 1 ? buffer.getReadPointer(1) : nullptr,
+         buffer.getNumSamples());
+}
+
+//==============================================================================
+// UI Thread Methods
+
+int StereoSampleRing::read(uint64_t& readPosition, float* left, float* right, int maxFrames) const
+{
+    const uint64_t end = writePosition.load(std::memory_order_acquire);
+
+    if (readPosition > end)
+        readPosition = end;   // Ring was prepared again
+
+    // Leave a quarter of the ring as headroom for the writer while copying
+    const uint64_t maxPending = static_cast<uint64_t>(juce::jmin(juce::jmax(0, maxFrames), capacity - capacity / 4));
+    const uint64_t start = juce::jmax(readPosition, end - juce::jmin(end, maxPending));
+    int count = static_cast<int>(end - start);
+
+    copyOut(start, left, right, count);
+
+    // Anything older than one ring behind the end of the block being written
+    // may have been overwritten meanwhile, including by a block still in progress
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t writing = writingPosition.load(std::memory_order_relaxed);
+    const uint64_t oldestIntact = writing > static_cast<uint64_t>(capacity) ? writing - static_cast<uint64_t>(capacity) : 0;
+
+    if (start < oldestIntact)
+    {
+        const int dropped = static_cast<int>(juce::jmin(static_cast<uint64_t>(count), oldestIntact - start));
+        count -= dropped;
+        std::memmove(left, left + dropped, sizeof(float) * static_cast<size_t>(count));
+        std::memmove(right, right + dropped, sizeof(float) * static_cast<size_t>(count));
+    }
+
+    readPosition = end;
+    return count;
+}
+
+void StereoSampleRing::copyOut(uint64_t start, float* left, float* right, int numFrames) const
+{
+    if (numFrames <= 0)
+        return;
+
+    const int offset = static_cast<int>(start & static_cast<uint64_t>(mask));
+    const int firstPart = juce::jmin(numFrames, capacity - offset);
+
+    std::memcpy(left, leftSamples.data() + offset, sizeof(float) * static_cast<size_t>(firstPart));
+    std::memcpy(right, rightSamples.data() + offset, sizeof(float) * static_cast<size_t>(firstPart));
+
+    if (firstPart < numFrames)
+    {
+        const int secondPart = numFrames - firstPart;
+        std::memcpy(left + firstPart, leftSamples.data(), sizeof(float) * static_cast<size_t>(secondPart));
+        std::memcpy(right + firstPart, rightSamples.data(), sizeof(float) * static_cast<size_t>(secondPart));
+    }
+}
+
+} // namespace shmui
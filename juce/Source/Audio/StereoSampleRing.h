@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    StereoSampleRing.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Lock-free ring of stereo sample frames for phase displays.
+
+    Thread-safe design: one audio thread writes, any number of UI readers,
+    each keeping its own read position.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+namespace shmui
+{
+
+/**
+ * @brief Single-writer ring of recent stereo audio.
+ *
+ * The audio thread copies each block's left and right channels in with
+ * push() or pushBuffer(); it never waits and never allocates. Readers
+ * (CorrelationMeter, Goniometer) pull everything written since their last
+ * read with read(). A reader that falls more than a ring behind skips to
+ * the newest audio instead of reading overwritten frames.
+ *
+ * Left and right are stored in separate arrays so readers can run vector
+ * operations on them directly.
+ */
+class StereoSampleRing
+{
+public:
+    //==============================================================================
+    /** Default capacity in frames (about 340ms at 96 kHz). */
+    static constexpr int kDefaultCapacity = 1 << 15;
+
+    //==============================================================================
+    StereoSampleRing();
+    ~StereoSampleRing() = default;
+
+    /**
+     * @brief Allocate the ring.
+     *
+     * Capacity is rounded up to a power of two. Allocates; call while no
+     * reader or writer is active. Clears the ring.
+     *
+     * @param minCapacity Minimum number of stereo frames held
+     */
+    void prepare(int minCapacity = kDefaultCapacity);
+
+    /**
+     * @brief Get capacity in frames.
+     */
+    int getCapacity() const { return capacity; }
+
+    //==============================================================================
+    // Audio Thread Methods
+
+    /**
+     * @brief Append stereo frames.
+     *
+     * @param left Left channel samples
+     * @param right Right channel samples, or nullptr to duplicate left (mono)
+     * @param numFrames Number of frames
+     */
+    void push(const float* left, const float* right, int numFrames);
+
+    /**
+     * @brief Append the first two channels of a buffer (one channel is treated as mono).
+     */
+    void pushBuffer(const juce::AudioBuffer<float>& buffer);
+
+    //==============================================================================
+    // UI Thread Methods
+
+    /**
+     * @brief Total frames written so far.
+     */
+    uint64_t getWritePosition() const { return writePosition.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Copy the frames written since readPosition.
+     *
+     * When more than maxFrames (or most of the ring) are pending, the
+     * oldest are skipped. Frames the writer overwrote during the copy are
+     * dropped as well, so the result is always contiguous audio.
+     *
+     * @param readPosition Caller's read position, advanced to the write position
+     * @param left Destination for left samples (maxFrames)
+     * @param right Destination for right samples (maxFrames)
+     * @param maxFrames Destination capacity
+     * @return Number of frames copied
+     */
+    int read(uint64_t& readPosition, float* left, float* right, int maxFrames) const;
+
+private:
+    //==============================================================================
+    void copyOut(uint64_t start, float* left, float* right, int numFrames) const;
+
+    //==============================================================================
+    int capacity = 0;
+    int mask = 0;
+    std::vector<float> leftSamples;
+    std::vector<float> rightSamples;
+    std::atomic<uint64_t> writePosition{0};
+    std::atomic<uint64_t> writingPosition{0};      // End of the block push() is writing (or last wrote)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StereoSampleRing)
+};
+
+} // namespace shmui
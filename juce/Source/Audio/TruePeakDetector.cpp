@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the polyphase true-peak detector.
+
+  ==============================================================================
+*/
+
+#include "TruePeakDetector.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+
+void TruePeakDetector::prepare(double sampleRate, int newNumChannels)
+{
+    oversampling = getOversamplingFactorFor(sampleRate);
+    numChannels = juce::jmax(0, newNumChannels);
+
+    designFilter();
+
+    history.assign(static_cast<size_t>(numChannels * 2 * kTapsPerPhase), 0.0f);
+    writePositions.assign(static_cast<size_t>(numChannels), 0);
+}
+
+void TruePeakDetector::reset()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    std::fill(writePositions.begin(), writePositions.end(), 0);
+}
+
+int TruePeakDetector::getOversamplingFactorFor(double sampleRate)
+{
+    if (sampleRate <= 0.0)
+        return 1;
+
+    // Smallest power of two that takes the rate to at least 192 kHz
+    int factor = 1;
+    while (factor < kMaxOversampling && sampleRate * factor < 192000.0 - 1.0)
+        factor *= 2;
+
+    return factor;
+}
+
+//==============================================================================
+// Audio Thread
+
+float TruePeakDetector::process(int channel, const float* samples, int numSamples)
+{
+    if (channel < 0 || channel >= numChannels || oversampling == 1)
+    {
+        float peak = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            peak = std::max(peak, std::abs(samples[i]));
+        return peak;
+    }
+
+    float* const buffer = history.data() + channel * 2 * kTapsPerPhase;
+    const float* const coeffs = coefficients.data();
+    int pos = writePositions[static_cast<size_t>(channel)];
+    float peak = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        buffer[pos] = samples[i];
+        buffer[pos + kTapsPerPhase] = samples[i];
+        pos = pos + 1 < kTapsPerPhase ? pos + 1 : 0;
+
+        // Oldest sample first, matching the coefficient layout
+        const float* const window = buffer + pos;
+
+        for (int phase = 0; phase < oversampling; ++phase)
+        {
+            const float* const h = coeffs + phase * kTapsPerPhase;
+            float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+
+            for (int k = 0; k < kTapsPerPhase; k += 4)
+            {
+                acc0 += window[k]     * h[k];
+                acc1 += window[k + 1] * h[k + 1];
+                acc2 += window[k + 2] * h[k + 2];
+                acc3 += window[k + 3] * h[k + 3];
+            }
+
+            peak = std::max(peak, std::abs((acc0 + acc1) + (acc2 + acc3)));
+        }
+    }
+
+    writePositions[static_cast<size_t>(channel)] = pos;
+    return peak;
+}
+
+//==============================================================================
+// Private Methods
+
+void TruePeakDetector::designFilter()
+{
+    static_assert(kTapsPerPhase % 4 == 0, "inner loop is unrolled by four");
+
+    const int numTaps = oversampling * kTapsPerPhase;
+    const double centre = 0.5 * (numTaps - 1);
+    const double cutoff = 0.5 / oversampling;   // Input Nyquist, relative to the oversampled rate
+
+    // Blackman-Harris windowed sinc prototype
+    std::vector<double> prototype(static_cast<size_t>(numTaps));
+    for (int n = 0; n < numTaps; ++n)
+    {
+        const double x = n - centre;
+        const double sinc = x == 0.0 ? 1.0
+                                     : std::sin(juce::MathConstants<double>::pi * 2.0 * cutoff * x)
+                                           / (juce::MathConstants<double>::pi * 2.0 * cutoff * x);
+        const double w = juce::MathConstants<double>::twoPi * n / (numTaps - 1);
+        const double window = 0.35875 - 0.48829 * std::cos(w)
+                                      + 0.14128 * std::cos(2.0 * w)
+                                      - 0.01168 * std::cos(3.0 * w);
+        prototype[static_cast<size_t>(n)] = sinc * window;
+    }
+
+    // Split into phases (oldest tap first), each normalised to unity DC gain
+    coefficients.assign(static_cast<size_t>(numTaps), 0.0f);
+    for (int phase = 0; phase < oversampling; ++phase)
+    {
+        double sum = 0.0;
+        for (int k = 0; k < kTapsPerPhase; ++k)
+            sum += prototype[static_cast<size_t>(phase + k * oversampling)];
+
+        for (int k = 0; k < kTapsPerPhase; ++k)
+        {
+            const double h = prototype[static_cast<size_t>(phase + k * oversampling)];
+            coefficients[static_cast<size_t>(phase * kTapsPerPhase + (kTapsPerPhase - 1 - k))] =
+                static_cast<float>(sum != 0.0 ? h / sum : 0.0);
+        }
+    }
+}
+
+} // namespace shmui
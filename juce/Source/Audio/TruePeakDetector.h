@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    ITU-R BS.1770 true-peak (dBTP) detection by polyphase oversampling.
+
+    Thread-safe design: prepare() on the message thread before playback,
+    process() on the audio thread with no allocation or locking.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace shmui
+{
+
+/**
+ * @brief Per-channel true-peak detector (ITU-R BS.1770 Annex 2).
+ *
+ * Estimates the peak of the reconstructed analogue signal by upsampling
+ * each block with a polyphase windowed-sinc interpolator and taking the
+ * largest absolute value of the oversampled signal, so inter-sample overs
+ * that a sample-peak meter misses are caught.
+ *
+ * The oversampling factor follows the sample rate so the oversampled rate
+ * is at least 192 kHz: 8x at 44.1 kHz, 4x at 48 and 88.2 kHz, 2x at
+ * 96 kHz. At 192 kHz and above the sample peak is reported. Tones up to
+ * a quarter of 48 kHz read at most 0.17 dB low, within the EBU Tech 3341
+ * tolerance; ShmuiBenchmarks --check verifies this.
+ *
+ * Each phase is a short dot product over a contiguous history window; the
+ * inner loop keeps independent accumulators so the compiler can vectorise
+ * it.
+ */
+class TruePeakDetector
+{
+public:
+    //==============================================================================
+    /** Filter taps per polyphase branch. */
+    static constexpr int kTapsPerPhase = 16;
+
+    /** Highest oversampling factor used (at 44.1 kHz and below). */
+    static constexpr int kMaxOversampling = 8;
+
+    //==============================================================================
+    TruePeakDetector() = default;
+    ~TruePeakDetector() = default;
+
+    /**
+     * @brief Design the interpolator and allocate channel history.
+     *
+     * Call from prepareToPlay(), not while process() may run.
+     *
+     * @param sampleRate Input sample rate in Hz
+     * @param numChannels Number of channels to track
+     */
+    void prepare(double sampleRate, int numChannels);
+
+    /**
+     * @brief Clear the filter history of all channels.
+     */
+    void reset();
+
+    /**
+     * @brief Check if prepare() has been called.
+     */
+    bool isPrepared() const { return numChannels > 0; }
+
+    /**
+     * @brief Get the oversampling factor chosen for the sample rate.
+     */
+    int getOversamplingFactor() const { return oversampling; }
+
+    /**
+     * @brief Get the number of prepared channels.
+     */
+    int getNumChannels() const { return numChannels; }
+
+    /**
+     * @brief Measure one block of a channel (audio thread).
+     *
+     * The filter history carries over between calls, so peaks that fall
+     * between two blocks are still found. Unprepared or out of range
+     * channels fall back to the sample peak.
+     *
+     * @param channel Channel index (0-based)
+     * @param samples Sample data
+     * @param numSamples Number of samples
+     * @return Linear true peak of the block
+     */
+    float process(int channel, const float* samples, int numSamples);
+
+    //==============================================================================
+
+    /**
+     * @brief Oversampling factor BS.1770 needs at a sample rate.
+     */
+    static int getOversamplingFactorFor(double sampleRate);
+
+    /**
+     * @brief Convert a linear true peak to dBTP.
+     */
+    static float toDBTP(float linearPeak)
+    {
+        return juce::Decibels::gainToDecibels(linearPeak, -100.0f);
+    }
+
+private:
+    //==============================================================================
+    void designFilter();
+
+    int oversampling = 1;
+    int numChannels = 0;
+
+    // Coefficients laid out phase by phase: phase p occupies
+    // [p * kTapsPerPhase, (p + 1) * kTapsPerPhase), oldest tap first
+    std::vector<float> coefficients;
+
+    // Per channel history, stored twice so a window never wraps:
+    // channel c occupies [c * 2 * kTapsPerPhase, (c + 1) * 2 * kTapsPerPhase)
+    std::vector<float> history;
+    std::vector<int> writePositions;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TruePeakDetector)
+};
+
+} // namespace shmui
@@ -8,6 +8,7 @@
 */
 
 #include "AudioPlayerControls.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -16,11 +17,12 @@ namespace shmui
 AudioPlayerControls::AudioPlayerControls()
 {
     setOpaque (false);
+    updateTimeDisplay (true);
 }
 
 AudioPlayerControls::~AudioPlayerControls()
 {
-    stopTimer();
+    stopFrames();
 }
 
 //==============================================================================
@@ -29,7 +31,7 @@ void AudioPlayerControls::setCurrentTime (double timeInSeconds)
     if (currentTime != timeInSeconds)
     {
         currentTime = timeInSeconds;
-        repaint();
+        updateTimeDisplay (false);
     }
 }
 
@@ -38,7 +40,7 @@ void AudioPlayerControls::setDuration (double durationInSeconds)
     if (duration != durationInSeconds)
     {
         duration = durationInSeconds;
-        repaint();
+        updateTimeDisplay (false);
     }
 }
 
@@ -69,9 +71,9 @@ void AudioPlayerControls::setBuffering (bool isBuffering)
     {
         buffering = isBuffering;
         if (buffering)
-            startTimerHz (60);
+            startFrames();
         else
-            stopTimer();
+            stopFrames();
         repaint();
     }
 }
@@ -90,12 +92,14 @@ void AudioPlayerControls::removeListener (Listener* listener)
 void AudioPlayerControls::setStyle (const Style& newStyle)
 {
     style = newStyle;
-    repaint();
+    updateTimeDisplay (true);
 }
 
 //==============================================================================
 void AudioPlayerControls::paint (juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("AudioPlayerControls::paint");
+
     auto bounds = getLocalBounds().toFloat().reduced (style.padding);
 
     // Background (optional)
@@ -132,12 +136,11 @@ void AudioPlayerControls::paint (juce::Graphics& g)
     }
 
     // Time display
-    auto timeBounds = getTimeDisplayBounds();
-    g.setColour (style.textColor);
-    g.setFont (style.fontSize);
-
-    juce::String timeText = formatTime (currentTime) + " / " + formatTime (duration);
-    g.drawText (timeText, timeBounds, juce::Justification::centred, true);
+    {
+        juce::Graphics::ScopedSaveState state (g);
+        g.reduceClipRegion (getTimeDisplayBounds().getSmallestIntegerContainer());
+        digitAtlas->draw (g, timeLayout, style.textColor);
+    }
 
     // Speed button
     auto speedBounds = getSpeedButtonBounds();
@@ -161,7 +164,9 @@ void AudioPlayerControls::paint (juce::Graphics& g)
 
 void AudioPlayerControls::resized()
 {
-    // Layout is computed dynamically in paint/getBounds methods
+    // Layout is computed dynamically in paint/getBounds methods,
+    // apart from the time text, which is only laid out when it changes
+    updateTimeDisplay (true);
 }
 
 //==============================================================================
@@ -227,33 +232,38 @@ void AudioPlayerControls::mouseExit (const juce::MouseEvent& event)
     repaint();
 }
 
-void AudioPlayerControls::timerCallback()
+bool AudioPlayerControls::advanceFrame (double deltaSeconds)
 {
-    spinnerAngle += 0.15f;
-    if (spinnerAngle > juce::MathConstants<float>::twoPi)
+    SHMUI_PROFILE_SCOPE("AudioPlayerControls::advanceFrame");
+
+    // 0.15 rad per 60 Hz frame
+    spinnerAngle += static_cast<float> (deltaSeconds) * 9.0f;
+    while (spinnerAngle > juce::MathConstants<float>::twoPi)
         spinnerAngle -= juce::MathConstants<float>::twoPi;
     repaint();
+    return buffering;
 }
 
 //==============================================================================
-juce::String AudioPlayerControls::formatTime (double seconds)
+void AudioPlayerControls::updateTimeDisplay (bool repaintAll)
 {
-    if (std::isnan (seconds) || std::isinf (seconds) || seconds < 0)
-        return "--:--";
+    TimeText text;
+    TimeFormat::appendClock (text, currentTime);
+    text.append (" / ");
+    TimeFormat::appendClock (text, duration);
 
-    int totalSeconds = static_cast<int> (seconds);
-    int hrs = totalSeconds / 3600;
-    int mins = (totalSeconds % 3600) / 60;
-    int secs = totalSeconds % 60;
+    if (! repaintAll && text == timeLayout.text)
+        return;
 
-    if (hrs > 0)
-    {
-        return juce::String::formatted ("%d:%02d:%02d", hrs, mins, secs);
-    }
-    else
-    {
-        return juce::String::formatted ("%d:%02d", mins, secs);
-    }
+    const auto layout = digitAtlas->layout (text, getTimeDisplayBounds(), juce::Justification::centred,
+                                            style.fontSize, false);
+    const auto changed = DigitAtlas::getChangedArea (timeLayout, layout);
+    timeLayout = layout;
+
+    if (repaintAll)
+        repaint();
+    else if (! changed.isEmpty())
+        repaint (changed);
 }
 
 juce::Rectangle<float> AudioPlayerControls::getPlayButtonBounds() const
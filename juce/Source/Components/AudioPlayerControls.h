@@ -13,6 +13,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../Utils/DigitAtlas.h"
+#include "../Utils/FrameClock.h"
 #include <functional>
 
 namespace shmui
@@ -35,7 +37,7 @@ namespace shmui
     - Customizable colors and sizes
 */
 class AudioPlayerControls : public juce::Component,
-                            public juce::Timer
+                            private FrameClockClient
 {
 public:
     //==========================================================================
@@ -126,13 +128,15 @@ public:
     void mouseMove (const juce::MouseEvent& event) override;
     void mouseExit (const juce::MouseEvent& event) override;
 
-    // Timer callback for buffering animation
-    void timerCallback() override;
-
 private:
     //==========================================================================
-    /** Formats time in seconds to mm:ss or hh:mm:ss string. */
-    static juce::String formatTime (double seconds);
+    /** Advances the buffering spinner. */
+    bool advanceFrame (double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+
+    //==========================================================================
+    /** Re-lays out "position / duration" and repaints the cells that changed. */
+    void updateTimeDisplay (bool repaintAll);
 
     /** Gets the bounds of the play button. */
     juce::Rectangle<float> getPlayButtonBounds() const;
@@ -170,6 +174,10 @@ private:
 
     Style style;
 
+    // Time display, laid out once per change and blitted from the atlas
+    juce::SharedResourcePointer<DigitAtlas> digitAtlas;
+    DigitLayout timeLayout;
+
     juce::ListenerList<Listener> listeners;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPlayerControls)
@@ -10,23 +10,50 @@
 */
 
 #include "BarVisualizer.h"
+#include "../Utils/Profiling.h"
 #include "../Utils/Interpolation.h"
+#include "../Utils/ColorUtils.h"
 
 namespace shmui
 {
 
+namespace
+{
+    /** VU gradient by level: green -> yellow (0.5) -> red, baked once. */
+    const ColorUtils::ColourLUT<1024>& getLevelColours()
+    {
+        static const auto table = []
+        {
+            ColorUtils::ColourLUT<1024> lut;
+            lut.build([](float level)
+            {
+                if (level < 0.5f)
+                    return juce::Colour::fromRGB(static_cast<uint8_t>(level * 2.0f * 255), 255, 0);
+
+                return juce::Colour::fromRGB(255, static_cast<uint8_t>((1.0f - (level - 0.5f) * 2.0f) * 255), 0);
+            });
+            return lut;
+        }();
+
+        return table;
+    }
+}
+
 BarVisualizer::BarVisualizer()
 {
     volumeBands.resize(barCount, 0.0f);
     fakeVolumeBands.resize(barCount, 0.2f);
 
     setOpaque(false);
-    startTimerHz(60);
+    startFrames();
 }
 
 BarVisualizer::~BarVisualizer()
 {
-    stopTimer();
+    stopFrames();
+
+    if (auto* service = quadRenderService.get())
+        service->removeClient(*this);
 }
 
 void BarVisualizer::setAudioAnalyzer(AudioAnalyzer* analyzer)
@@ -139,13 +166,39 @@ void BarVisualizer::setGradientMode(bool gradient)
     repaint();
 }
 
+void BarVisualizer::setQuadRenderService(QuadRenderService* service)
+{
+    if (service == quadRenderService.get())
+        return;
+
+    if (auto* previous = quadRenderService.get())
+        previous->removeClient(*this);
+
+    quadRenderService = service;
+    repaint();
+}
+
 void BarVisualizer::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("BarVisualizer::paint");
+
+    quads.clear();
+    buildQuads(quads);
+
+    auto* service = quadRenderService.get();
+
+    if (service != nullptr && service->isAvailable())
+        service->submit(*this, quads);
+    else
+        quads.paint(g);
+}
+
+void BarVisualizer::buildQuads(QuadBatch& batch) const
 {
     const auto bounds = getLocalBounds().toFloat().reduced(16.0f);
 
     // Background
-    g.setColour(backgroundColour);
-    g.fillRoundedRectangle(getLocalBounds().toFloat(), 8.0f);
+    batch.addRoundedRectangle(getLocalBounds().toFloat(), 8.0f, backgroundColour);
 
     if (barCount <= 0)
         return;
@@ -166,6 +219,8 @@ void BarVisualizer::paint(juce::Graphics& g)
     const float totalWidth = barCount * barWidth + totalGap;
     float startX = bounds.getX() + (bounds.getWidth() - totalWidth) / 2.0f;
 
+    const auto& levelColours = getLevelColours();
+
     // Draw bars
     for (int i = 0; i < barCount; ++i)
     {
@@ -194,25 +249,7 @@ void BarVisualizer::paint(juce::Graphics& g)
         if (gradientMode)
         {
             // VU meter gradient: green -> yellow -> red based on level
-            const float level = juce::jlimit(0.0f, 1.0f, volume);
-            if (level < 0.5f)
-            {
-                // Green to yellow
-                const float t = level * 2.0f;
-                colour = juce::Colour::fromRGB(
-                    static_cast<uint8_t>(t * 255),
-                    255,
-                    0);
-            }
-            else
-            {
-                // Yellow to red
-                const float t = (level - 0.5f) * 2.0f;
-                colour = juce::Colour::fromRGB(
-                    255,
-                    static_cast<uint8_t>((1.0f - t) * 255),
-                    0);
-            }
+            colour = levelColours.getColour(volume);
         }
         else if (isHighlighted)
         {
@@ -227,15 +264,14 @@ void BarVisualizer::paint(juce::Graphics& g)
             colour = barColour;
         }
 
-        g.setColour(colour);
-        g.fillRoundedRectangle(x, y, barWidth, barHeight, barWidth / 2.0f);
+        batch.addRoundedRectangle({ x, y, barWidth, barHeight }, barWidth / 2.0f, colour);
 
         // Pulsing effect for thinking state
         if (agentState == AgentState::Thinking && isHighlighted)
         {
-            const float pulseAlpha = 0.5f + 0.5f * std::sin(demoTime * 10.0f);
-            g.setColour(colour.withAlpha(pulseAlpha * 0.5f));
-            g.fillRoundedRectangle(x - 2, y - 2, barWidth + 4, barHeight + 4, (barWidth + 4) / 2.0f);
+            const float pulseAlpha = 0.5f + 0.5f * Interpolation::fastSin(demoTime * 10.0f);
+            batch.addRoundedRectangle({ x - 2, y - 2, barWidth + 4, barHeight + 4 }, (barWidth + 4) / 2.0f,
+                                      colour.withAlpha(pulseAlpha * 0.5f));
         }
     }
 }
@@ -245,12 +281,14 @@ void BarVisualizer::resized()
     repaint();
 }
 
-void BarVisualizer::timerCallback()
+bool BarVisualizer::advanceFrame(double deltaSeconds)
 {
+    SHMUI_PROFILE_SCOPE("BarVisualizer::advanceFrame");
+
     const int64_t currentTime = juce::Time::currentTimeMillis();
 
     // Update demo time
-    demoTime += 1.0f / 60.0f;
+    demoTime += static_cast<float>(deltaSeconds);
 
     // Update animation
     const int interval = getAnimationInterval();
@@ -278,6 +316,7 @@ void BarVisualizer::timerCallback()
     }
 
     repaint();
+    return true;
 }
 
 int BarVisualizer::getAnimationInterval() const
@@ -328,8 +367,8 @@ void BarVisualizer::updateFakeVolumeBands()
     for (int i = 0; i < barCount; ++i)
     {
         const float waveOffset = i * 0.5f;
-        const float baseVolume = std::sin((time - startTime) * 2.0f + waveOffset) * 0.3f + 0.5f;
-        const float randomNoise = Interpolation::seededRandom(time * 1000.0f + i) * 0.2f;
+        const float baseVolume = Interpolation::fastSin((time - startTime) * 2.0f + waveOffset) * 0.3f + 0.5f;
+        const float randomNoise = Interpolation::fastSeededRandom(time * 1000.0f + i) * 0.2f;
 
         fakeVolumeBands[i] = juce::jlimit(0.1f, 1.0f, baseVolume + randomNoise);
     }
@@ -15,6 +15,8 @@
 #include <JuceHeader.h>
 #include "../Audio/AudioAnalyzer.h"
 #include "../Utils/AgentState.h"
+#include "../Utils/FrameClock.h"
+#include "QuadRenderService.h"
 #include <vector>
 
 namespace shmui
@@ -28,7 +30,7 @@ namespace shmui
  * Port of BarVisualizer component from bar-visualizer.tsx.
  */
 class BarVisualizer : public juce::Component,
-                      public juce::Timer
+                      private FrameClockClient
 {
 public:
     BarVisualizer();
@@ -118,6 +120,31 @@ public:
      */
     bool isGradientMode() const { return gradientMode; }
 
+    //==============================================================================
+    // Rendering
+
+    /**
+     * @brief Draw the bars through a shared QuadRenderService (nullptr = juce::Graphics).
+     *
+     * The service must be attached to a component that contains this one.
+     */
+    void setQuadRenderService(QuadRenderService* service);
+
+    /**
+     * @brief Get the shared quad renderer, if any.
+     */
+    QuadRenderService* getQuadRenderService() const { return quadRenderService.get(); }
+
+    //==============================================================================
+    // Testing
+
+    /**
+     * @brief Run one frame of deltaSeconds without the FrameClock.
+     *
+     * For benchmarks and self-checks, which drive frames by hand.
+     */
+    void advanceFrameForTesting(double deltaSeconds) { advanceFrame(deltaSeconds); }
+
     //==============================================================================
     // Component overrides
 
@@ -125,12 +152,14 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
     int getAnimationInterval() const;
     std::vector<int> getHighlightedIndices() const;
     void updateFakeVolumeBands();
     void generateConnectingSequence();
     void generateListeningSequence();
+    void buildQuads(QuadBatch& batch) const;
 
     //==============================================================================
 
@@ -159,6 +188,10 @@ private:
     juce::Colour highlightColour = juce::Colour(0xFF3B82F6);  // primary
     juce::Colour backgroundColour = juce::Colour(0xFFF5F5F5);  // muted
 
+    // Rendering
+    QuadBatch quads;
+    juce::WeakReference<QuadRenderService> quadRenderService;
+
     // Frequency band configuration (matches AudioAnalyzer defaults and React)
     static constexpr int kLoPass = 100;
     static constexpr int kHiPass = 600;
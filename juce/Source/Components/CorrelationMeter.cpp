@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    CorrelationMeter.cpp
+    Created: shmui Component Library
+
+    Correlation meter implementation.
+
+  ==============================================================================
+*/
+
+#include "CorrelationMeter.h"
+#include "../Utils/Profiling.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+CorrelationMeter::CorrelationMeter() = default;
+
+CorrelationMeter::~CorrelationMeter()
+{
+    stopFrames();
+}
+
+//==============================================================================
+void CorrelationMeter::setSource(const StereoSampleRing* ring)
+{
+    m_ring = ring;
+    m_readPosition = ring != nullptr ? ring->getWritePosition() : 0;
+
+    if (m_ring != nullptr)
+        startFrames();
+    else
+        stopFrames();
+
+    reset();
+}
+
+void CorrelationMeter::reset()
+{
+    m_sumLR = 0.0;
+    m_sumLL = 0.0;
+    m_sumRR = 0.0;
+    m_correlation = 0.0f;
+    m_indicatorPixel = -1;
+    repaint();
+}
+
+void CorrelationMeter::setIntegrationTime(float milliseconds)
+{
+    m_integrationMs = juce::jmax(1.0f, milliseconds);
+}
+
+void CorrelationMeter::setStyle(const CorrelationMeterStyle& style)
+{
+    m_style = style;
+    m_indicatorPixel = -1;
+    repaint();
+}
+
+//==============================================================================
+bool CorrelationMeter::advanceFrame(double deltaSeconds)
+{
+    SHMUI_PROFILE_SCOPE("CorrelationMeter::advanceFrame");
+
+    // Idle until a source is set
+    if (m_ring == nullptr)
+        return false;
+
+    if (updateCorrelation(deltaSeconds * 1000.0))
+        repaint();
+
+    return true;
+}
+
+bool CorrelationMeter::updateCorrelation(double elapsedMs)
+{
+
+    const auto capacity = static_cast<size_t>(m_ring->getCapacity());
+    if (m_left.size() < capacity)
+    {
+        m_left.resize(capacity);
+        m_right.resize(capacity);
+    }
+
+    const int count = m_ring->read(m_readPosition, m_left.data(), m_right.data(), static_cast<int>(m_left.size()));
+
+    // Sums over this frame's audio, added to the decayed history
+    double sumLR = 0.0, sumLL = 0.0, sumRR = 0.0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const double l = m_left[static_cast<size_t>(i)];
+        const double r = m_right[static_cast<size_t>(i)];
+        sumLR += l * r;
+        sumLL += l * l;
+        sumRR += r * r;
+    }
+
+    const double decay = std::exp(-elapsedMs / m_integrationMs);
+    m_sumLR = m_sumLR * decay + sumLR;
+    m_sumLL = m_sumLL * decay + sumLL;
+    m_sumRR = m_sumRR * decay + sumRR;
+
+    const double energy = std::sqrt(m_sumLL * m_sumRR);
+    m_correlation = energy > 1.0e-9 ? static_cast<float>(juce::jlimit(-1.0, 1.0, m_sumLR / energy)) : 0.0f;
+
+    // Only repaint when the indicator moves by at least a pixel
+    const auto bar = getBarBounds();
+    const int pixel = juce::roundToInt((m_correlation + 1.0f) * 0.5f * bar.getWidth());
+
+    if (pixel == m_indicatorPixel)
+        return false;
+
+    m_indicatorPixel = pixel;
+    return true;
+}
+
+//==============================================================================
+juce::Rectangle<float> CorrelationMeter::getBarBounds() const
+{
+    auto bounds = getLocalBounds().toFloat().reduced(4.0f, 0.0f);
+
+    if (m_style.showScale)
+        bounds.removeFromBottom(12.0f);
+
+    return bounds.withSizeKeepingCentre(bounds.getWidth(), juce::jmin(bounds.getHeight(), m_style.barHeight));
+}
+
+void CorrelationMeter::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("CorrelationMeter::paint");
+
+    g.fillAll(m_style.backgroundColor);
+
+    const auto bar = getBarBounds();
+    const float centreX = bar.getCentreX();
+
+    // Track
+    g.setColour(m_style.trackColor);
+    g.fillRoundedRectangle(bar, m_style.cornerRadius);
+
+    // Filled from the centre towards the reading
+    const float x = bar.getX() + (m_correlation + 1.0f) * 0.5f * bar.getWidth();
+
+    g.setColour(m_correlation >= 0.0f ? m_style.positiveColor : m_style.negativeColor);
+    g.fillRect(juce::Rectangle<float>(juce::jmin(centreX, x), bar.getY(), std::abs(x - centreX), bar.getHeight()));
+
+    // Centre mark and indicator
+    g.setColour(m_style.tickColor);
+    g.fillRect(centreX - 0.5f, bar.getY(), 1.0f, bar.getHeight());
+
+    g.setColour(m_style.indicatorColor);
+    g.fillRect(x - m_style.indicatorWidth * 0.5f, bar.getY() - 2.0f, m_style.indicatorWidth, bar.getHeight() + 4.0f);
+
+    if (m_style.showScale)
+    {
+        auto labels = getLocalBounds().toFloat().reduced(4.0f, 0.0f).removeFromBottom(12.0f);
+
+        g.setColour(m_style.textColor);
+        g.setFont(9.0f);
+        g.drawText("-1", labels, juce::Justification::centredLeft, false);
+        g.drawText("0", labels, juce::Justification::centred, false);
+        g.drawText("+1", labels, juce::Justification::centredRight, false);
+    }
+}
+
+void CorrelationMeter::resized()
+{
+    m_indicatorPixel = -1;
+}
+
+} // namespace shmui
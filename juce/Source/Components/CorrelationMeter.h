@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    CorrelationMeter.h
+    Created: shmui Component Library
+
+    Stereo phase correlation meter (-1 to +1) fed from a StereoSampleRing.
+
+    Features:
+    - Energy-weighted correlation with configurable integration time
+    - Frame-rate independent smoothing
+    - Red / green colouring for out-of-phase / in-phase content
+    - Repaints only when the indicator moves
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/StereoSampleRing.h"
+#include "../Utils/FrameClock.h"
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Style configuration for CorrelationMeter.
+ */
+struct CorrelationMeterStyle
+{
+    // Colors
+    juce::Colour backgroundColor = juce::Colour(0xFF1A1A1A);
+    juce::Colour trackColor = juce::Colour(0xFF262626);
+    juce::Colour positiveColor = juce::Colour(0xFF22C55E);     // Green (in phase)
+    juce::Colour negativeColor = juce::Colour(0xFFEF4444);     // Red (out of phase)
+    juce::Colour indicatorColor = juce::Colours::white;
+    juce::Colour textColor = juce::Colour(0x80FFFFFF);
+    juce::Colour tickColor = juce::Colour(0x40FFFFFF);
+
+    // Appearance
+    float barHeight = 8.0f;
+    float indicatorWidth = 2.0f;
+    float cornerRadius = 2.0f;
+    bool showScale = true;
+};
+
+//==============================================================================
+/**
+ * @brief Horizontal stereo correlation meter.
+ *
+ * Reads the audio written to a StereoSampleRing since the last frame and
+ * integrates L*R, L*L and R*R with an exponential time constant, so the
+ * reading is +1 for mono, 0 for unrelated channels and -1 for
+ * polarity-inverted channels. Silence reads 0.
+ *
+ * Designed to sit next to a StereoLevelMeter and share its ring with a
+ * Goniometer; each reader keeps its own position in the ring.
+ */
+class CorrelationMeter : public juce::Component,
+                         private FrameClockClient
+{
+public:
+    //==============================================================================
+    /** Default integration time. */
+    static constexpr float kDefaultIntegrationMs = 300.0f;
+
+    //==============================================================================
+    CorrelationMeter();
+    ~CorrelationMeter() override;
+
+    //==============================================================================
+    /// @name Source
+    /// @{
+
+    /**
+     * @brief Set the ring to read (not owned, may be nullptr).
+     */
+    void setSource(const StereoSampleRing* ring);
+
+    /**
+     * @brief Get the ring being read.
+     */
+    const StereoSampleRing* getSource() const { return m_ring; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Readings
+    /// @{
+
+    /**
+     * @brief Get the current correlation (-1 to +1).
+     */
+    float getCorrelation() const { return m_correlation; }
+
+    /**
+     * @brief Clear the integrated state.
+     */
+    void reset();
+
+    /// @}
+
+    //==============================================================================
+    /// @name Configuration
+    /// @{
+
+    /**
+     * @brief Set integration time in milliseconds.
+     */
+    void setIntegrationTime(float milliseconds);
+
+    /**
+     * @brief Get integration time in milliseconds.
+     */
+    float getIntegrationTime() const { return m_integrationMs; }
+
+    /**
+     * @brief Set visual style.
+     */
+    void setStyle(const CorrelationMeterStyle& style);
+
+    /**
+     * @brief Get current style.
+     */
+    const CorrelationMeterStyle& getStyle() const { return m_style; }
+
+    /// @}
+
+    //==============================================================================
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==============================================================================
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    bool updateCorrelation(double elapsedMs);
+    juce::Rectangle<float> getBarBounds() const;
+
+    //==============================================================================
+    const StereoSampleRing* m_ring = nullptr;
+    uint64_t m_readPosition = 0;
+    CorrelationMeterStyle m_style;
+    float m_integrationMs = kDefaultIntegrationMs;
+
+    // Integrated products (energy-weighted, decayed per frame)
+    double m_sumLR = 0.0;
+    double m_sumLL = 0.0;
+    double m_sumRR = 0.0;
+    float m_correlation = 0.0f;
+    int m_indicatorPixel = -1;
+
+    // Read buffers, sized to the ring
+    std::vector<float> m_left;
+    std::vector<float> m_right;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CorrelationMeter)
+};
+
+} // namespace shmui
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+    Goniometer.cpp
+    Created: shmui Component Library
+
+    Goniometer implementation.
+
+  ==============================================================================
+*/
+
+#include "Goniometer.h"
+#include "../Utils/Profiling.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+Goniometer::Goniometer() = default;
+
+Goniometer::~Goniometer()
+{
+    stopFrames();
+}
+
+//==============================================================================
+void Goniometer::setSource(const StereoSampleRing* ring)
+{
+    m_ring = ring;
+    m_readPosition = ring != nullptr ? ring->getWritePosition() : 0;
+
+    if (m_ring != nullptr)
+        startFrames();
+    else
+        stopFrames();
+
+    clear();
+}
+
+void Goniometer::clear()
+{
+    std::fill(m_persistence.begin(), m_persistence.end(), 0.0f);
+    m_brightness = 0.0f;
+    repaint();
+}
+
+void Goniometer::setMode(GoniometerMode mode)
+{
+    if (m_mode != mode)
+    {
+        m_mode = mode;
+        clear();
+    }
+}
+
+void Goniometer::setGainDB(float dB)
+{
+    m_gainDB = dB;
+}
+
+void Goniometer::setStyle(const GoniometerStyle& style)
+{
+    m_style = style;
+    repaint();
+}
+
+//==============================================================================
+bool Goniometer::advanceFrame(double deltaSeconds)
+{
+    SHMUI_PROFILE_SCOPE("Goniometer::advanceFrame");
+
+    // Idle until a source is set
+    if (m_ring == nullptr)
+        return false;
+
+    if (updateTrace(deltaSeconds * 1000.0))
+        repaint();
+
+    return true;
+}
+
+bool Goniometer::updateTrace(double elapsedMs)
+{
+
+    const auto capacity = static_cast<size_t>(m_ring->getCapacity());
+    if (m_left.size() < capacity)
+    {
+        m_left.resize(capacity);
+        m_right.resize(capacity);
+        m_pointX.resize(capacity);
+        m_pointY.resize(capacity);
+    }
+
+    // Always drain the ring so a hidden or unsized plot does not fall behind
+    const int count = m_ring->read(m_readPosition, m_left.data(), m_right.data(), static_cast<int>(m_left.size()));
+
+    if (m_resolution == 0 || (count == 0 && m_brightness < 1.0f / 255.0f))
+        return false;
+
+    const int resolution = m_resolution;
+    const int numPixels = resolution * resolution;
+    float* const persistence = m_persistence.data();
+
+    // Fade the whole trace by the real elapsed time
+    const float decay = static_cast<float>(std::exp(-elapsedMs / juce::jmax(1.0f, m_style.persistenceMs)));
+    juce::FloatVectorOperations::multiply(persistence, decay, numPixels);
+    m_brightness *= decay;
+
+    if (count > 0)
+    {
+        // Map every frame to plot pixels in a few vector passes
+        const float half = static_cast<float>(resolution) * 0.5f;
+        float scale = juce::Decibels::decibelsToGain(m_gainDB) * half;
+        float* const x = m_pointX.data();
+        float* const y = m_pointY.data();
+
+        if (m_mode == GoniometerMode::MidSide)
+        {
+            juce::FloatVectorOperations::subtract(x, m_right.data(), m_left.data(), count);   // Side
+            juce::FloatVectorOperations::add(y, m_left.data(), m_right.data(), count);        // Mid
+            scale *= 0.5f;
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(x, m_left.data(), count);
+            juce::FloatVectorOperations::copy(y, m_right.data(), count);
+        }
+
+        juce::FloatVectorOperations::multiply(x, scale, count);
+        juce::FloatVectorOperations::multiply(y, -scale, count);
+        juce::FloatVectorOperations::add(x, half, count);
+        juce::FloatVectorOperations::add(y, half, count);
+
+        // Decimate to the point budget and accumulate
+        const int stride = juce::jmax(1, (count + m_style.maxPointsPerFrame - 1) / juce::jmax(1, m_style.maxPointsPerFrame));
+        const float intensity = m_style.pointIntensity;
+        const float limit = static_cast<float>(resolution);
+
+        for (int i = 0; i < count; i += stride)
+        {
+            if (x[i] >= 0.0f && x[i] < limit && y[i] >= 0.0f && y[i] < limit)
+                persistence[static_cast<int>(y[i]) * resolution + static_cast<int>(x[i])] += intensity;
+        }
+
+        m_brightness = 1.0f;
+    }
+
+    juce::FloatVectorOperations::min(persistence, persistence, 1.0f, numPixels);
+    updateImage();
+    return true;
+}
+
+void Goniometer::setResolution(int resolution)
+{
+    if (resolution == m_resolution)
+        return;
+
+    m_resolution = resolution;
+    m_persistence.assign(static_cast<size_t>(resolution * resolution), 0.0f);
+    m_image = resolution > 0 ? juce::Image(juce::Image::SingleChannel, resolution, resolution, true)
+                             : juce::Image();
+    m_brightness = 0.0f;
+}
+
+void Goniometer::updateImage()
+{
+    juce::Image::BitmapData data(m_image, juce::Image::BitmapData::writeOnly);
+
+    for (int row = 0; row < m_resolution; ++row)
+    {
+        const float* source = m_persistence.data() + row * m_resolution;
+        uint8_t* dest = data.getLinePointer(row);
+
+        for (int column = 0; column < m_resolution; ++column)
+        {
+            dest[column * data.pixelStride] = static_cast<uint8_t>(source[column] * 255.0f + 0.5f);
+        }
+    }
+}
+
+//==============================================================================
+juce::Rectangle<float> Goniometer::getPlotBounds() const
+{
+    auto bounds = getLocalBounds().toFloat().reduced(m_style.showLabels ? 12.0f : 2.0f);
+    const float size = juce::jmin(bounds.getWidth(), bounds.getHeight());
+    return bounds.withSizeKeepingCentre(size, size);
+}
+
+void Goniometer::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("Goniometer::paint");
+
+    g.fillAll(m_style.backgroundColor);
+
+    const auto plot = getPlotBounds();
+    if (plot.isEmpty())
+        return;
+
+    // Persistence buffer follows the plot's physical size
+    const float pixelScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    setResolution(juce::jlimit(0, m_style.maxResolution, juce::roundToInt(plot.getWidth() * pixelScale)));
+
+    if (m_style.showGrid)
+        drawGrid(g, plot);
+
+    if (m_resolution > 0 && m_brightness > 0.0f)
+    {
+        // Single channel image used as a mask for the trace colour
+        g.setColour(m_style.traceColor);
+        g.drawImage(m_image, plot, juce::RectanglePlacement::stretchToFit, true);
+    }
+}
+
+void Goniometer::drawGrid(juce::Graphics& g, juce::Rectangle<float> plot)
+{
+    const float left = plot.getX();
+    const float right = plot.getRight();
+    const float top = plot.getY();
+    const float bottom = plot.getBottom();
+    const auto centre = plot.getCentre();
+
+    g.setColour(m_style.gridColor);
+    g.drawRect(plot, 1.0f);
+    g.drawLine(centre.x, top, centre.x, bottom, 1.0f);
+    g.drawLine(left, centre.y, right, centre.y, 1.0f);
+    g.drawLine(left, top, right, bottom, 1.0f);
+    g.drawLine(left, bottom, right, top, 1.0f);
+
+    if (!m_style.showLabels)
+        return;
+
+    g.setColour(m_style.textColor);
+    g.setFont(9.0f);
+
+    if (m_mode == GoniometerMode::MidSide)
+    {
+        g.drawText("M", juce::Rectangle<float>(centre.x - 6.0f, top - 12.0f, 12.0f, 12.0f), juce::Justification::centred, false);
+        g.drawText("L", juce::Rectangle<float>(left - 12.0f, top - 12.0f, 12.0f, 12.0f), juce::Justification::centred, false);
+        g.drawText("R", juce::Rectangle<float>(right, top - 12.0f, 12.0f, 12.0f), juce::Justification::centred, false);
+    }
+    else
+    {
+        g.drawText("L", juce::Rectangle<float>(right, centre.y - 6.0f, 12.0f, 12.0f), juce::Justification::centred, false);
+        g.drawText("R", juce::Rectangle<float>(centre.x - 6.0f, top - 12.0f, 12.0f, 12.0f), juce::Justification::centred, false);
+    }
+}
+
+void Goniometer::resized()
+{
+    // Persistence buffer is resized on the next paint
+}
+
+} // namespace shmui
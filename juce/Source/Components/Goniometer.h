@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    Goniometer.h
+    Created: shmui Component Library
+
+    Stereo goniometer (vectorscope / Lissajous) fed from a StereoSampleRing.
+
+    Features:
+    - Mid/side (rotated 45 degrees) or left/right Lissajous display
+    - Persistence image with frame-rate independent exponential decay
+    - Per-frame point budget: audio is decimated, not drawn point by point
+    - Cost per frame bounded by the point budget and the image size,
+      not by the sample rate
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/StereoSampleRing.h"
+#include "../Utils/FrameClock.h"
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Goniometer plot orientation.
+ */
+enum class GoniometerMode
+{
+    MidSide,    ///< Mono vertical, L and R on the diagonals (classic goniometer)
+    LeftRight   ///< Left on x, right on y (Lissajous)
+};
+
+//==============================================================================
+/**
+ * @brief Style configuration for Goniometer.
+ */
+struct GoniometerStyle
+{
+    // Colors
+    juce::Colour backgroundColor = juce::Colour(0xFF1A1A1A);
+    juce::Colour traceColor = juce::Colour(0xFF22C55E);        // Green
+    juce::Colour gridColor = juce::Colour(0x30FFFFFF);
+    juce::Colour textColor = juce::Colour(0x80FFFFFF);
+
+    // Trace
+    float persistenceMs = 150.0f;     // Decay time constant of the trace
+    float pointIntensity = 0.35f;     // Brightness added per plotted point (0-1)
+    int maxPointsPerFrame = 4096;     // Decimation budget per frame
+    int maxResolution = 512;          // Persistence image size cap (physical pixels)
+
+    // Appearance
+    bool showGrid = true;
+    bool showLabels = true;
+};
+
+//==============================================================================
+/**
+ * @brief Stereo goniometer component.
+ *
+ * Each frame the audio written to the ring since the last frame is
+ * mapped to plot coordinates with vector operations, decimated to the
+ * style's point budget and accumulated into a float persistence buffer
+ * at the display's physical resolution. The buffer is decayed with one
+ * vector multiply per frame (exp(-dt / persistence), so the trace fades
+ * at the same speed at any refresh rate) and converted to a single
+ * channel image that is drawn, tinted with the trace colour, in one
+ * drawImage() call.
+ *
+ * Repaints stop once the trace has faded out and no audio arrives.
+ */
+class Goniometer : public juce::Component,
+                   private FrameClockClient
+{
+public:
+    //==============================================================================
+    Goniometer();
+    ~Goniometer() override;
+
+    //==============================================================================
+    /// @name Source
+    /// @{
+
+    /**
+     * @brief Set the ring to read (not owned, may be nullptr).
+     */
+    void setSource(const StereoSampleRing* ring);
+
+    /**
+     * @brief Get the ring being read.
+     */
+    const StereoSampleRing* getSource() const { return m_ring; }
+
+    /**
+     * @brief Clear the trace.
+     */
+    void clear();
+
+    /// @}
+
+    //==============================================================================
+    /// @name Configuration
+    /// @{
+
+    /**
+     * @brief Set plot orientation.
+     */
+    void setMode(GoniometerMode mode);
+
+    /**
+     * @brief Get plot orientation.
+     */
+    GoniometerMode getMode() const { return m_mode; }
+
+    /**
+     * @brief Set input gain in dB (0 dB puts full scale at the edge).
+     */
+    void setGainDB(float dB);
+
+    /**
+     * @brief Get input gain in dB.
+     */
+    float getGainDB() const { return m_gainDB; }
+
+    /**
+     * @brief Set visual style.
+     */
+    void setStyle(const GoniometerStyle& style);
+
+    /**
+     * @brief Get current style.
+     */
+    const GoniometerStyle& getStyle() const { return m_style; }
+
+    /// @}
+
+    //==============================================================================
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==============================================================================
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    bool updateTrace(double elapsedMs);
+    void setResolution(int resolution);
+    void updateImage();
+    void drawGrid(juce::Graphics& g, juce::Rectangle<float> plot);
+    juce::Rectangle<float> getPlotBounds() const;
+
+    //==============================================================================
+    const StereoSampleRing* m_ring = nullptr;
+    uint64_t m_readPosition = 0;
+    GoniometerMode m_mode = GoniometerMode::MidSide;
+    GoniometerStyle m_style;
+    float m_gainDB = 0.0f;
+
+    // Read buffers and plot coordinates, sized to the ring
+    std::vector<float> m_left;
+    std::vector<float> m_right;
+    std::vector<float> m_pointX;
+    std::vector<float> m_pointY;
+
+    // Persistence buffer (m_resolution squared) and its image
+    std::vector<float> m_persistence;
+    juce::Image m_image;
+    int m_resolution = 0;
+    float m_brightness = 0.0f;        // Upper bound of the buffer, to stop when faded
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Goniometer)
+};
+
+} // namespace shmui
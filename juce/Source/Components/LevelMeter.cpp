@@ -10,11 +10,28 @@
 */
 
 #include "LevelMeter.h"
+#include "../Utils/Profiling.h"
 #include <cmath>
 
 namespace shmui
 {
 
+namespace
+{
+    /** Raise an atomic to at least value (lock-free). */
+    void atomicMax(std::atomic<float>& target, float value)
+    {
+        float current = target.load(std::memory_order_relaxed);
+
+        while (value > current &&
+               !target.compare_exchange_weak(current, value,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
 //==============================================================================
 LevelMeter::LevelMeter()
     : LevelMeter(1)
@@ -28,19 +45,30 @@ LevelMeter::LevelMeter(int numChannels)
     for (int i = 0; i < MAX_CHANNELS; ++i)
     {
         m_inputLevels[i].store(0.0f);
+        m_pendingPeaks[i].store(0.0f);
+        m_pendingClipCounts[i].store(0);
+        m_pendingIntegrated[i].store(-1.0f);
+        m_latestIntegrated[i].store(0.0f);
+        m_integratorLimits[i].store(-1.0f);
+        m_lastFeedTimes[i] = 0;
+        m_clipCounts[i] = 0;
         m_displayLevels[i] = 0.0f;
         m_peakHolds[i] = 0.0f;
         m_peakHoldTimes[i] = 0;
         m_clipped[i] = false;
     }
 
+    m_clipThresholdLinear.store(juce::Decibels::decibelsToGain(m_style.clipThreshold));
     setBallistics(MeterBallistics::Peak);
-    startTimerHz(60);
+    startFrames();
 }
 
 LevelMeter::~LevelMeter()
 {
-    stopTimer();
+    stopFrames();
+
+    if (auto* service = m_quadRenderService.get())
+        service->removeClient(*this);
 }
 
 //==============================================================================
@@ -73,11 +101,169 @@ void LevelMeter::reset()
     for (int i = 0; i < m_numChannels; ++i)
     {
         m_inputLevels[i].store(0.0f);
+        m_pendingPeaks[i].store(0.0f);
+        m_pendingClipCounts[i].store(0);
+        m_pendingIntegrated[i].store(-1.0f);
+        m_latestIntegrated[i].store(0.0f);
+        m_integratorLimits[i].store(-1.0f);
+        m_lastFeedTimes[i] = 0;
+        m_clipCounts[i] = 0;
         m_displayLevels[i] = 0.0f;
         m_peakHolds[i] = 0.0f;
         m_peakHoldTimes[i] = 0;
         m_clipped[i] = false;
     }
+
+    // Restarts the audio thread's integrators from silence
+    updateIntegratorSettings();
+    repaint();
+}
+
+float LevelMeter::getDisplayLevel(int channel) const
+{
+    if (channel >= 0 && channel < m_numChannels)
+        return m_displayLevels[channel];
+    return 0.0f;
+}
+
+//==============================================================================
+void LevelMeter::prepare(double sampleRate)
+{
+    m_truePeakDetector.prepare(sampleRate, MAX_CHANNELS);
+    m_sampleRate = sampleRate;
+    updateIntegratorSettings();
+}
+
+void LevelMeter::updateIntegratorSettings()
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(m_integratorLock);
+        m_integratorSettings = PeakIntegrator::makeSettings(m_ballisticsSpec, m_sampleRate);
+    }
+
+    m_integratorVersion.fetch_add(1, std::memory_order_release);
+}
+
+void LevelMeter::syncIntegratorSettings()
+{
+    const uint32_t version = m_integratorVersion.load(std::memory_order_acquire);
+    if (version == m_audioIntegratorVersion)
+        return;
+
+    // Never waits: if the message thread holds the lock, try again next block
+    const juce::SpinLock::ScopedTryLockType lock(m_integratorLock);
+    if (!lock.isLocked())
+        return;
+
+    m_audioIntegratorSettings = m_integratorSettings;
+    m_audioIntegratorVersion = version;
+
+    for (auto& integrator : m_integrators)
+        integrator.reset();
+}
+
+void LevelMeter::pushSamples(int channel, const float* samples, int numSamples)
+{
+    if (channel < 0 || channel >= m_numChannels || samples == nullptr)
+        return;
+
+    const float clipLevel = m_clipThresholdLinear.load(std::memory_order_relaxed);
+    float peak = 0.0f;
+    int clippedSamples = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float magnitude = std::abs(samples[i]);
+        peak = juce::jmax(peak, magnitude);
+        clippedSamples += magnitude >= clipLevel ? 1 : 0;
+    }
+
+    const bool truePeak = m_truePeakMode.load(std::memory_order_relaxed) && m_truePeakDetector.isPrepared();
+    if (truePeak)
+    {
+        peak = m_truePeakDetector.process(channel, samples, numSamples);
+
+        // Inter-sample over with no clipped sample
+        if (clippedSamples == 0 && peak >= clipLevel)
+            clippedSamples = 1;
+    }
+
+    syncIntegratorSettings();
+    const auto& settings = m_audioIntegratorSettings;
+
+    if (!settings.enabled)
+    {
+        pushPeak(channel, peak, clippedSamples);
+        return;
+    }
+
+    // Ballistics per sample; true peaks are only known per block
+    auto& integrator = m_integrators[static_cast<size_t>(channel)];
+
+    const float limit = m_integratorLimits[channel].exchange(-1.0f, std::memory_order_relaxed);
+    if (limit >= 0.0f)
+        integrator.limit(limit);
+
+    const float highest = truePeak ? integrator.processPeak(settings, peak, numSamples)
+                                   : integrator.process(settings, samples, numSamples);
+
+    m_latestIntegrated[channel].store(integrator.getValue(), std::memory_order_relaxed);
+    atomicMax(m_pendingIntegrated[channel], highest);
+
+    if (clippedSamples > 0)
+        m_pendingClipCounts[channel].fetch_add(static_cast<uint32_t>(clippedSamples), std::memory_order_relaxed);
+}
+
+void LevelMeter::pushBuffer(const juce::AudioBuffer<float>& buffer)
+{
+    const int count = juce::jmin(buffer.getNumChannels(), m_numChannels);
+
+    for (int ch = 0; ch < count; ++ch)
+    {
+        pushSamples(ch, buffer.getReadPointer(ch), buffer.getNumSamples());
+    }
+}
+
+void LevelMeter::pushPeak(int channel, float peak, int clippedSamples)
+{
+    if (channel < 0 || channel >= m_numChannels)
+        return;
+
+    atomicMax(m_pendingPeaks[channel], peak);
+
+    if (clippedSamples > 0)
+        m_pendingClipCounts[channel].fetch_add(static_cast<uint32_t>(clippedSamples), std::memory_order_relaxed);
+}
+
+uint64_t LevelMeter::getClipCount(int channel) const
+{
+    if (channel >= 0 && channel < m_numChannels)
+        return m_clipCounts[channel];
+    return 0;
+}
+
+//==============================================================================
+void LevelMeter::setMeterSource(const MeterHub* hub, int firstIndex)
+{
+    m_meterHub = hub;
+    m_meterHubIndex = juce::jmax(0, firstIndex);
+
+    // Start counting clips from now
+    if (m_meterHub != nullptr)
+    {
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch)
+            m_hubClipCounts[ch] = m_meterHub->read(m_meterHubIndex + ch).clipCount;
+    }
+}
+
+//==============================================================================
+void LevelMeter::setDynamicRangeSource(const DynamicRangeAnalyzer* analyzer, bool useWindow)
+{
+    m_dynamicRange = analyzer;
+    m_dynamicRangeWindow = useWindow;
+    m_dynamicRangeSequence = 0;
+    m_dynamicRangeStats = {};
+    invalidateCachedLayers();
     repaint();
 }
 
@@ -91,26 +277,15 @@ void LevelMeter::setNumChannels(int numChannels)
 void LevelMeter::setBallistics(MeterBallistics ballistics)
 {
     m_ballistics = ballistics;
+    m_ballisticsSpec = BallisticsSpec::forType(ballistics);
+    m_truePeakMode.store(ballistics == MeterBallistics::TruePeak, std::memory_order_relaxed);
+    updateIntegratorSettings();
+}
 
-    // Set coefficients based on ballistics type
-    // Coefficients calculated for 60Hz update rate
-    switch (ballistics)
-    {
-        case MeterBallistics::Peak:
-            m_attackCoeff = 1.0f;           // Instant attack
-            m_releaseCoeff = 0.05f;         // ~200ms release
-            break;
-
-        case MeterBallistics::VU:
-            m_attackCoeff = 0.3f;           // ~300ms integration
-            m_releaseCoeff = 0.3f;          // Same as attack (VU is symmetrical)
-            break;
-
-        case MeterBallistics::PPM:
-            m_attackCoeff = 0.8f;           // Fast attack (~10ms)
-            m_releaseCoeff = 0.02f;         // Slow decay (~1.5s)
-            break;
-    }
+void LevelMeter::setBallisticsSpec(const BallisticsSpec& spec)
+{
+    m_ballisticsSpec = spec;
+    updateIntegratorSettings();
 }
 
 void LevelMeter::setVertical(bool vertical)
@@ -118,6 +293,7 @@ void LevelMeter::setVertical(bool vertical)
     if (m_isVertical != vertical)
     {
         m_isVertical = vertical;
+        invalidateCachedLayers();
         repaint();
     }
 }
@@ -131,12 +307,15 @@ void LevelMeter::setDBRange(float minDB, float maxDB)
 {
     m_minDB = minDB;
     m_maxDB = maxDB;
+    invalidateCachedLayers();
     repaint();
 }
 
 void LevelMeter::setStyle(const LevelMeterStyle& style)
 {
     m_style = style;
+    m_clipThresholdLinear.store(juce::Decibels::decibelsToGain(m_style.clipThreshold));
+    invalidateCachedLayers();
     repaint();
 }
 
@@ -146,6 +325,7 @@ void LevelMeter::clearClip()
     for (int i = 0; i < m_numChannels; ++i)
     {
         m_clipped[i] = false;
+        m_clipCounts[i] = 0;
     }
     repaint();
 }
@@ -167,13 +347,41 @@ bool LevelMeter::hasClipped(int channel) const
     return false;
 }
 
+void LevelMeter::setQuadRenderService(QuadRenderService* service)
+{
+    if (service == m_quadRenderService.get())
+        return;
+
+    if (auto* previous = m_quadRenderService.get())
+        previous->removeClient(*this);
+
+    m_quadRenderService = service;
+    repaint();
+}
+
 //==============================================================================
 void LevelMeter::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("LevelMeter::paint");
+
     auto bounds = getLocalBounds().toFloat();
 
+    auto* service = m_quadRenderService.get();
+    const bool useQuads = service != nullptr && service->isAvailable();
+
     // Background
-    g.fillAll(m_style.backgroundColor);
+    if (useQuads)
+    {
+        m_quads.clear();
+        m_quads.addRectangle(bounds, m_style.backgroundColor);
+    }
+    else
+    {
+        g.fillAll(m_style.backgroundColor);
+    }
+
+    if (isDynamicRangeShown())
+        drawDynamicRange(g, bounds.removeFromBottom(m_style.readoutHeight));
 
     // Calculate meter layout
     float scaleWidth = m_style.showScale ? 30.0f : 0.0f;
@@ -191,12 +399,6 @@ void LevelMeter::paint(juce::Graphics& g)
         meterArea = bounds;
     }
 
-    // Draw scale
-    if (m_style.showScale)
-    {
-        drawScale(g, scaleArea);
-    }
-
     // Calculate meter bounds for each channel
     float totalMeterWidth = m_numChannels * m_style.meterWidth +
                             (m_numChannels - 1) * m_style.meterGap;
@@ -211,24 +413,37 @@ void LevelMeter::paint(juce::Graphics& g)
         startOffset = meterArea.getY() + (meterArea.getHeight() - totalMeterWidth) * 0.5f;
     }
 
-    for (int ch = 0; ch < m_numChannels; ++ch)
+    auto getMeterBounds = [&](int ch)
     {
-        juce::Rectangle<float> meterBounds;
+        const float offset = startOffset + ch * (m_style.meterWidth + m_style.meterGap);
 
         if (m_isVertical)
-        {
-            float x = startOffset + ch * (m_style.meterWidth + m_style.meterGap);
-            meterBounds = juce::Rectangle<float>(x, meterArea.getY(),
-                                                  m_style.meterWidth, meterArea.getHeight());
-        }
-        else
-        {
-            float y = startOffset + ch * (m_style.meterWidth + m_style.meterGap);
-            meterBounds = juce::Rectangle<float>(meterArea.getX(), y,
-                                                  meterArea.getWidth(), m_style.meterWidth);
-        }
+            return juce::Rectangle<float>(offset, meterArea.getY(), m_style.meterWidth, meterArea.getHeight());
+
+        return juce::Rectangle<float>(meterArea.getX(), offset, meterArea.getWidth(), m_style.meterWidth);
+    };
+
+    updateCachedLayers(scaleArea, getMeterBounds(0),
+                       g.getInternalContext().getPhysicalPixelScaleFactor());
+
+    // Draw scale
+    if (m_style.showScale && m_scaleImage.isValid())
+    {
+        g.drawImage(m_scaleImage, scaleArea);
+    }
+
+    if (useQuads)
+    {
+        for (int ch = 0; ch < m_numChannels; ++ch)
+            addMeterQuads(m_quads, getMeterBounds(ch), ch);
 
-        drawMeter(g, meterBounds, ch);
+        service->submit(*this, m_quads);
+        return;
+    }
+
+    for (int ch = 0; ch < m_numChannels; ++ch)
+    {
+        drawMeter(g, getMeterBounds(ch), ch);
     }
 }
 
@@ -246,39 +461,135 @@ void LevelMeter::mouseDown(const juce::MouseEvent& e)
 }
 
 //==============================================================================
-void LevelMeter::timerCallback()
+bool LevelMeter::advanceFrame(double deltaSeconds)
 {
-    updateMeter();
-    repaint();
+    SHMUI_PROFILE_SCOPE("LevelMeter::advanceFrame");
+
+    if (updateMeter(deltaSeconds))
+        repaint();
+
+    // Levels arrive from the audio thread at any time, so keep polling
+    return true;
 }
 
-void LevelMeter::updateMeter()
+bool LevelMeter::updateMeter(double elapsedSeconds)
 {
     const int64_t currentTime = juce::Time::currentTimeMillis();
 
+    // Per-frame integration for levels that only arrive once per frame
+    const auto coefficients = m_ballisticsSpec.getCoefficients(elapsedSeconds);
+
+    const float meterLength = static_cast<float>(m_isVertical ? getHeight() : getWidth());
+    bool needsRepaint = false;
+
+    // One consistent copy of all bound hub entries; a stale hub reads as silence
+    std::array<MeterSnapshot, MAX_CHANNELS> hubValues{};
+    bool hubLive = false;
+    bool hubIntegrated = false;
+    if (m_meterHub != nullptr)
+    {
+        m_meterHub->read(m_meterHubIndex, m_numChannels, hubValues.data());
+        hubLive = !m_meterHub->isStale();
+
+        // The hub's integrated values can be shown as they are if it uses this timing
+        hubIntegrated = hubLive && m_ballistics != MeterBallistics::TruePeak
+                     && m_meterHub->isIntegrating() && m_meterHub->getBallisticsSpec() == m_ballisticsSpec;
+    }
+
+    // Gather each channel's input, then run the ballistics for all channels at once
+    std::array<float, MAX_CHANNELS> inputNorms{};
+    std::array<float, MAX_CHANNELS> inputGains{};
+    std::array<float, MAX_CHANNELS> displayGains{};
+    std::array<float, MAX_CHANNELS> previousGains{};
+    std::array<float, MAX_CHANNELS> integratedGains{};
+    std::array<bool, MAX_CHANNELS> integrated{};
+    std::array<uint32_t, MAX_CHANNELS> newClips{};
+
     for (int ch = 0; ch < m_numChannels; ++ch)
     {
-        float inputLevel = m_inputLevels[ch].load();
+        // Latest setLevel() value, or the loudest pushPeak() since the last frame
+        const float pendingPeak = m_pendingPeaks[ch].exchange(0.0f, std::memory_order_acquire);
+        uint32_t pendingClips = m_pendingClipCounts[ch].exchange(0, std::memory_order_relaxed);
+        float inputLevel = juce::jmax(m_inputLevels[ch].load(), pendingPeak);
 
-        // Convert to normalized
-        float inputNorm = linearToNormalized(inputLevel);
+        // Samples integrated on the audio thread: highest since the last frame and latest
+        const float pendingIntegrated = m_pendingIntegrated[ch].exchange(-1.0f, std::memory_order_acquire);
+        float integratedPeak = 0.0f;
+        float integratedLatest = 0.0f;
 
-        // Apply ballistics
-        float& displayLevel = m_displayLevels[ch];
+        if (pendingIntegrated >= 0.0f)
+        {
+            integrated[ch] = true;
+            integratedPeak = pendingIntegrated;
+            integratedLatest = m_latestIntegrated[ch].load(std::memory_order_relaxed);
+            m_lastFeedTimes[ch] = currentTime;
+        }
+
+        if (m_meterHub != nullptr)
+        {
+            const auto& hub = hubValues[ch];
 
-        if (inputNorm > displayLevel)
+            if (hubIntegrated)
+            {
+                integrated[ch] = true;
+                integratedPeak = juce::jmax(integratedPeak, hub.integratedPeak);
+                integratedLatest = juce::jmax(integratedLatest, hub.integrated);
+            }
+            else if (hubLive)
+            {
+                inputLevel = juce::jmax(inputLevel, m_ballistics == MeterBallistics::TruePeak ? hub.truePeak : hub.peak);
+            }
+
+            const uint32_t lastSeen = m_hubClipCounts[ch];
+            pendingClips += hub.clipCount >= lastSeen ? hub.clipCount - lastSeen
+                                                      : hub.clipCount;   // Counts were reset
+            m_hubClipCounts[ch] = hub.clipCount;
+        }
+
+        m_clipCounts[ch] += pendingClips;
+        newClips[ch] = pendingClips;
+
+        // Ballistics work on linear gain, displayed in dB
+        const float inputNorm = linearToNormalized(inputLevel);
+        const float displayLevel = m_displayLevels[ch];
+        inputNorms[ch] = inputNorm;
+        inputGains[ch] = inputNorm > 0.0f ? inputLevel : 0.0f;
+        displayGains[ch] = displayLevel > 0.0f ? juce::Decibels::decibelsToGain(normalizedToDB(displayLevel)) : 0.0f;
+        previousGains[ch] = displayGains[ch];
+
+        // A new rise shows its highest point; otherwise the integrator's own fall
+        integratedGains[ch] = integratedPeak > displayGains[ch] ? integratedPeak : integratedLatest;
+    }
+
+    BallisticsSpec::apply(coefficients, displayGains.data(), inputGains.data(), m_numChannels);
+
+    for (int ch = 0; ch < m_numChannels; ++ch)
+    {
+        if (integrated[ch])
         {
-            // Attack
-            displayLevel = displayLevel + (inputNorm - displayLevel) * m_attackCoeff;
+            // Already integrated; per-frame input only counts where it is louder
+            displayGains[ch] = inputGains[ch] > integratedGains[ch] ? juce::jmax(displayGains[ch], integratedGains[ch])
+                                                                    : integratedGains[ch];
+        }
+        else if (currentTime - m_lastFeedTimes[ch] <= static_cast<int64_t>(kFeedTimeoutMs))
+        {
+            // Between audio blocks: hold, the next block carries the fall on
+            displayGains[ch] = juce::jmax(displayGains[ch], previousGains[ch]);
         }
         else
         {
-            // Release
-            displayLevel = displayLevel + (inputNorm - displayLevel) * m_releaseCoeff;
+            // No audio: the display falls on the frame clock, and the integrator
+            // restarts from there when audio returns
+            m_integratorLimits[ch].store(displayGains[ch], std::memory_order_relaxed);
         }
+    }
+
+    const float clipThreshNorm = dbToNormalized(m_style.clipThreshold);
 
-        // Clamp
-        displayLevel = juce::jlimit(0.0f, 1.0f, displayLevel);
+    for (int ch = 0; ch < m_numChannels; ++ch)
+    {
+        const float displayLevel = linearToNormalized(displayGains[ch]);
+        m_displayLevels[ch] = displayLevel;
 
         // Update peak hold
         if (displayLevel >= m_peakHolds[ch])
@@ -293,14 +604,41 @@ void LevelMeter::updateMeter()
         }
 
         // Check for clip
-        float clipThreshNorm = dbToNormalized(m_style.clipThreshold);
-        if (inputNorm >= clipThreshNorm && !m_clipped[ch])
+        if ((inputNorms[ch] >= clipThreshNorm || newClips[ch] > 0) && !m_clipped[ch])
         {
             m_clipped[ch] = true;
             if (onClip)
                 onClip(ch);
         }
+
+        // Only repaint when something moved by at least a pixel
+        const int levelPixels = juce::roundToInt(displayLevel * meterLength);
+        const int peakPixels = juce::roundToInt(m_peakHolds[ch] * meterLength);
+
+        if (levelPixels != m_levelPixels[ch] || peakPixels != m_peakPixels[ch]
+            || m_clipped[ch] != m_clipShown[ch])
+        {
+            m_levelPixels[ch] = levelPixels;
+            m_peakPixels[ch] = peakPixels;
+            m_clipShown[ch] = m_clipped[ch];
+            needsRepaint = true;
+        }
+    }
+
+    // Dynamic-range statistics change once per analyzer block
+    if (m_dynamicRange != nullptr)
+    {
+        const uint64_t sequence = m_dynamicRange->getSequence();
+        if (sequence != m_dynamicRangeSequence)
+        {
+            m_dynamicRangeSequence = sequence;
+            m_dynamicRangeStats = m_dynamicRangeWindow ? m_dynamicRange->getWindowStats()
+                                                       : m_dynamicRange->getProgrammeStats();
+            needsRepaint |= m_style.showDynamicRange;
+        }
     }
+
+    return needsRepaint;
 }
 
 float LevelMeter::linearToNormalized(float linear) const
@@ -356,45 +694,24 @@ void LevelMeter::drawMeter(juce::Graphics& g, juce::Rectangle<float> bounds, int
     g.setColour(m_style.backgroundColor.brighter(0.1f));
     g.fillRoundedRectangle(bounds, m_style.cornerRadius);
 
-    // Draw level fill with gradient
-    juce::Rectangle<float> fillBounds;
-
-    if (m_isVertical)
-    {
-        float fillHeight = bounds.getHeight() * displayLevel;
-        fillBounds = bounds.removeFromBottom(fillHeight);
-    }
-    else
-    {
-        float fillWidth = bounds.getWidth() * displayLevel;
-        fillBounds = bounds.removeFromLeft(fillWidth);
-    }
-
-    // Create gradient for level
-    juce::ColourGradient gradient;
-    if (m_isVertical)
-    {
-        gradient = juce::ColourGradient::vertical(
-            m_style.meterColorHigh, bounds.getY(),
-            m_style.meterColorLow, bounds.getBottom());
-    }
-    else
+    // Draw level: the cached full-scale bar, clipped to the current level
+    if (displayLevel > 0.0f && m_gradientImage.isValid())
     {
-        gradient = juce::ColourGradient::horizontal(
-            m_style.meterColorLow, bounds.getX(),
-            m_style.meterColorHigh, bounds.getRight());
-    }
-
-    // Add color stops
-    float yellowNorm = dbToNormalized(m_style.yellowThreshold);
-    float redNorm = dbToNormalized(m_style.redThreshold);
+        juce::Rectangle<float> fillBounds;
 
-    gradient.addColour(0.0, m_style.meterColorLow);
-    gradient.addColour(yellowNorm, m_style.meterColorMid);
-    gradient.addColour(redNorm, m_style.meterColorHigh);
+        if (m_isVertical)
+        {
+            fillBounds = bounds.withTop(bounds.getBottom() - bounds.getHeight() * displayLevel);
+        }
+        else
+        {
+            fillBounds = bounds.withWidth(bounds.getWidth() * displayLevel);
+        }
 
-    g.setGradientFill(gradient);
-    g.fillRoundedRectangle(fillBounds, m_style.cornerRadius);
+        juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(fillBounds.getSmallestIntegerContainer());
+        g.drawImage(m_gradientImage, bounds);
+    }
 
     // Draw peak hold indicator
     if (m_style.showPeakHold && peakHold > 0.01f)
@@ -434,6 +751,166 @@ void LevelMeter::drawMeter(juce::Graphics& g, juce::Rectangle<float> bounds, int
     }
 }
 
+void LevelMeter::addMeterQuads(QuadBatch& batch, juce::Rectangle<float> bounds, int channel) const
+{
+    // Same geometry as drawMeter(), with the cached gradient bar expressed as
+    // one linear gradient quad per colour stop, each clipped to its span
+    const float displayLevel = m_displayLevels[channel];
+    const float peakHold = m_peakHolds[channel];
+    const bool clipped = m_clipped[channel];
+
+    batch.addRoundedRectangle(bounds, m_style.cornerRadius, m_style.backgroundColor.brighter(0.1f));
+
+    if (displayLevel > 0.0f)
+    {
+        const auto fillBounds = m_isVertical
+            ? bounds.withTop(bounds.getBottom() - bounds.getHeight() * displayLevel)
+            : bounds.withWidth(bounds.getWidth() * displayLevel);
+        const auto fillClip = fillBounds.getSmallestIntegerContainer();
+
+        // Point on the bar at a normalized level (low end bottom / left)
+        auto pointAt = [&](float normalized)
+        {
+            return m_isVertical
+                ? juce::Point<float>(bounds.getX(), bounds.getBottom() - bounds.getHeight() * normalized)
+                : juce::Point<float>(bounds.getX() + bounds.getWidth() * normalized, bounds.getY());
+        };
+
+        const float stops[] = { 0.0f, dbToNormalized(m_style.yellowThreshold), dbToNormalized(m_style.redThreshold), 1.0f };
+        const juce::Colour colours[] = { m_style.meterColorLow, m_style.meterColorMid,
+                                         m_style.meterColorHigh, m_style.meterColorHigh };
+
+        for (int i = 0; i < 3; ++i)
+        {
+            if (stops[i + 1] <= stops[i])
+                continue;
+
+            const auto start = pointAt(stops[i]);
+            const auto end = pointAt(stops[i + 1]);
+
+            // Span of this stop, on whole pixels so neighbouring spans tile exactly
+            auto span = fillClip;
+            if (m_isVertical)
+            {
+                const int top = i == 2 ? fillClip.getY() : juce::roundToInt(end.y);
+                const int bottom = i == 0 ? fillClip.getBottom() : juce::roundToInt(start.y);
+                span = span.withTop(top).withBottom(bottom).getIntersection(fillClip);
+            }
+            else
+            {
+                const int left = i == 0 ? fillClip.getX() : juce::roundToInt(start.x);
+                const int right = i == 2 ? fillClip.getRight() : juce::roundToInt(end.x);
+                span = span.withLeft(left).withRight(right).getIntersection(fillClip);
+            }
+
+            if (span.isEmpty())
+                continue;
+
+            auto& quad = batch.addRoundedRectangle(bounds, m_style.cornerRadius, colours[i]);
+            quad.fill = Quad::Fill::Linear;
+            quad.colour2 = colours[i + 1];
+            quad.gradientStart = start;
+            quad.gradientEnd = end;
+            quad.clip = span;
+        }
+    }
+
+    if (m_style.showPeakHold && peakHold > 0.01f)
+    {
+        if (m_isVertical)
+        {
+            const float peakY = bounds.getBottom() - bounds.getHeight() * peakHold;
+            batch.addRectangle({ bounds.getX(), peakY - m_style.peakHoldWidth * 0.5f,
+                                 bounds.getWidth(), m_style.peakHoldWidth },
+                               m_style.peakHoldColor);
+        }
+        else
+        {
+            const float peakX = bounds.getX() + bounds.getWidth() * peakHold;
+            batch.addRectangle({ peakX - m_style.peakHoldWidth * 0.5f, bounds.getY(),
+                                 m_style.peakHoldWidth, bounds.getHeight() },
+                               m_style.peakHoldColor);
+        }
+    }
+
+    if (m_style.showClipIndicator && clipped)
+    {
+        const auto clipBounds = m_isVertical ? bounds.withHeight(6.0f)
+                                             : bounds.withLeft(bounds.getRight() - 6.0f);
+        batch.addRoundedRectangle(clipBounds, m_style.cornerRadius, m_style.clipColor);
+    }
+}
+
+juce::ColourGradient LevelMeter::createMeterGradient(juce::Rectangle<float> bounds) const
+{
+    // Low end at the bottom (vertical) or left (horizontal)
+    juce::ColourGradient gradient;
+    if (m_isVertical)
+    {
+        gradient = juce::ColourGradient(m_style.meterColorLow, bounds.getX(), bounds.getBottom(),
+                                        m_style.meterColorHigh, bounds.getX(), bounds.getY(), false);
+    }
+    else
+    {
+        gradient = juce::ColourGradient(m_style.meterColorLow, bounds.getX(), bounds.getY(),
+                                        m_style.meterColorHigh, bounds.getRight(), bounds.getY(), false);
+    }
+
+    // Add color stops
+    gradient.addColour(dbToNormalized(m_style.yellowThreshold), m_style.meterColorMid);
+    gradient.addColour(dbToNormalized(m_style.redThreshold), m_style.meterColorHigh);
+
+    return gradient;
+}
+
+void LevelMeter::invalidateCachedLayers()
+{
+    m_layersValid = false;
+}
+
+void LevelMeter::updateCachedLayers(juce::Rectangle<float> scaleArea,
+                                    juce::Rectangle<float> meterBounds,
+                                    float pixelScale)
+{
+    const auto scaleSize = scaleArea.withZeroOrigin().getSmallestIntegerContainer();
+    const auto meterSize = meterBounds.withZeroOrigin().getSmallestIntegerContainer();
+
+    if (m_layersValid && scaleSize == m_cachedScaleSize && meterSize == m_cachedMeterSize
+        && pixelScale == m_cachedPixelScale)
+        return;
+
+    m_layersValid = true;
+    m_cachedScaleSize = scaleSize;
+    m_cachedMeterSize = meterSize;
+    m_cachedPixelScale = pixelScale;
+
+    // Render at physical resolution so the cached layers stay sharp on HiDPI
+    auto renderLayer = [pixelScale](juce::Rectangle<int> size, auto&& draw)
+    {
+        const int width = juce::roundToInt(size.getWidth() * pixelScale);
+        const int height = juce::roundToInt(size.getHeight() * pixelScale);
+
+        if (width <= 0 || height <= 0)
+            return juce::Image();
+
+        juce::Image image(juce::Image::ARGB, width, height, true);
+        juce::Graphics g(image);
+        g.addTransform(juce::AffineTransform::scale(pixelScale));
+        draw(g, size.toFloat());
+        return image;
+    };
+
+    m_scaleImage = m_style.showScale
+        ? renderLayer(scaleSize, [this](juce::Graphics& g, juce::Rectangle<float> area) { drawScale(g, area); })
+        : juce::Image();
+
+    m_gradientImage = renderLayer(meterSize, [this](juce::Graphics& g, juce::Rectangle<float> area)
+    {
+        g.setGradientFill(createMeterGradient(area));
+        g.fillRoundedRectangle(area, m_style.cornerRadius);
+    });
+}
+
 void LevelMeter::drawScale(juce::Graphics& g, juce::Rectangle<float> bounds)
 {
     g.setColour(m_style.textColor);
@@ -488,4 +965,26 @@ void LevelMeter::drawScale(juce::Graphics& g, juce::Rectangle<float> bounds)
     }
 }
 
+void LevelMeter::drawDynamicRange(juce::Graphics& g, juce::Rectangle<float> bounds)
+{
+    const auto& stats = m_dynamicRangeStats;
+
+    // "DR12  PLR 9.3  CF 14.1", or placeholders until the first block is measured
+    juce::String text;
+    if (stats.isValid())
+    {
+        text << "DR" << stats.getRoundedDR()
+             << "  PLR " << juce::String(stats.peakToLoudnessRatio, 1)
+             << "  CF " << juce::String(stats.crestFactorDB, 1);
+    }
+    else
+    {
+        text = "DR --";
+    }
+
+    g.setColour(m_style.textColor);
+    g.setFont(m_style.readoutFontSize);
+    g.drawFittedText(text, bounds.toNearestInt(), juce::Justification::centred, 1, 0.7f);
+}
+
 } // namespace shmui
@@ -10,10 +10,16 @@
     - Vertical or horizontal orientation
     - Peak hold indicator with configurable hold time
     - Stereo/multi-channel support
-    - VU, PPM, and Peak ballistics
+    - VU, PPM, Peak and true-peak (dBTP) ballistics
+    - Standard VU (IEC 60268-17) and PPM (IEC 60268-10) timing presets
+    - Ballistics integrated per sample on the audio thread, so tone-burst
+      readings and rise/fall times do not depend on the refresh rate
     - Clip indicator with latch
+    - Lossless audio-thread feed (peak since last frame, clip counts)
     - dB scale markings
     - Gradient coloring (green -> yellow -> red)
+    - Cached scale and gradient layers; repaints only on pixel changes
+    - Optional DR / PLR / crest factor readout from a DynamicRangeAnalyzer
 
   ==============================================================================
 */
@@ -21,23 +27,18 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../Audio/Ballistics.h"
+#include "../Audio/DynamicRangeAnalyzer.h"
+#include "../Audio/MeterHub.h"
+#include "../Audio/TruePeakDetector.h"
+#include "../Utils/FrameClock.h"
 #include "../Utils/Interpolation.h"
+#include "QuadRenderService.h"
 #include <array>
 
 namespace shmui
 {
 
-//==============================================================================
-/**
- * @brief Meter ballistics type.
- */
-enum class MeterBallistics
-{
-    Peak,   ///< Fast response, slow release (digital peak)
-    VU,     ///< VU meter ballistics (300ms integration)
-    PPM     ///< PPM meter ballistics (fast attack, slow decay)
-};
-
 //==============================================================================
 /**
  * @brief Style configuration for LevelMeter.
@@ -68,6 +69,11 @@ struct LevelMeterStyle
     bool showScale = true;
     bool showTicks = true;
     float peakHoldWidth = 2.0f;
+
+    // Dynamic-range readout (shown when a DynamicRangeAnalyzer is bound)
+    bool showDynamicRange = true;
+    float readoutHeight = 14.0f;
+    float readoutFontSize = 10.0f;
 };
 
 //==============================================================================
@@ -77,13 +83,25 @@ struct LevelMeterStyle
  * Provides accurate level metering with configurable ballistics:
  * - Peak: Fast response for digital peak detection
  * - VU: Classic VU meter ballistics (300ms integration)
- * - PPM: European PPM ballistics (fast attack, slow decay)
+ * - PPM, PPMTypeII, Nordic, BBC: IEC 60268-10 peak programme meters
+ * - TruePeak: Peak response measured on the oversampled signal; needs
+ *   prepare() and audio fed through pushSamples()/pushBuffer()
+ *
+ * Audio fed with pushSamples()/pushBuffer() after prepare() is run
+ * through the ballistics per sample on the audio thread (PeakIntegrator),
+ * so tone bursts read as IEC 60268-10 specifies at any refresh rate; each
+ * frame shows the highest integrated value since the last one. The
+ * display only falls on its own clock once no audio has arrived for
+ * 100 ms. Levels from setLevel() and pushPeak() arrive once per
+ * frame and are integrated over the time elapsed between frames, which
+ * is exact for steady levels only. Custom timing can be set with
+ * setBallisticsSpec().
  *
  * Supports mono, stereo, or multi-channel operation.
  * Thread-safe level updates via atomic values.
  */
 class LevelMeter : public juce::Component,
-                   private juce::Timer
+                   private FrameClockClient
 {
 public:
     //==============================================================================
@@ -124,6 +142,101 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Get a channel's displayed level (normalized 0-1).
+     */
+    float getDisplayLevel(int channel) const;
+
+    /// @}
+
+    //==============================================================================
+    /// @name Audio Thread Feed
+    /// Lock-free, allocation-free. Unlike setLevel(), which overwrites,
+    /// these keep the maximum since the meter last read it and count
+    /// clipped samples, so no peak or clip is lost between UI frames.
+    /// @{
+
+    /**
+     * @brief Prepare per-sample ballistics and true-peak detection for a sample rate.
+     *
+     * Call from prepareToPlay(), before samples are pushed. Until then
+     * pushed samples are integrated per frame like pushPeak(), and the
+     * TruePeak ballistics fall back to sample peak.
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Feed raw samples for a channel (audio thread).
+     * @param channel Channel index (0-based)
+     * @param samples Sample data
+     * @param numSamples Number of samples
+     */
+    void pushSamples(int channel, const float* samples, int numSamples);
+
+    /**
+     * @brief Feed every channel of a buffer (audio thread).
+     *
+     * Channels beyond the meter's channel count are ignored.
+     */
+    void pushBuffer(const juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Feed a precomputed block peak (audio thread).
+     *
+     * The peak is integrated per frame, not per sample; use pushSamples()
+     * where tone-burst readings matter.
+     *
+     * @param channel Channel index (0-based)
+     * @param peak Absolute peak of the block (linear)
+     * @param clippedSamples Samples in the block at or above the clip threshold
+     */
+    void pushPeak(int channel, float peak, int clippedSamples = 0);
+
+    /**
+     * @brief Number of clipped samples seen since the last clearClip().
+     *
+     * Counts samples fed through pushSamples()/pushPeak(). With TruePeak
+     * ballistics a block whose only over is between samples counts once.
+     */
+    uint64_t getClipCount(int channel) const;
+
+    /// @}
+
+    //==============================================================================
+    /// @name Meter Hub
+    /// @{
+
+    /**
+     * @brief Read levels from a MeterHub instead of (or as well as) the feed.
+     *
+     * Channel c shows hub entry firstIndex + c: its peak, or its true peak
+     * with TruePeak ballistics, and its clip count. Pass nullptr to unbind.
+     * The hub must outlive the binding.
+     *
+     * If the hub integrates with the same timing (MeterHub::setBallistics()
+     * with this meter's getBallisticsSpec()), its per-sample integrated
+     * values are shown as they are; otherwise its peaks are integrated per
+     * frame.
+     */
+    void setMeterSource(const MeterHub* hub, int firstIndex = 0);
+
+    /// @}
+
+    //==============================================================================
+    /// @name Dynamic Range Readout
+    /// @{
+
+    /**
+     * @brief Show DR score, PLR and crest factor below the meter.
+     *
+     * The readout updates when the analyzer publishes (every 3 s block).
+     * Pass nullptr to hide it. The analyzer must outlive the binding.
+     *
+     * @param analyzer Analyzer to read (not owned)
+     * @param useWindow Show the analyzer's window instead of the whole programme
+     */
+    void setDynamicRangeSource(const DynamicRangeAnalyzer* analyzer, bool useWindow = false);
+
     /// @}
 
     //==============================================================================
@@ -141,7 +254,7 @@ public:
     int getNumChannels() const { return m_numChannels; }
 
     /**
-     * @brief Set meter ballistics.
+     * @brief Set meter ballistics (measurement and standard timing).
      */
     void setBallistics(MeterBallistics ballistics);
 
@@ -150,6 +263,18 @@ public:
      */
     MeterBallistics getBallistics() const { return m_ballistics; }
 
+    /**
+     * @brief Override the timing of the current ballistics.
+     *
+     * Reset by the next setBallistics().
+     */
+    void setBallisticsSpec(const BallisticsSpec& spec);
+
+    /**
+     * @brief Get current ballistics timing.
+     */
+    const BallisticsSpec& getBallisticsSpec() const { return m_ballisticsSpec; }
+
     /**
      * @brief Set meter orientation (true = vertical, false = horizontal).
      */
@@ -203,6 +328,25 @@ public:
 
     /// @}
 
+    //==============================================================================
+    /// @name Rendering
+    /// @{
+
+    /**
+     * @brief Draw the meter bars through a shared QuadRenderService (nullptr = juce::Graphics).
+     *
+     * The service must be attached to a component that contains this one.
+     * The scale and dynamic-range readout are still painted on the CPU.
+     */
+    void setQuadRenderService(QuadRenderService* service);
+
+    /**
+     * @brief Get the shared quad renderer, if any.
+     */
+    QuadRenderService* getQuadRenderService() const { return m_quadRenderService.get(); }
+
+    /// @}
+
     //==============================================================================
     /// @name Clip Indicator
     /// @{
@@ -233,6 +377,19 @@ public:
 
     /// @}
 
+    //==============================================================================
+    /// @name Testing
+    /// @{
+
+    /**
+     * @brief Run one frame of deltaSeconds without the FrameClock.
+     *
+     * For benchmarks and self-checks, which drive frames by hand.
+     */
+    void advanceFrameForTesting(double deltaSeconds) { advanceFrame(deltaSeconds); }
+
+    /// @}
+
     //==============================================================================
     // Component overrides
     void paint(juce::Graphics& g) override;
@@ -241,18 +398,30 @@ public:
 
 private:
     //==============================================================================
-    void timerCallback() override;
-    void updateMeter();
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    bool updateMeter(double elapsedSeconds);
+    void updateIntegratorSettings();
+    void syncIntegratorSettings();
     float linearToNormalized(float linear) const;
     float dbToNormalized(float dB) const;
     float normalizedToDB(float normalized) const;
     juce::Colour getColorForLevel(float normalized) const;
     void drawMeter(juce::Graphics& g, juce::Rectangle<float> bounds, int channel);
+    void addMeterQuads(QuadBatch& batch, juce::Rectangle<float> bounds, int channel) const;
     void drawScale(juce::Graphics& g, juce::Rectangle<float> bounds);
+    void drawDynamicRange(juce::Graphics& g, juce::Rectangle<float> bounds);
+    bool isDynamicRangeShown() const { return m_dynamicRange != nullptr && m_style.showDynamicRange; }
+    juce::ColourGradient createMeterGradient(juce::Rectangle<float> bounds) const;
+    void updateCachedLayers(juce::Rectangle<float> scaleArea, juce::Rectangle<float> meterBounds, float pixelScale);
+    void invalidateCachedLayers();
 
     //==============================================================================
     static constexpr int MAX_CHANNELS = 8;
 
+    /** Time without pushed samples after which the display falls on its own. */
+    static constexpr double kFeedTimeoutMs = 100.0;
+
     int m_numChannels = 1;
     bool m_isVertical = true;
     MeterBallistics m_ballistics = MeterBallistics::Peak;
@@ -272,9 +441,62 @@ private:
     std::array<int64_t, MAX_CHANNELS> m_peakHoldTimes{};            // Peak hold timestamps
     std::array<bool, MAX_CHANNELS> m_clipped{};                     // Clip indicators
 
-    // Ballistics parameters
-    float m_attackCoeff = 0.0f;
-    float m_releaseCoeff = 0.0f;
+    // Audio thread feed: max / count since the last UI read, taken with exchange(0)
+    std::array<std::atomic<float>, MAX_CHANNELS> m_pendingPeaks{};
+    std::array<std::atomic<uint32_t>, MAX_CHANNELS> m_pendingClipCounts{};
+    std::array<uint64_t, MAX_CHANNELS> m_clipCounts{};              // Clipped samples since clearClip()
+    std::atomic<float> m_clipThresholdLinear{1.0f};
+
+    // Per-sample ballistics (audio thread). Settings are handed over under the
+    // lock, which the audio thread only ever tries; a new version restarts the integrators
+    std::array<PeakIntegrator, MAX_CHANNELS> m_integrators;
+    PeakIntegrator::Settings m_integratorSettings;                  // Written by the message thread
+    PeakIntegrator::Settings m_audioIntegratorSettings;             // Audio thread copy
+    juce::SpinLock m_integratorLock;
+    std::atomic<uint32_t> m_integratorVersion{0};
+    uint32_t m_audioIntegratorVersion = 0;
+    double m_sampleRate = 0.0;
+
+    // Integrated feed: highest value since the last frame (-1 if none) and the latest value
+    std::array<std::atomic<float>, MAX_CHANNELS> m_pendingIntegrated{};
+    std::array<std::atomic<float>, MAX_CHANNELS> m_latestIntegrated{};
+    std::array<std::atomic<float>, MAX_CHANNELS> m_integratorLimits{};  // Level to restart from, -1 if none
+    std::array<int64_t, MAX_CHANNELS> m_lastFeedTimes{};              // Last frame with integrated input
+
+    // Meter hub binding
+    const MeterHub* m_meterHub = nullptr;
+    int m_meterHubIndex = 0;
+    std::array<uint32_t, MAX_CHANNELS> m_hubClipCounts{};           // Last clip count seen per channel
+
+    // Dynamic-range readout binding and the last statistics read
+    const DynamicRangeAnalyzer* m_dynamicRange = nullptr;
+    bool m_dynamicRangeWindow = false;
+    uint64_t m_dynamicRangeSequence = 0;
+    DynamicRangeStats m_dynamicRangeStats;
+
+    // True-peak detection (audio thread), prepared for MAX_CHANNELS
+    TruePeakDetector m_truePeakDetector;
+    std::atomic<bool> m_truePeakMode{false};
+
+    // Cached static layers, rebuilt when size, style, range or orientation change
+    juce::Image m_scaleImage;                                        // Scale text and ticks
+    juce::Image m_gradientImage;                                     // Full-scale meter bar
+    juce::Rectangle<int> m_cachedScaleSize;
+    juce::Rectangle<int> m_cachedMeterSize;
+    float m_cachedPixelScale = 0.0f;
+    bool m_layersValid = false;
+
+    // Last level / peak hold positions in pixels, to skip repaints that change nothing
+    std::array<int, MAX_CHANNELS> m_levelPixels{};
+    std::array<int, MAX_CHANNELS> m_peakPixels{};
+    std::array<bool, MAX_CHANNELS> m_clipShown{};
+
+    // Ballistics timing
+    BallisticsSpec m_ballisticsSpec;
+
+    // Shared GL rendering (the cached layers above are the CPU path)
+    QuadBatch m_quads;
+    juce::WeakReference<QuadRenderService> m_quadRenderService;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
 };
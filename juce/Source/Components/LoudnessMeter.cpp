@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: shmui Component Library
+
+    Loudness meter implementation.
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+#include "../Utils/Profiling.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+bool LoudnessMeter::Readings::operator==(const Readings& other) const
+{
+    return momentary == other.momentary
+        && shortTerm == other.shortTerm
+        && integrated == other.integrated
+        && loudnessRange == other.loudnessRange
+        && maxMomentary == other.maxMomentary;
+}
+
+//==============================================================================
+LoudnessMeter::LoudnessMeter()
+{
+    // Analyzer readings change every 100 ms; poll a little faster
+    setMaxFrameRate(30.0);
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+    stopFrames();
+}
+
+//==============================================================================
+void LoudnessMeter::setAnalyzer(LoudnessAnalyzer* analyzer)
+{
+    m_analyzer = analyzer;
+    m_readings = {};
+
+    if (m_analyzer != nullptr)
+        startFrames();
+    else
+        stopFrames();
+
+    repaint();
+}
+
+void LoudnessMeter::resetIntegration()
+{
+    if (m_analyzer != nullptr)
+        m_analyzer->resetIntegration();
+}
+
+//==============================================================================
+void LoudnessMeter::setDisplayRange(float minLUFS, float maxLUFS)
+{
+    m_minLUFS = minLUFS;
+    m_maxLUFS = juce::jmax(minLUFS + 1.0f, maxLUFS);
+    repaint();
+}
+
+void LoudnessMeter::setStyle(const LoudnessMeterStyle& style)
+{
+    m_style = style;
+    repaint();
+}
+
+//==============================================================================
+bool LoudnessMeter::advanceFrame(double deltaSeconds)
+{
+    SHMUI_PROFILE_SCOPE("LoudnessMeter::advanceFrame");
+
+    juce::ignoreUnused(deltaSeconds);
+
+    if (m_analyzer == nullptr)
+        return false;
+
+    Readings readings;
+    readings.momentary = m_analyzer->getMomentaryLoudness();
+    readings.shortTerm = m_analyzer->getShortTermLoudness();
+    readings.integrated = m_analyzer->getIntegratedLoudness();
+    readings.loudnessRange = m_analyzer->getLoudnessRange();
+    readings.maxMomentary = m_analyzer->getMaxMomentaryLoudness();
+
+    // Only repaint when the analyzer has published something new
+    if (!(readings == m_readings))
+    {
+        m_readings = readings;
+        repaint();
+    }
+
+    return true;
+}
+
+//==============================================================================
+void LoudnessMeter::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("LoudnessMeter::paint");
+
+    auto bounds = getLocalBounds().toFloat();
+
+    // Background
+    g.fillAll(m_style.backgroundColor);
+
+    if (m_style.showReadouts)
+    {
+        drawReadouts(g, bounds.removeFromBottom(m_style.readoutHeight));
+    }
+
+    // Leave room for the M / S labels
+    auto labelArea = bounds.removeFromBottom(14.0f);
+
+    if (m_style.showScale)
+    {
+        drawScale(g, bounds.removeFromLeft(30.0f));
+        labelArea.removeFromLeft(30.0f);
+    }
+
+    // Centre the two bars in the remaining space
+    const float totalWidth = m_style.meterWidth * 2.0f + m_style.meterGap;
+    const float startX = bounds.getX() + (bounds.getWidth() - totalWidth) * 0.5f;
+
+    juce::Rectangle<float> momentaryBounds(startX, bounds.getY(), m_style.meterWidth, bounds.getHeight());
+    juce::Rectangle<float> shortTermBounds(startX + m_style.meterWidth + m_style.meterGap, bounds.getY(),
+                                           m_style.meterWidth, bounds.getHeight());
+
+    // Target band across both bars
+    const float targetNorm = lufsToNormalized(m_style.targetLoudness);
+    const float upperNorm = lufsToNormalized(m_style.targetLoudness + m_style.tolerance);
+    const float lowerNorm = lufsToNormalized(m_style.targetLoudness - m_style.tolerance);
+    const float left = momentaryBounds.getX() - 3.0f;
+    const float right = shortTermBounds.getRight() + 3.0f;
+
+    g.setColour(m_style.onTargetColor.withAlpha(0.15f));
+    g.fillRect(juce::Rectangle<float>(left, bounds.getBottom() - bounds.getHeight() * upperNorm,
+                                      right - left, bounds.getHeight() * (upperNorm - lowerNorm)));
+
+    drawBar(g, momentaryBounds, m_readings.momentary);
+    drawBar(g, shortTermBounds, m_readings.shortTerm);
+
+    g.setColour(m_style.targetColor);
+    g.fillRect(left, bounds.getBottom() - bounds.getHeight() * targetNorm - 0.5f, right - left, 1.0f);
+
+    // Max momentary hold
+    if (m_style.showMaxHold && std::isfinite(m_readings.maxMomentary))
+    {
+        const float maxNorm = lufsToNormalized(m_readings.maxMomentary);
+        if (maxNorm > 0.0f)
+        {
+            g.setColour(m_style.maxHoldColor);
+            g.fillRect(momentaryBounds.getX(), momentaryBounds.getBottom() - momentaryBounds.getHeight() * maxNorm - 1.0f,
+                       momentaryBounds.getWidth(), 2.0f);
+        }
+    }
+
+    // Bar labels
+    g.setColour(m_style.textColor);
+    g.setFont(9.0f);
+    g.drawText("M", juce::Rectangle<float>(momentaryBounds.getX(), labelArea.getY(), m_style.meterWidth, labelArea.getHeight()),
+               juce::Justification::centred, false);
+    g.drawText("S", juce::Rectangle<float>(shortTermBounds.getX(), labelArea.getY(), m_style.meterWidth, labelArea.getHeight()),
+               juce::Justification::centred, false);
+}
+
+void LoudnessMeter::resized()
+{
+    // No child components to layout
+}
+
+//==============================================================================
+float LoudnessMeter::lufsToNormalized(float lufs) const
+{
+    if (!std::isfinite(lufs))
+        return 0.0f;
+
+    return juce::jlimit(0.0f, 1.0f, (lufs - m_minLUFS) / (m_maxLUFS - m_minLUFS));
+}
+
+juce::Colour LoudnessMeter::getColorForLoudness(float lufs) const
+{
+    if (lufs > m_style.targetLoudness + m_style.tolerance)
+        return m_style.overColor;
+
+    if (lufs >= m_style.targetLoudness - m_style.tolerance)
+        return m_style.onTargetColor;
+
+    return m_style.barColor;
+}
+
+void LoudnessMeter::drawBar(juce::Graphics& g, juce::Rectangle<float> bounds, float lufs)
+{
+    // Track
+    g.setColour(m_style.backgroundColor.brighter(0.1f));
+    g.fillRoundedRectangle(bounds, m_style.cornerRadius);
+
+    const float normalized = lufsToNormalized(lufs);
+    if (normalized <= 0.0f)
+        return;
+
+    g.setColour(getColorForLoudness(lufs));
+    g.fillRoundedRectangle(bounds.removeFromBottom(bounds.getHeight() * normalized), m_style.cornerRadius);
+}
+
+void LoudnessMeter::drawScale(juce::Graphics& g, juce::Rectangle<float> bounds)
+{
+    g.setFont(9.0f);
+
+    // Marks every 6 LU from the top of the range
+    const float top = std::floor(m_maxLUFS / 6.0f) * 6.0f;
+
+    for (float lufs = top; lufs >= m_minLUFS; lufs -= 6.0f)
+    {
+        const float y = bounds.getBottom() - bounds.getHeight() * lufsToNormalized(lufs);
+
+        g.setColour(m_style.tickColor);
+        g.drawHorizontalLine(static_cast<int>(y), bounds.getRight() - 5, bounds.getRight());
+
+        g.setColour(m_style.textColor);
+        g.drawText(juce::String(static_cast<int>(lufs)), bounds.getX(), y - 6, bounds.getWidth() - 6, 12,
+                   juce::Justification::centredRight, false);
+    }
+}
+
+void LoudnessMeter::drawReadouts(juce::Graphics& g, juce::Rectangle<float> bounds)
+{
+    bounds.reduce(4.0f, 2.0f);
+    const float rowHeight = bounds.getHeight() / 3.0f;
+
+    auto drawRow = [&](const juce::String& name, const juce::String& value, juce::Colour valueColor)
+    {
+        auto row = bounds.removeFromTop(rowHeight);
+
+        g.setColour(m_style.textColor);
+        g.setFont(9.0f);
+        g.drawText(name, row, juce::Justification::centredLeft, false);
+
+        g.setColour(valueColor);
+        g.setFont(11.0f);
+        g.drawText(value, row, juce::Justification::centredRight, false);
+    };
+
+    const float integrated = m_readings.integrated;
+    drawRow("I", formatLUFS(integrated),
+            std::isfinite(integrated) ? getColorForLoudness(integrated) : m_style.readoutColor);
+    drawRow("S", formatLUFS(m_readings.shortTerm), m_style.readoutColor);
+    drawRow("LRA", juce::String(m_readings.loudnessRange, 1) + " LU", m_style.readoutColor);
+}
+
+juce::String LoudnessMeter::formatLUFS(float lufs)
+{
+    if (!std::isfinite(lufs))
+        return "-inf";
+
+    return juce::String(lufs, 1);
+}
+
+} // namespace shmui
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: shmui Component Library
+
+    EBU R128 loudness meter (LUFS) driven by a LoudnessAnalyzer.
+
+    Features:
+    - Momentary and short-term bars on a LUFS scale
+    - Target loudness marker with tolerance band
+    - Max momentary hold
+    - Integrated loudness, LRA and short-term readouts
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/LoudnessAnalyzer.h"
+#include "../Utils/FrameClock.h"
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Style configuration for LoudnessMeter.
+ */
+struct LoudnessMeterStyle
+{
+    // Colors
+    juce::Colour backgroundColor = juce::Colour(0xFF1A1A1A);
+    juce::Colour barColor = juce::Colour(0xFF3B82F6);          // Blue (below target)
+    juce::Colour onTargetColor = juce::Colour(0xFF22C55E);     // Green (within tolerance)
+    juce::Colour overColor = juce::Colour(0xFFEF4444);         // Red (above tolerance)
+    juce::Colour targetColor = juce::Colours::white;
+    juce::Colour maxHoldColor = juce::Colour(0xC0FFFFFF);
+    juce::Colour textColor = juce::Colour(0x80FFFFFF);
+    juce::Colour readoutColor = juce::Colour(0xE0FFFFFF);
+    juce::Colour tickColor = juce::Colour(0x40FFFFFF);
+
+    // Target (EBU R128 default: -23 LUFS, +/-1 LU)
+    float targetLoudness = -23.0f;
+    float tolerance = 1.0f;
+
+    // Appearance
+    float meterWidth = 10.0f;         // Width of each bar
+    float meterGap = 4.0f;            // Gap between momentary and short-term bars
+    float cornerRadius = 2.0f;
+    float readoutHeight = 48.0f;      // Text area below the bars
+    bool showScale = true;
+    bool showReadouts = true;
+    bool showMaxHold = true;
+};
+
+//==============================================================================
+/**
+ * @brief Loudness meter component (EBU R128).
+ *
+ * Shows momentary (M) and short-term (S) loudness as two bars against a
+ * target marker, with integrated loudness (I) and loudness range (LRA)
+ * printed underneath. Readings come from a LoudnessAnalyzer fed on the
+ * audio thread; the meter only polls its atomics, so it never blocks
+ * audio.
+ *
+ * Works as a companion to LevelMeter: same layout, scale and style
+ * conventions.
+ */
+class LoudnessMeter : public juce::Component,
+                      private FrameClockClient
+{
+public:
+    //==============================================================================
+    LoudnessMeter();
+    ~LoudnessMeter() override;
+
+    //==============================================================================
+    /// @name Source
+    /// @{
+
+    /**
+     * @brief Set the analyzer to display (not owned, may be nullptr).
+     */
+    void setAnalyzer(LoudnessAnalyzer* analyzer);
+
+    /**
+     * @brief Get the displayed analyzer.
+     */
+    LoudnessAnalyzer* getAnalyzer() const { return m_analyzer; }
+
+    /**
+     * @brief Restart integrated loudness, LRA and max hold.
+     */
+    void resetIntegration();
+
+    /// @}
+
+    //==============================================================================
+    /// @name Configuration
+    /// @{
+
+    /**
+     * @brief Set displayed LUFS range (e.g., -50 to 0).
+     */
+    void setDisplayRange(float minLUFS, float maxLUFS);
+
+    /**
+     * @brief Get min displayed LUFS.
+     */
+    float getMinLUFS() const { return m_minLUFS; }
+
+    /**
+     * @brief Get max displayed LUFS.
+     */
+    float getMaxLUFS() const { return m_maxLUFS; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Style
+    /// @{
+
+    /**
+     * @brief Set visual style.
+     */
+    void setStyle(const LoudnessMeterStyle& style);
+
+    /**
+     * @brief Get current style.
+     */
+    const LoudnessMeterStyle& getStyle() const { return m_style; }
+
+    /// @}
+
+    //==============================================================================
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==============================================================================
+    struct Readings
+    {
+        float momentary = LoudnessAnalyzer::kSilence;
+        float shortTerm = LoudnessAnalyzer::kSilence;
+        float integrated = LoudnessAnalyzer::kSilence;
+        float loudnessRange = 0.0f;
+        float maxMomentary = LoudnessAnalyzer::kSilence;
+
+        bool operator==(const Readings& other) const;
+    };
+
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    float lufsToNormalized(float lufs) const;
+    juce::Colour getColorForLoudness(float lufs) const;
+    void drawBar(juce::Graphics& g, juce::Rectangle<float> bounds, float lufs);
+    void drawScale(juce::Graphics& g, juce::Rectangle<float> bounds);
+    void drawReadouts(juce::Graphics& g, juce::Rectangle<float> bounds);
+    static juce::String formatLUFS(float lufs);
+
+    //==============================================================================
+    LoudnessAnalyzer* m_analyzer = nullptr;
+    LoudnessMeterStyle m_style;
+    Readings m_readings;
+
+    // Display range
+    float m_minLUFS = -50.0f;
+    float m_maxLUFS = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
+
+} // namespace shmui
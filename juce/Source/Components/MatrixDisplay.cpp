@@ -10,72 +10,176 @@
 */
 
 #include "MatrixDisplay.h"
+#include "../Utils/Profiling.h"
+#include "../Utils/Interpolation.h"
+#include <cmath>
 #include <set>
 
 namespace shmui
 {
 
+//==============================================================================
+// Flat frame conversion
+
+Frame FlatFrame::toNested() const
+{
+    Frame result = createEmptyFrame(rows, cols);
+
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+            result[r][c] = cellToBrightness(cells[static_cast<size_t>(r) * cols + c]);
+
+    return result;
+}
+
+std::vector<Frame> FrameArena::toNested() const
+{
+    std::vector<Frame> result;
+    result.reserve(static_cast<size_t>(numFrames));
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const auto frame = (*this)[i];
+        Frame nested = createEmptyFrame(rows, cols);
+
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c)
+                nested[r][c] = frame.getBrightness(r, c);
+
+        result.push_back(std::move(nested));
+    }
+
+    return result;
+}
+
 //==============================================================================
 // Utility Functions
 
+static constexpr int kVUMeterRows = 7;
+
 Frame createEmptyFrame(int rows, int cols)
 {
     return Frame(rows, std::vector<float>(cols, 0.0f));
 }
 
-Frame createVUMeterFrame(int columns, const std::vector<float>& levels)
+namespace
 {
-    // From matrix.tsx vu function
-    const int rows = 7;
-    Frame frame = createEmptyFrame(rows, columns);
+    /**
+     * Writable nested frame with the MutableFrameView set() interface, so
+     * the generators below fill the compatibility Frame form directly at
+     * full float precision instead of going through 8-bit cells.
+     */
+    struct NestedFrameView
+    {
+        Frame* frame;
 
-    for (int col = 0; col < std::min(columns, static_cast<int>(levels.size())); ++col)
+        void set(int row, int col, float brightness) const
+        {
+            if (row >= 0 && row < static_cast<int>(frame->size())
+                && col >= 0 && col < static_cast<int>((*frame)[static_cast<size_t>(row)].size()))
+                (*frame)[static_cast<size_t>(row)][static_cast<size_t>(col)] = brightness;
+        }
+    };
+
+    /** Nested counterpart of the FrameArena calls the animation generators use. */
+    class NestedFrames
     {
-        const float level = juce::jlimit(0.0f, 1.0f, levels[col]);
-        const int height = static_cast<int>(level * rows);
+    public:
+        void reset(int numRows, int numCols, int framesToReserve)
+        {
+            rows = std::max(1, numRows);
+            cols = std::max(1, numCols);
+            frames.clear();
+            frames.reserve(static_cast<size_t>(std::max(0, framesToReserve)));
+        }
+
+        NestedFrameView addFrame()
+        {
+            frames.push_back(createEmptyFrame(rows, cols));
+            return { &frames.back() };
+        }
+
+        std::vector<Frame> frames;
+
+    private:
+        int rows = 1;
+        int cols = 1;
+    };
 
-        for (int row = 0; row < rows; ++row)
+    template <typename FrameWriter>
+    void writeVUMeter(const FrameWriter& frame, int rows, int numColumns, const float* levels, int numLevels)
+    {
+        // From matrix.tsx vu function
+        for (int col = 0; col < std::min(numColumns, numLevels); ++col)
         {
-            const int rowFromBottom = rows - 1 - row;
+            const float level = juce::jlimit(0.0f, 1.0f, levels[col]);
+            const int height = static_cast<int>(level * rows);
 
-            if (rowFromBottom < height)
+            for (int row = 0; row < rows; ++row)
             {
-                // Brightness gradient (top = brightest)
-                float brightness;
-                if (row < rows * 0.3f)
-                    brightness = 1.0f;
-                else if (row < rows * 0.6f)
-                    brightness = 0.8f;
-                else
-                    brightness = 0.6f;
+                const int rowFromBottom = rows - 1 - row;
 
-                frame[row][col] = brightness;
+                if (rowFromBottom < height)
+                {
+                    // Brightness gradient (top = brightest)
+                    float brightness;
+                    if (row < rows * 0.3f)
+                        brightness = 1.0f;
+                    else if (row < rows * 0.6f)
+                        brightness = 0.8f;
+                    else
+                        brightness = 0.6f;
+
+                    frame.set(row, col, brightness);
+                }
             }
         }
     }
+}
 
+Frame createVUMeterFrame(int columns, const std::vector<float>& levels)
+{
+    Frame frame = createEmptyFrame(kVUMeterRows, columns);
+    writeVUMeter(NestedFrameView { &frame }, kVUMeterRows, columns, levels.data(), static_cast<int>(levels.size()));
     return frame;
 }
 
+void writeVUMeterFrame(MutableFrameView frame, const float* levels, int numLevels)
+{
+    frame.clear();
+    writeVUMeter(frame, frame.getNumRows(), frame.getNumColumns(), levels, numLevels);
+}
+
 //==============================================================================
 // MatrixDisplay
 
 MatrixDisplay::MatrixDisplay()
 {
-    currentFrame = createEmptyFrame(rows, cols);
+    currentFrame.resize(rows, cols);
+    onColours.buildAlphaRamp(onColour);
     setOpaque(false);
 }
 
 MatrixDisplay::~MatrixDisplay()
 {
-    stopTimer();
+    stopFrames();
+
+    if (auto* service = quadRenderService.get())
+        service->removeClient(*this);
 }
 
 void MatrixDisplay::setSize(int newRows, int newCols)
 {
     rows = std::max(1, newRows);
     cols = std::max(1, newCols);
-    currentFrame = createEmptyFrame(rows, cols);
+
+    // A playing animation stays on screen; FrameView reads cells outside
+    // a frame of another size as off
+    currentFrame.resize(rows, cols);
+
+    if (spectrogramMode)
+        resetSpectrogram();
+
     repaint();
 }
 
@@ -83,65 +187,299 @@ void MatrixDisplay::setPattern(const Frame& pattern)
 {
     // Stop any animation
     animationPlaying = false;
-    stopTimer();
+    showingAnimation = false;
+    stopFrames();
+    exitSpectrogramMode();
+    vuLevels.clear();
+
+    currentFrame.assign(pattern, rows, cols);
+    repaint();
+}
+
+void MatrixDisplay::setPattern(FrameView pattern)
+{
+    animationPlaying = false;
+    showingAnimation = false;
+    stopFrames();
+    exitSpectrogramMode();
     vuLevels.clear();
 
-    currentFrame = ensureFrameSize(pattern);
+    currentFrame.assign(pattern, rows, cols);
     repaint();
 }
 
 void MatrixDisplay::setFrames(const std::vector<Frame>& frames, float newFps, bool shouldLoop)
 {
-    animationFrames = frames;
+    auto arena = std::make_shared<FrameArena>(rows, cols, static_cast<int>(frames.size()));
+
+    for (const auto& frame : frames)
+        arena->addFrame(frame);
+
+    animationFrames = std::move(arena);
+    startAnimationFrames(newFps, shouldLoop);
+}
+
+void MatrixDisplay::setFrames(FrameArena&& frames, float newFps, bool shouldLoop)
+{
+    animationFrames = std::make_shared<const FrameArena>(std::move(frames));
+    startAnimationFrames(newFps, shouldLoop);
+}
+
+void MatrixDisplay::setFrames(std::shared_ptr<const FrameArena> frames, float newFps, bool shouldLoop)
+{
+    animationFrames = std::move(frames);
+    startAnimationFrames(newFps, shouldLoop);
+}
+
+void MatrixDisplay::startAnimationFrames(float newFps, bool shouldLoop)
+{
+    exitSpectrogramMode();
+
     fps = newFps;
     loop = shouldLoop;
     frameIndex = 0;
     accumulator = 0.0f;
     vuLevels.clear();
 
-    if (!animationFrames.empty())
-    {
-        currentFrame = ensureFrameSize(animationFrames[0]);
-    }
-    else
-    {
-        currentFrame = createEmptyFrame(rows, cols);
-    }
+    // Frames are read in place from the arena, so only the static frame is reset
+    showingAnimation = animationFrames != nullptr && !animationFrames->empty();
+
+    if (!showingAnimation)
+        currentFrame.resize(rows, cols);
 
     repaint();
 }
 
 void MatrixDisplay::setLevels(const std::vector<float>& levels)
 {
+    exitSpectrogramMode();
+
     vuLevels = levels;
-    currentFrame = createVUMeterFrame(cols, levels);
+    showingAnimation = false;
+
+    // Reuses the frame buffer, so streaming levels does not allocate
+    currentFrame.resize(kVUMeterRows, cols);
+    writeVUMeterFrame(currentFrame.mutableView(), vuLevels.data(), static_cast<int>(vuLevels.size()));
     repaint();
 }
 
 void MatrixDisplay::clear()
 {
     animationPlaying = false;
-    stopTimer();
-    animationFrames.clear();
+    showingAnimation = false;
+    stopFrames();
+    exitSpectrogramMode();
+    animationFrames.reset();
     vuLevels.clear();
-    currentFrame = createEmptyFrame(rows, cols);
+    currentFrame.resize(rows, cols);
     repaint();
 }
 
 void MatrixDisplay::play()
 {
-    if (!animationFrames.empty())
+    if (animationFrames != nullptr && !animationFrames->empty())
     {
+        exitSpectrogramMode();
+
         animationPlaying = true;
-        lastTime = juce::Time::currentTimeMillis();
-        startTimerHz(60);
+        showingAnimation = true;
+        frameIndex = juce::jlimit(0, animationFrames->size() - 1, frameIndex);
+        startFrames();
+    }
+}
+
+//==============================================================================
+// Spectrogram Mode
+
+void MatrixDisplay::setSpectrogramSource(AudioAnalyzer* analyzer)
+{
+    if (analyzer == nullptr)
+    {
+        exitSpectrogramMode();
+        currentFrame.resize(rows, cols);
+        repaint();
+        return;
+    }
+
+    animationPlaying = false;
+    showingAnimation = false;
+    vuLevels.clear();
+
+    spectrogramSource = analyzer;
+    lastAnalysisCount = analyzer->getAnalysisCount();
+
+    if (!spectrogramMode)
+    {
+        spectrogramMode = true;
+        resetSpectrogram();
+    }
+
+    startFrames();
+    repaint();
+}
+
+void MatrixDisplay::setSpectrogramFrequencyRange(float minFrequency, float maxFrequency, double sampleRate)
+{
+    spectrogramMinFrequency = std::max(0.0f, minFrequency);
+    spectrogramMaxFrequency = std::max(spectrogramMinFrequency, maxFrequency);
+    spectrogramSampleRate = std::max(0.0, sampleRate);
+
+    // Rebuilt on the next column
+    spectrogramBandBins = 0;
+}
+
+void MatrixDisplay::pushSpectrogramColumn(const float* magnitudes, int numBins)
+{
+    if (!spectrogramMode)
+    {
+        animationPlaying = false;
+        showingAnimation = false;
+        stopFrames();
+        vuLevels.clear();
+
+        spectrogramMode = true;
+        resetSpectrogram();
     }
+
+    addSpectrogramColumn(magnitudes, numBins);
+    repaint();
+}
+
+void MatrixDisplay::exitSpectrogramMode()
+{
+    if (!spectrogramMode)
+        return;
+
+    spectrogramMode = false;
+    spectrogramSource = nullptr;
+    stopFrames();
+}
+
+void MatrixDisplay::resetSpectrogram()
+{
+    spectrogramHistory.resize(cols, rows);
+    spectrogramHead = 0;
+    spectrogramBandBins = 0;
+}
+
+void MatrixDisplay::updateSpectrogram()
+{
+    if (spectrogramSource == nullptr)
+        return;
+
+    const uint32_t count = spectrogramSource->getAnalysisCount();
+    const uint32_t hops = count - lastAnalysisCount;
+
+    // No new analysis since the last tick, so nothing to scroll or repaint
+    if (hops == 0)
+        return;
+
+    lastAnalysisCount = count;
+    spectrogramSource->getFrequencyData(spectrogramBins);
+
+    // Only the latest spectrum can be read. Hops that landed between two
+    // ticks scroll in as floor columns ahead of it, so the time axis keeps
+    // one column per hop without repeating a spectrum that was never measured.
+    const int columnsToAdd = static_cast<int>(std::min(hops, static_cast<uint32_t>(cols)));
+
+    for (int i = 1; i < columnsToAdd; ++i)
+        addSpectrogramFloorColumn();
+
+    addSpectrogramColumn(spectrogramBins.data(), static_cast<int>(spectrogramBins.size()));
+
+    repaint();
 }
 
+void MatrixDisplay::updateSpectrogramBands(int numBins)
+{
+    // Fractional bin positions of the band edges, spaced evenly on a log
+    // frequency axis. Bin 0 (DC) is skipped so the log mapping stays finite.
+    float lowBin = 1.0f;
+    float highBin = static_cast<float>(numBins);
+
+    if (spectrogramSampleRate > 0.0 && spectrogramMaxFrequency > 0.0f)
+    {
+        const float hzToBin = static_cast<float>(2 * numBins / spectrogramSampleRate);
+        lowBin = std::max(1.0f, spectrogramMinFrequency * hzToBin);
+        highBin = std::min(static_cast<float>(numBins), spectrogramMaxFrequency * hzToBin);
+    }
+
+    highBin = std::max(highBin, lowBin + 1.0f);
+
+    spectrogramBandEdges.resize(static_cast<size_t>(rows) + 1);
+    const float ratio = highBin / lowBin;
+
+    for (int band = 0; band <= rows; ++band)
+        spectrogramBandEdges[band] = lowBin * std::pow(ratio, static_cast<float>(band) / rows);
+
+    spectrogramBandBins = numBins;
+}
+
+void MatrixDisplay::addSpectrogramColumn(const float* magnitudes, int numBins)
+{
+    if (numBins <= 1 || cols <= 0)
+        return;
+
+    if (numBins != spectrogramBandBins)
+        updateSpectrogramBands(numBins);
+
+    FrameCell* column = spectrogramHistory.mutableView().getRow(spectrogramHead);
+
+    for (int band = 0; band < rows; ++band)
+    {
+        const float lo = spectrogramBandEdges[band];
+        const float hi = spectrogramBandEdges[band + 1];
+        float magnitude = 0.0f;
+
+        if (hi - lo < 1.0f)
+        {
+            // Band narrower than a bin (low end of the log axis): interpolate
+            const float position = std::min((lo + hi) * 0.5f, static_cast<float>(numBins - 1));
+            const int index = std::min(static_cast<int>(position), numBins - 2);
+            const float frac = position - static_cast<float>(index);
+            magnitude = magnitudes[index] + (magnitudes[index + 1] - magnitudes[index]) * frac;
+        }
+        else
+        {
+            // Wide band: peak of the bins it covers
+            const int first = static_cast<int>(lo);
+            const int last = std::min(static_cast<int>(std::ceil(hi)), numBins);
+
+            for (int bin = first; bin < last; ++bin)
+                magnitude = std::max(magnitude, magnitudes[bin]);
+        }
+
+        const float db = magnitude > 0.0f ? Interpolation::fastGainToDb(magnitude) : AudioAnalyzer::kMinDb;
+        column[band] = brightnessToCell(AudioAnalyzer::normalizeDb(db));
+    }
+
+    spectrogramHead = (spectrogramHead + 1) % cols;
+}
+
+void MatrixDisplay::addSpectrogramFloorColumn()
+{
+    if (cols <= 0)
+        return;
+
+    FrameCell* column = spectrogramHistory.mutableView().getRow(spectrogramHead);
+    std::fill(column, column + rows, brightnessToCell(0.0f));
+
+    spectrogramHead = (spectrogramHead + 1) % cols;
+}
+
+float MatrixDisplay::getSpectrogramBrightness(int row, int col) const
+{
+    // spectrogramHead is the oldest column, so it lands on the left edge
+    const int column = (spectrogramHead + col) % cols;
+    return spectrogramHistory.view().getBrightness(column, rows - 1 - row);
+}
+
+//==============================================================================
+
 void MatrixDisplay::stop()
 {
     animationPlaying = false;
-    stopTimer();
+    stopFrames();
 }
 
 void MatrixDisplay::setFPS(float newFps)
@@ -169,6 +507,7 @@ void MatrixDisplay::setLEDGap(float gap)
 void MatrixDisplay::setOnColour(const juce::Colour& colour)
 {
     onColour = colour;
+    onColours.buildAlphaRamp(onColour);
     repaint();
 }
 
@@ -184,7 +523,34 @@ void MatrixDisplay::setBrightness(float newBrightness)
     repaint();
 }
 
+void MatrixDisplay::setQuadRenderService(QuadRenderService* service)
+{
+    if (service == quadRenderService.get())
+        return;
+
+    if (auto* previous = quadRenderService.get())
+        previous->removeClient(*this);
+
+    quadRenderService = service;
+    repaint();
+}
+
 void MatrixDisplay::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("MatrixDisplay::paint");
+
+    quads.clear();
+    buildQuads(quads);
+
+    auto* service = quadRenderService.get();
+
+    if (service != nullptr && service->isAvailable())
+        service->submit(*this, quads);
+    else
+        quads.paint(g);
+}
+
+void MatrixDisplay::buildQuads(QuadBatch& batch) const
 {
     const float totalWidth = cols * (ledSize + ledGap) - ledGap;
     const float totalHeight = rows * (ledSize + ledGap) - ledGap;
@@ -193,13 +559,15 @@ void MatrixDisplay::paint(juce::Graphics& g)
     const float startX = (getWidth() - totalWidth) / 2.0f;
     const float startY = (getHeight() - totalHeight) / 2.0f;
 
+    const FrameView frame = getDisplayedFrame();
+    const juce::Colour unlitColour = offColour.withAlpha(0.1f);
+
     for (int row = 0; row < rows; ++row)
     {
         for (int col = 0; col < cols; ++col)
         {
-            const float value = (row < static_cast<int>(currentFrame.size()) &&
-                                col < static_cast<int>(currentFrame[row].size()))
-                               ? currentFrame[row][col] : 0.0f;
+            const float value = spectrogramMode ? getSpectrogramBrightness(row, col)
+                                                : frame.getBrightness(row, col);
 
             const float x = startX + col * (ledSize + ledGap);
             const float y = startY + row * (ledSize + ledGap);
@@ -217,27 +585,24 @@ void MatrixDisplay::paint(juce::Graphics& g)
                 // Glow effect for active LEDs
                 if (isActive)
                 {
-                    g.setColour(onColour.withAlpha(opacity * 0.3f));
-                    g.fillEllipse(centerX - radius * 1.4f, centerY - radius * 1.4f,
-                                 radius * 2.8f, radius * 2.8f);
+                    batch.addEllipse({ centerX - radius * 1.4f, centerY - radius * 1.4f,
+                                       radius * 2.8f, radius * 2.8f },
+                                     onColours.getColour(opacity * 0.3f));
                 }
 
                 // LED body with gradient effect
-                juce::ColourGradient gradient(
-                    onColour.withAlpha(opacity),
-                    centerX, centerY,
-                    onColour.withAlpha(opacity * 0.6f),
-                    centerX + radius, centerY + radius,
-                    true);
-
-                g.setGradientFill(gradient);
-                g.fillEllipse(centerX - radius, centerY - radius, radius * 2.0f, radius * 2.0f);
+                auto& body = batch.addEllipse({ centerX - radius, centerY - radius, radius * 2.0f, radius * 2.0f },
+                                              onColours.getColour(opacity));
+                body.fill = Quad::Fill::Radial;
+                body.colour2 = onColours.getColour(opacity * 0.6f);
+                body.gradientStart = { centerX, centerY };
+                body.gradientEnd = { centerX + radius, centerY + radius };
             }
             else
             {
                 // Inactive LED
-                g.setColour(offColour.withAlpha(0.1f));
-                g.fillEllipse(centerX - radius, centerY - radius, radius * 2.0f, radius * 2.0f);
+                batch.addEllipse({ centerX - radius, centerY - radius, radius * 2.0f, radius * 2.0f },
+                                 unlitColour);
             }
         }
     }
@@ -248,24 +613,49 @@ void MatrixDisplay::resized()
     repaint();
 }
 
-void MatrixDisplay::timerCallback()
+bool MatrixDisplay::advanceFrame(double deltaSeconds)
 {
-    if (!animationPlaying || animationFrames.empty())
-        return;
+    SHMUI_PROFILE_SCOPE("MatrixDisplay::advanceFrame");
+
+    if (spectrogramMode)
+    {
+        updateSpectrogram();
+        return true;
+    }
 
-    const int64_t currentTime = juce::Time::currentTimeMillis();
-    const float deltaTime = static_cast<float>(currentTime - lastTime) / 1000.0f;
-    lastTime = currentTime;
+    if (!animationPlaying || animationFrames == nullptr || animationFrames->empty())
+        return false;
 
-    accumulator += deltaTime;
+    const int numFrames = animationFrames->size();
+
+    accumulator += static_cast<float>(deltaSeconds);
     const float frameInterval = 1.0f / fps;
 
+    // Back from suspension: skip whole cycles (or to the end) instead of stepping every frame
+    const float remaining = static_cast<float>(numFrames - frameIndex) * frameInterval;
+    if (accumulator >= remaining)
+    {
+        if (loop)
+        {
+            accumulator = std::fmod(accumulator, static_cast<float>(numFrames) * frameInterval);
+        }
+        else
+        {
+            accumulator = 0.0f;
+            frameIndex = numFrames - 1;
+            animationPlaying = false;
+
+            if (onFrame)
+                onFrame(frameIndex);
+        }
+    }
+
     while (accumulator >= frameInterval)
     {
         accumulator -= frameInterval;
         frameIndex++;
 
-        if (frameIndex >= static_cast<int>(animationFrames.size()))
+        if (frameIndex >= numFrames)
         {
             if (loop)
             {
@@ -273,9 +663,8 @@ void MatrixDisplay::timerCallback()
             }
             else
             {
-                frameIndex = static_cast<int>(animationFrames.size()) - 1;
+                frameIndex = numFrames - 1;
                 animationPlaying = false;
-                stopTimer();
             }
         }
 
@@ -285,25 +674,20 @@ void MatrixDisplay::timerCallback()
         }
     }
 
-    currentFrame = ensureFrameSize(animationFrames[frameIndex]);
+    // Frames are painted straight from the arena, nothing to copy here
     repaint();
+    return animationPlaying;
 }
 
-Frame MatrixDisplay::ensureFrameSize(const Frame& frame) const
+FrameView MatrixDisplay::getDisplayedFrame() const
 {
-    Frame result(rows, std::vector<float>(cols, 0.0f));
-
-    for (int r = 0; r < rows; ++r)
+    if (showingAnimation && animationFrames != nullptr &&
+        frameIndex >= 0 && frameIndex < animationFrames->size())
     {
-        const auto& row = (r < static_cast<int>(frame.size())) ? frame[r] : std::vector<float>();
-
-        for (int c = 0; c < cols; ++c)
-        {
-            result[r][c] = (c < static_cast<int>(row.size())) ? row[c] : 0.0f;
-        }
+        return (*animationFrames)[frameIndex];
     }
 
-    return result;
+    return currentFrame.view();
 }
 
 //==============================================================================
@@ -312,162 +696,175 @@ Frame MatrixDisplay::ensureFrameSize(const Frame& frame) const
 namespace MatrixAnimations
 {
 
-std::vector<Frame> createLoader()
+namespace
 {
-    // From matrix.tsx loader
-    std::vector<Frame> frames;
-    const int size = 7;
-    const int center = 3;
-    const float radius = 2.5f;
-
-    for (int frame = 0; frame < 12; ++frame)
+    template <typename Frames>
+    void generateLoader(Frames& frames)
     {
-        Frame f = createEmptyFrame(size, size);
+        // From matrix.tsx loader
+        const int size = 7;
+        const int center = 3;
+        const float radius = 2.5f;
 
-        for (int i = 0; i < 8; ++i)
+        frames.reset(size, size, 12);
+
+        for (int frame = 0; frame < 12; ++frame)
         {
-            const float angle = (static_cast<float>(frame) / 12.0f) * juce::MathConstants<float>::twoPi +
-                               (static_cast<float>(i) / 8.0f) * juce::MathConstants<float>::twoPi;
+            const auto f = frames.addFrame();
 
-            const int x = static_cast<int>(std::round(center + std::cos(angle) * radius));
-            const int y = static_cast<int>(std::round(center + std::sin(angle) * radius));
+            for (int i = 0; i < 8; ++i)
+            {
+                const float angle = (static_cast<float>(frame) / 12.0f) * juce::MathConstants<float>::twoPi +
+                                   (static_cast<float>(i) / 8.0f) * juce::MathConstants<float>::twoPi;
 
-            const float brightness = 1.0f - i / 10.0f;
+                const int x = static_cast<int>(std::round(center + std::cos(angle) * radius));
+                const int y = static_cast<int>(std::round(center + std::sin(angle) * radius));
 
-            if (y >= 0 && y < size && x >= 0 && x < size)
-            {
-                f[y][x] = std::max(0.2f, brightness);
+                const float brightness = 1.0f - i / 10.0f;
+
+                f.set(y, x, std::max(0.2f, brightness));
             }
         }
-
-        frames.push_back(f);
     }
+}
 
-    return frames;
+std::vector<Frame> createLoader()
+{
+    NestedFrames frames;
+    generateLoader(frames);
+    return std::move(frames.frames);
 }
 
-std::vector<Frame> createPulse()
+void createLoader(FrameArena& arena)
 {
-    // From matrix.tsx pulse
-    std::vector<Frame> frames;
-    const int size = 7;
-    const int center = 3;
+    generateLoader(arena);
+}
 
-    for (int frame = 0; frame < 16; ++frame)
+namespace
+{
+    template <typename Frames>
+    void generatePulse(Frames& frames)
     {
-        Frame f = createEmptyFrame(size, size);
+        // From matrix.tsx pulse
+        const int size = 7;
+        const int center = 3;
 
-        const float phase = (static_cast<float>(frame) / 16.0f) * juce::MathConstants<float>::twoPi;
-        const float intensity = (std::sin(phase) + 1.0f) / 2.0f;
+        frames.reset(size, size, 16);
 
-        // Center point
-        f[center][center] = 1.0f;
+        for (int frame = 0; frame < 16; ++frame)
+        {
+            const auto f = frames.addFrame();
 
-        // Expanding ring
-        const int radius = static_cast<int>((1.0f - intensity) * 3.0f) + 1;
+            const float phase = (static_cast<float>(frame) / 16.0f) * juce::MathConstants<float>::twoPi;
+            const float intensity = (std::sin(phase) + 1.0f) / 2.0f;
 
-        for (int dy = -radius; dy <= radius; ++dy)
-        {
-            for (int dx = -radius; dx <= radius; ++dx)
-            {
-                const float dist = std::sqrt(static_cast<float>(dx * dx + dy * dy));
+            // Center point
+            f.set(center, center, 1.0f);
+
+            // Expanding ring
+            const int radius = static_cast<int>((1.0f - intensity) * 3.0f) + 1;
 
-                if (std::abs(dist - radius) < 0.7f)
+            for (int dy = -radius; dy <= radius; ++dy)
+            {
+                for (int dx = -radius; dx <= radius; ++dx)
                 {
-                    const int py = center + dy;
-                    const int px = center + dx;
+                    const float dist = std::sqrt(static_cast<float>(dx * dx + dy * dy));
 
-                    if (py >= 0 && py < size && px >= 0 && px < size)
-                    {
-                        f[py][px] = intensity * 0.6f;
-                    }
+                    if (std::abs(dist - radius) < 0.7f)
+                        f.set(center + dy, center + dx, intensity * 0.6f);
                 }
             }
         }
-
-        frames.push_back(f);
     }
+}
 
-    return frames;
+std::vector<Frame> createPulse()
+{
+    NestedFrames frames;
+    generatePulse(frames);
+    return std::move(frames.frames);
 }
 
-std::vector<Frame> createWave()
+void createPulse(FrameArena& arena)
 {
-    // From matrix.tsx wave
-    std::vector<Frame> frames;
-    const int rows = 7;
-    const int cols = 7;
+    generatePulse(arena);
+}
 
-    for (int frame = 0; frame < 24; ++frame)
+namespace
+{
+    template <typename Frames>
+    void generateWave(Frames& frames)
     {
-        Frame f = createEmptyFrame(rows, cols);
+        // From matrix.tsx wave
+        const int rows = 7;
+        const int cols = 7;
 
-        const float phase = (static_cast<float>(frame) / 24.0f) * juce::MathConstants<float>::twoPi;
+        frames.reset(rows, cols, 24);
 
-        for (int col = 0; col < cols; ++col)
+        for (int frame = 0; frame < 24; ++frame)
         {
-            const float colPhase = (static_cast<float>(col) / cols) * juce::MathConstants<float>::twoPi;
-            const float height = std::sin(phase + colPhase) * 2.5f + 3.5f;
-            const int row = static_cast<int>(height);
+            const auto f = frames.addFrame();
 
-            if (row >= 0 && row < rows)
+            const float phase = (static_cast<float>(frame) / 24.0f) * juce::MathConstants<float>::twoPi;
+
+            for (int col = 0; col < cols; ++col)
             {
-                f[row][col] = 1.0f;
+                const float colPhase = (static_cast<float>(col) / cols) * juce::MathConstants<float>::twoPi;
+                const float height = std::sin(phase + colPhase) * 2.5f + 3.5f;
+                const int row = static_cast<int>(height);
 
-                const float frac = height - row;
+                if (row >= 0 && row < rows)
+                {
+                    f.set(row, col, 1.0f);
 
-                if (row > 0)
-                    f[row - 1][col] = 1.0f - frac;
+                    const float frac = height - row;
 
-                if (row < rows - 1)
-                    f[row + 1][col] = frac;
+                    if (row > 0)
+                        f.set(row - 1, col, 1.0f - frac);
+
+                    if (row < rows - 1)
+                        f.set(row + 1, col, frac);
+                }
             }
         }
-
-        frames.push_back(f);
     }
-
-    return frames;
 }
 
-std::vector<Frame> createSnake()
+std::vector<Frame> createWave()
 {
-    // From matrix.tsx snake
-    std::vector<Frame> frames;
-    const int rows = 7;
-    const int cols = 7;
-
-    // Generate snake path
-    std::vector<std::pair<int, int>> path;
-    int x = 0, y = 0;
-    int dx = 1, dy = 0;
+    NestedFrames frames;
+    generateWave(frames);
+    return std::move(frames.frames);
+}
 
-    std::set<std::pair<int, int>> visited;
+void createWave(FrameArena& arena)
+{
+    generateWave(arena);
+}
 
-    while (static_cast<int>(path.size()) < rows * cols)
+namespace
+{
+    template <typename Frames>
+    void generateSnake(Frames& frames)
     {
-        path.push_back({y, x});
-        visited.insert({y, x});
+        // From matrix.tsx snake
+        const int rows = 7;
+        const int cols = 7;
 
-        int nextX = x + dx;
-        int nextY = y + dy;
+        // Generate snake path
+        std::vector<std::pair<int, int>> path;
+        int x = 0, y = 0;
+        int dx = 1, dy = 0;
 
-        if (nextX >= 0 && nextX < cols && nextY >= 0 && nextY < rows &&
-            visited.find({nextY, nextX}) == visited.end())
-        {
-            x = nextX;
-            y = nextY;
-        }
-        else
+        std::set<std::pair<int, int>> visited;
+
+        while (static_cast<int>(path.size()) < rows * cols)
         {
-            // Turn
-            int newDx = -dy;
-            int newDy = dx;
-            dx = newDx;
-            dy = newDy;
+            path.push_back({y, x});
+            visited.insert({y, x});
 
-            nextX = x + dx;
-            nextY = y + dy;
+            int nextX = x + dx;
+            int nextY = y + dy;
 
             if (nextX >= 0 && nextX < cols && nextY >= 0 && nextY < rows &&
                 visited.find({nextY, nextX}) == visited.end())
@@ -477,34 +874,62 @@ std::vector<Frame> createSnake()
             }
             else
             {
-                break;
+                // Turn
+                int newDx = -dy;
+                int newDy = dx;
+                dx = newDx;
+                dy = newDy;
+
+                nextX = x + dx;
+                nextY = y + dy;
+
+                if (nextX >= 0 && nextX < cols && nextY >= 0 && nextY < rows &&
+                    visited.find({nextY, nextX}) == visited.end())
+                {
+                    x = nextX;
+                    y = nextY;
+                }
+                else
+                {
+                    break;
+                }
             }
         }
-    }
 
-    // Generate frames
-    const int snakeLength = 5;
+        // Generate frames
+        const int snakeLength = 5;
 
-    for (size_t frame = 0; frame < path.size(); ++frame)
-    {
-        Frame f = createEmptyFrame(rows, cols);
+        frames.reset(rows, cols, static_cast<int>(path.size()));
 
-        for (int i = 0; i < snakeLength; ++i)
+        for (size_t frame = 0; frame < path.size(); ++frame)
         {
-            const int idx = static_cast<int>(frame) - i;
+            const auto f = frames.addFrame();
 
-            if (idx >= 0 && idx < static_cast<int>(path.size()))
+            for (int i = 0; i < snakeLength; ++i)
             {
-                const auto& [py, px] = path[idx];
-                const float brightness = 1.0f - static_cast<float>(i) / snakeLength;
-                f[py][px] = brightness;
+                const int idx = static_cast<int>(frame) - i;
+
+                if (idx >= 0 && idx < static_cast<int>(path.size()))
+                {
+                    const auto& [py, px] = path[idx];
+                    const float brightness = 1.0f - static_cast<float>(i) / snakeLength;
+                    f.set(py, px, brightness);
+                }
             }
         }
-
-        frames.push_back(f);
     }
+}
+
+std::vector<Frame> createSnake()
+{
+    NestedFrames frames;
+    generateSnake(frames);
+    return std::move(frames.frames);
+}
 
-    return frames;
+void createSnake(FrameArena& arena)
+{
+    generateSnake(arena);
 }
 
 // Static storage for digits
@@ -625,6 +1050,22 @@ const std::vector<Frame>& getDigits()
     return s_digits;
 }
 
+std::shared_ptr<const FrameArena> getDigitFrames()
+{
+    static const std::shared_ptr<const FrameArena> digitFrames = []
+    {
+        const auto& digits = getDigits();
+        auto arena = std::make_shared<FrameArena>(7, 5, static_cast<int>(digits.size()));
+
+        for (const auto& digit : digits)
+            arena->addFrame(digit);
+
+        return arena;
+    }();
+
+    return digitFrames;
+}
+
 const Frame& getChevronLeft()
 {
     initializeSymbols();
@@ -13,6 +13,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../Audio/AudioAnalyzer.h"
+#include "../Utils/ColorUtils.h"
+#include "../Utils/FrameClock.h"
+#include "QuadRenderService.h"
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 namespace shmui
@@ -21,10 +27,318 @@ namespace shmui
 /**
  * @brief Frame data type for matrix display.
  *
- * 2D array of brightness values (0-1).
+ * 2D array of brightness values (0-1). Kept for compatibility with the
+ * matrix.tsx frame literals; the display itself stores FlatFrame/FrameArena.
+ *
+ * Those store 8 bits per LED (FrameCell), so a Frame handed to the display
+ * or converted to a FlatFrame/FrameArena is rounded to the nearest 1/255,
+ * and toNested() returns the rounded values. Functions that return a Frame
+ * (createVUMeterFrame(), MatrixAnimations::createLoader() etc.) compute it
+ * directly and keep full float precision.
  */
 using Frame = std::vector<std::vector<float>>;
 
+/**
+ * @brief Brightness of a single LED, 0-255 mapping to 0-1.
+ */
+using FrameCell = uint8_t;
+
+/**
+ * @brief Convert a 0-1 brightness value to an 8-bit cell.
+ */
+inline FrameCell brightnessToCell(float brightness)
+{
+    return static_cast<FrameCell>(juce::jlimit(0.0f, 1.0f, brightness) * 255.0f + 0.5f);
+}
+
+/**
+ * @brief Convert an 8-bit cell back to a 0-1 brightness value.
+ */
+inline float cellToBrightness(FrameCell cell)
+{
+    return static_cast<float>(cell) * (1.0f / 255.0f);
+}
+
+//==============================================================================
+
+/**
+ * @brief Non-owning, read-only view of a row-major frame.
+ *
+ * Views are cheap to copy and never allocate. Reads outside the frame
+ * return 0 so frames of a different size can be displayed without cropping.
+ */
+class FrameView
+{
+public:
+    FrameView() = default;
+
+    FrameView(const FrameCell* cellData, int numRows, int numCols)
+        : cells(cellData), rows(numRows), cols(numCols)
+    {
+    }
+
+    int getNumRows() const { return rows; }
+    int getNumColumns() const { return cols; }
+    bool isEmpty() const { return cells == nullptr || rows <= 0 || cols <= 0; }
+
+    /** Raw row-major cell data (rows * cols entries). */
+    const FrameCell* data() const { return cells; }
+
+    /** Pointer to the first cell of a row. */
+    const FrameCell* getRow(int row) const { return cells + static_cast<size_t>(row) * cols; }
+
+    /** Cell value, or 0 if outside the frame. */
+    FrameCell getCell(int row, int col) const
+    {
+        if (row < 0 || row >= rows || col < 0 || col >= cols)
+            return 0;
+
+        return cells[static_cast<size_t>(row) * cols + col];
+    }
+
+    /** Brightness (0-1), or 0 if outside the frame. */
+    float getBrightness(int row, int col) const { return cellToBrightness(getCell(row, col)); }
+
+private:
+    const FrameCell* cells = nullptr;
+    int rows = 0;
+    int cols = 0;
+};
+
+/**
+ * @brief Non-owning, writable view of a row-major frame.
+ *
+ * Used by the animation generators to write directly into arena storage.
+ */
+class MutableFrameView
+{
+public:
+    MutableFrameView() = default;
+
+    MutableFrameView(FrameCell* cellData, int numRows, int numCols)
+        : cells(cellData), rows(numRows), cols(numCols)
+    {
+    }
+
+    int getNumRows() const { return rows; }
+    int getNumColumns() const { return cols; }
+
+    FrameCell* data() const { return cells; }
+    FrameCell* getRow(int row) const { return cells + static_cast<size_t>(row) * cols; }
+
+    /** Set brightness (0-1). Writes outside the frame are ignored. */
+    void set(int row, int col, float brightness) const
+    {
+        if (row >= 0 && row < rows && col >= 0 && col < cols)
+            cells[static_cast<size_t>(row) * cols + col] = brightnessToCell(brightness);
+    }
+
+    /** Brightness (0-1), or 0 if outside the frame. */
+    float get(int row, int col) const { return FrameView(*this).getBrightness(row, col); }
+
+    /** Set every cell to 0. */
+    void clear() const { std::fill(cells, cells + static_cast<size_t>(rows) * cols, FrameCell(0)); }
+
+    operator FrameView() const { return FrameView(cells, rows, cols); }
+
+private:
+    FrameCell* cells = nullptr;
+    int rows = 0;
+    int cols = 0;
+};
+
+//==============================================================================
+
+/**
+ * @brief Single frame stored as one contiguous row-major buffer.
+ *
+ * Replaces the nested Frame type inside the display: one allocation per
+ * frame, which is reused when resizing to a size that fits the capacity.
+ */
+class FlatFrame
+{
+public:
+    FlatFrame() = default;
+
+    /** Create a frame with all cells set to 0. */
+    FlatFrame(int numRows, int numCols) { resize(numRows, numCols); }
+
+    /** Compatibility constructor from the nested Frame form. */
+    explicit FlatFrame(const Frame& nested) { assign(nested, static_cast<int>(nested.size()), getWidestRow(nested)); }
+
+    /**
+     * @brief Resize the frame, clearing all cells.
+     *
+     * Does not allocate if the new size fits the existing capacity.
+     */
+    void resize(int numRows, int numCols)
+    {
+        rows = std::max(0, numRows);
+        cols = std::max(0, numCols);
+        cells.assign(static_cast<size_t>(rows) * cols, FrameCell(0));
+    }
+
+    /** Set every cell to 0. */
+    void clear() { std::fill(cells.begin(), cells.end(), FrameCell(0)); }
+
+    /**
+     * @brief Copy a frame in, cropping or zero-padding to the given size.
+     */
+    void assign(FrameView source, int numRows, int numCols)
+    {
+        resize(numRows, numCols);
+
+        const int copyRows = std::min(rows, source.getNumRows());
+        const int copyCols = std::min(cols, source.getNumColumns());
+
+        for (int r = 0; r < copyRows; ++r)
+            std::copy(source.getRow(r), source.getRow(r) + copyCols, cells.data() + static_cast<size_t>(r) * cols);
+    }
+
+    /**
+     * @brief Copy a nested frame in, cropping or zero-padding to the given size.
+     */
+    void assign(const Frame& nested, int numRows, int numCols)
+    {
+        resize(numRows, numCols);
+
+        const int copyRows = std::min(rows, static_cast<int>(nested.size()));
+
+        for (int r = 0; r < copyRows; ++r)
+        {
+            const int copyCols = std::min(cols, static_cast<int>(nested[r].size()));
+
+            for (int c = 0; c < copyCols; ++c)
+                cells[static_cast<size_t>(r) * cols + c] = brightnessToCell(nested[r][c]);
+        }
+    }
+
+    int getNumRows() const { return rows; }
+    int getNumColumns() const { return cols; }
+
+    FrameView view() const { return FrameView(cells.data(), rows, cols); }
+    MutableFrameView mutableView() { return MutableFrameView(cells.data(), rows, cols); }
+
+    operator FrameView() const { return view(); }
+
+    /** Convert back to the nested Frame form (values rounded to 1/255, see Frame). */
+    Frame toNested() const;
+
+private:
+    static int getWidestRow(const Frame& nested)
+    {
+        size_t widest = 0;
+        for (const auto& row : nested)
+            widest = std::max(widest, row.size());
+        return static_cast<int>(widest);
+    }
+
+    std::vector<FrameCell> cells;
+    int rows = 0;
+    int cols = 0;
+};
+
+//==============================================================================
+
+/**
+ * @brief Many equally-sized frames stored in one contiguous buffer.
+ *
+ * Animations and streamed frames live back-to-back in a single allocation.
+ * Frames are accessed as views, so playback never copies frame data.
+ */
+class FrameArena
+{
+public:
+    FrameArena() = default;
+
+    /** Create an empty arena for frames of the given size. */
+    FrameArena(int numRows, int numCols, int framesToReserve = 0)
+    {
+        reset(numRows, numCols, framesToReserve);
+    }
+
+    /**
+     * @brief Remove all frames and set the frame size.
+     *
+     * Keeps the existing allocation where possible.
+     */
+    void reset(int numRows, int numCols, int framesToReserve = 0)
+    {
+        rows = std::max(1, numRows);
+        cols = std::max(1, numCols);
+        numFrames = 0;
+        cells.clear();
+        cells.reserve(static_cast<size_t>(std::max(0, framesToReserve)) * getFrameSize());
+    }
+
+    /** Remove all frames, keeping the frame size and allocation. */
+    void clear()
+    {
+        numFrames = 0;
+        cells.clear();
+    }
+
+    /**
+     * @brief Append a cleared frame and return a writable view of it.
+     *
+     * The view is invalidated by the next call to addFrame().
+     */
+    MutableFrameView addFrame()
+    {
+        cells.resize(cells.size() + getFrameSize(), FrameCell(0));
+        ++numFrames;
+        return getMutableFrame(numFrames - 1);
+    }
+
+    /** Append a frame, cropping or zero-padding it to the arena frame size. */
+    void addFrame(FrameView source)
+    {
+        auto dest = addFrame();
+
+        const int copyRows = std::min(rows, source.getNumRows());
+        const int copyCols = std::min(cols, source.getNumColumns());
+
+        for (int r = 0; r < copyRows; ++r)
+            std::copy(source.getRow(r), source.getRow(r) + copyCols, dest.getRow(r));
+    }
+
+    /** Append a nested frame, cropping or zero-padding it to the arena frame size. */
+    void addFrame(const Frame& nested)
+    {
+        auto dest = addFrame();
+
+        for (int r = 0; r < std::min(rows, static_cast<int>(nested.size())); ++r)
+            for (int c = 0; c < std::min(cols, static_cast<int>(nested[r].size())); ++c)
+                dest.set(r, c, nested[r][c]);
+    }
+
+    int size() const { return numFrames; }
+    bool empty() const { return numFrames == 0; }
+    int getNumRows() const { return rows; }
+    int getNumColumns() const { return cols; }
+
+    FrameView operator[](int index) const
+    {
+        return FrameView(cells.data() + static_cast<size_t>(index) * getFrameSize(), rows, cols);
+    }
+
+    MutableFrameView getMutableFrame(int index)
+    {
+        return MutableFrameView(cells.data() + static_cast<size_t>(index) * getFrameSize(), rows, cols);
+    }
+
+    /** Convert all frames to the nested Frame form (values rounded to 1/255, see Frame). */
+    std::vector<Frame> toNested() const;
+
+private:
+    size_t getFrameSize() const { return static_cast<size_t>(rows) * cols; }
+
+    std::vector<FrameCell> cells;
+    int rows = 1;
+    int cols = 1;
+    int numFrames = 0;
+};
+
 /**
  * @brief Create an empty frame with all values set to 0.
  */
@@ -39,17 +353,30 @@ Frame createEmptyFrame(int rows, int cols);
  */
 Frame createVUMeterFrame(int columns, const std::vector<float>& levels);
 
+/**
+ * @brief Write a VU meter into an existing frame.
+ *
+ * Allocation-free variant of createVUMeterFrame(); the frame's row count
+ * sets the meter height.
+ *
+ * @param frame Destination frame (cleared first)
+ * @param levels Pointer to level values (0-1)
+ * @param numLevels Number of level values
+ */
+void writeVUMeterFrame(MutableFrameView frame, const float* levels, int numLevels);
+
 //==============================================================================
 
 /**
  * @brief LED-style matrix display component.
  *
  * Displays a grid of virtual LEDs with variable brightness.
- * Supports frame-based animations and real-time VU meter mode.
+ * Supports frame-based animations, real-time VU meter mode and a
+ * scrolling spectrogram driven by an AudioAnalyzer.
  * Port of Matrix component from matrix.tsx.
  */
 class MatrixDisplay : public juce::Component,
-                      public juce::Timer
+                      private FrameClockClient
 {
 public:
     MatrixDisplay();
@@ -84,6 +411,13 @@ public:
      */
     void setPattern(const Frame& pattern);
 
+    /**
+     * @brief Set a static pattern from a flat frame view.
+     *
+     * The pattern is copied, cropped or zero-padded to the matrix size.
+     */
+    void setPattern(FrameView pattern);
+
     /**
      * @brief Set animation frames.
      *
@@ -93,6 +427,19 @@ public:
      */
     void setFrames(const std::vector<Frame>& frames, float fps = 12.0f, bool loop = true);
 
+    /**
+     * @brief Set animation frames from an arena, taking ownership.
+     */
+    void setFrames(FrameArena&& frames, float fps = 12.0f, bool loop = true);
+
+    /**
+     * @brief Set shared animation frames without copying.
+     *
+     * The arena can be shared between several displays; frames are read
+     * in place during playback.
+     */
+    void setFrames(std::shared_ptr<const FrameArena> frames, float fps = 12.0f, bool loop = true);
+
     /**
      * @brief Set VU meter levels for real-time display.
      *
@@ -105,6 +452,53 @@ public:
      */
     void clear();
 
+    //==============================================================================
+    // Spectrogram Mode
+
+    /**
+     * @brief Show a scrolling spectrogram of an analyzer's output.
+     *
+     * One column is added per analysis hop, newest on the right. Rows map to
+     * log-spaced frequency bands with low frequencies at the bottom. The
+     * history is a circular buffer, so scrolling only moves the write
+     * position and never copies the matrix.
+     *
+     * The analyzer's smoothing time constant also smooths the spectrogram
+     * over time; lower it for a sharper waterfall.
+     *
+     * @param analyzer Analyzer to read from, or nullptr to leave spectrogram mode.
+     *                 Must outlive the display or be detached first.
+     */
+    void setSpectrogramSource(AudioAnalyzer* analyzer);
+
+    /**
+     * @brief Set the frequency range covered by the spectrogram rows.
+     *
+     * Without a range (the default) the rows span from the first bin above
+     * DC up to Nyquist.
+     *
+     * @param minFrequency Lowest frequency in Hz (bottom row)
+     * @param maxFrequency Highest frequency in Hz (top row)
+     * @param sampleRate Sample rate of the analysed audio
+     */
+    void setSpectrogramFrequencyRange(float minFrequency, float maxFrequency, double sampleRate);
+
+    /**
+     * @brief Push one spectrogram column from magnitude bins.
+     *
+     * For feeding the spectrogram without an AudioAnalyzer. Switches the
+     * display to spectrogram mode if needed.
+     *
+     * @param magnitudes Linear magnitudes (0-1), bin 0 = DC
+     * @param numBins Number of bins
+     */
+    void pushSpectrogramColumn(const float* magnitudes, int numBins);
+
+    /**
+     * @brief Check if the spectrogram is being displayed.
+     */
+    bool isSpectrogramMode() const { return spectrogramMode; }
+
     //==============================================================================
     // Animation Control
 
@@ -161,6 +555,21 @@ public:
      */
     void setBrightness(float brightness);
 
+    //==============================================================================
+    // Rendering
+
+    /**
+     * @brief Draw the LEDs through a shared QuadRenderService (nullptr = juce::Graphics).
+     *
+     * The service must be attached to a component that contains this one.
+     */
+    void setQuadRenderService(QuadRenderService* service);
+
+    /**
+     * @brief Get the shared quad renderer, if any.
+     */
+    QuadRenderService* getQuadRenderService() const { return quadRenderService.get(); }
+
     //==============================================================================
     // Callbacks
 
@@ -176,8 +585,19 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
-    Frame ensureFrameSize(const Frame& frame) const;
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    void startAnimationFrames(float fps, bool loop);
+    FrameView getDisplayedFrame() const;
+
+    void exitSpectrogramMode();
+    void resetSpectrogram();
+    void updateSpectrogram();
+    void updateSpectrogramBands(int numBins);
+    void addSpectrogramColumn(const float* magnitudes, int numBins);
+    void addSpectrogramFloorColumn();
+    float getSpectrogramBrightness(int row, int col) const;
+    void buildQuads(QuadBatch& batch) const;
 
     //==============================================================================
 
@@ -185,8 +605,8 @@ private:
     int cols = 7;
 
     // Display modes
-    Frame currentFrame;
-    std::vector<Frame> animationFrames;
+    FlatFrame currentFrame;
+    std::shared_ptr<const FrameArena> animationFrames;
     std::vector<float> vuLevels;
 
     // Animation state
@@ -195,7 +615,21 @@ private:
     float fps = 12.0f;
     bool loop = true;
     bool animationPlaying = false;
-    int64_t lastTime = 0;
+    bool showingAnimation = false;
+
+    // Spectrogram state. History rows are time columns (rows cells each),
+    // so a new column is one contiguous write at spectrogramHead.
+    AudioAnalyzer* spectrogramSource = nullptr;
+    FlatFrame spectrogramHistory;
+    std::vector<float> spectrogramBins;
+    std::vector<float> spectrogramBandEdges;
+    int spectrogramHead = 0;
+    int spectrogramBandBins = 0;
+    uint32_t lastAnalysisCount = 0;
+    float spectrogramMinFrequency = 0.0f;
+    float spectrogramMaxFrequency = 0.0f;
+    double spectrogramSampleRate = 0.0;
+    bool spectrogramMode = false;
 
     // Appearance
     float ledSize = 10.0f;
@@ -203,6 +637,11 @@ private:
     juce::Colour onColour = juce::Colours::white;  // currentColor default
     juce::Colour offColour = juce::Colour(0x80808080);  // muted-foreground
     float brightness = 1.0f;
+    ColorUtils::ColourLUT<> onColours;  // onColour by opacity, rebuilt in setOnColour()
+
+    // Rendering
+    QuadBatch quads;
+    juce::WeakReference<QuadRenderService> quadRenderService;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MatrixDisplay)
 };
@@ -218,26 +657,51 @@ namespace MatrixAnimations
  */
 std::vector<Frame> createLoader();
 
+/**
+ * @brief Spinning loader animation, written into an arena.
+ */
+void createLoader(FrameArena& arena);
+
 /**
  * @brief Pulsing circle animation.
  */
 std::vector<Frame> createPulse();
 
+/**
+ * @brief Pulsing circle animation, written into an arena.
+ */
+void createPulse(FrameArena& arena);
+
 /**
  * @brief Wave animation.
  */
 std::vector<Frame> createWave();
 
+/**
+ * @brief Wave animation, written into an arena.
+ */
+void createWave(FrameArena& arena);
+
 /**
  * @brief Snake animation.
  */
 std::vector<Frame> createSnake();
 
+/**
+ * @brief Snake animation, written into an arena.
+ */
+void createSnake(FrameArena& arena);
+
 /**
  * @brief Digit frames (0-9) for number display.
  */
 const std::vector<Frame>& getDigits();
 
+/**
+ * @brief Digit frames (0-9) as a shared arena.
+ */
+std::shared_ptr<const FrameArena> getDigitFrames();
+
 /**
  * @brief Chevron left symbol.
  */
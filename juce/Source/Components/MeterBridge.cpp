@@ -0,0 +1,601 @@
+/*
+  ==============================================================================
+
+    MeterBridge.cpp
+    Created: shmui Component Library
+
+    Meter bridge implementation.
+
+  ==============================================================================
+*/
+
+#include "MeterBridge.h"
+#include "../Utils/Profiling.h"
+#include <cmath>
+
+namespace shmui
+{
+
+//==============================================================================
+MeterBridge::MeterBridge()
+    : MeterBridge(16)
+{
+}
+
+MeterBridge::MeterBridge(int numChannels)
+{
+    setNumChannels(numChannels);
+    setBallistics(MeterBallistics::Peak);
+    startFrames();
+}
+
+MeterBridge::~MeterBridge()
+{
+    stopFrames();
+}
+
+//==============================================================================
+void MeterBridge::setNumChannels(int numChannels)
+{
+    m_numChannels = juce::jmax(1, numChannels);
+    const auto size = static_cast<size_t>(m_numChannels);
+
+    m_pendingPeaks.reset(new std::atomic<float>[size]);
+    for (size_t i = 0; i < size; ++i)
+        m_pendingPeaks[i].store(0.0f);
+
+    m_inputLevels.assign(size, 0.0f);
+    m_inputGains.assign(size, 0.0f);
+    m_integratedGains.assign(size, 0.0f);
+    m_displayGains.assign(size, 0.0f);
+    m_displayLevels.assign(size, 0.0f);
+    m_peakHolds.assign(size, 0.0f);
+    m_peakHoldTimes.assign(size, 0);
+    m_clipped.assign(size, 0);
+    m_levelPixels.assign(size, 0);
+    m_peakPixels.assign(size, 0);
+    m_labels.assign(size, {});
+    m_hubValues.assign(size, MeterSnapshot{});
+    m_hubClipCounts.assign(size, 0);
+    m_groups.clear();
+    m_hasLabels = false;
+
+    m_trackRects.ensureStorageAllocated(m_numChannels);
+    m_levelRects.ensureStorageAllocated(m_numChannels);
+    m_peakRects.ensureStorageAllocated(m_numChannels);
+    m_clipRects.ensureStorageAllocated(m_numChannels);
+
+    updateLayout();
+    repaint();
+}
+
+void MeterBridge::setChannelLabel(int channel, const juce::String& label)
+{
+    if (channel < 0 || channel >= m_numChannels)
+        return;
+
+    m_labels[static_cast<size_t>(channel)] = label;
+
+    m_hasLabels = false;
+    for (const auto& l : m_labels)
+        m_hasLabels = m_hasLabels || l.isNotEmpty();
+
+    updateLayout();
+    repaint();
+}
+
+juce::String MeterBridge::getChannelLabel(int channel) const
+{
+    if (channel >= 0 && channel < m_numChannels)
+        return m_labels[static_cast<size_t>(channel)];
+    return {};
+}
+
+void MeterBridge::addGroup(const MeterGroup& group)
+{
+    MeterGroup clamped = group;
+    clamped.firstChannel = juce::jlimit(0, m_numChannels - 1, group.firstChannel);
+    clamped.numChannels = juce::jlimit(0, m_numChannels - clamped.firstChannel, group.numChannels);
+
+    if (clamped.numChannels == 0)
+        return;
+
+    m_groups.push_back(clamped);
+    updateLayout();
+    repaint();
+}
+
+void MeterBridge::clearGroups()
+{
+    m_groups.clear();
+    updateLayout();
+    repaint();
+}
+
+//==============================================================================
+void MeterBridge::pushPeak(int channel, float peak)
+{
+    if (channel < 0 || channel >= m_numChannels)
+        return;
+
+    // Lock-free max
+    auto& target = m_pendingPeaks[static_cast<size_t>(channel)];
+    float current = target.load(std::memory_order_relaxed);
+
+    while (peak > current &&
+           !target.compare_exchange_weak(current, peak,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+}
+
+void MeterBridge::pushSamples(int channel, const float* samples, int numSamples)
+{
+    if (samples == nullptr)
+        return;
+
+    float peak = 0.0f;
+    for (int i = 0; i < numSamples; ++i)
+        peak = juce::jmax(peak, std::abs(samples[i]));
+
+    pushPeak(channel, peak);
+}
+
+void MeterBridge::pushBuffer(const juce::AudioBuffer<float>& buffer, int firstChannel)
+{
+    const int count = juce::jmin(buffer.getNumChannels(), m_numChannels - firstChannel);
+
+    for (int ch = 0; ch < count; ++ch)
+    {
+        pushSamples(firstChannel + ch, buffer.getReadPointer(ch), buffer.getNumSamples());
+    }
+}
+
+//==============================================================================
+void MeterBridge::setMeterSource(const MeterHub* hub, int firstIndex)
+{
+    m_meterHub = hub;
+    m_meterHubIndex = juce::jmax(0, firstIndex);
+    m_meterHubSequence = 0;
+
+    // Start counting clips from now
+    std::fill(m_hubValues.begin(), m_hubValues.end(), MeterSnapshot{});
+    if (m_meterHub != nullptr)
+        m_meterHub->read(m_meterHubIndex, m_numChannels, m_hubValues.data());
+
+    for (size_t i = 0; i < m_hubValues.size(); ++i)
+        m_hubClipCounts[i] = m_hubValues[i].clipCount;
+}
+
+//==============================================================================
+void MeterBridge::reset()
+{
+    for (int ch = 0; ch < m_numChannels; ++ch)
+        m_pendingPeaks[static_cast<size_t>(ch)].store(0.0f);
+
+    std::fill(m_inputLevels.begin(), m_inputLevels.end(), 0.0f);
+    std::fill(m_inputGains.begin(), m_inputGains.end(), 0.0f);
+    std::fill(m_displayGains.begin(), m_displayGains.end(), 0.0f);
+    std::fill(m_displayLevels.begin(), m_displayLevels.end(), 0.0f);
+    std::fill(m_peakHolds.begin(), m_peakHolds.end(), 0.0f);
+    std::fill(m_peakHoldTimes.begin(), m_peakHoldTimes.end(), 0);
+    std::fill(m_clipped.begin(), m_clipped.end(), uint8_t(0));
+    repaint();
+}
+
+void MeterBridge::clearClip()
+{
+    std::fill(m_clipped.begin(), m_clipped.end(), uint8_t(0));
+    repaint();
+}
+
+bool MeterBridge::hasClipped(int channel) const
+{
+    if (channel >= 0 && channel < m_numChannels)
+        return m_clipped[static_cast<size_t>(channel)] != 0;
+    return false;
+}
+
+float MeterBridge::getDisplayLevel(int channel) const
+{
+    if (channel >= 0 && channel < m_numChannels)
+        return m_displayLevels[static_cast<size_t>(channel)];
+    return 0.0f;
+}
+
+//==============================================================================
+void MeterBridge::setBallistics(MeterBallistics ballistics)
+{
+    m_ballistics = ballistics;
+    m_ballisticsSpec = BallisticsSpec::forType(ballistics);
+}
+
+void MeterBridge::setBallisticsSpec(const BallisticsSpec& spec)
+{
+    m_ballisticsSpec = spec;
+}
+
+void MeterBridge::setPeakHoldTime(int milliseconds)
+{
+    m_peakHoldTimeMs = juce::jmax(0, milliseconds);
+}
+
+void MeterBridge::setDBRange(float minDB, float maxDB)
+{
+    m_minDB = minDB;
+    m_maxDB = juce::jmax(minDB + 1.0f, maxDB);
+    invalidateCachedLayers();
+    repaint();
+}
+
+void MeterBridge::setStyle(const MeterBridgeStyle& style)
+{
+    m_style = style;
+    updateLayout();
+    repaint();
+}
+
+//==============================================================================
+bool MeterBridge::advanceFrame(double deltaSeconds)
+{
+    SHMUI_PROFILE_SCOPE("MeterBridge::advanceFrame");
+
+    if (updateMeters(deltaSeconds))
+        repaint();
+
+    // Levels arrive from the audio thread at any time, so keep polling
+    return true;
+}
+
+bool MeterBridge::updateMeters(double elapsedSeconds)
+{
+    const int64_t currentTime = juce::Time::currentTimeMillis();
+
+    // Integrate over the real time since the last frame, whatever the refresh rate
+    const auto coefficients = m_ballisticsSpec.getCoefficients(elapsedSeconds);
+
+    const int n = m_numChannels;
+    const float minDB = m_minDB;
+    const float invRange = 1.0f / (m_maxDB - m_minDB);
+    const float clipNorm = dbToNormalized(m_style.clipThreshold);
+
+    float* const input = m_inputLevels.data();
+    float* const inputGain = m_inputGains.data();
+    float* const displayGain = m_displayGains.data();
+    float* const display = m_displayLevels.data();
+    const float floorGain = juce::Decibels::decibelsToGain(minDB);
+
+    // One copy of every bound hub entry, only when the hub has published;
+    // a stale hub reads as silence
+    const bool hubBound = m_meterHub != nullptr;
+    if (hubBound && m_meterHub->getSequence() != m_meterHubSequence)
+        m_meterHubSequence = m_meterHub->read(m_meterHubIndex, n, m_hubValues.data());
+    const bool hubLive = hubBound && !m_meterHub->isStale();
+
+    // Hub values already integrated per sample with this timing are shown as they are
+    const bool hubIntegrated = hubLive && m_meterHub->isIntegrating()
+                            && m_meterHub->getBallisticsSpec() == m_ballisticsSpec;
+    float* const integrated = m_integratedGains.data();
+
+    // Drain the audio feed into normalized input levels
+    for (int ch = 0; ch < n; ++ch)
+    {
+        const auto& hub = m_hubValues[static_cast<size_t>(ch)];
+        float peak = m_pendingPeaks[static_cast<size_t>(ch)].exchange(0.0f, std::memory_order_acquire);
+
+        if (hubLive && !hubIntegrated)
+            peak = juce::jmax(peak, hub.peak);
+
+        inputGain[ch] = peak > floorGain ? peak : 0.0f;
+        input[ch] = peak > 0.0f ? (20.0f * std::log10(peak) - minDB) * invRange : 0.0f;
+
+        // A new rise shows its highest point; otherwise the integrator's own fall
+        if (hubIntegrated)
+            integrated[ch] = hub.integratedPeak > displayGain[ch] ? hub.integratedPeak : hub.integrated;
+    }
+
+    // Ballistics for every channel on linear gain, then back to the dB scale
+    BallisticsSpec::apply(coefficients, displayGain, inputGain, n);
+
+    // The feed's per-frame input only counts where it is louder than the hub
+    if (hubIntegrated)
+    {
+        for (int ch = 0; ch < n; ++ch)
+            displayGain[ch] = inputGain[ch] > integrated[ch] ? juce::jmax(displayGain[ch], integrated[ch]) : integrated[ch];
+    }
+
+    for (int ch = 0; ch < n; ++ch)
+        displayGain[ch] = displayGain[ch] > floorGain ? displayGain[ch] : 0.0f;
+
+    for (int ch = 0; ch < n; ++ch)
+    {
+        display[ch] = displayGain[ch] > 0.0f
+                          ? juce::jlimit(0.0f, 1.0f, (20.0f * std::log10(displayGain[ch]) - minDB) * invRange)
+                          : 0.0f;
+    }
+
+    // Peak hold, clip latch and repaint check
+    const float meterHeight = m_meterArea.getHeight();
+    bool needsRepaint = false;
+
+    for (int ch = 0; ch < n; ++ch)
+    {
+        const auto i = static_cast<size_t>(ch);
+
+        if (display[ch] >= m_peakHolds[i])
+        {
+            m_peakHolds[i] = display[ch];
+            m_peakHoldTimes[i] = currentTime;
+        }
+        else if (currentTime - m_peakHoldTimes[i] > m_peakHoldTimeMs)
+        {
+            m_peakHolds[i] = display[ch];
+        }
+
+        bool hubClipped = false;
+        if (hubBound)
+        {
+            hubClipped = m_hubValues[i].clipCount != m_hubClipCounts[i];
+            m_hubClipCounts[i] = m_hubValues[i].clipCount;
+        }
+
+        if ((input[ch] >= clipNorm || hubClipped) && m_clipped[i] == 0)
+        {
+            m_clipped[i] = 1;
+            needsRepaint = true;
+            if (onClip)
+                onClip(ch);
+        }
+
+        const int levelPixels = juce::roundToInt(display[ch] * meterHeight);
+        const int peakPixels = juce::roundToInt(m_peakHolds[i] * meterHeight);
+
+        if (levelPixels != m_levelPixels[i] || peakPixels != m_peakPixels[i])
+        {
+            m_levelPixels[i] = levelPixels;
+            m_peakPixels[i] = peakPixels;
+            needsRepaint = true;
+        }
+    }
+
+    return needsRepaint;
+}
+
+float MeterBridge::dbToNormalized(float dB) const
+{
+    return juce::jlimit(0.0f, 1.0f, (dB - m_minDB) / (m_maxDB - m_minDB));
+}
+
+//==============================================================================
+void MeterBridge::resized()
+{
+    updateLayout();
+}
+
+void MeterBridge::updateLayout()
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    if (!m_groups.empty())
+        bounds.removeFromTop(m_style.groupHeaderHeight);
+
+    if (m_hasLabels)
+        bounds.removeFromBottom(m_style.labelHeight);
+
+    m_scaleArea = m_style.showScale ? bounds.removeFromLeft(m_style.scaleWidth) : juce::Rectangle<float>();
+    m_meterArea = bounds.reduced(0.0f, 2.0f);
+
+    // Extra gap before the first channel of each group (except channel 0)
+    std::vector<uint8_t> groupBreak(static_cast<size_t>(m_numChannels), 0);
+    int numBreaks = 0;
+    for (const auto& group : m_groups)
+    {
+        if (group.firstChannel > 0 && groupBreak[static_cast<size_t>(group.firstChannel)] == 0)
+        {
+            groupBreak[static_cast<size_t>(group.firstChannel)] = 1;
+            ++numBreaks;
+        }
+    }
+
+    // Strips shrink to fit, on whole pixels so level rectangles stay crisp
+    const float gaps = (m_numChannels - 1) * m_style.meterGap + numBreaks * m_style.groupGap;
+    const float fitWidth = (m_meterArea.getWidth() - gaps) / static_cast<float>(m_numChannels);
+    m_stripWidth = juce::jmax(1.0f, std::floor(juce::jmin(m_style.meterWidth, fitWidth)));
+
+    const float totalWidth = m_numChannels * m_stripWidth + gaps;
+    float x = std::round(m_meterArea.getX() + juce::jmax(0.0f, (m_meterArea.getWidth() - totalWidth) * 0.5f));
+
+    m_stripX.resize(static_cast<size_t>(m_numChannels));
+    for (int ch = 0; ch < m_numChannels; ++ch)
+    {
+        if (ch > 0)
+            x += m_style.meterGap + (groupBreak[static_cast<size_t>(ch)] != 0 ? m_style.groupGap : 0.0f);
+
+        m_stripX[static_cast<size_t>(ch)] = std::round(x);
+        x += m_stripWidth;
+    }
+
+    invalidateCachedLayers();
+}
+
+//==============================================================================
+void MeterBridge::invalidateCachedLayers()
+{
+    m_layersValid = false;
+}
+
+void MeterBridge::updateCachedLayers(float pixelScale)
+{
+    if (m_layersValid && pixelScale == m_cachedPixelScale)
+        return;
+
+    m_layersValid = true;
+    m_cachedPixelScale = pixelScale;
+
+    // Gradient: one column, low at the bottom, shared by every strip
+    const int gradientHeight = juce::roundToInt(m_meterArea.getHeight() * pixelScale);
+    m_gradientImage = juce::Image();
+
+    if (gradientHeight > 0)
+    {
+        m_gradientImage = juce::Image(juce::Image::ARGB, 1, gradientHeight, true);
+        juce::Graphics g(m_gradientImage);
+
+        juce::ColourGradient gradient(m_style.meterColorLow, 0.0f, static_cast<float>(gradientHeight),
+                                      m_style.meterColorHigh, 0.0f, 0.0f, false);
+        gradient.addColour(dbToNormalized(m_style.yellowThreshold), m_style.meterColorMid);
+        gradient.addColour(dbToNormalized(m_style.redThreshold), m_style.meterColorHigh);
+
+        g.setGradientFill(gradient);
+        g.fillAll();
+    }
+
+    // Scale, group headers and labels
+    const int width = juce::roundToInt(getWidth() * pixelScale);
+    const int height = juce::roundToInt(getHeight() * pixelScale);
+    m_staticImage = juce::Image();
+
+    if (width > 0 && height > 0)
+    {
+        m_staticImage = juce::Image(juce::Image::ARGB, width, height, true);
+        juce::Graphics g(m_staticImage);
+        g.addTransform(juce::AffineTransform::scale(pixelScale));
+        drawStaticLayer(g);
+    }
+}
+
+void MeterBridge::drawStaticLayer(juce::Graphics& g)
+{
+    g.setFont(9.0f);
+
+    // dB scale
+    if (m_style.showScale)
+    {
+        const float markers[] = {0.0f, -3.0f, -6.0f, -12.0f, -18.0f, -24.0f, -36.0f, -48.0f, -60.0f};
+
+        for (float dB : markers)
+        {
+            if (dB < m_minDB || dB > m_maxDB)
+                continue;
+
+            const float y = m_meterArea.getBottom() - m_meterArea.getHeight() * dbToNormalized(dB);
+
+            g.setColour(m_style.tickColor);
+            g.drawHorizontalLine(static_cast<int>(y), m_scaleArea.getRight() - 5, m_scaleArea.getRight());
+
+            g.setColour(m_style.textColor);
+            g.drawText(juce::String(static_cast<int>(dB)), m_scaleArea.getX(), y - 6,
+                       m_scaleArea.getWidth() - 6, 12, juce::Justification::centredRight, false);
+        }
+    }
+
+    // Group headers
+    for (const auto& group : m_groups)
+    {
+        const float left = m_stripX[static_cast<size_t>(group.firstChannel)];
+        const float right = m_stripX[static_cast<size_t>(group.firstChannel + group.numChannels - 1)] + m_stripWidth;
+        const juce::Rectangle<float> header(left, 0.0f, right - left, m_style.groupHeaderHeight - 2.0f);
+
+        g.setColour(group.color);
+        g.fillRoundedRectangle(header, 2.0f);
+
+        g.setColour(m_style.textColor);
+        g.drawText(group.name, header, juce::Justification::centred, true);
+    }
+
+    // Channel labels
+    if (m_hasLabels)
+    {
+        const float y = static_cast<float>(getHeight()) - m_style.labelHeight;
+
+        g.setColour(m_style.textColor);
+        for (int ch = 0; ch < m_numChannels; ++ch)
+        {
+            const auto& label = m_labels[static_cast<size_t>(ch)];
+            if (label.isEmpty())
+                continue;
+
+            const float centre = m_stripX[static_cast<size_t>(ch)] + m_stripWidth * 0.5f;
+            g.drawText(label, juce::Rectangle<float>(centre - 15.0f, y, 30.0f, m_style.labelHeight),
+                       juce::Justification::centred, true);
+        }
+    }
+}
+
+//==============================================================================
+void MeterBridge::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("MeterBridge::paint");
+
+    g.fillAll(m_style.backgroundColor);
+
+    updateCachedLayers(g.getInternalContext().getPhysicalPixelScaleFactor());
+
+    if (m_staticImage.isValid())
+        g.drawImage(m_staticImage, getLocalBounds().toFloat());
+
+    // Gather every strip into rectangle lists, then fill each list once
+    const float top = m_meterArea.getY();
+    const float bottom = m_meterArea.getBottom();
+    const float height = m_meterArea.getHeight();
+    const float width = m_stripWidth;
+
+    m_trackRects.clear();
+    m_levelRects.clear();
+    m_peakRects.clear();
+    m_clipRects.clear();
+
+    for (int ch = 0; ch < m_numChannels; ++ch)
+    {
+        const auto i = static_cast<size_t>(ch);
+        const float x = m_stripX[i];
+
+        m_trackRects.addWithoutMerging({x, top, width, height});
+
+        const float levelHeight = std::round(m_displayLevels[i] * height);
+        if (levelHeight > 0.0f)
+        {
+            m_levelRects.addWithoutMerging(juce::Rectangle<float>(x, bottom - levelHeight, width, levelHeight)
+                                               .getSmallestIntegerContainer());
+        }
+
+        if (m_style.showPeakHold && m_peakHolds[i] > 0.01f)
+        {
+            const float peakY = bottom - height * m_peakHolds[i];
+            m_peakRects.addWithoutMerging({x, peakY - m_style.peakHoldHeight * 0.5f, width, m_style.peakHoldHeight});
+        }
+
+        if (m_style.showClipIndicator && m_clipped[i] != 0)
+        {
+            m_clipRects.addWithoutMerging({x, top, width, m_style.clipHeight});
+        }
+    }
+
+    g.setColour(m_style.trackColor);
+    g.fillRectList(m_trackRects);
+
+    // One gradient draw through the union of all level rectangles
+    if (!m_levelRects.isEmpty() && m_gradientImage.isValid())
+    {
+        juce::Graphics::ScopedSaveState state(g);
+        g.reduceClipRegion(m_levelRects);
+        g.drawImage(m_gradientImage, m_meterArea);
+    }
+
+    g.setColour(m_style.peakHoldColor);
+    g.fillRectList(m_peakRects);
+
+    g.setColour(m_style.clipColor);
+    g.fillRectList(m_clipRects);
+}
+
+void MeterBridge::mouseDown(const juce::MouseEvent& e)
+{
+    juce::ignoreUnused(e);
+
+    // Click to clear clip indicators
+    clearClip();
+}
+
+} // namespace shmui
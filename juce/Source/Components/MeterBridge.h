@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+
+    MeterBridge.h
+    Created: shmui Component Library
+
+    Console-style meter bridge for any number of channels in one component.
+
+    Features:
+    - Arbitrary channel count (no MAX_CHANNELS cap)
+    - Structure-of-arrays channel state, one ballistics loop for all channels
+    - All strips painted in one batched pass with a shared cached gradient
+    - Lossless audio-thread feed (peak since last frame, clip latch)
+    - Channel groups with names and colours
+    - Per-channel labels
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LevelMeter.h"
+#include "../Utils/FrameClock.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief A named run of adjacent channels in a MeterBridge.
+ */
+struct MeterGroup
+{
+    juce::String name;
+    int firstChannel = 0;
+    int numChannels = 0;
+    juce::Colour color = juce::Colour(0x40FFFFFF);
+};
+
+//==============================================================================
+/**
+ * @brief Style configuration for MeterBridge.
+ */
+struct MeterBridgeStyle
+{
+    // Colors
+    juce::Colour backgroundColor = juce::Colour(0xFF1A1A1A);
+    juce::Colour trackColor = juce::Colour(0xFF262626);
+    juce::Colour meterColorLow = juce::Colour(0xFF22C55E);     // Green
+    juce::Colour meterColorMid = juce::Colour(0xFFF59E0B);     // Amber
+    juce::Colour meterColorHigh = juce::Colour(0xFFEF4444);    // Red
+    juce::Colour peakHoldColor = juce::Colours::white;
+    juce::Colour clipColor = juce::Colour(0xFFDC2626);         // Bright red
+    juce::Colour textColor = juce::Colour(0x80FFFFFF);
+    juce::Colour tickColor = juce::Colour(0x40FFFFFF);
+
+    // Thresholds (in dB)
+    float yellowThreshold = -12.0f;
+    float redThreshold = -3.0f;
+    float clipThreshold = 0.0f;
+
+    // Appearance
+    float meterWidth = 8.0f;          // Maximum strip width (shrinks to fit)
+    float meterGap = 2.0f;            // Gap between strips
+    float groupGap = 6.0f;            // Extra gap between groups
+    float scaleWidth = 30.0f;
+    float groupHeaderHeight = 16.0f;  // Used when groups are set
+    float labelHeight = 14.0f;        // Used when any channel has a label
+    float clipHeight = 4.0f;
+    float peakHoldHeight = 2.0f;
+    bool showPeakHold = true;
+    bool showClipIndicator = true;
+    bool showScale = true;
+};
+
+//==============================================================================
+/**
+ * @brief Multi-channel meter bridge.
+ *
+ * One component, one clock tick and one repaint for the whole bridge, however
+ * many channels it shows. Channel state lives in flat per-field arrays
+ * (input, display level, peak hold, hold time, clip) so each frame's
+ * ballistics run as straight loops over all channels, and painting
+ * gathers every strip's track, level, peak hold and clip rectangle into
+ * rectangle lists that are filled in a handful of calls. The level
+ * colouring comes from one cached gradient image drawn through the clip
+ * region of all level rectangles at once.
+ *
+ * Strips are vertical. Audio is fed with pushPeak()/pushSamples()/
+ * pushBuffer() from the audio thread; like LevelMeter's feed these keep
+ * the maximum since the last frame so no peak is lost.
+ */
+class MeterBridge : public juce::Component,
+                    private FrameClockClient
+{
+public:
+    //==============================================================================
+    MeterBridge();
+    explicit MeterBridge(int numChannels);
+    ~MeterBridge() override;
+
+    //==============================================================================
+    /// @name Channels
+    /// @{
+
+    /**
+     * @brief Set number of channels.
+     *
+     * Allocates; call while the audio thread is not feeding the bridge.
+     * Clears levels, labels and groups.
+     */
+    void setNumChannels(int numChannels);
+
+    /**
+     * @brief Get number of channels.
+     */
+    int getNumChannels() const { return m_numChannels; }
+
+    /**
+     * @brief Set a channel's label.
+     */
+    void setChannelLabel(int channel, const juce::String& label);
+
+    /**
+     * @brief Get a channel's label.
+     */
+    juce::String getChannelLabel(int channel) const;
+
+    /**
+     * @brief Add a group of adjacent channels.
+     *
+     * Groups are drawn in the order added; channels outside any group are
+     * drawn without a header.
+     */
+    void addGroup(const MeterGroup& group);
+
+    /**
+     * @brief Remove all groups.
+     */
+    void clearGroups();
+
+    /**
+     * @brief Get the groups.
+     */
+    const std::vector<MeterGroup>& getGroups() const { return m_groups; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Audio Thread Feed
+    /// Lock-free and allocation-free.
+    /// @{
+
+    /**
+     * @brief Feed a precomputed block peak (linear).
+     */
+    void pushPeak(int channel, float peak);
+
+    /**
+     * @brief Feed raw samples for a channel.
+     */
+    void pushSamples(int channel, const float* samples, int numSamples);
+
+    /**
+     * @brief Feed a buffer's channels starting at a bridge channel.
+     */
+    void pushBuffer(const juce::AudioBuffer<float>& buffer, int firstChannel = 0);
+
+    /// @}
+
+    //==============================================================================
+    /// @name Meter Hub
+    /// @{
+
+    /**
+     * @brief Read levels from a MeterHub as well as the feed.
+     *
+     * Channel c shows hub entry firstIndex + c. All channels are copied
+     * from the hub in one read per frame. Pass nullptr to unbind; the hub
+     * must outlive the binding.
+     *
+     * If the hub integrates with this bridge's timing (MeterHub::setBallistics()),
+     * its per-sample integrated values are shown as they are, so tone
+     * bursts read the same at any refresh rate; otherwise its peaks are
+     * integrated per frame.
+     */
+    void setMeterSource(const MeterHub* hub, int firstIndex = 0);
+
+    /// @}
+
+    //==============================================================================
+    /// @name Levels (message thread)
+    /// @{
+
+    /**
+     * @brief Reset all levels, peak holds and clip indicators.
+     */
+    void reset();
+
+    /**
+     * @brief Clear clip indicators for all channels.
+     */
+    void clearClip();
+
+    /**
+     * @brief Check if a channel has clipped.
+     */
+    bool hasClipped(int channel) const;
+
+    /**
+     * @brief Get a channel's displayed level (normalized 0-1).
+     */
+    float getDisplayLevel(int channel) const;
+
+    /// @}
+
+    //==============================================================================
+    /// @name Configuration
+    /// @{
+
+    /**
+     * @brief Set meter ballistics (TruePeak is treated as Peak).
+     */
+    void setBallistics(MeterBallistics ballistics);
+
+    /**
+     * @brief Get current ballistics.
+     */
+    MeterBallistics getBallistics() const { return m_ballistics; }
+
+    /**
+     * @brief Override the timing of the current ballistics (reset by setBallistics()).
+     */
+    void setBallisticsSpec(const BallisticsSpec& spec);
+
+    /**
+     * @brief Get current ballistics timing.
+     */
+    const BallisticsSpec& getBallisticsSpec() const { return m_ballisticsSpec; }
+
+    /**
+     * @brief Set peak hold time in milliseconds.
+     */
+    void setPeakHoldTime(int milliseconds);
+
+    /**
+     * @brief Set dB range (e.g., -60 to +6).
+     */
+    void setDBRange(float minDB, float maxDB);
+
+    /**
+     * @brief Set visual style.
+     */
+    void setStyle(const MeterBridgeStyle& style);
+
+    /**
+     * @brief Get current style.
+     */
+    const MeterBridgeStyle& getStyle() const { return m_style; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Callbacks
+    /// @{
+
+    /** Callback when a channel's clip indicator is triggered. */
+    std::function<void(int channel)> onClip;
+
+    /// @}
+
+    //==============================================================================
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseDown(const juce::MouseEvent& e) override;
+
+private:
+    //==============================================================================
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    bool updateMeters(double elapsedSeconds);
+    void updateLayout();
+    void updateCachedLayers(float pixelScale);
+    void invalidateCachedLayers();
+    void drawStaticLayer(juce::Graphics& g);
+    float dbToNormalized(float dB) const;
+
+    //==============================================================================
+    int m_numChannels = 0;
+    MeterBallistics m_ballistics = MeterBallistics::Peak;
+    MeterBridgeStyle m_style;
+
+    float m_minDB = -60.0f;
+    float m_maxDB = 6.0f;
+    int m_peakHoldTimeMs = 2000;
+    BallisticsSpec m_ballisticsSpec;
+
+    // Audio thread feed: max since the last frame, taken with exchange(0)
+    std::unique_ptr<std::atomic<float>[]> m_pendingPeaks;
+
+    // Meter hub binding
+    const MeterHub* m_meterHub = nullptr;
+    int m_meterHubIndex = 0;
+    uint64_t m_meterHubSequence = 0;
+    std::vector<MeterSnapshot> m_hubValues;
+    std::vector<uint32_t> m_hubClipCounts;
+
+    // Per-channel state, one array per field
+    std::vector<float> m_inputLevels;         // Normalized input this frame
+    std::vector<float> m_inputGains;          // Linear input this frame
+    std::vector<float> m_integratedGains;     // Linear hub ballistics output this frame
+    std::vector<float> m_displayGains;        // Linear, after ballistics
+    std::vector<float> m_displayLevels;       // Normalized display level
+    std::vector<float> m_peakHolds;           // Normalized
+    std::vector<int64_t> m_peakHoldTimes;     // ms timestamps
+    std::vector<uint8_t> m_clipped;
+    std::vector<int> m_levelPixels;           // Last level/peak heights, for repaint skipping
+    std::vector<int> m_peakPixels;
+    std::vector<juce::String> m_labels;
+    std::vector<MeterGroup> m_groups;
+
+    // Layout (strip x positions, computed on resize / channel / group change)
+    std::vector<float> m_stripX;
+    float m_stripWidth = 0.0f;
+    juce::Rectangle<float> m_meterArea;
+    juce::Rectangle<float> m_scaleArea;
+    bool m_hasLabels = false;
+
+    // Cached layers
+    juce::Image m_gradientImage;              // 1 px wide, full meter height
+    juce::Image m_staticImage;                // Scale, group headers and labels
+    float m_cachedPixelScale = 0.0f;
+    bool m_layersValid = false;
+
+    // Reused each paint
+    juce::RectangleList<float> m_trackRects;
+    juce::RectangleList<int> m_levelRects;
+    juce::RectangleList<float> m_peakRects;
+    juce::RectangleList<float> m_clipRects;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterBridge)
+};
+
+} // namespace shmui
@@ -0,0 +1,549 @@
+/*
+  ==============================================================================
+
+    OrbRenderService.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the shared orb GL resources and render service.
+
+  ==============================================================================
+*/
+
+#include "OrbRenderService.h"
+#include "../Utils/FrameClock.h"
+#include "../Utils/Profiling.h"
+#include "OrbVisualizer.h"
+
+namespace shmui
+{
+
+// Embedded shader source (loaded from files at compile time)
+static const char* vertexShaderSource = R"(
+attribute vec4 aPosition;
+attribute vec2 aTexCoord;
+varying vec2 vUv;
+void main()
+{
+    vUv = aTexCoord;
+    gl_Position = aPosition;
+}
+)";
+
+static const char* fragmentShaderSource = R"(
+#ifdef GL_ES
+precision highp float;
+#endif
+
+uniform float uTime;
+uniform float uAnimation;
+uniform float uInverted;
+uniform float uOffsets[7];
+uniform vec3 uColor1;
+uniform vec3 uColor2;
+uniform float uInputVolume;
+uniform float uOutputVolume;
+uniform float uOpacity;
+uniform sampler2D uPerlinTexture;
+
+varying vec2 vUv;
+
+const float PI = 3.14159265358979323846;
+
+bool drawOval(vec2 polarUv, vec2 polarCenter, float a, float b, bool reverseGradient, float softness, out vec4 color) {
+    vec2 p = polarUv - polarCenter;
+    float oval = (p.x * p.x) / (a * a) + (p.y * p.y) / (b * b);
+    float edge = smoothstep(1.0, 1.0 - softness, oval);
+    if (edge > 0.0) {
+        float gradient = reverseGradient ? (1.0 - (p.x / a + 1.0) / 2.0) : ((p.x / a + 1.0) / 2.0);
+        gradient = mix(0.5, gradient, 0.1);
+        color = vec4(vec3(gradient), 0.85 * edge);
+        return true;
+    }
+    return false;
+}
+
+vec3 colorRamp(float grayscale, vec3 color1, vec3 color2, vec3 color3, vec3 color4) {
+    if (grayscale < 0.33) {
+        return mix(color1, color2, grayscale * 3.0);
+    } else if (grayscale < 0.66) {
+        return mix(color2, color3, (grayscale - 0.33) * 3.0);
+    } else {
+        return mix(color3, color4, (grayscale - 0.66) * 3.0);
+    }
+}
+
+vec2 hash2(vec2 p) {
+    return fract(sin(vec2(dot(p, vec2(127.1, 311.7)), dot(p, vec2(269.5, 183.3)))) * 43758.5453);
+}
+
+float noise2D(vec2 p) {
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+    vec2 u = f * f * (3.0 - 2.0 * f);
+    float n = mix(
+        mix(dot(hash2(i + vec2(0.0, 0.0)), f - vec2(0.0, 0.0)),
+            dot(hash2(i + vec2(1.0, 0.0)), f - vec2(1.0, 0.0)), u.x),
+        mix(dot(hash2(i + vec2(0.0, 1.0)), f - vec2(0.0, 1.0)),
+            dot(hash2(i + vec2(1.0, 1.0)), f - vec2(1.0, 1.0)), u.x),
+        u.y
+    );
+    return 0.5 + 0.5 * n;
+}
+
+float sharpRing(vec3 decomposed, float time) {
+    float ringStart = 1.0;
+    float ringWidth = 0.3;
+    float noiseScale = 5.0;
+    float noise = mix(
+        noise2D(vec2(decomposed.x, time) * noiseScale),
+        noise2D(vec2(decomposed.y, time) * noiseScale),
+        decomposed.z
+    );
+    noise = (noise - 0.5) * 2.5;
+    return ringStart + noise * ringWidth * 1.5;
+}
+
+float smoothRing(vec3 decomposed, float time) {
+    float ringStart = 0.9;
+    float ringWidth = 0.2;
+    float noiseScale = 6.0;
+    float noise = mix(
+        noise2D(vec2(decomposed.x, time) * noiseScale),
+        noise2D(vec2(decomposed.y, time) * noiseScale),
+        decomposed.z
+    );
+    noise = (noise - 0.5) * 5.0;
+    return ringStart + noise * ringWidth;
+}
+
+float flow(vec3 decomposed, float time) {
+    return mix(
+        texture2D(uPerlinTexture, vec2(time, decomposed.x / 2.0)).r,
+        texture2D(uPerlinTexture, vec2(time, decomposed.y / 2.0)).r,
+        decomposed.z
+    );
+}
+
+void main() {
+    vec2 uv = vUv * 2.0 - 1.0;
+    float radius = length(uv);
+    float theta = atan(uv.y, uv.x);
+    if (theta < 0.0) theta += 2.0 * PI;
+
+    vec3 decomposed = vec3(
+        theta / (2.0 * PI),
+        mod(theta / (2.0 * PI) + 0.5, 1.0) + 1.0,
+        abs(theta / PI - 1.0)
+    );
+
+    float noise = flow(decomposed, radius * 0.03 - uAnimation * 0.2) - 0.5;
+    theta += noise * mix(0.08, 0.25, uOutputVolume);
+
+    vec4 color = vec4(1.0, 1.0, 1.0, 1.0);
+
+    float originalCenters[7];
+    originalCenters[0] = 0.0;
+    originalCenters[1] = 0.5 * PI;
+    originalCenters[2] = 1.0 * PI;
+    originalCenters[3] = 1.5 * PI;
+    originalCenters[4] = 2.0 * PI;
+    originalCenters[5] = 2.5 * PI;
+    originalCenters[6] = 3.0 * PI;
+
+    float centers[7];
+    for (int i = 0; i < 7; i++) {
+        centers[i] = originalCenters[i] + 0.5 * sin(uTime / 20.0 + uOffsets[i]);
+    }
+
+    float a, b;
+    vec4 ovalColor;
+
+    for (int i = 0; i < 7; i++) {
+        float noiseVal = texture2D(uPerlinTexture, vec2(mod(centers[i] + uTime * 0.05, 1.0), 0.5)).r;
+        a = 0.5 + noiseVal * 0.3;
+        b = noiseVal * mix(3.5, 2.5, uInputVolume);
+        bool reverseGradient = (mod(float(i), 2.0) == 1.0);
+
+        float distTheta = min(
+            abs(theta - centers[i]),
+            min(
+                abs(theta + 2.0 * PI - centers[i]),
+                abs(theta - 2.0 * PI - centers[i])
+            )
+        );
+        float distRadius = radius;
+        float softness = 0.6;
+
+        if (drawOval(vec2(distTheta, distRadius), vec2(0.0, 0.0), a, b, reverseGradient, softness, ovalColor)) {
+            color.rgb = mix(color.rgb, ovalColor.rgb, ovalColor.a);
+            color.a = max(color.a, ovalColor.a);
+        }
+    }
+
+    float ringRadius1 = sharpRing(decomposed, uTime * 0.1);
+    float ringRadius2 = smoothRing(decomposed, uTime * 0.1);
+
+    float inputRadius1 = radius + uInputVolume * 0.2;
+    float inputRadius2 = radius + uInputVolume * 0.15;
+    float opacity1 = mix(0.2, 0.6, uInputVolume);
+    float opacity2 = mix(0.15, 0.45, uInputVolume);
+
+    float ringAlpha1 = (inputRadius2 >= ringRadius1) ? opacity1 : 0.0;
+    float ringAlpha2 = smoothstep(ringRadius2 - 0.05, ringRadius2 + 0.05, inputRadius1) * opacity2;
+    float totalRingAlpha = max(ringAlpha1, ringAlpha2);
+
+    vec3 ringColor = vec3(1.0);
+    color.rgb = 1.0 - (1.0 - color.rgb) * (1.0 - ringColor * totalRingAlpha);
+
+    vec3 c1 = vec3(0.0, 0.0, 0.0);
+    vec3 c2 = uColor1;
+    vec3 c3 = uColor2;
+    vec3 c4 = vec3(1.0, 1.0, 1.0);
+
+    float luminance = mix(color.r, 1.0 - color.r, uInverted);
+    color.rgb = colorRamp(luminance, c1, c2, c3, c4);
+    color.a *= uOpacity;
+
+    gl_FragColor = color;
+}
+)";
+
+//==============================================================================
+// OrbGLResources
+
+bool OrbGLResources::create(juce::OpenGLContext& context)
+{
+    shader = std::make_unique<juce::OpenGLShaderProgram>(context);
+
+    if (!shader->addVertexShader(vertexShaderSource))
+    {
+        DBG("Vertex shader compile error: " + shader->getLastError());
+        shader.reset();
+        return false;
+    }
+
+    if (!shader->addFragmentShader(fragmentShaderSource))
+    {
+        DBG("Fragment shader compile error: " + shader->getLastError());
+        shader.reset();
+        return false;
+    }
+
+    if (!shader->link())
+    {
+        DBG("Shader link error: " + shader->getLastError());
+        shader.reset();
+        return false;
+    }
+
+    // Array uniforms need the raw location
+    offsetsLocation = context.extensions.glGetUniformLocation(shader->getProgramID(), "uOffsets");
+
+    // Noise texture, generated once per process and shared with the CPU renderer
+    const int size = kOrbNoiseTextureSize;
+    const auto& data = getOrbNoiseTexture();
+
+    glGenTextures(1, &noiseTexture);
+    glBindTexture(GL_TEXTURE_2D, noiseTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, size, size, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Create vertex buffers for fullscreen quad
+    const GLfloat vertices[] = {
+        -1.0f, -1.0f, 0.0f, 1.0f,
+         1.0f, -1.0f, 0.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f
+    };
+
+    const GLfloat texCoords[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f
+    };
+
+    context.extensions.glGenBuffers(1, &vertexBuffer);
+    context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    context.extensions.glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    context.extensions.glGenBuffers(1, &texCoordBuffer);
+    context.extensions.glBindBuffer(GL_ARRAY_BUFFER, texCoordBuffer);
+    context.extensions.glBufferData(GL_ARRAY_BUFFER, sizeof(texCoords), texCoords, GL_STATIC_DRAW);
+
+    return true;
+}
+
+void OrbGLResources::release(juce::OpenGLContext& context)
+{
+    shader.reset();
+    offsetsLocation = -1;
+
+    if (noiseTexture != 0)
+    {
+        glDeleteTextures(1, &noiseTexture);
+        noiseTexture = 0;
+    }
+
+    if (vertexBuffer != 0)
+    {
+        context.extensions.glDeleteBuffers(1, &vertexBuffer);
+        vertexBuffer = 0;
+    }
+
+    if (texCoordBuffer != 0)
+    {
+        context.extensions.glDeleteBuffers(1, &texCoordBuffer);
+        texCoordBuffer = 0;
+    }
+}
+
+void OrbGLResources::draw(juce::OpenGLContext& context, const OrbUniforms& uniforms)
+{
+    if (shader == nullptr)
+        return;
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader->use();
+
+    // Set uniforms
+    shader->setUniform("uTime", uniforms.time);
+    shader->setUniform("uAnimation", uniforms.animation);
+    shader->setUniform("uInverted", uniforms.inverted ? 1.0f : 0.0f);
+    shader->setUniform("uInputVolume", uniforms.inputVolume);
+    shader->setUniform("uOutputVolume", uniforms.outputVolume);
+    shader->setUniform("uOpacity", uniforms.opacity);
+
+    // Set colors
+    shader->setUniform("uColor1",
+                       uniforms.color1.getFloatRed(),
+                       uniforms.color1.getFloatGreen(),
+                       uniforms.color1.getFloatBlue());
+    shader->setUniform("uColor2",
+                       uniforms.color2.getFloatRed(),
+                       uniforms.color2.getFloatGreen(),
+                       uniforms.color2.getFloatBlue());
+
+    if (offsetsLocation >= 0)
+    {
+        glUniform1fv(offsetsLocation, 7, uniforms.offsets.data());
+    }
+
+    // Bind texture
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, noiseTexture);
+    shader->setUniform("uPerlinTexture", 0);
+
+    // Draw quad
+    context.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    if (auto* posAttr = shader->getAttributeIDFromName("aPosition"))
+    {
+        context.extensions.glVertexAttribPointer(posAttr->attributeID, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        context.extensions.glEnableVertexAttribArray(posAttr->attributeID);
+    }
+
+    context.extensions.glBindBuffer(GL_ARRAY_BUFFER, texCoordBuffer);
+    if (auto* texAttr = shader->getAttributeIDFromName("aTexCoord"))
+    {
+        context.extensions.glVertexAttribPointer(texAttr->attributeID, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        context.extensions.glEnableVertexAttribArray(texAttr->attributeID);
+    }
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
+bool OrbGLResources::isSoftwareRasteriser()
+{
+    const auto* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+
+    if (renderer == nullptr)
+        return false;
+
+    const juce::String name(renderer);
+    return name.containsIgnoreCase("llvmpipe")
+        || name.containsIgnoreCase("softpipe")
+        || name.containsIgnoreCase("swrast")
+        || name.containsIgnoreCase("Software Rasterizer")
+        || name.containsIgnoreCase("GDI Generic");
+}
+
+//==============================================================================
+// OrbRenderService
+
+OrbRenderService::OrbRenderService(juce::Component& hostComponent)
+    : host(hostComponent)
+{
+    openGLContext.setRenderer(this);
+    openGLContext.attachTo(host);
+}
+
+OrbRenderService::~OrbRenderService()
+{
+    openGLContext.detach();
+    cancelPendingUpdate();
+
+    // Hand the remaining orbs back to their own contexts
+    const auto remaining = entries;
+
+    for (const auto& entry : remaining)
+        entry.orb->renderServiceClosing();
+}
+
+int OrbRenderService::getNumOrbs() const
+{
+    const juce::SpinLock::ScopedLockType lock(entryLock);
+    return static_cast<int>(entries.size());
+}
+
+void OrbRenderService::addOrb(OrbVisualizer& orb)
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        for (const auto& entry : entries)
+            if (entry.orb == &orb)
+                return;
+
+        Entry entry;
+        entry.orb = &orb;
+        entries.push_back(entry);
+    }
+
+    if (glUnusable.load())
+        triggerAsyncUpdate();
+
+    updateOrb(orb, orb.getUniforms());
+}
+
+void OrbRenderService::removeOrb(OrbVisualizer& orb)
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&orb](const Entry& e) { return e.orb == &orb; }),
+                      entries.end());
+    }
+
+    openGLContext.triggerRepaint();
+}
+
+void OrbRenderService::updateOrb(OrbVisualizer& orb, const OrbUniforms& uniforms)
+{
+    // Component geometry is only safe to query here, on the message thread
+    const auto bounds = host.getLocalArea(&orb, orb.getLocalBounds());
+    const auto clip = FrameClock::getVisibleArea(orb, host).getIntersection(host.getLocalBounds());
+    const bool visible = orb.isShowing();
+
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        hostHeight = host.getHeight();
+
+        for (auto& entry : entries)
+        {
+            if (entry.orb == &orb)
+            {
+                entry.bounds = bounds;
+                entry.clip = clip;
+                entry.uniforms = uniforms;
+                entry.visible = visible;
+                break;
+            }
+        }
+    }
+
+    openGLContext.triggerRepaint();
+}
+
+void OrbRenderService::newOpenGLContextCreated()
+{
+    const bool created = resources.create(openGLContext);
+
+    if (!created || OrbGLResources::isSoftwareRasteriser())
+    {
+        glUnusable.store(true);
+        triggerAsyncUpdate();
+    }
+}
+
+void OrbRenderService::renderOpenGL()
+{
+    SHMUI_PROFILE_SCOPE("OrbRenderService::renderOpenGL");
+
+    juce::OpenGLHelpers::clear(juce::Colours::transparentBlack);
+
+    if (!resources.isValid())
+        return;
+
+    int height = 0;
+
+    {
+        // Copy into a reused list so drawing doesn't hold the lock
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+        renderList.assign(entries.begin(), entries.end());
+        height = hostHeight;
+    }
+
+    const auto scale = static_cast<float>(openGLContext.getRenderingScale());
+
+    // GL viewports are in physical pixels with the origin at the bottom left
+    auto toPhysical = [scale, height](juce::Rectangle<int> area)
+    {
+        return juce::Rectangle<int>::leftTopRightBottom(juce::roundToInt(area.getX() * scale),
+                                                        juce::roundToInt((height - area.getBottom()) * scale),
+                                                        juce::roundToInt(area.getRight() * scale),
+                                                        juce::roundToInt((height - area.getY()) * scale));
+    };
+
+    glEnable(GL_SCISSOR_TEST);
+
+    for (const auto& entry : renderList)
+    {
+        // Scrolled out of a viewport or behind a collapsed parent
+        if (!entry.visible || entry.bounds.isEmpty() || entry.clip.isEmpty())
+            continue;
+
+        const auto viewport = toPhysical(entry.bounds);
+        const auto scissor = toPhysical(entry.clip);
+
+        // The viewport keeps the orb's own size; the scissor cuts it to what its ancestors show
+        glViewport(viewport.getX(), viewport.getY(), viewport.getWidth(), viewport.getHeight());
+        glScissor(scissor.getX(), scissor.getY(), scissor.getWidth(), scissor.getHeight());
+        resources.draw(openGLContext, entry.uniforms);
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+}
+
+void OrbRenderService::openGLContextClosing()
+{
+    resources.release(openGLContext);
+}
+
+void OrbRenderService::handleAsyncUpdate()
+{
+    if (!glUnusable.load())
+        return;
+
+    std::vector<OrbVisualizer*> orbs;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        for (const auto& entry : entries)
+            orbs.push_back(entry.orb);
+    }
+
+    // useSoftwareRenderer() removes the orb from this service
+    for (auto* orb : orbs)
+        if (orb->getRenderBackend() == OrbRenderBackend::Auto)
+            orb->useSoftwareRenderer();
+}
+
+} // namespace shmui
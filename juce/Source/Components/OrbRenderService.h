@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    OrbRenderService.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Shared OpenGL rendering for many OrbVisualizer instances: one context,
+    one compiled program and one noise texture, with each orb drawn into
+    its own viewport.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OrbSoftwareRenderer.h"
+#include <atomic>
+#include <vector>
+
+namespace shmui
+{
+
+class OrbVisualizer;
+
+/**
+ * @brief GL objects needed to draw the orb shader.
+ *
+ * Program, noise texture and quad buffers for one OpenGL context. Used by
+ * a standalone OrbVisualizer for its own context and by OrbRenderService
+ * for the shared one. Must be created, used and released on the GL thread.
+ */
+class OrbGLResources
+{
+public:
+    OrbGLResources() = default;
+    ~OrbGLResources() = default;
+
+    /**
+     * @brief Compile the program and upload the texture and quad.
+     *
+     * @return false if the shader failed to compile or link
+     */
+    bool create(juce::OpenGLContext& context);
+
+    /**
+     * @brief Delete all GL objects.
+     */
+    void release(juce::OpenGLContext& context);
+
+    /**
+     * @brief Check if the program is ready to draw.
+     */
+    bool isValid() const { return shader != nullptr; }
+
+    /**
+     * @brief Draw the orb into the current viewport.
+     */
+    void draw(juce::OpenGLContext& context, const OrbUniforms& uniforms);
+
+    /**
+     * @brief Check if the current context is a software rasteriser.
+     *
+     * True for llvmpipe, softpipe, swrast and the Windows GDI fallback.
+     */
+    static bool isSoftwareRasteriser();
+
+private:
+    std::unique_ptr<juce::OpenGLShaderProgram> shader;
+    GLuint noiseTexture = 0;
+    GLuint vertexBuffer = 0;
+    GLuint texCoordBuffer = 0;
+    GLint offsetsLocation = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrbGLResources)
+};
+
+//==============================================================================
+
+/**
+ * @brief One OpenGL context that renders many orbs.
+ *
+ * Attach the service to a component that contains the orbs (typically the
+ * dashboard or editor), then hand it to each orb with
+ * OrbVisualizer::setRenderService(). The orbs drop their own contexts and
+ * the service draws each one into its bounds within the host, so startup
+ * cost and GPU memory stay flat as more orbs are added.
+ *
+ * Orbs report their bounds and shader inputs from the message thread
+ * whenever they need a new frame; the GL thread renders the latest
+ * snapshot of all of them in one pass.
+ *
+ * The context keeps component painting on, so the rest of the host UI
+ * still draws, composited over the GL output. The host and every parent
+ * between it and the orbs must therefore leave the orb bounds unpainted:
+ * an opaque background there hides the orbs.
+ *
+ * If the shared context has no usable GPU, orbs using the Auto backend
+ * switch to their software renderer, as they would on their own.
+ */
+class OrbRenderService : private juce::OpenGLRenderer,
+                         private juce::AsyncUpdater
+{
+public:
+    /**
+     * @brief Create the service and attach its context to a host.
+     *
+     * @param host Component that contains (directly or indirectly) the orbs
+     */
+    explicit OrbRenderService(juce::Component& host);
+    ~OrbRenderService() override;
+
+    /**
+     * @brief Get the number of orbs drawn by this service.
+     */
+    int getNumOrbs() const;
+
+    /**
+     * @brief Get the host component.
+     */
+    juce::Component& getHost() const { return host; }
+
+private:
+    friend class OrbVisualizer;
+
+    struct Entry
+    {
+        OrbVisualizer* orb = nullptr;
+        juce::Rectangle<int> bounds;
+        juce::Rectangle<int> clip;          // Part of bounds inside every ancestor
+        OrbUniforms uniforms;
+        bool visible = false;
+    };
+
+    // Called by OrbVisualizer on the message thread
+    void addOrb(OrbVisualizer& orb);
+    void removeOrb(OrbVisualizer& orb);
+    void updateOrb(OrbVisualizer& orb, const OrbUniforms& uniforms);
+
+    // OpenGLRenderer
+    void newOpenGLContextCreated() override;
+    void renderOpenGL() override;
+    void openGLContextClosing() override;
+
+    // AsyncUpdater: moves Auto orbs to software rendering after a GL failure
+    void handleAsyncUpdate() override;
+
+    //==============================================================================
+
+    juce::Component& host;
+    juce::OpenGLContext openGLContext;
+    OrbGLResources resources;
+
+    // Message thread writes, GL thread copies into renderList
+    std::vector<Entry> entries;
+    int hostHeight = 0;
+    mutable juce::SpinLock entryLock;
+
+    std::vector<Entry> renderList;
+    std::atomic<bool> glUnusable{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrbRenderService)
+};
+
+} // namespace shmui
@@ -0,0 +1,478 @@
+/*
+  ==============================================================================
+
+    OrbSoftwareRenderer.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the CPU orb renderer.
+
+  ==============================================================================
+*/
+
+#include "OrbSoftwareRenderer.h"
+#include "../Utils/Profiling.h"
+#include "../Utils/ColorUtils.h"
+#include "../Utils/Interpolation.h"
+
+namespace shmui
+{
+
+//==============================================================================
+// Noise Texture
+
+const std::vector<uint8_t>& getOrbNoiseTexture()
+{
+    static const std::vector<uint8_t> texture = []
+    {
+        // Simple multi-octave value noise
+        const int size = kOrbNoiseTextureSize;
+        std::vector<uint8_t> data(static_cast<size_t>(size) * size);
+
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const float fx = static_cast<float>(x) / size;
+                const float fy = static_cast<float>(y) / size;
+
+                float value = 0.0f;
+                float amplitude = 1.0f;
+                float frequency = 4.0f;
+
+                for (int octave = 0; octave < 4; ++octave)
+                {
+                    const int ix = static_cast<int>(fx * frequency) % size;
+                    const int iy = static_cast<int>(fy * frequency) % size;
+
+                    // Use seeded random for deterministic noise
+                    const float noise = Interpolation::seededRandom(
+                        static_cast<float>(ix * 1000 + iy + octave * 10000));
+
+                    value += noise * amplitude;
+                    amplitude *= 0.5f;
+                    frequency *= 2.0f;
+                }
+
+                data[static_cast<size_t>(y) * size + x] =
+                    static_cast<uint8_t>(juce::jlimit(0.0f, 255.0f, value * 128.0f));
+            }
+        }
+
+        return data;
+    }();
+
+    return texture;
+}
+
+//==============================================================================
+// Shader helpers (same math as the fragment shader in OrbVisualizer.cpp)
+
+namespace
+{
+
+constexpr float kPi = juce::MathConstants<float>::pi;
+constexpr float kTwoPi = juce::MathConstants<float>::twoPi;
+constexpr int kTextureMask = kOrbNoiseTextureSize - 1;
+
+inline float fract(float x)
+{
+    return x - std::floor(x);
+}
+
+inline float mix(float a, float b, float t)
+{
+    return a + (b - a) * t;
+}
+
+inline float smoothstep(float edge0, float edge1, float x)
+{
+    // GLSL form, also valid for edge0 > edge1
+    const float t = juce::jlimit(0.0f, 1.0f, (x - edge0) / (edge1 - edge0));
+    return t * t * (3.0f - 2.0f * t);
+}
+
+/** texture2D() on the noise texture with GL_LINEAR and GL_REPEAT. */
+float sampleNoiseTexture(const uint8_t* texture, float u, float v)
+{
+    const float x = u * kOrbNoiseTextureSize - 0.5f;
+    const float y = v * kOrbNoiseTextureSize - 0.5f;
+    const float x0 = std::floor(x);
+    const float y0 = std::floor(y);
+    const float fx = x - x0;
+    const float fy = y - y0;
+
+    const int ix0 = static_cast<int>(x0) & kTextureMask;
+    const int ix1 = (ix0 + 1) & kTextureMask;
+    const int iy0 = (static_cast<int>(y0) & kTextureMask) * kOrbNoiseTextureSize;
+    const int iy1 = (((static_cast<int>(y0) + 1) & kTextureMask)) * kOrbNoiseTextureSize;
+
+    const float top = mix(texture[iy0 + ix0], texture[iy0 + ix1], fx);
+    const float bottom = mix(texture[iy1 + ix0], texture[iy1 + ix1], fx);
+
+    return mix(top, bottom, fy) * (1.0f / 255.0f);
+}
+
+/** dot(hash2(i), f) from the shader. */
+inline float hashDot(float ix, float iy, float fx, float fy)
+{
+    const float hx = fract(std::sin(ix * 127.1f + iy * 311.7f) * 43758.5453f);
+    const float hy = fract(std::sin(ix * 269.5f + iy * 183.3f) * 43758.5453f);
+    return hx * fx + hy * fy;
+}
+
+float noise2D(float px, float py)
+{
+    const float ix = std::floor(px);
+    const float iy = std::floor(py);
+    const float fx = px - ix;
+    const float fy = py - iy;
+    const float ux = fx * fx * (3.0f - 2.0f * fx);
+    const float uy = fy * fy * (3.0f - 2.0f * fy);
+
+    const float n = mix(mix(hashDot(ix, iy, fx, fy),
+                            hashDot(ix + 1.0f, iy, fx - 1.0f, fy), ux),
+                        mix(hashDot(ix, iy + 1.0f, fx, fy - 1.0f),
+                            hashDot(ix + 1.0f, iy + 1.0f, fx - 1.0f, fy - 1.0f), ux),
+                        uy);
+
+    return 0.5f + 0.5f * n;
+}
+
+struct Decomposed
+{
+    float x, y, z;
+};
+
+inline Decomposed decompose(float theta)
+{
+    const float x = theta / kTwoPi;
+    return { x, fract(x + 0.5f) + 1.0f, std::abs(theta / kPi - 1.0f) };
+}
+
+float sharpRing(const Decomposed& d, float time)
+{
+    const float noiseScale = 5.0f;
+    float noise = mix(noise2D(d.x * noiseScale, time * noiseScale),
+                      noise2D(d.y * noiseScale, time * noiseScale),
+                      d.z);
+    noise = (noise - 0.5f) * 2.5f;
+    return 1.0f + noise * 0.3f * 1.5f;
+}
+
+float smoothRing(const Decomposed& d, float time)
+{
+    const float noiseScale = 6.0f;
+    float noise = mix(noise2D(d.x * noiseScale, time * noiseScale),
+                      noise2D(d.y * noiseScale, time * noiseScale),
+                      d.z);
+    noise = (noise - 0.5f) * 5.0f;
+    return 0.9f + noise * 0.2f;
+}
+
+} // namespace
+
+//==============================================================================
+
+OrbSoftwareRenderer::OrbSoftwareRenderer(int numThreads)
+{
+    numWorkers = numThreads < 0 ? std::max(0, juce::SystemStats::getNumCpus() - 1)
+                                : numThreads;
+
+    if (numWorkers > 0)
+        pool = std::make_unique<juce::ThreadPool>(numWorkers);
+}
+
+OrbSoftwareRenderer::~OrbSoftwareRenderer()
+{
+    // Jobs from the last frame may still be spinning down
+    if (pool != nullptr)
+        pool->removeAllJobs(true, 1000);
+}
+
+void OrbSoftwareRenderer::setResolutionScale(float scale)
+{
+    resolutionScale = juce::jlimit(0.1f, 1.0f, scale);
+}
+
+const juce::Image& OrbSoftwareRenderer::render(const OrbUniforms& uniforms, int targetWidth, int targetHeight)
+{
+    SHMUI_PROFILE_SCOPE("OrbSoftwareRenderer::render");
+
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    const int width = std::max(1, juce::roundToInt(targetWidth * resolutionScale));
+    const int height = std::max(1, juce::roundToInt(targetHeight * resolutionScale));
+
+    if (width != imageWidth || height != imageHeight)
+        prepareTables(width, height);
+
+    prepareFrame(uniforms);
+
+    {
+        juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::writeOnly);
+        pixelData = bitmap.data;
+        lineStride = bitmap.lineStride;
+        pixelStride = bitmap.pixelStride;
+
+        renderTiles();
+
+        pixelData = nullptr;
+    }
+
+    lastRenderMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    return image;
+}
+
+//==============================================================================
+// Tables
+
+void OrbSoftwareRenderer::prepareTables(int width, int height)
+{
+    imageWidth = width;
+    imageHeight = height;
+    image = juce::Image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+
+    const size_t numPixels = static_cast<size_t>(width) * height;
+
+    radius.resize(numPixels);
+    theta.resize(numPixels);
+    angleMix.resize(numPixels);
+    flowU.resize(numPixels);
+    flowRowA0.resize(numPixels);
+    flowRowA1.resize(numPixels);
+    flowRowB0.resize(numPixels);
+    flowRowB1.resize(numPixels);
+    flowFracA.resize(numPixels);
+    flowFracB.resize(numPixels);
+    ringIndex.resize(numPixels);
+    ringFrac.resize(numPixels);
+
+    // Texture row pair and weight for a fixed v coordinate
+    auto textureRows = [](float v, int& row0, int& row1, float& frac)
+    {
+        const float y = v * kOrbNoiseTextureSize - 0.5f;
+        const float y0 = std::floor(y);
+        frac = y - y0;
+        row0 = (static_cast<int>(y0) & kTextureMask) * kOrbNoiseTextureSize;
+        row1 = ((static_cast<int>(y0) + 1) & kTextureMask) * kOrbNoiseTextureSize;
+    };
+
+    for (int y = 0; y < height; ++y)
+    {
+        // vUv has its origin at the bottom left, image rows run top down
+        const float uvY = (1.0f - (y + 0.5f) / height) * 2.0f - 1.0f;
+
+        for (int x = 0; x < width; ++x)
+        {
+            const size_t i = static_cast<size_t>(y) * width + x;
+            const float uvX = ((x + 0.5f) / width) * 2.0f - 1.0f;
+
+            const float r = std::sqrt(uvX * uvX + uvY * uvY);
+            float angle = std::atan2(uvY, uvX);
+            if (angle < 0.0f)
+                angle += kTwoPi;
+
+            const auto d = decompose(angle);
+
+            radius[i] = r;
+            theta[i] = angle;
+            angleMix[i] = d.z;
+            flowU[i] = r * 0.03f * kOrbNoiseTextureSize - 0.5f;
+
+            textureRows(d.x / 2.0f, flowRowA0[i], flowRowA1[i], flowFracA[i]);
+            textureRows(d.y / 2.0f, flowRowB0[i], flowRowB1[i], flowFracB[i]);
+
+            const float ringPos = angle / kTwoPi * kRingTableSize;
+            ringIndex[i] = std::min(static_cast<int>(ringPos), kRingTableSize - 1);
+            ringFrac[i] = ringPos - static_cast<float>(ringIndex[i]);
+        }
+    }
+}
+
+void OrbSoftwareRenderer::prepareFrame(const OrbUniforms& uniforms)
+{
+    const uint8_t* texture = getOrbNoiseTexture().data();
+
+    inputVolume = uniforms.inputVolume;
+    inverted = uniforms.inverted;
+    thetaNoiseAmount = mix(0.08f, 0.25f, uniforms.outputVolume);
+    flowOffset = -uniforms.animation * 0.2f * kOrbNoiseTextureSize;
+
+    // Oval shapes
+    for (size_t i = 0; i < ovals.size(); ++i)
+    {
+        auto& oval = ovals[i];
+        oval.center = static_cast<float>(i) * 0.5f * kPi +
+                      0.5f * std::sin(uniforms.time / 20.0f + uniforms.offsets[i]);
+
+        const float noiseVal = sampleNoiseTexture(texture, fract(oval.center + uniforms.time * 0.05f), 0.5f);
+        const float a = 0.5f + noiseVal * 0.3f;
+        const float b = std::max(1.0e-4f, noiseVal * mix(3.5f, 2.5f, uniforms.inputVolume));
+
+        oval.invA = 1.0f / a;
+        oval.invASquared = oval.invA * oval.invA;
+        oval.invBSquared = 1.0f / (b * b);
+        oval.reverseGradient = (i % 2) == 1;
+    }
+
+    // Ring radii only depend on the unperturbed angle
+    const float ringTime = uniforms.time * 0.1f;
+
+    for (int k = 0; k <= kRingTableSize; ++k)
+    {
+        const auto d = decompose(static_cast<float>(k) * kTwoPi / kRingTableSize);
+        sharpRingTable[k] = sharpRing(d, ringTime);
+        smoothRingTable[k] = smoothRing(d, ringTime);
+    }
+
+    // Colour ramp with opacity
+    ramp.buildOrbRamp(uniforms.color1, uniforms.color2, uniforms.opacity);
+}
+
+//==============================================================================
+// Rendering
+
+void OrbSoftwareRenderer::renderTiles()
+{
+    // Tile layout is captured per frame, never read from members the next frame rewrites
+    constexpr int rowsPerTile = 8;
+    const int numTiles = (imageHeight + rowsPerTile - 1) / rowsPerTile;
+    const int height = imageHeight;
+
+    tilesDone.store(0);
+    allTilesDone.reset();
+    nextTile.store(0);
+
+    auto drainTiles = [this, numTiles, height]
+    {
+        for (int tile = nextTile.fetch_add(1); tile < numTiles; tile = nextTile.fetch_add(1))
+        {
+            const int startRow = tile * rowsPerTile;
+            renderRows(startRow, std::min(startRow + rowsPerTile, height));
+
+            if (tilesDone.fetch_add(1) + 1 == numTiles)
+                allTilesDone.signal();
+        }
+    };
+
+    const int helpers = pool != nullptr ? std::min(numWorkers, numTiles - 1) : 0;
+
+    activeHelpers.store(helpers);
+    helpersFinished.reset();
+
+    for (int i = 0; i < helpers; ++i)
+    {
+        pool->addJob([this, drainTiles]
+        {
+            drainTiles();
+
+            if (activeHelpers.fetch_sub(1) == 1)
+                helpersFinished.signal();
+        });
+    }
+
+    // The calling thread works through tiles too
+    drainTiles();
+    allTilesDone.wait();
+
+    // A helper can still be between its last tile and leaving drainTiles(),
+    // or not have started yet; it must be gone before the next frame resets
+    // the counters it reads
+    if (helpers > 0)
+        helpersFinished.wait();
+}
+
+void OrbSoftwareRenderer::renderRows(int startRow, int endRow)
+{
+    // Rows are processed in spans so the scratch buffers stay on the stack
+    constexpr int kSpan = 256;
+    std::array<float, kSpan> angle;
+    std::array<float, kSpan> luminance;
+
+    const uint8_t* texture = getOrbNoiseTexture().data();
+    const float opacity1 = mix(0.2f, 0.6f, inputVolume);
+    const float opacity2 = mix(0.15f, 0.45f, inputVolume);
+
+    for (int y = startRow; y < endRow; ++y)
+    {
+        auto* line = pixelData + static_cast<size_t>(y) * lineStride;
+
+        for (int spanStart = 0; spanStart < imageWidth; spanStart += kSpan)
+        {
+            const int n = std::min(kSpan, imageWidth - spanStart);
+            const size_t base = static_cast<size_t>(y) * imageWidth + spanStart;
+
+            // Pass 1: flow noise perturbs the angle
+            for (int i = 0; i < n; ++i)
+            {
+                const size_t p = base + i;
+
+                const float u = flowU[p] + flowOffset;
+                const float u0 = std::floor(u);
+                const float fu = u - u0;
+                const int ix0 = static_cast<int>(u0) & kTextureMask;
+                const int ix1 = (ix0 + 1) & kTextureMask;
+
+                const float a = mix(mix(texture[flowRowA0[p] + ix0], texture[flowRowA0[p] + ix1], fu),
+                                    mix(texture[flowRowA1[p] + ix0], texture[flowRowA1[p] + ix1], fu),
+                                    flowFracA[p]);
+                const float b = mix(mix(texture[flowRowB0[p] + ix0], texture[flowRowB0[p] + ix1], fu),
+                                    mix(texture[flowRowB1[p] + ix0], texture[flowRowB1[p] + ix1], fu),
+                                    flowFracB[p]);
+
+                const float flow = mix(a, b, angleMix[p]) * (1.0f / 255.0f);
+                angle[i] = theta[p] + (flow - 0.5f) * thetaNoiseAmount;
+                luminance[i] = 1.0f;
+            }
+
+            // Pass 2: ovals, branchless (edge is 0 outside an oval)
+            for (const auto& oval : ovals)
+            {
+                const float gradientBase = oval.reverseGradient ? 1.0f : 0.0f;
+                const float gradientSign = oval.reverseGradient ? -1.0f : 1.0f;
+
+                for (int i = 0; i < n; ++i)
+                {
+                    const float t = angle[i];
+                    const float r = radius[base + i];
+
+                    const float dist = std::min(std::abs(t - oval.center),
+                                                std::min(std::abs(t + kTwoPi - oval.center),
+                                                         std::abs(t - kTwoPi - oval.center)));
+
+                    const float shape = dist * dist * oval.invASquared + r * r * oval.invBSquared;
+                    const float e = std::min(1.0f, std::max(0.0f, (1.0f - shape) * (1.0f / 0.6f)));
+                    const float edge = e * e * (3.0f - 2.0f * e);
+
+                    const float gradient = 0.5f + 0.1f * (gradientBase + gradientSign * (dist * oval.invA + 1.0f) * 0.5f - 0.5f);
+                    luminance[i] += (gradient - luminance[i]) * (0.85f * edge);
+                }
+            }
+
+            // Pass 3: rings, then the colour ramp over the whole span
+            for (int i = 0; i < n; ++i)
+            {
+                const size_t p = base + i;
+                const int k = ringIndex[p];
+                const float f = ringFrac[p];
+                const float r = radius[p];
+
+                const float ring1 = mix(sharpRingTable[k], sharpRingTable[k + 1], f);
+                const float ring2 = mix(smoothRingTable[k], smoothRingTable[k + 1], f);
+
+                const float alpha1 = (r + inputVolume * 0.15f >= ring1) ? opacity1 : 0.0f;
+                const float alpha2 = smoothstep(ring2 - 0.05f, ring2 + 0.05f, r + inputVolume * 0.2f) * opacity2;
+                const float ringAlpha = std::max(alpha1, alpha2);
+
+                const float value = 1.0f - (1.0f - luminance[i]) * (1.0f - ringAlpha);
+                luminance[i] = inverted ? 1.0f - value : value;
+            }
+
+            jassert(pixelStride == static_cast<int>(sizeof(juce::PixelARGB)));
+            ramp.mapToPixels(luminance.data(),
+                             reinterpret_cast<juce::PixelARGB*>(line + static_cast<size_t>(spanStart) * pixelStride), n);
+        }
+    }
+}
+
+} // namespace shmui
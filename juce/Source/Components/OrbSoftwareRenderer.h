@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    OrbSoftwareRenderer.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    CPU renderer for the orb shader, used when no usable GPU is available.
+    Renders the same math as the OrbVisualizer fragment shader into a
+    juce::Image at reduced internal resolution.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Utils/ColorUtils.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace shmui
+{
+
+/**
+ * @brief Per-frame inputs of the orb shader.
+ *
+ * Mirrors the uniforms of the OrbVisualizer fragment shader so the OpenGL
+ * and software paths render from the same values.
+ */
+struct OrbUniforms
+{
+    float time = 0.0f;             ///< uTime
+    float animation = 0.0f;        ///< uAnimation
+    float inputVolume = 0.0f;      ///< uInputVolume (0-1)
+    float outputVolume = 0.0f;     ///< uOutputVolume (0-1)
+    float opacity = 1.0f;          ///< uOpacity (0-1)
+    bool inverted = false;         ///< uInverted
+    std::array<float, 7> offsets{};  ///< uOffsets
+    juce::Colour color1{0xFFCADCFC};  ///< uColor1
+    juce::Colour color2{0xFFA0B9D1};  ///< uColor2
+};
+
+/** Width and height of the orb noise texture. */
+constexpr int kOrbNoiseTextureSize = 256;
+
+/**
+ * @brief Get the orb noise texture (single channel, row-major).
+ *
+ * Generated once and shared by the OpenGL texture upload and the software
+ * renderer, so both sample identical data.
+ */
+const std::vector<uint8_t>& getOrbNoiseTexture();
+
+//==============================================================================
+
+/**
+ * @brief Multithreaded CPU implementation of the orb fragment shader.
+ *
+ * Renders into an ARGB image at a fraction of the target size; the caller
+ * draws it scaled up. Everything that depends only on pixel position
+ * (polar coordinates, texture rows, ring table positions) is tabulated when
+ * the size changes, and everything that depends only on the frame (oval
+ * shapes, ring radii per angle, colour ramp) is tabulated once per frame.
+ * The per-pixel work is a handful of branchless passes over those tables,
+ * split into row tiles across a thread pool.
+ *
+ * Output matches the shader to within texture filtering and float
+ * precision differences, except that the ring radii are interpolated
+ * from a per-angle table.
+ */
+class OrbSoftwareRenderer
+{
+public:
+    /**
+     * @brief Create a renderer.
+     *
+     * @param numThreads Worker threads used besides the calling thread.
+     *                   Negative picks one less than the number of CPUs.
+     */
+    explicit OrbSoftwareRenderer(int numThreads = -1);
+    ~OrbSoftwareRenderer();
+
+    /**
+     * @brief Set internal resolution relative to the target size (0.1-1).
+     *
+     * Default is 0.5, i.e. a quarter of the pixels.
+     */
+    void setResolutionScale(float scale);
+
+    /**
+     * @brief Get the internal resolution scale.
+     */
+    float getResolutionScale() const { return resolutionScale; }
+
+    /**
+     * @brief Render one frame.
+     *
+     * @param uniforms Shader inputs for this frame
+     * @param targetWidth Width the image will be drawn at
+     * @param targetHeight Height the image will be drawn at
+     * @return Premultiplied ARGB image at the internal resolution
+     */
+    const juce::Image& render(const OrbUniforms& uniforms, int targetWidth, int targetHeight);
+
+    /**
+     * @brief Get the last rendered image.
+     */
+    const juce::Image& getImage() const { return image; }
+
+    /**
+     * @brief Time taken by the last render() call in milliseconds.
+     */
+    double getLastRenderMilliseconds() const { return lastRenderMs; }
+
+    /** Number of entries in the per-angle ring tables. */
+    static constexpr int kRingTableSize = 512;
+
+    /** Number of entries in the colour ramp lookup table. */
+    static constexpr int kRampTableSize = 1024;
+
+private:
+    struct Oval
+    {
+        float center = 0.0f;
+        float invA = 1.0f;
+        float invASquared = 1.0f;
+        float invBSquared = 1.0f;
+        bool reverseGradient = false;
+    };
+
+    void prepareTables(int width, int height);
+    void prepareFrame(const OrbUniforms& uniforms);
+    void renderTiles();
+    void renderRows(int startRow, int endRow);
+
+    //==============================================================================
+
+    float resolutionScale = 0.5f;
+    juce::Image image;
+    int imageWidth = 0;
+    int imageHeight = 0;
+
+    // Per-pixel tables (size-dependent)
+    std::vector<float> radius;
+    std::vector<float> theta;
+    std::vector<float> angleMix;        // decomposed.z
+    std::vector<float> flowU;           // texel x of the flow lookup, before the time offset
+    std::vector<int> flowRowA0, flowRowA1, flowRowB0, flowRowB1;
+    std::vector<float> flowFracA, flowFracB;
+    std::vector<int> ringIndex;
+    std::vector<float> ringFrac;
+
+    // Per-frame tables
+    std::array<Oval, 7> ovals;
+    std::array<float, kRingTableSize + 1> sharpRingTable{};
+    std::array<float, kRingTableSize + 1> smoothRingTable{};
+    ColorUtils::ColourLUT<kRampTableSize> ramp;     // Colour ramp with opacity
+    float flowOffset = 0.0f;
+    float thetaNoiseAmount = 0.0f;
+    float inputVolume = 0.0f;
+    bool inverted = false;
+
+    // Output access shared with the workers during a frame
+    uint8_t* pixelData = nullptr;
+    int lineStride = 0;
+    int pixelStride = 0;
+
+    // Row tiles
+    std::unique_ptr<juce::ThreadPool> pool;
+    int numWorkers = 0;
+    std::atomic<int> nextTile{0};
+    std::atomic<int> tilesDone{0};
+    std::atomic<int> activeHelpers{0};          // Helper jobs of this frame not yet finished
+    juce::WaitableEvent allTilesDone;
+    juce::WaitableEvent helpersFinished;
+
+    double lastRenderMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrbSoftwareRenderer)
+};
+
+} // namespace shmui
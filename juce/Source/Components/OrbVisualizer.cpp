@@ -10,205 +10,16 @@
 */
 
 #include "OrbVisualizer.h"
+#include "../Utils/Profiling.h"
 #include "../Utils/ColorUtils.h"
 
 namespace shmui
 {
 
-// Embedded shader source (loaded from files at compile time)
-static const char* vertexShaderSource = R"(
-attribute vec4 aPosition;
-attribute vec2 aTexCoord;
-varying vec2 vUv;
-void main()
-{
-    vUv = aTexCoord;
-    gl_Position = aPosition;
-}
-)";
-
-static const char* fragmentShaderSource = R"(
-#ifdef GL_ES
-precision highp float;
-#endif
-
-uniform float uTime;
-uniform float uAnimation;
-uniform float uInverted;
-uniform float uOffsets[7];
-uniform vec3 uColor1;
-uniform vec3 uColor2;
-uniform float uInputVolume;
-uniform float uOutputVolume;
-uniform float uOpacity;
-uniform sampler2D uPerlinTexture;
-
-varying vec2 vUv;
-
-const float PI = 3.14159265358979323846;
-
-bool drawOval(vec2 polarUv, vec2 polarCenter, float a, float b, bool reverseGradient, float softness, out vec4 color) {
-    vec2 p = polarUv - polarCenter;
-    float oval = (p.x * p.x) / (a * a) + (p.y * p.y) / (b * b);
-    float edge = smoothstep(1.0, 1.0 - softness, oval);
-    if (edge > 0.0) {
-        float gradient = reverseGradient ? (1.0 - (p.x / a + 1.0) / 2.0) : ((p.x / a + 1.0) / 2.0);
-        gradient = mix(0.5, gradient, 0.1);
-        color = vec4(vec3(gradient), 0.85 * edge);
-        return true;
-    }
-    return false;
-}
-
-vec3 colorRamp(float grayscale, vec3 color1, vec3 color2, vec3 color3, vec3 color4) {
-    if (grayscale < 0.33) {
-        return mix(color1, color2, grayscale * 3.0);
-    } else if (grayscale < 0.66) {
-        return mix(color2, color3, (grayscale - 0.33) * 3.0);
-    } else {
-        return mix(color3, color4, (grayscale - 0.66) * 3.0);
-    }
-}
-
-vec2 hash2(vec2 p) {
-    return fract(sin(vec2(dot(p, vec2(127.1, 311.7)), dot(p, vec2(269.5, 183.3)))) * 43758.5453);
-}
-
-float noise2D(vec2 p) {
-    vec2 i = floor(p);
-    vec2 f = fract(p);
-    vec2 u = f * f * (3.0 - 2.0 * f);
-    float n = mix(
-        mix(dot(hash2(i + vec2(0.0, 0.0)), f - vec2(0.0, 0.0)),
-            dot(hash2(i + vec2(1.0, 0.0)), f - vec2(1.0, 0.0)), u.x),
-        mix(dot(hash2(i + vec2(0.0, 1.0)), f - vec2(0.0, 1.0)),
-            dot(hash2(i + vec2(1.0, 1.0)), f - vec2(1.0, 1.0)), u.x),
-        u.y
-    );
-    return 0.5 + 0.5 * n;
-}
-
-float sharpRing(vec3 decomposed, float time) {
-    float ringStart = 1.0;
-    float ringWidth = 0.3;
-    float noiseScale = 5.0;
-    float noise = mix(
-        noise2D(vec2(decomposed.x, time) * noiseScale),
-        noise2D(vec2(decomposed.y, time) * noiseScale),
-        decomposed.z
-    );
-    noise = (noise - 0.5) * 2.5;
-    return ringStart + noise * ringWidth * 1.5;
-}
-
-float smoothRing(vec3 decomposed, float time) {
-    float ringStart = 0.9;
-    float ringWidth = 0.2;
-    float noiseScale = 6.0;
-    float noise = mix(
-        noise2D(vec2(decomposed.x, time) * noiseScale),
-        noise2D(vec2(decomposed.y, time) * noiseScale),
-        decomposed.z
-    );
-    noise = (noise - 0.5) * 5.0;
-    return ringStart + noise * ringWidth;
-}
-
-float flow(vec3 decomposed, float time) {
-    return mix(
-        texture2D(uPerlinTexture, vec2(time, decomposed.x / 2.0)).r,
-        texture2D(uPerlinTexture, vec2(time, decomposed.y / 2.0)).r,
-        decomposed.z
-    );
-}
-
-void main() {
-    vec2 uv = vUv * 2.0 - 1.0;
-    float radius = length(uv);
-    float theta = atan(uv.y, uv.x);
-    if (theta < 0.0) theta += 2.0 * PI;
-
-    vec3 decomposed = vec3(
-        theta / (2.0 * PI),
-        mod(theta / (2.0 * PI) + 0.5, 1.0) + 1.0,
-        abs(theta / PI - 1.0)
-    );
-
-    float noise = flow(decomposed, radius * 0.03 - uAnimation * 0.2) - 0.5;
-    theta += noise * mix(0.08, 0.25, uOutputVolume);
-
-    vec4 color = vec4(1.0, 1.0, 1.0, 1.0);
-
-    float originalCenters[7];
-    originalCenters[0] = 0.0;
-    originalCenters[1] = 0.5 * PI;
-    originalCenters[2] = 1.0 * PI;
-    originalCenters[3] = 1.5 * PI;
-    originalCenters[4] = 2.0 * PI;
-    originalCenters[5] = 2.5 * PI;
-    originalCenters[6] = 3.0 * PI;
-
-    float centers[7];
-    for (int i = 0; i < 7; i++) {
-        centers[i] = originalCenters[i] + 0.5 * sin(uTime / 20.0 + uOffsets[i]);
-    }
-
-    float a, b;
-    vec4 ovalColor;
-
-    for (int i = 0; i < 7; i++) {
-        float noiseVal = texture2D(uPerlinTexture, vec2(mod(centers[i] + uTime * 0.05, 1.0), 0.5)).r;
-        a = 0.5 + noiseVal * 0.3;
-        b = noiseVal * mix(3.5, 2.5, uInputVolume);
-        bool reverseGradient = (mod(float(i), 2.0) == 1.0);
-
-        float distTheta = min(
-            abs(theta - centers[i]),
-            min(
-                abs(theta + 2.0 * PI - centers[i]),
-                abs(theta - 2.0 * PI - centers[i])
-            )
-        );
-        float distRadius = radius;
-        float softness = 0.6;
-
-        if (drawOval(vec2(distTheta, distRadius), vec2(0.0, 0.0), a, b, reverseGradient, softness, ovalColor)) {
-            color.rgb = mix(color.rgb, ovalColor.rgb, ovalColor.a);
-            color.a = max(color.a, ovalColor.a);
-        }
-    }
-
-    float ringRadius1 = sharpRing(decomposed, uTime * 0.1);
-    float ringRadius2 = smoothRing(decomposed, uTime * 0.1);
-
-    float inputRadius1 = radius + uInputVolume * 0.2;
-    float inputRadius2 = radius + uInputVolume * 0.15;
-    float opacity1 = mix(0.2, 0.6, uInputVolume);
-    float opacity2 = mix(0.15, 0.45, uInputVolume);
-
-    float ringAlpha1 = (inputRadius2 >= ringRadius1) ? opacity1 : 0.0;
-    float ringAlpha2 = smoothstep(ringRadius2 - 0.05, ringRadius2 + 0.05, inputRadius1) * opacity2;
-    float totalRingAlpha = max(ringAlpha1, ringAlpha2);
-
-    vec3 ringColor = vec3(1.0);
-    color.rgb = 1.0 - (1.0 - color.rgb) * (1.0 - ringColor * totalRingAlpha);
-
-    vec3 c1 = vec3(0.0, 0.0, 0.0);
-    vec3 c2 = uColor1;
-    vec3 c3 = uColor2;
-    vec3 c4 = vec3(1.0, 1.0, 1.0);
-
-    float luminance = mix(color.r, 1.0 - color.r, uInverted);
-    color.rgb = colorRamp(luminance, c1, c2, c3, c4);
-    color.a *= uOpacity;
-
-    gl_FragColor = color;
-}
-)";
-
 //==============================================================================
 
-OrbVisualizer::OrbVisualizer()
+OrbVisualizer::OrbVisualizer(OrbRenderService* service)
+    : renderService(service)
 {
     // Initialize random offsets
     Interpolation::SeedRandom rng(seed);
@@ -217,38 +28,51 @@ OrbVisualizer::OrbVisualizer()
         offsets[i] = rng.next() * juce::MathConstants<float>::twoPi;
     }
 
-    // Setup OpenGL
+    // Setup OpenGL, unless a shared service draws this orb
     openGLContext.setRenderer(this);
-    openGLContext.attachTo(*this);
+
+    if (renderService != nullptr)
+        renderService->addOrb(*this);
+    else
+        openGLContext.attachTo(*this);
 
     setOpaque(false);
-    startTimerHz(60);
+
+    setTickRate(activeFrameRate);
 }
 
 OrbVisualizer::~OrbVisualizer()
 {
-    stopTimer();
+    stopFrames();
+
+    if (renderService != nullptr)
+        renderService->removeOrb(*this);
+
     openGLContext.detach();
 }
 
 void OrbVisualizer::setAgentState(AgentState state)
 {
     agentState = state;
+    wake();
 }
 
 void OrbVisualizer::setVolumeMode(OrbVolumeMode mode)
 {
     volumeMode = mode;
+    wake();
 }
 
 void OrbVisualizer::setInputVolume(float volume)
 {
     manualInput = Interpolation::clamp01(volume);
+    wake();
 }
 
 void OrbVisualizer::setOutputVolume(float volume)
 {
     manualOutput = Interpolation::clamp01(volume);
+    wake();
 }
 
 void OrbVisualizer::setColors(const juce::Colour& c1, const juce::Colour& c2)
@@ -257,6 +81,7 @@ void OrbVisualizer::setColors(const juce::Colour& c1, const juce::Colour& c2)
     color2 = c2;
     targetColor1 = c1;
     targetColor2 = c2;
+    wake();
 }
 
 void OrbVisualizer::setSeed(uint32_t newSeed)
@@ -268,138 +93,277 @@ void OrbVisualizer::setSeed(uint32_t newSeed)
     {
         offsets[i] = rng.next() * juce::MathConstants<float>::twoPi;
     }
+
+    wake();
 }
 
 void OrbVisualizer::setInverted(bool inv)
 {
     inverted = inv;
+    wake();
 }
 
-void OrbVisualizer::newOpenGLContextCreated()
+//==============================================================================
+// Frame Scheduling
+
+void OrbVisualizer::setFrameRates(int activeHz, int idleHz)
 {
-    createShaders();
-    createNoiseTexture();
+    activeFrameRate = juce::jlimit(1, 240, activeHz);
+    idleFrameRate = juce::jlimit(0, activeFrameRate, idleHz);
+    setTickRate(isSettled() ? idleFrameRate : activeFrameRate);
+}
 
-    // Create vertex buffers for fullscreen quad
-    const GLfloat vertices[] = {
-        -1.0f, -1.0f, 0.0f, 1.0f,
-         1.0f, -1.0f, 0.0f, 1.0f,
-        -1.0f,  1.0f, 0.0f, 1.0f,
-         1.0f,  1.0f, 0.0f, 1.0f
-    };
+void OrbVisualizer::setVisualChangeThreshold(float threshold)
+{
+    visualChangeThreshold = std::max(0.0f, threshold);
+}
 
-    const GLfloat texCoords[] = {
-        0.0f, 0.0f,
-        1.0f, 0.0f,
-        0.0f, 1.0f,
-        1.0f, 1.0f
-    };
+bool OrbVisualizer::isSettled() const
+{
+    // Outside Manual mode only Idle has constant targets, the other states oscillate
+    if (volumeMode == OrbVolumeMode::Auto && agentState != AgentState::Idle)
+        return false;
+
+    if (opacity < 1.0f)
+        return false;
 
-    openGLContext.extensions.glGenBuffers(1, &vertexBuffer);
-    openGLContext.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-    openGLContext.extensions.glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    if (std::abs(targetInput - smoothedInput) > kSettleEpsilon ||
+        std::abs(targetOutput - smoothedOutput) > kSettleEpsilon ||
+        std::abs(getTargetAnimationSpeed() - animationSpeed) > kSettleEpsilon)
+        return false;
 
-    openGLContext.extensions.glGenBuffers(1, &texCoordBuffer);
-    openGLContext.extensions.glBindBuffer(GL_ARRAY_BUFFER, texCoordBuffer);
-    openGLContext.extensions.glBufferData(GL_ARRAY_BUFFER, sizeof(texCoords), texCoords, GL_STATIC_DRAW);
+    return currentColor1 == targetColor1 && currentColor2 == targetColor2;
 }
 
-void OrbVisualizer::renderOpenGL()
+OrbVisualizer::FrameStats OrbVisualizer::getFrameStats() const
 {
-    if (shader == nullptr)
+    return { framesRendered, framesSkipped };
+}
+
+void OrbVisualizer::resetFrameStats()
+{
+    framesRendered = 0;
+    framesSkipped = 0;
+}
+
+void OrbVisualizer::wake()
+{
+    renderPending = true;
+
+    // Restarting the frames also restarts the delta time, so a long pause
+    // does not turn into one large animation step
+    setTickRate(activeFrameRate);
+}
+
+void OrbVisualizer::setTickRate(int hz)
+{
+    if (hz == currentTickHz)
         return;
 
-    juce::OpenGLHelpers::clear(juce::Colours::transparentBlack);
+    currentTickHz = hz;
+    setMaxFrameRate(hz);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    shader->use();
-
-    // Set uniforms
-    shader->setUniform("uTime", time);
-    shader->setUniform("uAnimation", animationTime);
-    shader->setUniform("uInverted", inverted ? 1.0f : 0.0f);
-    shader->setUniform("uInputVolume", smoothedInput);
-    shader->setUniform("uOutputVolume", smoothedOutput);
-    shader->setUniform("uOpacity", opacity);
-
-    // Set colors
-    shader->setUniform("uColor1",
-                       currentColor1.getFloatRed(),
-                       currentColor1.getFloatGreen(),
-                       currentColor1.getFloatBlue());
-    shader->setUniform("uColor2",
-                       currentColor2.getFloatRed(),
-                       currentColor2.getFloatGreen(),
-                       currentColor2.getFloatBlue());
-
-    // Set offsets array - use glGetUniformLocation directly for array uniforms
-    GLint offsetsLocation = openGLContext.extensions.glGetUniformLocation(shader->getProgramID(), "uOffsets");
-    if (offsetsLocation >= 0)
-    {
-        glUniform1fv(offsetsLocation, 7, offsets.data());
-    }
+    if (hz > 0)
+        startFrames();
+    else
+        stopFrames();
+}
 
-    // Bind texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, noiseTexture);
-    shader->setUniform("uPerlinTexture", 0);
+float OrbVisualizer::getTargetAnimationSpeed() const
+{
+    return 0.1f + (1.0f - std::pow(smoothedOutput - 1.0f, 2.0f)) * 0.9f;
+}
 
-    // Draw quad
-    openGLContext.extensions.glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-    if (auto* posAttr = shader->getAttributeIDFromName("aPosition"))
+float OrbVisualizer::getVisualDelta(const OrbUniforms& a, const OrbUniforms& b)
+{
+    // Time and animation are weighted by how fast they move the shader's
+    // noise lookups (ring noise at time * 0.5, flow at animation * 0.2)
+    float delta = std::abs(a.time - b.time) * 0.5f;
+    delta = std::max(delta, std::abs(a.animation - b.animation) * 0.2f);
+    delta = std::max(delta, std::abs(a.inputVolume - b.inputVolume));
+    delta = std::max(delta, std::abs(a.outputVolume - b.outputVolume));
+    delta = std::max(delta, std::abs(a.opacity - b.opacity));
+
+    auto colourDelta = [](const juce::Colour& x, const juce::Colour& y)
     {
-        openGLContext.extensions.glVertexAttribPointer(posAttr->attributeID, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-        openGLContext.extensions.glEnableVertexAttribArray(posAttr->attributeID);
-    }
+        return std::max(std::abs(x.getFloatRed() - y.getFloatRed()),
+                        std::max(std::abs(x.getFloatGreen() - y.getFloatGreen()),
+                                 std::abs(x.getFloatBlue() - y.getFloatBlue())));
+    };
 
-    openGLContext.extensions.glBindBuffer(GL_ARRAY_BUFFER, texCoordBuffer);
-    if (auto* texAttr = shader->getAttributeIDFromName("aTexCoord"))
-    {
-        openGLContext.extensions.glVertexAttribPointer(texAttr->attributeID, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-        openGLContext.extensions.glEnableVertexAttribArray(texAttr->attributeID);
-    }
+    delta = std::max(delta, colourDelta(a.color1, b.color1));
+    delta = std::max(delta, colourDelta(a.color2, b.color2));
+
+    if (a.inverted != b.inverted || a.offsets != b.offsets)
+        return 1.0f;
 
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    return delta;
 }
 
-void OrbVisualizer::openGLContextClosing()
+void OrbVisualizer::setRenderBackend(OrbRenderBackend backend)
 {
-    shader.reset();
+    renderBackend = backend;
 
-    if (noiseTexture != 0)
-    {
-        glDeleteTextures(1, &noiseTexture);
-        noiseTexture = 0;
-    }
+    if (backend == OrbRenderBackend::Software)
+        useSoftwareRenderer();
+    else
+        useOpenGLRenderer();
+}
+
+void OrbVisualizer::setSoftwareResolutionScale(float scale)
+{
+    softwareResolutionScale = juce::jlimit(0.1f, 1.0f, scale);
+
+    if (softwareRenderer != nullptr)
+        softwareRenderer->setResolutionScale(softwareResolutionScale);
+}
 
-    if (vertexBuffer != 0)
+OrbUniforms OrbVisualizer::getUniforms() const
+{
+    OrbUniforms uniforms;
+    uniforms.time = time;
+    uniforms.animation = animationTime;
+    uniforms.inputVolume = smoothedInput;
+    uniforms.outputVolume = smoothedOutput;
+    uniforms.opacity = opacity;
+    uniforms.inverted = inverted;
+    uniforms.offsets = offsets;
+    uniforms.color1 = currentColor1;
+    uniforms.color2 = currentColor2;
+    return uniforms;
+}
+
+void OrbVisualizer::setRenderService(OrbRenderService* service)
+{
+    if (service == renderService)
+        return;
+
+    if (renderService != nullptr)
+        renderService->removeOrb(*this);
+
+    renderService = service;
+
+    // The software renderer stays in charge until OpenGL is requested again
+    if (softwareRenderer == nullptr)
     {
-        openGLContext.extensions.glDeleteBuffers(1, &vertexBuffer);
-        vertexBuffer = 0;
+        if (renderService != nullptr)
+        {
+            openGLContext.detach();
+            renderService->addOrb(*this);
+        }
+        else
+        {
+            openGLContext.attachTo(*this);
+        }
     }
 
-    if (texCoordBuffer != 0)
+    wake();
+}
+
+void OrbVisualizer::renderServiceClosing()
+{
+    renderService = nullptr;
+
+    if (softwareRenderer == nullptr)
+        openGLContext.attachTo(*this);
+
+    wake();
+}
+
+void OrbVisualizer::useOpenGLRenderer()
+{
+    if (softwareRenderer == nullptr && (renderService != nullptr || openGLContext.isAttached()))
+        return;
+
+    softwareRenderer.reset();
+
+    if (renderService != nullptr)
+        renderService->addOrb(*this);
+    else
+        openGLContext.attachTo(*this);
+
+    wake();
+    repaint();
+}
+
+void OrbVisualizer::useSoftwareRenderer()
+{
+    if (softwareRenderer != nullptr)
+        return;
+
+    if (renderService != nullptr)
+        renderService->removeOrb(*this);
+    else
+        openGLContext.detach();
+
+    softwareRenderer = std::make_unique<OrbSoftwareRenderer>();
+    softwareRenderer->setResolutionScale(softwareResolutionScale);
+    wake();
+    repaint();
+}
+
+void OrbVisualizer::newOpenGLContextCreated()
+{
+    const bool created = glResources.create(openGLContext);
+
+    // No usable GPU: hand over to the CPU renderer on the message thread
+    if (renderBackend == OrbRenderBackend::Auto && (!created || OrbGLResources::isSoftwareRasteriser()))
     {
-        openGLContext.extensions.glDeleteBuffers(1, &texCoordBuffer);
-        texCoordBuffer = 0;
+        juce::Component::SafePointer<OrbVisualizer> safeThis(this);
+
+        juce::MessageManager::callAsync([safeThis]
+        {
+            if (safeThis != nullptr && safeThis->renderBackend == OrbRenderBackend::Auto)
+                safeThis->useSoftwareRenderer();
+        });
     }
 }
 
-void OrbVisualizer::paint(juce::Graphics&)
+void OrbVisualizer::renderOpenGL()
+{
+    SHMUI_PROFILE_SCOPE("OrbVisualizer::renderOpenGL");
+
+    juce::OpenGLHelpers::clear(juce::Colours::transparentBlack);
+    glResources.draw(openGLContext, getUniforms());
+}
+
+void OrbVisualizer::openGLContextClosing()
 {
-    // OpenGL handles rendering
+    glResources.release(openGLContext);
+}
+
+void OrbVisualizer::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("OrbVisualizer::paint");
+
+    // OpenGL handles rendering unless the CPU fallback is active
+    if (softwareRenderer == nullptr || getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    const auto& image = softwareRenderer->render(getUniforms(), getWidth(), getHeight());
+
+    // Rendered at reduced resolution, upscaled here
+    g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+    g.drawImage(image, getLocalBounds().toFloat());
 }
 
 void OrbVisualizer::resized()
 {
-    // OpenGL context will handle viewport
+    // An own OpenGL context handles the viewport; a render service needs the new bounds
+    wake();
 }
 
-void OrbVisualizer::timerCallback()
+void OrbVisualizer::moved()
 {
-    const float deltaTime = 1.0f / 60.0f;
+    wake();
+}
+
+bool OrbVisualizer::advanceFrame(double deltaSeconds)
+{
+    SHMUI_PROFILE_SCOPE("OrbVisualizer::advanceFrame");
+
+    // Real elapsed time, since the tick rate drops while settled
+    const float deltaTime = juce::jlimit(0.0f, kMaxDeltaTime, static_cast<float>(deltaSeconds));
 
     // Update time
     time += deltaTime * 0.5f;
@@ -413,20 +377,48 @@ void OrbVisualizer::timerCallback()
     // Update animation targets based on state
     updateAnimationTargets();
 
-    // Smooth volume
-    smoothedInput += (targetInput - smoothedInput) * kSmoothingFactor;
-    smoothedOutput += (targetOutput - smoothedOutput) * kSmoothingFactor;
+    // Smooth volume (factors were tuned per 60 Hz frame)
+    smoothedInput = Interpolation::smoothDelta(smoothedInput, targetInput, kSmoothingFactor, deltaTime);
+    smoothedOutput = Interpolation::smoothDelta(smoothedOutput, targetOutput, kSmoothingFactor, deltaTime);
 
     // Update animation speed
-    const float targetSpeed = 0.1f + (1.0f - std::pow(smoothedOutput - 1.0f, 2.0f)) * 0.9f;
-    animationSpeed += (targetSpeed - animationSpeed) * 0.12f;
+    animationSpeed = Interpolation::smoothDelta(animationSpeed, getTargetAnimationSpeed(), 0.12f, deltaTime);
     animationTime += deltaTime * animationSpeed;
 
     // Lerp colors
-    currentColor1 = ColorUtils::lerpColour(currentColor1, targetColor1, kColorLerpFactor);
-    currentColor2 = ColorUtils::lerpColour(currentColor2, targetColor2, kColorLerpFactor);
+    const float colourFactor = 1.0f - std::pow(1.0f - kColorLerpFactor, deltaTime * 60.0f);
+    currentColor1 = ColorUtils::lerpColour(currentColor1, targetColor1, colourFactor);
+    currentColor2 = ColorUtils::lerpColour(currentColor2, targetColor2, colourFactor);
+
+    // 8-bit colour lerps can stall a few steps short of the target
+    if (ColorUtils::lerpColour(currentColor1, targetColor1, colourFactor) == currentColor1)
+        currentColor1 = targetColor1;
+    if (ColorUtils::lerpColour(currentColor2, targetColor2, colourFactor) == currentColor2)
+        currentColor2 = targetColor2;
+
+    // Only render when the result would look different
+    const auto uniforms = getUniforms();
+
+    if (renderPending || getVisualDelta(uniforms, lastRenderedUniforms) >= visualChangeThreshold)
+    {
+        lastRenderedUniforms = uniforms;
+        renderPending = false;
+        ++framesRendered;
+
+        if (softwareRenderer != nullptr)
+            repaint();
+        else if (renderService != nullptr)
+            renderService->updateOrb(*this, uniforms);
+        else
+            openGLContext.triggerRepaint();
+    }
+    else
+    {
+        ++framesSkipped;
+    }
 
-    openGLContext.triggerRepaint();
+    setTickRate(isSettled() ? idleFrameRate : activeFrameRate);
+    return currentTickHz > 0;
 }
 
 void OrbVisualizer::updateAnimationTargets()
@@ -476,77 +468,4 @@ void OrbVisualizer::updateAnimationTargets()
     }
 }
 
-void OrbVisualizer::createShaders()
-{
-    shader = std::make_unique<juce::OpenGLShaderProgram>(openGLContext);
-
-    if (!shader->addVertexShader(vertexShaderSource))
-    {
-        DBG("Vertex shader compile error: " + shader->getLastError());
-        shader.reset();
-        return;
-    }
-
-    if (!shader->addFragmentShader(fragmentShaderSource))
-    {
-        DBG("Fragment shader compile error: " + shader->getLastError());
-        shader.reset();
-        return;
-    }
-
-    if (!shader->link())
-    {
-        DBG("Shader link error: " + shader->getLastError());
-        shader.reset();
-        return;
-    }
-}
-
-void OrbVisualizer::createNoiseTexture()
-{
-    // Generate a simple Perlin-like noise texture
-    const int size = 256;
-    std::vector<uint8_t> data(size * size);
-
-    Interpolation::SeedRandom rng(12345);
-
-    for (int y = 0; y < size; ++y)
-    {
-        for (int x = 0; x < size; ++x)
-        {
-            // Simple value noise
-            const float fx = static_cast<float>(x) / size;
-            const float fy = static_cast<float>(y) / size;
-
-            float value = 0.0f;
-            float amplitude = 1.0f;
-            float frequency = 4.0f;
-
-            for (int octave = 0; octave < 4; ++octave)
-            {
-                const int ix = static_cast<int>(fx * frequency) % size;
-                const int iy = static_cast<int>(fy * frequency) % size;
-
-                // Use seeded random for deterministic noise
-                const float noise = Interpolation::seededRandom(
-                    static_cast<float>(ix * 1000 + iy + octave * 10000));
-
-                value += noise * amplitude;
-                amplitude *= 0.5f;
-                frequency *= 2.0f;
-            }
-
-            data[y * size + x] = static_cast<uint8_t>(juce::jlimit(0.0f, 255.0f, value * 128.0f));
-        }
-    }
-
-    glGenTextures(1, &noiseTexture);
-    glBindTexture(GL_TEXTURE_2D, noiseTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, size, size, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data.data());
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-}
-
 } // namespace shmui
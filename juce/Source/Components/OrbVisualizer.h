@@ -4,7 +4,7 @@
     OrbVisualizer.h
     Created: Shmui-to-JUCE Audio Visualization Port
 
-    3D orb visualization using OpenGL shaders.
+    3D orb visualization using OpenGL shaders, with a CPU fallback.
     Port of orb.tsx from shmui.
 
   ==============================================================================
@@ -14,7 +14,10 @@
 
 #include <JuceHeader.h>
 #include "../Utils/AgentState.h"
+#include "../Utils/FrameClock.h"
 #include "../Utils/Interpolation.h"
+#include "OrbSoftwareRenderer.h"
+#include "OrbRenderService.h"
 
 namespace shmui
 {
@@ -28,19 +31,42 @@ enum class OrbVolumeMode
     Manual  ///< Use manual input/output values
 };
 
+/**
+ * @brief Rendering backend for the orb.
+ */
+enum class OrbRenderBackend
+{
+    Auto,     ///< OpenGL, falling back to Software without a usable GPU
+    OpenGL,   ///< Always use the GLSL shader
+    Software  ///< Always use the CPU renderer
+};
+
 /**
  * @brief 3D orb visualization with OpenGL shaders.
  *
  * Displays an animated orb that responds to agent state and volume levels.
  * Uses GLSL shaders for rendering with noise-based distortion effects.
+ * When the shader fails to build or the context is a software rasteriser
+ * (llvmpipe and friends), Auto mode switches to OrbSoftwareRenderer.
+ *
+ * Rendering is on demand: a frame is only drawn when the shader inputs
+ * changed visibly since the last one, and the tick rate drops to an idle
+ * rate once volumes, colours and animation speed have settled. Setters
+ * wake the scheduler immediately.
  * Port of Orb component from orb.tsx.
  */
 class OrbVisualizer : public juce::Component,
                       public juce::OpenGLRenderer,
-                      public juce::Timer
+                      private FrameClockClient
 {
 public:
-    OrbVisualizer();
+    /**
+     * @brief Create an orb.
+     *
+     * @param service Shared render service to draw through, or nullptr for
+     *                an own OpenGL context (see setRenderService())
+     */
+    explicit OrbVisualizer(OrbRenderService* service = nullptr);
     ~OrbVisualizer() override;
 
     //==============================================================================
@@ -109,6 +135,107 @@ public:
      */
     void setInverted(bool inverted);
 
+    //==============================================================================
+    // Rendering
+
+    /**
+     * @brief Choose the rendering backend.
+     *
+     * Default is Auto.
+     */
+    void setRenderBackend(OrbRenderBackend backend);
+
+    /**
+     * @brief Get the requested rendering backend.
+     */
+    OrbRenderBackend getRenderBackend() const { return renderBackend; }
+
+    /**
+     * @brief Check if the CPU renderer is currently drawing the orb.
+     */
+    bool isUsingSoftwareRenderer() const { return softwareRenderer != nullptr; }
+
+    /**
+     * @brief Draw through a shared render service instead of an own context.
+     *
+     * The orb releases its own OpenGL context and is drawn by the service
+     * into its bounds within the service's host. Pass nullptr to go back to
+     * an own context. The service must outlive the orb or be destroyed
+     * first, in which case the orb reattaches its own context.
+     */
+    void setRenderService(OrbRenderService* service);
+
+    /**
+     * @brief Get the shared render service, if any.
+     */
+    OrbRenderService* getRenderService() const { return renderService; }
+
+    /**
+     * @brief Set the CPU renderer's internal resolution relative to the
+     *        component size (0.1-1, default 0.5).
+     */
+    void setSoftwareResolutionScale(float scale);
+
+    /**
+     * @brief Get the current shader inputs.
+     */
+    OrbUniforms getUniforms() const;
+
+    //==============================================================================
+    // Frame Scheduling
+
+    /**
+     * @brief Frame scheduler counters.
+     */
+    struct FrameStats
+    {
+        uint64_t framesRendered = 0;  ///< Ticks that requested a render
+        uint64_t framesSkipped = 0;   ///< Ticks below the visual change threshold
+    };
+
+    /**
+     * @brief Set the tick rates used while animating and once settled.
+     *
+     * @param activeHz Rate while inputs are changing (default 60)
+     * @param idleHz Rate once settled (default 20); 0 stops ticking until
+     *               the next setter call
+     */
+    void setFrameRates(int activeHz, int idleHz);
+
+    /**
+     * @brief Set the smallest change of the shader inputs worth a render.
+     *
+     * Volumes, opacity and colour channels count in 0-1 units; time and
+     * animation are scaled by how fast they move the shader's noise.
+     * Default is 0.005; 0 renders every tick.
+     */
+    void setVisualChangeThreshold(float threshold);
+
+    /**
+     * @brief Check if all smoothed values have reached their targets.
+     */
+    bool isSettled() const;
+
+    /**
+     * @brief Get rendered/skipped frame counts.
+     */
+    FrameStats getFrameStats() const;
+
+    /**
+     * @brief Reset the frame counters.
+     */
+    void resetFrameStats();
+
+    //==============================================================================
+    // Testing
+
+    /**
+     * @brief Run one frame of deltaSeconds without the FrameClock.
+     *
+     * For benchmarks and self-checks, which drive frames by hand.
+     */
+    void advanceFrameForTesting(double deltaSeconds) { advanceFrame(deltaSeconds); }
+
     //==============================================================================
     // OpenGLRenderer overrides
 
@@ -121,22 +248,32 @@ public:
 
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void moved() override;
 
 private:
-    void timerCallback() override;
+    friend class OrbRenderService;
+
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
     void updateAnimationTargets();
-    void createShaders();
-    void createNoiseTexture();
+    void useOpenGLRenderer();
+    void useSoftwareRenderer();
+    void renderServiceClosing();
+    void wake();
+    void setTickRate(int hz);
+    float getTargetAnimationSpeed() const;
+    static float getVisualDelta(const OrbUniforms& a, const OrbUniforms& b);
 
     //==============================================================================
 
     juce::OpenGLContext openGLContext;
-    std::unique_ptr<juce::OpenGLShaderProgram> shader;
-    std::unique_ptr<juce::OpenGLShaderProgram::Attribute> position;
-    std::unique_ptr<juce::OpenGLShaderProgram::Attribute> texCoord;
-    GLuint noiseTexture = 0;
-    GLuint vertexBuffer = 0;
-    GLuint texCoordBuffer = 0;
+    OrbGLResources glResources;
+    OrbRenderService* renderService = nullptr;
+
+    // Software fallback
+    OrbRenderBackend renderBackend = OrbRenderBackend::Auto;
+    std::unique_ptr<OrbSoftwareRenderer> softwareRenderer;
+    float softwareResolutionScale = 0.5f;
 
     // State
     AgentState agentState = AgentState::Idle;
@@ -169,9 +306,21 @@ private:
     uint32_t seed = 0;
     bool inverted = false;
 
+    // Frame scheduling
+    OrbUniforms lastRenderedUniforms;
+    int activeFrameRate = 60;
+    int idleFrameRate = 20;
+    int currentTickHz = 0;
+    float visualChangeThreshold = 0.005f;
+    bool renderPending = true;
+    uint64_t framesRendered = 0;
+    uint64_t framesSkipped = 0;
+
     // Constants
     static constexpr float kSmoothingFactor = 0.2f;
     static constexpr float kColorLerpFactor = 0.08f;
+    static constexpr float kSettleEpsilon = 0.001f;
+    static constexpr float kMaxDeltaTime = 0.1f;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrbVisualizer)
 };
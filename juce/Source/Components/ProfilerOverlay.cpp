@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.cpp
+    Created: shmui Component Library
+
+    Profiler overlay implementation.
+
+  ==============================================================================
+*/
+
+#include "ProfilerOverlay.h"
+#include <algorithm>
+
+namespace shmui
+{
+
+//==============================================================================
+ProfilerOverlay::ProfilerOverlay()
+{
+    setInterceptsMouseClicks(false, false);
+    setMaxFrameRate(kDefaultRefreshHz);
+
+    if (Profiling::isEnabled())
+        startFrames();
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    stopFrames();
+}
+
+//==============================================================================
+void ProfilerOverlay::setNumRows(int numRows)
+{
+    m_numRows = juce::jmax(1, numRows);
+    sortRows();
+    repaint();
+}
+
+void ProfilerOverlay::setSortKey(SortKey key)
+{
+    m_sortKey = key;
+    sortRows();
+    repaint();
+}
+
+void ProfilerOverlay::setRefreshRate(double hz)
+{
+    setMaxFrameRate(juce::jmax(0.1, hz));
+}
+
+void ProfilerOverlay::setStyle(const ProfilerOverlayStyle& style)
+{
+    m_style = style;
+    repaint();
+}
+
+int ProfilerOverlay::getIdealHeight() const
+{
+    // Clock line, column headings, rows
+    return juce::roundToInt(m_style.padding * 2.0f + m_style.rowHeight * static_cast<float>(m_numRows + 2));
+}
+
+//==============================================================================
+bool ProfilerOverlay::advanceFrame(double deltaSeconds)
+{
+    if (deltaSeconds <= 0.0)
+        return true;
+
+    Profiling::getEntries(m_current);
+    m_clockStats = m_frameClock->getStats();
+
+    m_allRows.clear();
+
+    for (size_t i = 0; i < m_current.size(); ++i)
+    {
+        const auto& entry = m_current[i];
+
+        // Sites only ever append, so the same index is the same scope;
+        // totals that went down were reset and count from zero
+        Profiling::Entry before;
+        if (i < m_previous.size() && m_previous[i].name == entry.name && m_previous[i].count <= entry.count)
+            before = m_previous[i];
+
+        const auto calls = entry.count - before.count;
+        const auto ns = entry.totalNs - before.totalNs;
+
+        if (calls == 0 && entry.count == 0)
+            continue;
+
+        Row row;
+        row.name = entry.name;
+        row.callsPerSecond = static_cast<double>(calls) / deltaSeconds;
+        row.msPerSecond = static_cast<double>(ns) * 1.0e-6 / deltaSeconds;
+        row.meanUs = calls > 0 ? static_cast<double>(ns) * 1.0e-3 / static_cast<double>(calls) : 0.0;
+        row.maxUs = static_cast<double>(entry.maxNs) * 1.0e-3;
+        m_allRows.push_back(row);
+    }
+
+    std::swap(m_previous, m_current);
+
+    sortRows();
+    repaint();
+    return true;
+}
+
+void ProfilerOverlay::sortRows()
+{
+    auto value = [this](const Row& row)
+    {
+        switch (m_sortKey)
+        {
+            case SortKey::MaxTime:          return row.maxUs;
+            case SortKey::MeanTime:         return row.meanUs;
+            case SortKey::CallsPerSecond:   return row.callsPerSecond;
+            case SortKey::TimePerSecond:
+            default:                        return row.msPerSecond;
+        }
+    };
+
+    const size_t numShown = juce::jmin(static_cast<size_t>(m_numRows), m_allRows.size());
+    std::partial_sort(m_allRows.begin(), m_allRows.begin() + static_cast<std::ptrdiff_t>(numShown), m_allRows.end(),
+                      [&value](const Row& a, const Row& b) { return value(a) > value(b); });
+
+    m_rows.assign(m_allRows.begin(), m_allRows.begin() + static_cast<std::ptrdiff_t>(numShown));
+}
+
+//==============================================================================
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour(m_style.backgroundColor);
+    g.fillRoundedRectangle(bounds, m_style.cornerRadius);
+
+    bounds.reduce(m_style.padding, m_style.padding);
+    g.setFont(m_style.fontSize);
+
+    if (!Profiling::isEnabled())
+    {
+        g.setColour(m_style.dimTextColor);
+        g.drawText("Profiling compiled out (build with SHMUI_ENABLE_PROFILING=1)",
+                   bounds, juce::Justification::topLeft, true);
+        return;
+    }
+
+    // Clock line
+    const juce::String clockText = juce::String(m_clockStats.numRunning) + " animating, "
+                                 + juce::String(m_clockStats.numSuspended) + " suspended, "
+                                 + (m_clockStats.vblankDriven ? "vblank" : "timer");
+    g.setColour(m_style.dimTextColor);
+    g.drawText(clockText, bounds.removeFromTop(m_style.rowHeight), juce::Justification::centredLeft, true);
+
+    // Numeric columns on the right, scope name takes the rest
+    const float columnWidth = m_style.fontSize * 4.5f;
+
+    auto drawRow = [&](juce::Rectangle<float> area, const juce::String& name, const juce::String* columns)
+    {
+        for (int column = 3; column >= 0; --column)
+            g.drawText(columns[column], area.removeFromRight(columnWidth), juce::Justification::centredRight, false);
+
+        g.drawText(name, area, juce::Justification::centredLeft, true);
+    };
+
+    const juce::String headings[] = { "calls/s", "ms/s", "avg us", "max us" };
+    drawRow(bounds.removeFromTop(m_style.rowHeight), "scope", headings);
+
+    const double topMsPerSecond = m_rows.empty() ? 0.0 : juce::jmax(m_rows.front().msPerSecond, 1.0e-9);
+    const float maxHotUs = m_style.hotThresholdMs * 1000.0f;
+
+    for (const auto& row : m_rows)
+    {
+        if (bounds.getHeight() < m_style.rowHeight)
+            break;
+
+        auto area = bounds.removeFromTop(m_style.rowHeight);
+
+        // Bar: time per second relative to the busiest listed scope
+        const auto barFraction = static_cast<float>(juce::jlimit(0.0, 1.0, row.msPerSecond / topMsPerSecond));
+        g.setColour(m_style.barColor);
+        g.fillRect(area.withWidth(area.getWidth() * barFraction).reduced(0.0f, 1.0f));
+
+        const juce::String columns[] =
+        {
+            juce::String(row.callsPerSecond, 0),
+            juce::String(row.msPerSecond, 2),
+            juce::String(row.meanUs, 1),
+            juce::String(row.maxUs, 0)
+        };
+
+        g.setColour(row.maxUs > maxHotUs ? m_style.hotColor : m_style.textColor);
+        drawRow(area, row.name, columns);
+    }
+}
+
+} // namespace shmui
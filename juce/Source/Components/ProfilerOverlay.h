@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.h
+    Created: shmui Component Library
+
+    Debug overlay listing the most expensive SHMUI_PROFILE_SCOPE sites.
+
+    Features:
+    - Live calls/s, ms/s, mean and max per scope over the last refresh
+    - Sort by time per second, max time, mean time or call rate
+    - FrameClock running / suspended client counts
+    - Click-through, so it can sit on top of the UI it measures
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Utils/FrameClock.h"
+#include "../Utils/Profiling.h"
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Style configuration for ProfilerOverlay.
+ */
+struct ProfilerOverlayStyle
+{
+    // Colors
+    juce::Colour backgroundColor = juce::Colour(0xE0101010);
+    juce::Colour textColor = juce::Colour(0xFFE5E5E5);
+    juce::Colour dimTextColor = juce::Colour(0x80FFFFFF);
+    juce::Colour barColor = juce::Colour(0x60F59E0B);           // Amber
+    juce::Colour hotColor = juce::Colour(0xFFEF4444);           // Red, scopes over the hot threshold
+
+    // Appearance
+    float fontSize = 11.0f;
+    float rowHeight = 15.0f;
+    float cornerRadius = 4.0f;
+    float padding = 6.0f;
+    float hotThresholdMs = 4.0f;                                // Max time that marks a scope as hot
+};
+
+//==============================================================================
+/**
+ * @brief Live table of the top profiled scopes.
+ *
+ * Every refresh it reads Profiling::getEntries() and shows, per scope,
+ * what happened since the previous refresh: calls per second, time per
+ * second (ms/s, so 1000 would be a whole core), mean time per call and
+ * the maximum since the last Profiling::reset(). Only the top rows by
+ * the chosen sort key are drawn.
+ *
+ * Does not intercept mouse clicks. When the library is built without
+ * SHMUI_ENABLE_PROFILING it shows a note instead and never refreshes.
+ */
+class ProfilerOverlay : public juce::Component,
+                        private FrameClockClient
+{
+public:
+    //==============================================================================
+    /** Default refreshes per second. */
+    static constexpr double kDefaultRefreshHz = 4.0;
+
+    /** Row ordering. */
+    enum class SortKey
+    {
+        TimePerSecond,      ///< Share of CPU time (default)
+        MaxTime,            ///< Worst single call
+        MeanTime,           ///< Average call
+        CallsPerSecond      ///< Call rate
+    };
+
+    /** One scope as shown. */
+    struct Row
+    {
+        juce::String name;
+        double callsPerSecond = 0.0;
+        double msPerSecond = 0.0;
+        double meanUs = 0.0;
+        double maxUs = 0.0;
+    };
+
+    //==============================================================================
+    ProfilerOverlay();
+    ~ProfilerOverlay() override;
+
+    //==============================================================================
+    /// @name Configuration
+    /// @{
+
+    /**
+     * @brief Set how many scopes are listed (default 10).
+     */
+    void setNumRows(int numRows);
+
+    /**
+     * @brief Set the row ordering.
+     */
+    void setSortKey(SortKey key);
+
+    /**
+     * @brief Set refreshes per second (default kDefaultRefreshHz).
+     */
+    void setRefreshRate(double hz);
+
+    /**
+     * @brief Set visual style.
+     */
+    void setStyle(const ProfilerOverlayStyle& style);
+
+    /**
+     * @brief Get current style.
+     */
+    const ProfilerOverlayStyle& getStyle() const { return m_style; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Readings
+    /// @{
+
+    /**
+     * @brief Rows from the last refresh, sorted, at most the row count.
+     */
+    const std::vector<Row>& getRows() const { return m_rows; }
+
+    /**
+     * @brief Height that fits the header and the configured row count.
+     */
+    int getIdealHeight() const;
+
+    /// @}
+
+    //==============================================================================
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+
+private:
+    //==============================================================================
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
+    void sortRows();
+
+    //==============================================================================
+    ProfilerOverlayStyle m_style;
+    SortKey m_sortKey = SortKey::TimePerSecond;
+    int m_numRows = 10;
+
+    std::vector<Profiling::Entry> m_current;
+    std::vector<Profiling::Entry> m_previous;
+    std::vector<Row> m_allRows;
+    std::vector<Row> m_rows;
+
+    juce::SharedResourcePointer<FrameClock> m_frameClock;
+    FrameClock::Stats m_clockStats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerOverlay)
+};
+
+} // namespace shmui
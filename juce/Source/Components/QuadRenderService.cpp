@@ -0,0 +1,672 @@
+/*
+  ==============================================================================
+
+    QuadRenderService.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Implementation of the quad batch and the shared quad renderer.
+
+  ==============================================================================
+*/
+
+#include "QuadRenderService.h"
+#include "../Utils/FrameClock.h"
+#include "../Utils/Profiling.h"
+#include "OrbRenderService.h"
+#include <cstddef>
+
+namespace shmui
+{
+
+// Positions arrive in physical host pixels with the origin at the top left
+static const char* quadVertexShaderSource = R"(
+attribute vec2 aPosition;
+attribute vec4 aShape;
+attribute vec3 aRadius;
+attribute vec4 aClip;
+attribute vec4 aGradient;
+attribute vec4 aColour;
+attribute vec4 aColour2;
+
+uniform vec2 uViewport;
+
+varying vec4 vShape;
+varying vec3 vRadius;
+varying vec4 vClip;
+varying vec4 vGradient;
+varying vec4 vColour;
+varying vec4 vColour2;
+
+void main()
+{
+    vShape = aShape;
+    vRadius = aRadius;
+    vClip = aClip;
+    vGradient = aGradient;
+
+    // Premultiplied, so gradients interpolate like juce::ColourGradient
+    vColour = vec4(aColour.rgb * aColour.a, aColour.a);
+    vColour2 = vec4(aColour2.rgb * aColour2.a, aColour2.a);
+
+    vec2 ndc = aPosition / uViewport * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+}
+)";
+
+// Coverage comes from the distance to the shape at the pixel centre, so
+// every rasteriser produces the same pixels. Rounded rectangles use the
+// exact distance; ellipses the first-order one, exact for circles and
+// within a small fraction of a pixel at the edge otherwise
+static const char* quadFragmentShaderSource = R"(
+#ifdef GL_ES
+precision highp float;
+#endif
+
+uniform vec2 uViewport;
+
+varying vec4 vShape;
+varying vec3 vRadius;
+varying vec4 vClip;
+varying vec4 vGradient;
+varying vec4 vColour;
+varying vec4 vColour2;
+
+void main()
+{
+    vec2 pixel = vec2(gl_FragCoord.x, uViewport.y - gl_FragCoord.y);
+
+    vec2 offsetFromCentre = pixel - vShape.xy;
+    float distance;
+
+    if (vRadius.z > 0.5)
+    {
+        // Implicit function over its gradient length
+        float k0 = length(offsetFromCentre / vShape.zw);
+        float k1 = length(offsetFromCentre / (vShape.zw * vShape.zw));
+        distance = k1 > 0.0 ? k0 * (k0 - 1.0) / k1 : -min(vShape.z, vShape.w);
+    }
+    else
+    {
+        vec2 q = abs(offsetFromCentre) - vShape.zw + vec2(vRadius.x);
+        distance = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - vRadius.x;
+    }
+
+    float coverage = clamp(0.5 - distance, 0.0, 1.0);
+
+    vec2 inside = step(vClip.xy, pixel) * (1.0 - step(vClip.zw, pixel));
+    coverage *= inside.x * inside.y;
+
+    vec2 offset = pixel - vGradient.xy;
+    float t = vRadius.y > 0.5 ? length(offset) * vGradient.z : dot(offset, vGradient.zw);
+
+    gl_FragColor = mix(vColour, vColour2, clamp(t, 0.0, 1.0)) * coverage;
+}
+)";
+
+//==============================================================================
+// QuadBatch
+
+Quad& QuadBatch::addRectangle(juce::Rectangle<float> bounds, juce::Colour colour)
+{
+    Quad quad;
+    quad.bounds = bounds;
+    quad.colour = colour;
+    return add(quad);
+}
+
+Quad& QuadBatch::addRoundedRectangle(juce::Rectangle<float> bounds, float cornerRadius, juce::Colour colour)
+{
+    Quad quad;
+    quad.bounds = bounds;
+    quad.cornerRadius = cornerRadius;
+    quad.colour = colour;
+    return add(quad);
+}
+
+Quad& QuadBatch::addEllipse(juce::Rectangle<float> bounds, juce::Colour colour)
+{
+    Quad quad;
+    quad.bounds = bounds;
+    quad.isEllipse = true;
+    quad.colour = colour;
+    return add(quad);
+}
+
+Quad& QuadBatch::add(const Quad& quad)
+{
+    quads.push_back(quad);
+    return quads.back();
+}
+
+void QuadBatch::paint(juce::Graphics& g) const
+{
+    for (const auto& quad : quads)
+    {
+        const bool clipped = !quad.clip.isEmpty();
+
+        if (clipped)
+        {
+            g.saveState();
+            g.reduceClipRegion(quad.clip);
+        }
+
+        switch (quad.fill)
+        {
+            case Quad::Fill::Linear:
+                g.setGradientFill(juce::ColourGradient(quad.colour, quad.gradientStart,
+                                                       quad.colour2, quad.gradientEnd, false));
+                break;
+
+            case Quad::Fill::Radial:
+                g.setGradientFill(juce::ColourGradient(quad.colour, quad.gradientStart,
+                                                       quad.colour2, quad.gradientEnd, true));
+                break;
+
+            case Quad::Fill::Solid:
+            default:
+                g.setColour(quad.colour);
+                break;
+        }
+
+        if (quad.isEllipse)
+            g.fillEllipse(quad.bounds);
+        else if (quad.cornerRadius > 0.0f)
+            g.fillRoundedRectangle(quad.bounds, quad.cornerRadius);
+        else
+            g.fillRect(quad.bounds);
+
+        if (clipped)
+            g.restoreState();
+    }
+}
+
+//==============================================================================
+// QuadRenderService
+
+QuadRenderService::QuadRenderService(juce::Component& hostComponent)
+    : host(hostComponent)
+{
+    openGLContext.setRenderer(this);
+    openGLContext.attachTo(host);
+}
+
+QuadRenderService::~QuadRenderService()
+{
+    openGLContext.detach();
+    cancelPendingUpdate();
+
+    // Clients go back to painting on the CPU once the weak reference clears
+    for (const auto& entry : entries)
+    {
+        entry.client->removeComponentListener(this);
+        entry.client->repaint();
+    }
+}
+
+int QuadRenderService::getNumClients() const
+{
+    const juce::SpinLock::ScopedLockType lock(entryLock);
+    return static_cast<int>(entries.size());
+}
+
+QuadRenderService::Entry* QuadRenderService::findEntry(juce::Component& client)
+{
+    for (auto& entry : entries)
+        if (entry.client == &client)
+            return &entry;
+
+    return nullptr;
+}
+
+//==============================================================================
+void QuadRenderService::submit(juce::Component& client, const QuadBatch& batch)
+{
+    // Component geometry is only safe to query here, on the message thread
+    const auto bounds = host.getLocalArea(&client, client.getLocalBounds());
+    const auto clip = FrameClock::getVisibleArea(client, host).getIntersection(host.getLocalBounds());
+    const bool visible = client.isShowing();
+    bool added = false;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        hostWidth = host.getWidth();
+        hostHeight = host.getHeight();
+
+        auto* entry = findEntry(client);
+        if (entry == nullptr)
+        {
+            entries.emplace_back();
+            entry = &entries.back();
+            entry->client = &client;
+            added = true;
+        }
+
+        entry->bounds = bounds;
+        entry->clip = clip;
+        entry->visible = visible;
+        entry->quads.assign(batch.getQuads().begin(), batch.getQuads().end());
+    }
+
+    if (added)
+        client.addComponentListener(this);
+
+    openGLContext.triggerRepaint();
+}
+
+void QuadRenderService::removeClient(juce::Component& client)
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&client](const Entry& e) { return e.client == &client; }),
+                      entries.end());
+    }
+
+    client.removeComponentListener(this);
+    openGLContext.triggerRepaint();
+}
+
+void QuadRenderService::updateClient(juce::Component& client)
+{
+    const auto bounds = host.getLocalArea(&client, client.getLocalBounds());
+    const auto clip = FrameClock::getVisibleArea(client, host).getIntersection(host.getLocalBounds());
+    const bool visible = client.isShowing();
+
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        hostWidth = host.getWidth();
+        hostHeight = host.getHeight();
+
+        if (auto* entry = findEntry(client))
+        {
+            entry->bounds = bounds;
+            entry->clip = clip;
+            entry->visible = visible;
+        }
+    }
+
+    openGLContext.triggerRepaint();
+}
+
+void QuadRenderService::componentMovedOrResized(juce::Component& component, bool, bool)
+{
+    updateClient(component);
+}
+
+void QuadRenderService::componentVisibilityChanged(juce::Component& component)
+{
+    updateClient(component);
+}
+
+void QuadRenderService::componentParentHierarchyChanged(juce::Component& component)
+{
+    updateClient(component);
+}
+
+void QuadRenderService::componentBeingDeleted(juce::Component& component)
+{
+    removeClient(component);
+}
+
+//==============================================================================
+void QuadRenderService::requestCaptureForTesting()
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(captureLock);
+        captureReady = false;
+    }
+
+    captureRequested.store(true);
+    openGLContext.triggerRepaint();
+}
+
+juce::Image QuadRenderService::getCapturedFrameForTesting() const
+{
+    const juce::SpinLock::ScopedLockType lock(captureLock);
+
+    if (!captureReady || capturedPixels.empty())
+        return {};
+
+    juce::Image image(juce::Image::ARGB, capturedWidth, capturedHeight, true);
+    juce::Image::BitmapData data(image, juce::Image::BitmapData::writeOnly);
+
+    // GL rows run bottom to top; the blend already left them premultiplied
+    for (int y = 0; y < capturedHeight; ++y)
+    {
+        const uint8_t* source = capturedPixels.data() + static_cast<size_t>(capturedHeight - 1 - y) * static_cast<size_t>(capturedWidth) * 4;
+
+        for (int x = 0; x < capturedWidth; ++x, source += 4)
+            reinterpret_cast<juce::PixelARGB*>(data.getPixelPointer(x, y))->setARGB(source[3], source[0], source[1], source[2]);
+    }
+
+    return image;
+}
+
+//==============================================================================
+void QuadRenderService::newOpenGLContextCreated()
+{
+    softwareRasteriser.store(OrbGLResources::isSoftwareRasteriser());
+
+    shader = std::make_unique<juce::OpenGLShaderProgram>(openGLContext);
+
+    if (!shader->addVertexShader(quadVertexShaderSource)
+        || !shader->addFragmentShader(quadFragmentShaderSource)
+        || !shader->link())
+    {
+        DBG("Quad shader error: " + shader->getLastError());
+        shader.reset();
+        glUnusable.store(true);
+        triggerAsyncUpdate();
+        return;
+    }
+
+    // Every quad uses the same two triangles, so one index buffer serves all draws
+    std::vector<GLushort> indices(static_cast<size_t>(kQuadsPerDraw) * 6);
+
+    for (int quad = 0; quad < kQuadsPerDraw; ++quad)
+    {
+        const auto first = static_cast<GLushort>(quad * 4);
+        auto* index = indices.data() + static_cast<size_t>(quad) * 6;
+
+        index[0] = first;
+        index[1] = static_cast<GLushort>(first + 1);
+        index[2] = static_cast<GLushort>(first + 2);
+        index[3] = static_cast<GLushort>(first + 2);
+        index[4] = static_cast<GLushort>(first + 1);
+        index[5] = static_cast<GLushort>(first + 3);
+    }
+
+    auto& gl = openGLContext.extensions;
+
+    gl.glGenBuffers(1, &indexBuffer);
+    gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    gl.glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLushort)),
+                    indices.data(), GL_STATIC_DRAW);
+
+    gl.glGenBuffers(1, &vertexBuffer);
+}
+
+void QuadRenderService::renderOpenGL()
+{
+    SHMUI_PROFILE_SCOPE("QuadRenderService::renderOpenGL");
+
+    juce::OpenGLHelpers::clear(juce::Colours::transparentBlack);
+
+    if (shader == nullptr)
+        return;
+
+    int width = 0;
+    int height = 0;
+
+    {
+        // Copy into reused lists so building vertices doesn't hold the lock
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        renderList.resize(entries.size());
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            renderList[i].client = entries[i].client;
+            renderList[i].bounds = entries[i].bounds;
+            renderList[i].clip = entries[i].clip;
+            renderList[i].visible = entries[i].visible;
+            renderList[i].quads.assign(entries[i].quads.begin(), entries[i].quads.end());
+        }
+
+        width = hostWidth;
+        height = hostHeight;
+    }
+
+    const auto scale = static_cast<float>(openGLContext.getRenderingScale());
+
+    vertices.clear();
+
+    for (const auto& entry : renderList)
+        if (entry.visible && !entry.bounds.isEmpty() && !entry.clip.isEmpty())
+            appendVertices(entry, scale);
+
+    const int numQuads = static_cast<int>(vertices.size() / 4);
+    numQuadsRendered.store(numQuads);
+
+    const int viewportWidth = juce::roundToInt(static_cast<float>(width) * scale);
+    const int viewportHeight = juce::roundToInt(static_cast<float>(height) * scale);
+
+    if (captureRequested.exchange(false))
+        captureFrame(viewportWidth, viewportHeight);
+
+    drawVertices(viewportWidth, viewportHeight);
+}
+
+void QuadRenderService::drawVertices(int viewportWidth, int viewportHeight)
+{
+    const int numQuads = static_cast<int>(vertices.size() / 4);
+
+    if (numQuads == 0)
+        return;
+
+    glViewport(0, 0, viewportWidth, viewportHeight);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader->use();
+    shader->setUniform("uViewport", static_cast<GLfloat>(viewportWidth), static_cast<GLfloat>(viewportHeight));
+
+    auto& gl = openGLContext.extensions;
+    const auto programID = shader->getProgramID();
+
+    gl.glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    gl.glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)),
+                    vertices.data(), GL_STREAM_DRAW);
+    gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    struct Attribute
+    {
+        const char* name;
+        GLint size;
+        GLenum type;
+        GLboolean normalised;
+        size_t offset;
+    };
+
+    const Attribute attributes[] =
+    {
+        { "aPosition", 2, GL_FLOAT,         GL_FALSE, offsetof(Vertex, position) },
+        { "aShape",    4, GL_FLOAT,         GL_FALSE, offsetof(Vertex, shape) },
+        { "aRadius",   3, GL_FLOAT,         GL_FALSE, offsetof(Vertex, radius) },
+        { "aClip",     4, GL_FLOAT,         GL_FALSE, offsetof(Vertex, clip) },
+        { "aGradient", 4, GL_FLOAT,         GL_FALSE, offsetof(Vertex, gradient) },
+        { "aColour",   4, GL_UNSIGNED_BYTE, GL_TRUE,  offsetof(Vertex, colour) },
+        { "aColour2",  4, GL_UNSIGNED_BYTE, GL_TRUE,  offsetof(Vertex, colour2) }
+    };
+
+    // 16-bit indices: draw in chunks, pointing the attributes at each chunk
+    for (int first = 0; first < numQuads; first += kQuadsPerDraw)
+    {
+        const size_t base = static_cast<size_t>(first) * 4 * sizeof(Vertex);
+
+        for (const auto& attribute : attributes)
+        {
+            const auto location = gl.glGetAttribLocation(programID, attribute.name);
+            if (location < 0)
+                continue;
+
+            gl.glVertexAttribPointer(static_cast<GLuint>(location), attribute.size, attribute.type,
+                                     attribute.normalised, static_cast<GLsizei>(sizeof(Vertex)),
+                                     reinterpret_cast<const void*>(base + attribute.offset));
+            gl.glEnableVertexAttribArray(static_cast<GLuint>(location));
+        }
+
+        const int count = juce::jmin(kQuadsPerDraw, numQuads - first);
+        glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, nullptr);
+    }
+
+    for (const auto& attribute : attributes)
+    {
+        const auto location = gl.glGetAttribLocation(programID, attribute.name);
+        if (location >= 0)
+            gl.glDisableVertexAttribArray(static_cast<GLuint>(location));
+    }
+
+    gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+    gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void QuadRenderService::captureFrame(int viewportWidth, int viewportHeight)
+{
+    std::vector<uint8_t> pixels;
+    juce::OpenGLFrameBuffer frameBuffer;
+
+    if (viewportWidth > 0 && viewportHeight > 0 && frameBuffer.initialise(openGLContext, viewportWidth, viewportHeight))
+    {
+        frameBuffer.makeCurrentRenderingTarget();
+        juce::OpenGLHelpers::clear(juce::Colours::transparentBlack);
+        drawVertices(viewportWidth, viewportHeight);
+
+        pixels.resize(static_cast<size_t>(viewportWidth) * static_cast<size_t>(viewportHeight) * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, viewportWidth, viewportHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        frameBuffer.releaseAsRenderingTarget();
+    }
+
+    const juce::SpinLock::ScopedLockType lock(captureLock);
+    capturedPixels.swap(pixels);
+    capturedWidth = capturedPixels.empty() ? 0 : viewportWidth;
+    capturedHeight = capturedPixels.empty() ? 0 : viewportHeight;
+    captureReady = true;
+}
+
+void QuadRenderService::appendVertices(const Entry& entry, float scale)
+{
+    const auto origin = entry.bounds.getPosition().toFloat();
+    const auto clientClip = entry.clip.toFloat() * scale;
+
+    for (const auto& quad : entry.quads)
+    {
+        if (quad.colour.isTransparent() && (quad.fill == Quad::Fill::Solid || quad.colour2.isTransparent()))
+            continue;
+
+        const auto rect = (quad.bounds + origin) * scale;
+        if (rect.isEmpty())
+            continue;
+
+        auto clip = clientClip;
+        if (!quad.clip.isEmpty())
+            clip = clip.getIntersection((quad.clip + entry.bounds.getPosition()).toFloat() * scale);
+
+        if (clip.isEmpty())
+            continue;
+
+        const float halfWidth = rect.getWidth() * 0.5f;
+        const float halfHeight = rect.getHeight() * 0.5f;
+        const float maxRadius = juce::jmin(halfWidth, halfHeight);
+
+        Vertex vertex {};
+        vertex.shape[0] = rect.getCentreX();
+        vertex.shape[1] = rect.getCentreY();
+        vertex.shape[2] = halfWidth;
+        vertex.shape[3] = halfHeight;
+        vertex.radius[0] = quad.isEllipse ? 0.0f : juce::jlimit(0.0f, maxRadius, quad.cornerRadius * scale);
+        vertex.radius[2] = quad.isEllipse ? 1.0f : 0.0f;
+
+        vertex.clip[0] = clip.getX();
+        vertex.clip[1] = clip.getY();
+        vertex.clip[2] = clip.getRight();
+        vertex.clip[3] = clip.getBottom();
+
+        const auto colour2 = quad.fill == Quad::Fill::Solid ? quad.colour : quad.colour2;
+        const auto start = (quad.gradientStart + origin) * scale;
+        const auto end = (quad.gradientEnd + origin) * scale;
+
+        if (quad.fill == Quad::Fill::Linear)
+        {
+            const auto direction = end - start;
+            const float lengthSquared = direction.x * direction.x + direction.y * direction.y;
+
+            vertex.gradient[0] = start.x;
+            vertex.gradient[1] = start.y;
+            vertex.gradient[2] = lengthSquared > 0.0f ? direction.x / lengthSquared : 0.0f;
+            vertex.gradient[3] = lengthSquared > 0.0f ? direction.y / lengthSquared : 0.0f;
+        }
+        else if (quad.fill == Quad::Fill::Radial)
+        {
+            const float radius = start.getDistanceFrom(end);
+
+            vertex.radius[1] = 1.0f;
+            vertex.gradient[0] = start.x;
+            vertex.gradient[1] = start.y;
+            vertex.gradient[2] = radius > 0.0f ? 1.0f / radius : 0.0f;
+        }
+
+        const juce::Colour colours[] = { quad.colour, colour2 };
+        uint8_t* targets[] = { vertex.colour, vertex.colour2 };
+
+        for (int i = 0; i < 2; ++i)
+        {
+            targets[i][0] = colours[i].getRed();
+            targets[i][1] = colours[i].getGreen();
+            targets[i][2] = colours[i].getBlue();
+            targets[i][3] = colours[i].getAlpha();
+        }
+
+        // A pixel of fringe on every side for the antialiased edge
+        const auto outer = rect.expanded(1.0f);
+        const float corners[4][2] =
+        {
+            { outer.getX(), outer.getY() },
+            { outer.getRight(), outer.getY() },
+            { outer.getX(), outer.getBottom() },
+            { outer.getRight(), outer.getBottom() }
+        };
+
+        for (const auto& corner : corners)
+        {
+            vertex.position[0] = corner[0];
+            vertex.position[1] = corner[1];
+            vertices.push_back(vertex);
+        }
+    }
+}
+
+void QuadRenderService::openGLContextClosing()
+{
+    shader.reset();
+
+    auto& gl = openGLContext.extensions;
+
+    if (vertexBuffer != 0)
+    {
+        gl.glDeleteBuffers(1, &vertexBuffer);
+        vertexBuffer = 0;
+    }
+
+    if (indexBuffer != 0)
+    {
+        gl.glDeleteBuffers(1, &indexBuffer);
+        indexBuffer = 0;
+    }
+}
+
+void QuadRenderService::handleAsyncUpdate()
+{
+    if (!glUnusable.load())
+        return;
+
+    std::vector<juce::Component*> clients;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(entryLock);
+
+        for (const auto& entry : entries)
+            clients.push_back(entry.client);
+    }
+
+    // isAvailable() is now false, so the next paint goes through juce::Graphics
+    for (auto* client : clients)
+        client->repaint();
+}
+
+} // namespace shmui
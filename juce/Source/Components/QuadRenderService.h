@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+
+    QuadRenderService.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Batched quad geometry for the 2D visualizers, drawn either through
+    juce::Graphics or, for many components at once, through one shared
+    OpenGL context.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief One filled rectangle, rounded rectangle or circle.
+ *
+ * Coordinates are in the owning component's space. The fill is a solid
+ * colour or a two-colour linear or radial gradient with the same meaning
+ * as juce::ColourGradient.
+ */
+struct Quad
+{
+    enum class Fill : uint8_t
+    {
+        Solid,      ///< colour
+        Linear,     ///< colour at gradientStart to colour2 at gradientEnd
+        Radial      ///< colour at gradientStart (centre) to colour2 at the distance of gradientEnd
+    };
+
+    juce::Rectangle<float> bounds;
+    float cornerRadius = 0.0f;          ///< Clamped to half the smaller side
+    bool isEllipse = false;             ///< Fill the ellipse inscribed in bounds (cornerRadius unused)
+
+    Fill fill = Fill::Solid;
+    juce::Colour colour;
+    juce::Colour colour2;
+    juce::Point<float> gradientStart;
+    juce::Point<float> gradientEnd;
+
+    juce::Rectangle<int> clip;          ///< Only pixels inside are drawn (empty = no clip)
+};
+
+//==============================================================================
+/**
+ * @brief Reusable list of quads in paint order.
+ *
+ * Components describe a frame as a batch once, then either paint() it
+ * into a juce::Graphics (CPU path) or submit() it to a QuadRenderService
+ * (GL path). Clearing keeps the storage, so rebuilding a batch every
+ * frame does not allocate once it has reached its largest size.
+ */
+class QuadBatch
+{
+public:
+    QuadBatch() = default;
+
+    /** Remove all quads (keeps the storage). */
+    void clear() { quads.clear(); }
+
+    /** Append a solid rectangle. */
+    Quad& addRectangle(juce::Rectangle<float> bounds, juce::Colour colour);
+
+    /** Append a solid rounded rectangle. */
+    Quad& addRoundedRectangle(juce::Rectangle<float> bounds, float cornerRadius, juce::Colour colour);
+
+    /** Append a solid ellipse. */
+    Quad& addEllipse(juce::Rectangle<float> bounds, juce::Colour colour);
+
+    /** Append a prepared quad. */
+    Quad& add(const Quad& quad);
+
+    /**
+     * @brief Draw every quad through juce::Graphics, in order.
+     *
+     * Makes the same fillRect / fillRoundedRectangle / fillEllipse and
+     * gradient calls a component would make itself.
+     */
+    void paint(juce::Graphics& g) const;
+
+    const std::vector<Quad>& getQuads() const { return quads; }
+    bool isEmpty() const { return quads.empty(); }
+    int size() const { return static_cast<int>(quads.size()); }
+
+private:
+    std::vector<Quad> quads;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(QuadBatch)
+};
+
+//==============================================================================
+/**
+ * @brief One OpenGL context that draws the quads of many components.
+ *
+ * Attach the service to a component that contains the visualizers
+ * (typically a monitoring wall or dashboard), then hand it to each of
+ * them with setQuadRenderService(). From then on their paint() builds a
+ * QuadBatch and submits it here instead of filling paths on the CPU;
+ * text and cached images are still painted normally, on top.
+ *
+ * Every frame, the GL thread expands all submitted quads, client by
+ * client in the order they first submitted, into one vertex buffer and
+ * draws them with a single indexed draw call per 16384 quads.
+ * Shapes and gradients are evaluated per fragment from analytic
+ * distances in physical pixels, with no multisampling, derivatives or
+ * textures, so a software rasteriser (Mesa llvmpipe / softpipe) produces
+ * the same pixels as a GPU and the path can be checked on GPU-less
+ * machines (ShmuiBenchmarks --check compares it with QuadBatch::paint()). Unlike OrbRenderService, a software rasteriser is therefore
+ * not treated as a failure.
+ *
+ * As with any attached OpenGLContext, component painting is composited
+ * over the GL output, so the host and the parents between it and the
+ * clients must not paint opaque backgrounds over them.
+ *
+ * If the shader cannot be built the service reports itself unavailable
+ * and repaints its clients, which then draw through juce::Graphics.
+ */
+class QuadRenderService : private juce::OpenGLRenderer,
+                          private juce::AsyncUpdater,
+                          private juce::ComponentListener
+{
+public:
+    /** Most quads drawn by one call (16-bit indices). */
+    static constexpr int kQuadsPerDraw = 16384;
+
+    /**
+     * @brief Create the service and attach its context to a host.
+     *
+     * @param host Component that contains (directly or indirectly) the clients
+     */
+    explicit QuadRenderService(juce::Component& host);
+    ~QuadRenderService() override;
+
+    /**
+     * @brief Check if clients should submit their quads.
+     *
+     * False once the shader failed to build; clients then paint on the CPU.
+     */
+    bool isAvailable() const { return !glUnusable.load(); }
+
+    /**
+     * @brief Check if the context turned out to be a software rasteriser.
+     */
+    bool isSoftwareRasteriser() const { return softwareRasteriser.load(); }
+
+    /**
+     * @brief Replace a client's quads (message thread, usually from paint()).
+     *
+     * The client is registered on first use and its position within the
+     * host is tracked from then on. Quads are clipped to the part of the
+     * client its parents show (as when it is scrolled out of a viewport).
+     */
+    void submit(juce::Component& client, const QuadBatch& batch);
+
+    /**
+     * @brief Stop drawing a client's quads.
+     */
+    void removeClient(juce::Component& client);
+
+    /**
+     * @brief Get the number of registered clients.
+     */
+    int getNumClients() const;
+
+    /**
+     * @brief Get the number of quads in the last rendered frame.
+     */
+    int getNumQuadsRendered() const { return numQuadsRendered.load(); }
+
+    /**
+     * @brief Get the host component.
+     */
+    juce::Component& getHost() const { return host; }
+
+    //==============================================================================
+    /// @name Testing
+    /// @{
+
+    /**
+     * @brief Read back the next rendered frame (for self-checks).
+     *
+     * The GL thread draws its next frame a second time into an offscreen
+     * framebuffer the size of the host in physical pixels and copies it
+     * out. Poll getCapturedFrameForTesting() for the result.
+     */
+    void requestCaptureForTesting();
+
+    /**
+     * @brief Get the frame read back after requestCaptureForTesting().
+     *
+     * @return Premultiplied ARGB pixels, or an invalid image until the GL
+     *         thread has rendered a frame since the request
+     */
+    juce::Image getCapturedFrameForTesting() const;
+
+    /// @}
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        juce::Component* client = nullptr;
+        juce::Rectangle<int> bounds;        // In the host
+        juce::Rectangle<int> clip;          // Part of bounds inside every ancestor, in the host
+        bool visible = false;
+        std::vector<Quad> quads;
+    };
+
+    /** Vertex layout; positions in physical pixels of the host. */
+    struct Vertex
+    {
+        float position[2];
+        float shape[4];         // Quad centre, half size
+        float radius[3];        // Corner radius, gradient mode (0 linear, 1 radial), 1 for an ellipse
+        float clip[4];          // Left, top, right, bottom
+        float gradient[4];      // Linear: origin, direction / length^2; radial: centre, 1 / radius
+        uint8_t colour[4];
+        uint8_t colour2[4];
+    };
+
+    Entry* findEntry(juce::Component& client);
+    void updateClient(juce::Component& client);
+    void appendVertices(const Entry& entry, float scale);
+    void drawVertices(int viewportWidth, int viewportHeight);
+    void captureFrame(int viewportWidth, int viewportHeight);
+
+    // OpenGLRenderer
+    void newOpenGLContextCreated() override;
+    void renderOpenGL() override;
+    void openGLContextClosing() override;
+
+    // AsyncUpdater: sends clients back to the CPU path after a GL failure
+    void handleAsyncUpdate() override;
+
+    // ComponentListener: keeps client positions and visibility current
+    void componentMovedOrResized(juce::Component& component, bool wasMoved, bool wasResized) override;
+    void componentVisibilityChanged(juce::Component& component) override;
+    void componentParentHierarchyChanged(juce::Component& component) override;
+    void componentBeingDeleted(juce::Component& component) override;
+
+    //==============================================================================
+    juce::Component& host;
+    juce::OpenGLContext openGLContext;
+
+    // Message thread writes, GL thread copies into renderList
+    std::vector<Entry> entries;
+    int hostWidth = 0;
+    int hostHeight = 0;
+    mutable juce::SpinLock entryLock;
+
+    // GL thread
+    std::vector<Entry> renderList;
+    std::vector<Vertex> vertices;
+    std::unique_ptr<juce::OpenGLShaderProgram> shader;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+
+    std::atomic<bool> glUnusable{false};
+    std::atomic<bool> softwareRasteriser{false};
+    std::atomic<int> numQuadsRendered{0};
+
+    // Self-check readback: requested on the message thread, filled by the GL thread
+    std::atomic<bool> captureRequested{false};
+    std::vector<uint8_t> capturedPixels;            // RGBA rows, bottom row first
+    int capturedWidth = 0;
+    int capturedHeight = 0;
+    bool captureReady = false;
+    mutable juce::SpinLock captureLock;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(QuadRenderService)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(QuadRenderService)
+};
+
+} // namespace shmui
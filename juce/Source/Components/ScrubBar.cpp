@@ -8,6 +8,7 @@
 */
 
 #include "ScrubBar.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -89,6 +90,8 @@ void ScrubBar::setStyle (const Style& newStyle)
 //==============================================================================
 void ScrubBar::paint (juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("ScrubBar::paint");
+
     auto trackBounds = getTrackBounds();
 
     // Draw track background
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    TimeReadout.cpp
+    Created: shmui Component Library
+
+    Time readout implementation.
+
+  ==============================================================================
+*/
+
+#include "TimeReadout.h"
+#include "../Utils/Profiling.h"
+
+namespace shmui
+{
+
+//==============================================================================
+TimeReadout::TimeReadout()
+{
+    setOpaque(false);
+    setInterceptsMouseClicks(false, false);
+    refresh(false);
+}
+
+//==============================================================================
+void TimeReadout::setSeconds(double seconds)
+{
+    m_seconds = seconds;
+    m_hasExactSamples = false;
+    refresh(false);
+}
+
+void TimeReadout::setSamples(int64_t samples)
+{
+    m_samples = samples;
+    m_seconds = m_settings.sampleRate > 0.0 ? static_cast<double>(samples) / m_settings.sampleRate : 0.0;
+    m_hasExactSamples = true;
+    refresh(false);
+}
+
+void TimeReadout::setFormat(TimeDisplayFormat format)
+{
+    auto settings = m_settings;
+    settings.format = format;
+    setFormatSettings(settings);
+}
+
+void TimeReadout::setFormatSettings(const TimeFormatSettings& settings)
+{
+    m_settings = settings;
+    refresh(false);
+}
+
+void TimeReadout::setStyle(const TimeReadoutStyle& style)
+{
+    m_style = style;
+    refresh(true);
+}
+
+//==============================================================================
+void TimeReadout::paint(juce::Graphics& g)
+{
+    SHMUI_PROFILE_SCOPE("TimeReadout::paint");
+
+    m_digitAtlas->draw(g, m_layout, m_style.textColor);
+}
+
+void TimeReadout::resized()
+{
+    refresh(true);
+}
+
+//==============================================================================
+void TimeReadout::refresh(bool repaintAll)
+{
+    TimeText text;
+
+    if (m_hasExactSamples && m_settings.format == TimeDisplayFormat::Samples)
+        TimeFormat::appendSamples(text, m_samples);
+    else
+        TimeFormat::appendTime(text, m_seconds, m_settings);
+
+    if (!repaintAll && text == m_layout.text)
+        return;
+
+    const auto layout = m_digitAtlas->layout(text, getLocalBounds().toFloat(), m_style.justification,
+                                             m_style.fontHeight, m_style.bold);
+
+    if (repaintAll)
+    {
+        m_layout = layout;
+        repaint();
+        return;
+    }
+
+    const auto changed = DigitAtlas::getChangedArea(m_layout, layout);
+    m_layout = layout;
+
+    if (!changed.isEmpty())
+        repaint(changed);
+}
+
+} // namespace shmui
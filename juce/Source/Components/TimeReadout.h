@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    TimeReadout.h
+    Created: shmui Component Library
+
+    Transport time readout drawn from the shared digit atlas.
+
+    Features:
+    - MM:SS.mmm, Bar.Beat.Tick, sample count and HH:MM:SS:FF formats
+    - Tabular digits, so a running clock never shifts
+    - Repaints only the character cells that changed
+    - No string building or allocation per update
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Utils/DigitAtlas.h"
+#include "../Utils/TimeFormat.h"
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Style configuration for TimeReadout.
+ */
+struct TimeReadoutStyle
+{
+    juce::Colour textColor = juce::Colours::white;
+    float fontHeight = 14.0f;
+    bool bold = false;
+    juce::Justification justification = juce::Justification::centredLeft;
+};
+
+//==============================================================================
+/**
+ * @brief Time display for transport positions and lengths.
+ *
+ * Each update formats into a fixed TimeText, compares it with what is on
+ * screen and repaints only the cells whose character changed, so a
+ * position readout updated at frame rate usually repaints one or two
+ * digits. paint() blits the glyphs from the shared DigitAtlas.
+ *
+ * Transparent: the parent draws the background.
+ */
+class TimeReadout : public juce::Component
+{
+public:
+    //==============================================================================
+    TimeReadout();
+    ~TimeReadout() override = default;
+
+    //==============================================================================
+    /// @name Value
+    /// @{
+
+    /** Set the time in seconds. */
+    void setSeconds(double seconds);
+
+    /** Set the time as an exact sample count (shown as-is in the Samples format). */
+    void setSamples(int64_t samples);
+
+    /** Get the time in seconds. */
+    double getSeconds() const { return m_seconds; }
+
+    /** Get the characters currently shown. */
+    const TimeText& getText() const { return m_layout.text; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Format
+    /// @{
+
+    /** Set the display format. */
+    void setFormat(TimeDisplayFormat format);
+
+    /** Get the display format. */
+    TimeDisplayFormat getFormat() const { return m_settings.format; }
+
+    /** Set the format, sample rate, tempo, meter and frame rate together. */
+    void setFormatSettings(const TimeFormatSettings& settings);
+
+    /** Get the format settings. */
+    const TimeFormatSettings& getFormatSettings() const { return m_settings; }
+
+    /// @}
+
+    //==============================================================================
+    /// @name Style
+    /// @{
+
+    /** Set visual style. */
+    void setStyle(const TimeReadoutStyle& style);
+
+    /** Get current style. */
+    const TimeReadoutStyle& getStyle() const { return m_style; }
+
+    /// @}
+
+    //==============================================================================
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    //==============================================================================
+    /** Reformat and repaint what changed (everything if repaintAll). */
+    void refresh(bool repaintAll);
+
+    //==============================================================================
+    juce::SharedResourcePointer<DigitAtlas> m_digitAtlas;
+
+    TimeFormatSettings m_settings;
+    TimeReadoutStyle m_style;
+
+    double m_seconds = 0.0;
+    int64_t m_samples = 0;
+    bool m_hasExactSamples = false;     // Last set through setSamples()
+
+    DigitLayout m_layout;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeReadout)
+};
+
+} // namespace shmui
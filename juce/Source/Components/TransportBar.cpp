@@ -10,6 +10,7 @@
 */
 
 #include "TransportBar.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -59,18 +60,23 @@ void TransportBar::setPositionSeconds(double seconds)
     m_positionSeconds = seconds;
     m_positionSamples = static_cast<int64_t>(seconds * m_sampleRate);
 
-    if (m_positionLabel)
-        m_positionLabel->setText(formatTime(seconds), juce::dontSendNotification);
+    if (m_positionReadout)
+        m_positionReadout->setSeconds(seconds);
 }
 
 void TransportBar::setPositionSamples(int64_t samples, int sampleRate)
 {
     m_positionSamples = samples;
-    m_sampleRate = sampleRate;
     m_positionSeconds = static_cast<double>(samples) / sampleRate;
 
-    if (m_positionLabel)
-        m_positionLabel->setText(formatTime(m_positionSeconds), juce::dontSendNotification);
+    if (m_sampleRate != sampleRate)
+    {
+        m_sampleRate = sampleRate;
+        updateTimeReadouts();
+    }
+
+    if (m_positionReadout)
+        m_positionReadout->setSamples(samples);
 }
 
 void TransportBar::setDurationSeconds(double seconds)
@@ -78,25 +84,29 @@ void TransportBar::setDurationSeconds(double seconds)
     m_durationSeconds = seconds;
     m_durationSamples = static_cast<int64_t>(seconds * m_sampleRate);
 
-    if (m_durationLabel)
-        m_durationLabel->setText(formatTime(seconds), juce::dontSendNotification);
+    if (m_durationReadout)
+        m_durationReadout->setSeconds(seconds);
 }
 
 void TransportBar::setDurationSamples(int64_t samples, int sampleRate)
 {
     m_durationSamples = samples;
-    m_sampleRate = sampleRate;
     m_durationSeconds = static_cast<double>(samples) / sampleRate;
 
-    if (m_durationLabel)
-        m_durationLabel->setText(formatTime(m_durationSeconds), juce::dontSendNotification);
+    if (m_sampleRate != sampleRate)
+    {
+        m_sampleRate = sampleRate;
+        updateTimeReadouts();
+    }
+
+    if (m_durationReadout)
+        m_durationReadout->setSamples(samples);
 }
 
 void TransportBar::setTimeFormat(TimeDisplayFormat format)
 {
     m_timeFormat = format;
-    setPositionSeconds(m_positionSeconds); // Refresh display
-    setDurationSeconds(m_durationSeconds);
+    updateTimeReadouts();
 }
 
 //==============================================================================
@@ -105,12 +115,15 @@ void TransportBar::setTempo(double bpm)
     m_tempoBPM = bpm;
     if (m_tempoLabel)
         m_tempoLabel->setText(juce::String(bpm, 1) + " BPM", juce::dontSendNotification);
+
+    updateTimeReadouts();
 }
 
 void TransportBar::setTimeSignature(int numerator, int denominator)
 {
     m_timeSignatureNum = numerator;
     m_timeSignatureDenom = denominator;
+    updateTimeReadouts();
 }
 
 void TransportBar::setStyle(const TransportBarStyle& style)
@@ -127,6 +140,14 @@ void TransportBar::setStyle(const TransportBarStyle& style)
     if (m_panicButton)
         m_panicButton->setVisible(style.showPanic);
 
+    auto positionStyle = m_positionReadout->getStyle();
+    positionStyle.textColor = style.textColor;
+    m_positionReadout->setStyle(positionStyle);
+
+    auto durationStyle = m_durationReadout->getStyle();
+    durationStyle.textColor = style.dimTextColor;
+    m_durationReadout->setStyle(durationStyle);
+
     resized();
     repaint();
 }
@@ -134,6 +155,8 @@ void TransportBar::setStyle(const TransportBarStyle& style)
 //==============================================================================
 void TransportBar::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("TransportBar::paint");
+
     auto bounds = getLocalBounds().toFloat();
 
     // Background
@@ -185,13 +208,13 @@ void TransportBar::resized()
     const int timeLabelHeight = 20;
     int timeY = (bounds.getHeight() - timeLabelHeight) / 2;
 
-    m_positionLabel->setBounds(x, timeY, timeLabelWidth, timeLabelHeight);
+    m_positionReadout->setBounds(x, timeY, timeLabelWidth, timeLabelHeight);
     x += timeLabelWidth + 8;
 
     // Separator "/"
     // (drawn in paint if needed)
 
-    m_durationLabel->setBounds(x, timeY, timeLabelWidth, timeLabelHeight);
+    m_durationReadout->setBounds(x, timeY, timeLabelWidth, timeLabelHeight);
     x += timeLabelWidth + sectionSpacing;
 
     // Tempo display (if visible)
@@ -273,21 +296,26 @@ void TransportBar::setupButtons()
     addAndMakeVisible(*m_panicButton);
     m_panicButton->setVisible(m_style.showPanic);
 
-    // Position label
-    m_positionLabel = std::make_unique<juce::Label>();
-    m_positionLabel->setText("0:00.000", juce::dontSendNotification);
-    m_positionLabel->setFont(juce::Font(14.0f, juce::Font::bold));
-    m_positionLabel->setColour(juce::Label::textColourId, m_style.textColor);
-    m_positionLabel->setJustificationType(juce::Justification::centredRight);
-    addAndMakeVisible(*m_positionLabel);
-
-    // Duration label
-    m_durationLabel = std::make_unique<juce::Label>();
-    m_durationLabel->setText("0:00.000", juce::dontSendNotification);
-    m_durationLabel->setFont(juce::Font(14.0f));
-    m_durationLabel->setColour(juce::Label::textColourId, m_style.dimTextColor);
-    m_durationLabel->setJustificationType(juce::Justification::centredLeft);
-    addAndMakeVisible(*m_durationLabel);
+    // Position readout
+    TimeReadoutStyle positionStyle;
+    positionStyle.textColor = m_style.textColor;
+    positionStyle.bold = true;
+    positionStyle.justification = juce::Justification::centredRight;
+
+    m_positionReadout = std::make_unique<TimeReadout>();
+    m_positionReadout->setStyle(positionStyle);
+    addAndMakeVisible(*m_positionReadout);
+
+    // Duration readout
+    TimeReadoutStyle durationStyle;
+    durationStyle.textColor = m_style.dimTextColor;
+    durationStyle.justification = juce::Justification::centredLeft;
+
+    m_durationReadout = std::make_unique<TimeReadout>();
+    m_durationReadout->setStyle(durationStyle);
+    addAndMakeVisible(*m_durationReadout);
+
+    updateTimeReadouts();
 
     // Tempo label
     m_tempoLabel = std::make_unique<juce::Label>();
@@ -299,57 +327,18 @@ void TransportBar::setupButtons()
     m_tempoLabel->setVisible(m_style.showTempo);
 }
 
-juce::String TransportBar::formatTime(double seconds) const
-{
-    switch (m_timeFormat)
-    {
-        case TimeDisplayFormat::MinutesSeconds:
-        {
-            int mins = static_cast<int>(seconds / 60.0);
-            double secs = std::fmod(seconds, 60.0);
-            return juce::String::formatted("%d:%06.3f", mins, secs);
-        }
-
-        case TimeDisplayFormat::Timecode:
-            return formatTimecode(seconds);
-
-        case TimeDisplayFormat::Bars:
-            return formatBars(seconds);
-
-        case TimeDisplayFormat::Samples:
-            return formatSamples(static_cast<int64_t>(seconds * m_sampleRate));
-
-        default:
-            return juce::String(seconds, 3);
-    }
-}
-
-juce::String TransportBar::formatTimecode(double seconds) const
-{
-    int hours = static_cast<int>(seconds / 3600.0);
-    int mins = static_cast<int>(std::fmod(seconds, 3600.0) / 60.0);
-    int secs = static_cast<int>(std::fmod(seconds, 60.0));
-    int frames = static_cast<int>(std::fmod(seconds * 30.0, 30.0)); // 30fps
-
-    return juce::String::formatted("%02d:%02d:%02d:%02d", hours, mins, secs, frames);
-}
-
-juce::String TransportBar::formatBars(double seconds) const
-{
-    // Calculate beats
-    double beatsPerSecond = m_tempoBPM / 60.0;
-    double totalBeats = seconds * beatsPerSecond;
-
-    int bars = static_cast<int>(totalBeats / m_timeSignatureNum) + 1;
-    int beats = static_cast<int>(std::fmod(totalBeats, m_timeSignatureNum)) + 1;
-    int ticks = static_cast<int>(std::fmod(totalBeats, 1.0) * 480); // 480 ticks per beat
-
-    return juce::String::formatted("%d.%d.%03d", bars, beats, ticks);
-}
-
-juce::String TransportBar::formatSamples(int64_t samples) const
+void TransportBar::updateTimeReadouts()
 {
-    return juce::String(samples);
+    TimeFormatSettings settings;
+    settings.format = m_timeFormat;
+    settings.sampleRate = static_cast<double>(m_sampleRate);
+    settings.tempoBPM = m_tempoBPM;
+    settings.beatsPerBar = m_timeSignatureNum;
+
+    if (m_positionReadout)
+        m_positionReadout->setFormatSettings(settings);
+    if (m_durationReadout)
+        m_durationReadout->setFormatSettings(settings);
 }
 
 } // namespace shmui
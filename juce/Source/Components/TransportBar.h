@@ -24,6 +24,7 @@
 #include "../Controls/TransportButton.h"
 #include "../Controls/ToggleButton.h"
 #include "../Icons/Icons.h"
+#include "TimeReadout.h"
 
 namespace shmui
 {
@@ -53,18 +54,6 @@ struct TransportBarStyle
     bool showPanic = true;
 };
 
-//==============================================================================
-/**
- * @brief Transport time display format.
- */
-enum class TimeDisplayFormat
-{
-    MinutesSeconds,     ///< MM:SS.mmm
-    Bars,               ///< Bar.Beat.Tick
-    Samples,            ///< Sample count
-    Timecode            ///< HH:MM:SS:FF
-};
-
 //==============================================================================
 /**
  * @brief Full transport control strip component.
@@ -189,10 +178,7 @@ public:
 private:
     //==============================================================================
     void setupButtons();
-    juce::String formatTime(double seconds) const;
-    juce::String formatTimecode(double seconds) const;
-    juce::String formatBars(double seconds) const;
-    juce::String formatSamples(int64_t samples) const;
+    void updateTimeReadouts();
 
     //==============================================================================
     TransportBarStyle m_style;
@@ -222,9 +208,11 @@ private:
     std::unique_ptr<ToggleButton> m_loopButton;
     std::unique_ptr<TransportButton> m_panicButton;
 
+    // Time readouts
+    std::unique_ptr<TimeReadout> m_positionReadout;
+    std::unique_ptr<TimeReadout> m_durationReadout;
+
     // Labels
-    std::unique_ptr<juce::Label> m_positionLabel;
-    std::unique_ptr<juce::Label> m_durationLabel;
     std::unique_ptr<juce::Label> m_tempoLabel;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TransportBar)
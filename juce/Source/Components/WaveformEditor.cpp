@@ -10,6 +10,7 @@
 */
 
 #include "WaveformEditor.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -175,6 +176,8 @@ void WaveformEditor::setStyle(const WaveformEditorStyle& style)
 //==============================================================================
 void WaveformEditor::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("WaveformEditor::paint");
+
     auto bounds = getLocalBounds().toFloat();
 
     // Background
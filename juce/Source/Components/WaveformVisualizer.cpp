@@ -10,6 +10,7 @@
 */
 
 #include "WaveformVisualizer.h"
+#include "../Utils/Profiling.h"
 #include "../Utils/ColorUtils.h"
 
 namespace shmui
@@ -43,6 +44,8 @@ void WaveformVisualizer::setBarColour(const juce::Colour& colour)
 
 void WaveformVisualizer::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("WaveformVisualizer::paint");
+
     const auto bounds = getLocalBounds().toFloat();
     renderWaveform(g, bounds);
 
@@ -159,7 +162,7 @@ ScrollingWaveformVisualizer::ScrollingWaveformVisualizer()
 
 ScrollingWaveformVisualizer::~ScrollingWaveformVisualizer()
 {
-    stopTimer();
+    stopFrames();
 }
 
 void ScrollingWaveformVisualizer::setSpeed(float pixelsPerSecond)
@@ -174,13 +177,12 @@ void ScrollingWaveformVisualizer::setBarCount(int count)
 
 void ScrollingWaveformVisualizer::start()
 {
-    lastTime = juce::Time::currentTimeMillis();
-    startTimerHz(60);  // 60 FPS
+    startFrames();
 }
 
 void ScrollingWaveformVisualizer::stop()
 {
-    stopTimer();
+    stopFrames();
 }
 
 void ScrollingWaveformVisualizer::setDataSource(const std::vector<float>* source)
@@ -196,6 +198,8 @@ void ScrollingWaveformVisualizer::setSeed(uint32_t seed)
 
 void ScrollingWaveformVisualizer::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("ScrollingWaveformVisualizer::paint");
+
     const auto bounds = getLocalBounds().toFloat();
     const float centerY = bounds.getCentreY();
     const float maxHeight = bounds.getHeight() * 0.6f;  // From shmui
@@ -247,11 +251,11 @@ void ScrollingWaveformVisualizer::resized()
     }
 }
 
-void ScrollingWaveformVisualizer::timerCallback()
+bool ScrollingWaveformVisualizer::advanceFrame(double deltaSeconds)
 {
-    const int64_t currentTime = juce::Time::currentTimeMillis();
-    const float deltaTime = static_cast<float>(currentTime - lastTime) / 1000.0f;
-    lastTime = currentTime;
+    SHMUI_PROFILE_SCOPE("ScrollingWaveformVisualizer::advanceFrame");
+
+    const float deltaTime = static_cast<float>(deltaSeconds);
 
     // Move all bars to the left
     for (auto& bar : bars)
@@ -273,6 +277,7 @@ void ScrollingWaveformVisualizer::timerCallback()
     }
 
     repaint();
+    return true;
 }
 
 void ScrollingWaveformVisualizer::addNewBar()
@@ -295,9 +300,9 @@ void ScrollingWaveformVisualizer::addNewBar()
         const float time = static_cast<float>(juce::Time::currentTimeMillis()) / 1000.0f;
         const float uniqueIndex = static_cast<float>(bars.size()) + time * 0.01f;
 
-        const float wave1 = std::sin(uniqueIndex * 0.1f) * 0.2f;
-        const float wave2 = std::cos(uniqueIndex * 0.05f) * 0.15f;
-        const float randomComponent = Interpolation::seededRandom(
+        const float wave1 = Interpolation::fastSin(uniqueIndex * 0.1f) * 0.2f;
+        const float wave2 = Interpolation::fastCos(uniqueIndex * 0.05f) * 0.15f;
+        const float randomComponent = Interpolation::fastSeededRandom(
             static_cast<float>(randomSeed) * 10000.0f + uniqueIndex * 137.5f) * 0.4f;
 
         newHeight = juce::jlimit(0.1f, 0.9f, 0.3f + wave1 + wave2 + randomComponent);
@@ -369,6 +374,8 @@ void AudioScrubberVisualizer::setPlayheadColour(const juce::Colour& colour)
 
 void AudioScrubberVisualizer::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("AudioScrubberVisualizer::paint");
+
     const auto bounds = getLocalBounds().toFloat();
 
     // Draw waveform
@@ -459,11 +466,12 @@ LiveWaveformVisualizer::LiveWaveformVisualizer()
     style.barRadius = 1.0f;
 
     setOpaque(false);
+    setMaxFrameRate(1000.0 / updateRate);
 }
 
 LiveWaveformVisualizer::~LiveWaveformVisualizer()
 {
-    stopTimer();
+    stopFrames();
 }
 
 void LiveWaveformVisualizer::setAudioAnalyzer(AudioAnalyzer* analyzer)
@@ -471,6 +479,12 @@ void LiveWaveformVisualizer::setAudioAnalyzer(AudioAnalyzer* analyzer)
     audioAnalyzer = analyzer;
 }
 
+void LiveWaveformVisualizer::setMeterSource(const MeterHub* hub, int index)
+{
+    meterHub = hub;
+    meterHubIndex = index;
+}
+
 void LiveWaveformVisualizer::setActive(bool isActive)
 {
     if (active != isActive)
@@ -480,11 +494,12 @@ void LiveWaveformVisualizer::setActive(bool isActive)
         if (active)
         {
             clearHistory();
-            startTimer(updateRate);
+            pendingUpdateMs = 0.0;
+            startFrames();
         }
         else
         {
-            stopTimer();
+            stopFrames();
         }
     }
 }
@@ -496,13 +511,8 @@ void LiveWaveformVisualizer::setHistorySize(int size)
 
 void LiveWaveformVisualizer::setUpdateRate(int milliseconds)
 {
-    updateRate = milliseconds;
-
-    if (isTimerRunning())
-    {
-        stopTimer();
-        startTimer(updateRate);
-    }
+    updateRate = juce::jmax(1, milliseconds);
+    setMaxFrameRate(1000.0 / updateRate);
 }
 
 void LiveWaveformVisualizer::setSensitivity(float sens)
@@ -524,6 +534,8 @@ void LiveWaveformVisualizer::clearHistory()
 
 void LiveWaveformVisualizer::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("LiveWaveformVisualizer::paint");
+
     if (history.empty())
         return;
 
@@ -587,25 +599,49 @@ void LiveWaveformVisualizer::resized()
     repaint();
 }
 
-void LiveWaveformVisualizer::timerCallback()
+bool LiveWaveformVisualizer::advanceFrame(double deltaSeconds)
 {
-    if (!audioAnalyzer || !active)
-        return;
+    SHMUI_PROFILE_SCOPE("LiveWaveformVisualizer::advanceFrame");
+
+    if (!active)
+        return false;
+
+    if (!audioAnalyzer && !meterHub)
+        return true;
+
+    // One history entry per updateRate of real time, whatever the frame
+    // pacing; the remainder carries over to the next frame
+    pendingUpdateMs += deltaSeconds * 1000.0;
+    const double dueUpdates = std::floor(pendingUpdateMs / updateRate);
+    if (dueUpdates < 1.0)
+        return true;
 
-    // Get current RMS level
-    const float level = audioAnalyzer->getRMSLevel() * sensitivity;
+    pendingUpdateMs -= dueUpdates * updateRate;
+
+    // Get current RMS level (a stale hub reads as silence)
+    const float rms = meterHub != nullptr ? (meterHub->isStale() ? 0.0f : meterHub->read(meterHubIndex).rms)
+                                          : audioAnalyzer->getRMSLevel();
+    const float level = rms * sensitivity;
     const float clampedLevel = juce::jlimit(0.05f, 1.0f, level);
 
+    // Entries the frame covered besides the last one: the held level when
+    // frames are slower than updateRate, but the floor after a suspension
+    // (frame gaps that long never come from frame pacing), since nothing
+    // was measured while hidden
+    const bool resumed = deltaSeconds > 0.25;
+    const int heldUpdates = static_cast<int>(juce::jmin(dueUpdates, static_cast<double>(historySize))) - 1;
+    for (int i = 0; i < heldUpdates; ++i)
+        history.push_back(resumed ? 0.05f : clampedLevel);
+
     // Add to history
     history.push_back(clampedLevel);
 
     // Trim history
-    while (static_cast<int>(history.size()) > historySize)
-    {
-        history.erase(history.begin());
-    }
+    if (static_cast<int>(history.size()) > historySize)
+        history.erase(history.begin(), history.end() - historySize);
 
     repaint();
+    return true;
 }
 
 } // namespace shmui
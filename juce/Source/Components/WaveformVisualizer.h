@@ -14,6 +14,8 @@
 
 #include <JuceHeader.h>
 #include "../Audio/AudioAnalyzer.h"
+#include "../Audio/MeterHub.h"
+#include "../Utils/FrameClock.h"
 #include "../Utils/Interpolation.h"
 #include <vector>
 
@@ -124,7 +126,7 @@ protected:
  * Port of the ScrollingWaveform component from waveform.tsx.
  */
 class ScrollingWaveformVisualizer : public WaveformVisualizer,
-                                    public juce::Timer
+                                    private FrameClockClient
 {
 public:
     ScrollingWaveformVisualizer();
@@ -156,7 +158,7 @@ public:
     /**
      * @brief Check if animation is running.
      */
-    bool isRunning() const { return isTimerRunning(); }
+    bool isRunning() const { return isReceivingFrames(); }
 
     //==============================================================================
     // Data Source
@@ -174,6 +176,16 @@ public:
      */
     void setSeed(uint32_t seed);
 
+    //==============================================================================
+    // Testing
+
+    /**
+     * @brief Run one frame of deltaSeconds without the FrameClock.
+     *
+     * For benchmarks and self-checks, which drive frames by hand.
+     */
+    void advanceFrameForTesting(double deltaSeconds) { advanceFrame(deltaSeconds); }
+
     //==============================================================================
     // Component overrides
 
@@ -181,7 +193,8 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
     void addNewBar();
     void removeOldBars();
 
@@ -194,7 +207,6 @@ private:
     std::vector<Bar> bars;
     float scrollSpeed = 50.0f;  // pixels per second
     int targetBarCount = 60;
-    int64_t lastTime = 0;
     uint32_t randomSeed = 42;
     int dataIndex = 0;
     const std::vector<float>* dataSource = nullptr;
@@ -291,7 +303,7 @@ private:
  * Port of the LiveMicrophoneWaveform component from waveform.tsx.
  */
 class LiveWaveformVisualizer : public juce::Component,
-                                public juce::Timer
+                                private FrameClockClient
 {
 public:
     LiveWaveformVisualizer();
@@ -305,6 +317,13 @@ public:
      */
     void setAudioAnalyzer(AudioAnalyzer* analyzer);
 
+    /**
+     * @brief Take the level from a MeterHub entry's RMS instead.
+     *
+     * Takes precedence over the analyzer while set. Pass nullptr to unbind.
+     */
+    void setMeterSource(const MeterHub* hub, int index);
+
     /**
      * @brief Set active state (recording).
      */
@@ -351,6 +370,16 @@ public:
      */
     void clearHistory();
 
+    //==============================================================================
+    // Testing
+
+    /**
+     * @brief Run one frame of deltaSeconds without the FrameClock.
+     *
+     * For benchmarks and self-checks, which drive frames by hand.
+     */
+    void advanceFrameForTesting(double deltaSeconds) { advanceFrame(deltaSeconds); }
+
     //==============================================================================
     // Component overrides
 
@@ -358,15 +387,19 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
 
     AudioAnalyzer* audioAnalyzer = nullptr;
+    const MeterHub* meterHub = nullptr;
+    int meterHubIndex = 0;
     std::vector<float> history;
     WaveformStyle style;
 
     bool active = false;
     int historySize = 150;
     int updateRate = 50;
+    double pendingUpdateMs = 0.0;       // Frame time not yet turned into history entries
     float sensitivity = 1.0f;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LiveWaveformVisualizer)
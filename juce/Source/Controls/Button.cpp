@@ -10,31 +10,13 @@
 */
 
 #include "Button.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
 
-//==============================================================================
-/**
- * @brief Internal timer for button animations.
- */
-class Button::AnimationTimer : public juce::Timer
-{
-public:
-    AnimationTimer(Button& owner) : m_owner(owner) {}
-
-    void timerCallback() override
-    {
-        m_owner.animationTick();
-    }
-
-private:
-    Button& m_owner;
-};
-
 //==============================================================================
 Button::Button()
-    : m_animTimer(std::make_unique<AnimationTimer>(*this))
 {
     setWantsKeyboardFocus(true);
     setMouseCursor(juce::MouseCursor::PointingHandCursor);
@@ -104,6 +86,7 @@ void Button::setEnabled(bool enabled)
         }
         setMouseCursor(enabled ? juce::MouseCursor::PointingHandCursor
                                : juce::MouseCursor::NormalCursor);
+        startAnimation();
         repaint();
     }
 }
@@ -113,14 +96,7 @@ void Button::setLoading(bool loading)
     if (m_isLoading != loading)
     {
         m_isLoading = loading;
-        if (loading)
-        {
-            startAnimation();
-        }
-        else if (!m_isHovered && !m_isPressed)
-        {
-            stopAnimation();
-        }
+        startAnimation();
         repaint();
     }
 }
@@ -134,6 +110,8 @@ void Button::setTooltipText(const juce::String& tooltip)
 //==============================================================================
 void Button::paint(juce::Graphics& g)
 {
+    SHMUI_PROFILE_SCOPE("Button::paint");
+
     auto bounds = getLocalBounds().toFloat();
     const auto colors = getEffectiveColors();
     const float cornerRadius = getCornerRadiusForButton(m_size);
@@ -202,6 +180,8 @@ void Button::paintContent(juce::Graphics& g,
                           juce::Rectangle<float> bounds,
                           juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("Button::paintContent");
+
     // Base implementation does nothing - subclasses override
     juce::ignoreUnused(g, bounds, foregroundColor);
 }
@@ -227,10 +207,7 @@ void Button::mouseExit(const juce::MouseEvent& e)
     juce::ignoreUnused(e);
     m_isHovered = false;
     m_isPressed = false;
-    if (!m_isLoading && m_hoverOpacity < 0.01f && m_pressOpacity < 0.01f)
-    {
-        stopAnimation();
-    }
+    startAnimation();
 }
 
 void Button::mouseDown(const juce::MouseEvent& e)
@@ -255,6 +232,7 @@ void Button::mouseUp(const juce::MouseEvent& e)
     if (m_isPressed && m_isEnabled && !m_isLoading)
     {
         m_isPressed = false;
+        startAnimation();
 
         if (getLocalBounds().contains(e.getPosition()))
         {
@@ -275,10 +253,7 @@ void Button::focusLost(FocusChangeType cause)
 {
     juce::ignoreUnused(cause);
     m_hasFocus = false;
-    if (!m_isHovered && !m_isLoading)
-    {
-        stopAnimation();
-    }
+    startAnimation();
 }
 
 bool Button::keyPressed(const juce::KeyPress& key)
@@ -298,24 +273,23 @@ bool Button::keyPressed(const juce::KeyPress& key)
 //==============================================================================
 void Button::startAnimation()
 {
-    if (!m_animTimer->isTimerRunning())
-    {
-        m_lastAnimTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
-        m_animTimer->startTimerHz(60);
-    }
+    startFrames();
 }
 
 void Button::stopAnimation()
 {
-    m_animTimer->stopTimer();
+    stopFrames();
 }
 
-void Button::animationTick()
+bool Button::advanceFrame(double deltaSeconds)
 {
-    const double currentTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
-    const float deltaTime = static_cast<float>(currentTime - m_lastAnimTime);
-    m_lastAnimTime = currentTime;
+    SHMUI_PROFILE_SCOPE("Button::advanceFrame");
 
+    return animationTick(static_cast<float>(deltaSeconds));
+}
+
+bool Button::animationTick(float deltaTime)
+{
     bool needsRepaint = false;
     bool animationComplete = true;
 
@@ -359,8 +333,8 @@ void Button::animationTick()
     if (needsRepaint)
         repaint();
 
-    if (animationComplete && !m_isHovered && !m_hasFocus && !m_isLoading)
-        stopAnimation();
+    // Idle once every opacity has reached its target
+    return !animationComplete;
 }
 
 } // namespace shmui
@@ -19,6 +19,8 @@
 
 #include <JuceHeader.h>
 #include "ButtonStyles.h"
+#include "../Icons/IconCache.h"
+#include "../Utils/FrameClock.h"
 #include "../Utils/Interpolation.h"
 
 namespace shmui
@@ -31,7 +33,8 @@ namespace shmui
  * Provides:
  * - Style variants (Primary, Secondary, Ghost, Destructive, Success, Muted)
  * - Size variants (XSmall through XLarge)
- * - Smooth hover/press/focus animations
+ * - Smooth hover/press/focus animations on the shared FrameClock, only
+ *   while something is actually moving
  * - Keyboard navigation (Tab, Enter, Space)
  * - Theme-aware colors (light/dark mode)
  * - Tooltip support
@@ -40,7 +43,8 @@ namespace shmui
  * Subclasses: IconButton, TextButton, ToggleButton, ClipButton, etc.
  */
 class Button : public juce::Component,
-               public juce::SettableTooltipClient
+               public juce::SettableTooltipClient,
+               private FrameClockClient
 {
 public:
     //==============================================================================
@@ -117,6 +121,19 @@ public:
 
     /// @}
 
+    //==============================================================================
+    /// @name Testing
+    /// @{
+
+    /**
+     * @brief Run one frame of deltaSeconds without the FrameClock.
+     *
+     * For benchmarks and self-checks, which drive frames by hand.
+     */
+    void advanceFrameForTesting(double deltaSeconds) { advanceFrame(deltaSeconds); }
+
+    /// @}
+
     //==============================================================================
     // Component overrides
     void paint(juce::Graphics& g) override;
@@ -145,14 +162,21 @@ protected:
                               juce::Rectangle<float> bounds,
                               juce::Colour foregroundColor);
 
-    /** Start the animation timer. */
+    /** Start receiving animation frames (they stop by themselves once idle). */
     void startAnimation();
 
-    /** Stop the animation timer. */
+    /** Stop receiving animation frames. */
     void stopAnimation();
 
-    /** Called every animation frame. */
-    virtual void animationTick();
+    /**
+     * @brief Advance animations by one frame.
+     * @param deltaTime Seconds since the previous frame
+     * @return True while anything is still animating
+     */
+    virtual bool animationTick(float deltaTime);
+
+    /** Shared icon paths and atlas, for drawing icons in paintContent(). */
+    IconCache& getIconCache() { return *m_iconCache; }
 
     //==============================================================================
     // Animation state
@@ -163,8 +187,8 @@ protected:
 
 private:
     //==============================================================================
-    class AnimationTimer;
-    std::unique_ptr<AnimationTimer> m_animTimer;
+    bool advanceFrame(double deltaSeconds) override;
+    juce::Component* getFrameComponent() override { return this; }
 
     ButtonStyle m_style = ButtonStyle::Primary;
     ButtonSize m_size = ButtonSize::Medium;
@@ -177,8 +201,7 @@ private:
     bool m_hasCustomColors = false;
     ButtonColors m_customColors;
     juce::String m_tooltipText;
-
-    double m_lastAnimTime = 0.0;
+    juce::SharedResourcePointer<IconCache> m_iconCache;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Button)
 };
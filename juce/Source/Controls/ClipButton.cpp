@@ -10,6 +10,7 @@
 */
 
 #include "ClipButton.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -35,10 +36,9 @@ void ClipButton::setClipState(State newState)
 
         // Start playing pulse animation
         if (newState == State::Playing)
-        {
             m_playingPulse = 0.0f;
-            startAnimation();
-        }
+
+        startAnimation();
 
         repaint();
     }
@@ -146,6 +146,8 @@ void ClipButton::paintContent(juce::Graphics& g,
                               juce::Rectangle<float> bounds,
                               juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("ClipButton::paintContent");
+
     juce::ignoreUnused(foregroundColor);
 
     // Background based on state
@@ -218,23 +220,31 @@ void ClipButton::paintContent(juce::Graphics& g,
     }
 }
 
-void ClipButton::animationTick()
+bool ClipButton::animationTick(float deltaTime)
 {
-    Button::animationTick();
+    bool animating = Button::animationTick(deltaTime);
 
     // Pulse animation for playing state
     if (m_clipState == State::Playing)
     {
-        m_playingPulse = std::sin(juce::Time::getMillisecondCounterHiRes() / 1000.0 * juce::MathConstants<double>::twoPi * 0.5f) * 0.5f + 0.5f;
+        // 0.5 Hz; whole cycles are removed in double, so precision holds over long uptimes
+        const double cycles = juce::Time::getMillisecondCounterHiRes() / 1000.0 * 0.5;
+        m_playingPulse = Interpolation::fastSinCycles(static_cast<float>(cycles - std::floor(cycles))) * 0.5f + 0.5f;
         repaint();
+        animating = true;
     }
 
-    // State transition animation
+    // State transition animation; kTransitionStep is per 60 Hz frame, scaled to the real frame time
     if (m_stateTransition < 1.0f)
     {
-        m_stateTransition = Interpolation::smooth(m_stateTransition, 1.0f, Interpolation::kTransitionStep);
+        m_stateTransition = Interpolation::smoothDelta(m_stateTransition, 1.0f, Interpolation::kTransitionStep, deltaTime);
+        if (m_stateTransition > 0.999f)
+            m_stateTransition = 1.0f;
         repaint();
+        animating = true;
     }
+
+    return animating;
 }
 
 //==============================================================================
@@ -267,11 +277,10 @@ void ClipButton::drawClipHUD(juce::Graphics& g, juce::Rectangle<float> bounds)
     // Duration (bottom-right)
     if (m_durationSeconds > 0.0)
     {
-        g.setColour(juce::Colours::white.withAlpha(0.5f));
-        g.setFont(juce::Font(8.0f));
-        g.drawText(formatDuration(m_durationSeconds),
-                   bounds.reduced(PADDING),
-                   juce::Justification::bottomRight, false);
+        TimeText text;
+        TimeFormat::appendDuration(text, m_durationSeconds);
+        m_digitAtlas->drawText(g, text, bounds.reduced(PADDING), juce::Justification::bottomRight,
+                               juce::Colours::white.withAlpha(0.5f), 8.0f, false);
     }
 }
 
@@ -285,7 +294,7 @@ void ClipButton::drawStatusIcons(juce::Graphics& g, juce::Rectangle<float> bound
     if (m_loopEnabled)
     {
         auto iconBounds = juce::Rectangle<float>(iconX, iconY, ICON_SIZE, ICON_SIZE);
-        Icons::drawIcon(g, IconType::Loop, iconBounds, juce::Colours::white.withAlpha(0.6f));
+        getIconCache().drawIcon(g, IconType::Loop, iconBounds, juce::Colours::white.withAlpha(0.6f));
         iconX -= ICON_SIZE + 2;
     }
 
@@ -307,18 +316,4 @@ void ClipButton::drawProgressIndicator(juce::Graphics& g, juce::Rectangle<float>
     g.fillRect(progressBounds.removeFromLeft(progressBounds.getWidth() * m_playbackProgress));
 }
 
-juce::String ClipButton::formatDuration(double seconds) const
-{
-    if (seconds < 60.0)
-    {
-        return juce::String(seconds, 1) + "s";
-    }
-    else
-    {
-        int mins = static_cast<int>(seconds / 60.0);
-        int secs = static_cast<int>(std::fmod(seconds, 60.0));
-        return juce::String(mins) + ":" + juce::String(secs).paddedLeft('0', 2);
-    }
-}
-
 } // namespace shmui
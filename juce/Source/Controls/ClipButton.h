@@ -22,6 +22,7 @@
 
 #include "Button.h"
 #include "../Icons/Icons.h"
+#include "../Utils/DigitAtlas.h"
 #include "../Utils/Interpolation.h"
 
 namespace shmui
@@ -156,7 +157,7 @@ protected:
                       juce::Rectangle<float> bounds,
                       juce::Colour foregroundColor) override;
 
-    void animationTick() override;
+    bool animationTick(float deltaTime) override;
 
 private:
     //==============================================================================
@@ -165,7 +166,6 @@ private:
     void drawClipHUD(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawStatusIcons(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawProgressIndicator(juce::Graphics& g, juce::Rectangle<float> bounds);
-    juce::String formatDuration(double seconds) const;
 
     //==============================================================================
     int m_buttonIndex;
@@ -188,6 +188,9 @@ private:
     float m_stateTransition = 0.0f;
     float m_playingPulse = 0.0f;
 
+    // Duration glyphs
+    juce::SharedResourcePointer<DigitAtlas> m_digitAtlas;
+
     // Visual constants
     static constexpr int BORDER_THICKNESS = 2;
     static constexpr int CORNER_RADIUS = 4;
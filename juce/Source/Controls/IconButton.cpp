@@ -10,6 +10,7 @@
 */
 
 #include "IconButton.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -55,12 +56,14 @@ void IconButton::paintContent(juce::Graphics& g,
                               juce::Rectangle<float> bounds,
                               juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("IconButton::paintContent");
+
     const float iconSize = getIconSizeForButton(getButtonSize());
 
     // Center the icon in bounds
     auto iconBounds = bounds.withSizeKeepingCentre(iconSize, iconSize);
 
-    Icons::drawIcon(g, m_icon, iconBounds, foregroundColor, m_iconStrokeWidth);
+    getIconCache().drawIcon(g, m_icon, iconBounds, foregroundColor, m_iconStrokeWidth);
 }
 
 } // namespace shmui
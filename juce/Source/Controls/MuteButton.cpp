@@ -10,6 +10,7 @@
 */
 
 #include "MuteButton.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -52,6 +53,8 @@ void MuteButton::paintContent(juce::Graphics& g,
                               juce::Rectangle<float> bounds,
                               juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("MuteButton::paintContent");
+
     const float iconSize = getIconSizeForButton(getButtonSize());
 
     // Use active color when active
@@ -60,7 +63,7 @@ void MuteButton::paintContent(juce::Graphics& g,
     // Center the icon in bounds
     auto iconBounds = bounds.withSizeKeepingCentre(iconSize, iconSize);
 
-    Icons::drawIcon(g, getCurrentIcon(), iconBounds, iconColor);
+    getIconCache().drawIcon(g, getCurrentIcon(), iconBounds, iconColor);
 }
 
 void MuteButton::handleClick()
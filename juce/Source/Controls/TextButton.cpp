@@ -10,6 +10,7 @@
 */
 
 #include "TextButton.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -90,6 +91,8 @@ void TextButton::paintContent(juce::Graphics& g,
                               juce::Rectangle<float> bounds,
                               juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("TextButton::paintContent");
+
     const float fontSize = getFontHeightForButton(getButtonSize());
     const float iconSize = getIconSizeForButton(getButtonSize()) * 0.75f; // Slightly smaller icons for text buttons
     const float iconGap = 6.0f;
@@ -112,7 +115,7 @@ void TextButton::paintContent(juce::Graphics& g,
     if (m_hasLeadingIcon)
     {
         auto iconBounds = juce::Rectangle<float>(x, centerY - iconSize * 0.5f, iconSize, iconSize);
-        Icons::drawIcon(g, m_leadingIcon, iconBounds, foregroundColor);
+        getIconCache().drawIcon(g, m_leadingIcon, iconBounds, foregroundColor);
         x += iconSize + iconGap;
     }
 
@@ -128,7 +131,7 @@ void TextButton::paintContent(juce::Graphics& g,
     {
         x += iconGap;
         auto iconBounds = juce::Rectangle<float>(x, centerY - iconSize * 0.5f, iconSize, iconSize);
-        Icons::drawIcon(g, m_trailingIcon, iconBounds, foregroundColor);
+        getIconCache().drawIcon(g, m_trailingIcon, iconBounds, foregroundColor);
     }
 }
 
@@ -10,6 +10,7 @@
 */
 
 #include "ToggleButton.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -69,6 +70,8 @@ void ToggleButton::paintContent(juce::Graphics& g,
                                 juce::Rectangle<float> bounds,
                                 juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("ToggleButton::paintContent");
+
     const float iconSize = getIconSizeForButton(getButtonSize());
 
     // Use on color if toggled and custom color is set
@@ -82,7 +85,7 @@ void ToggleButton::paintContent(juce::Graphics& g,
     auto iconBounds = bounds.withSizeKeepingCentre(iconSize, iconSize);
 
     IconType currentIcon = m_isToggled ? m_iconOn : m_iconOff;
-    Icons::drawIcon(g, currentIcon, iconBounds, iconColor);
+    getIconCache().drawIcon(g, currentIcon, iconBounds, iconColor);
 }
 
 void ToggleButton::handleClick()
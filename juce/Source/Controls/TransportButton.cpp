@@ -10,6 +10,7 @@
 */
 
 #include "TransportButton.h"
+#include "../Utils/Profiling.h"
 
 namespace shmui
 {
@@ -89,6 +90,8 @@ void TransportButton::paintContent(juce::Graphics& g,
                                    juce::Rectangle<float> bounds,
                                    juce::Colour foregroundColor)
 {
+    SHMUI_PROFILE_SCOPE("TransportButton::paintContent");
+
     const float iconSize = getIconSizeForButton(getButtonSize());
 
     // Special color handling for active states
@@ -105,7 +108,7 @@ void TransportButton::paintContent(juce::Graphics& g,
     // Center the icon in bounds
     auto iconBounds = bounds.withSizeKeepingCentre(iconSize, iconSize);
 
-    Icons::drawIcon(g, getCurrentIcon(), iconBounds, iconColor);
+    getIconCache().drawIcon(g, getCurrentIcon(), iconBounds, iconColor);
 }
 
 IconType TransportButton::getCurrentIcon() const
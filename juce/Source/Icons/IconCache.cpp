@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    IconCache.cpp
+    Created: shmui Icon Library
+
+    Icon path cache and atlas implementation.
+
+  ==============================================================================
+*/
+
+#include "IconCache.h"
+#include <cmath>
+
+namespace shmui
+{
+
+namespace
+{
+    /** Gap between atlas cells so neighbours never bleed into each other. */
+    constexpr int kCellGutter = 1;
+
+    size_t indexOf(IconType type)
+    {
+        return static_cast<size_t>(type);
+    }
+
+    bool isValid(IconType type)
+    {
+        return type >= IconType::Play && type < IconType::NumIcons;
+    }
+}
+
+//==============================================================================
+IconCache::IconCache()
+{
+    for (size_t i = 0; i < m_paths.size(); ++i)
+    {
+        m_paths[i] = Icons::getIcon(static_cast<IconType>(i));
+        m_pathBounds[i] = m_paths[i].getBounds();
+    }
+}
+
+const juce::Path& IconCache::getPath(IconType type) const
+{
+    static const juce::Path empty;
+    return isValid(type) ? m_paths[indexOf(type)] : empty;
+}
+
+void IconCache::setAtlasEnabled(bool enabled)
+{
+    m_atlasEnabled = enabled;
+
+    if (!enabled)
+    {
+        clearAtlas();
+        m_atlas = {};
+    }
+}
+
+void IconCache::clearAtlas()
+{
+    m_masks.clear();
+    m_shelfX = 0;
+    m_shelfY = 0;
+    m_shelfHeight = 0;
+
+    if (m_atlas.isValid())
+        m_atlas.clear(m_atlas.getBounds());
+}
+
+//==============================================================================
+void IconCache::drawIcon(juce::Graphics& g,
+                         IconType type,
+                         juce::Rectangle<float> bounds,
+                         juce::Colour colour,
+                         float strokeWidth)
+{
+    if (!isValid(type) || m_paths[indexOf(type)].isEmpty())
+        return;
+
+    const float size = juce::jmin(bounds.getWidth(), bounds.getHeight());
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int pixelSize = juce::roundToInt(size * scale);
+
+    if (pixelSize <= 0)
+        return;
+
+    const juce::Image* mask = nullptr;
+    if (m_atlasEnabled && pixelSize <= kMaxAtlasPixels)
+        mask = findOrRasterize(type, pixelSize, strokeWidth * scale, scale);
+
+    if (mask == nullptr)
+    {
+        drawVector(g, type, bounds, colour, strokeWidth);
+        return;
+    }
+
+    // Centre the cell on the bounds, on whole physical pixels so the blit is 1:1
+    const float x = std::round(bounds.getCentreX() * scale - static_cast<float>(mask->getWidth()) * 0.5f);
+    const float y = std::round(bounds.getCentreY() * scale - static_cast<float>(mask->getHeight()) * 0.5f);
+
+    g.setColour(colour);
+    g.drawImageTransformed(*mask, juce::AffineTransform::translation(x, y).scaled(1.0f / scale), true);
+}
+
+void IconCache::drawVector(juce::Graphics& g, IconType type, juce::Rectangle<float> bounds,
+                           juce::Colour colour, float strokeWidth) const
+{
+    const auto& pathBounds = m_pathBounds[indexOf(type)];
+    const float k = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 24.0f;
+
+    // Scale from the 24x24 viewbox and centre the geometry in bounds
+    const auto transform = juce::AffineTransform::scale(k).translated(
+        bounds.getX() + (bounds.getWidth() - pathBounds.getWidth() * k) * 0.5f - pathBounds.getX() * k,
+        bounds.getY() + (bounds.getHeight() - pathBounds.getHeight() * k) * 0.5f - pathBounds.getY() * k);
+
+    g.setColour(colour);
+
+    if (strokeWidth > 0.0f)
+    {
+        g.strokePath(m_paths[indexOf(type)],
+                     juce::PathStrokeType(strokeWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded),
+                     transform);
+    }
+    else
+    {
+        g.fillPath(m_paths[indexOf(type)], transform);
+    }
+}
+
+//==============================================================================
+const juce::Image* IconCache::findOrRasterize(IconType type, int pixelSize, float strokePixels, float scale)
+{
+    const uint64_t key = makeKey(type, pixelSize, strokePixels, scale);
+
+    const auto found = m_masks.find(key);
+    if (found != m_masks.end())
+        return &found->second;
+
+    const auto& path = m_paths[indexOf(type)];
+    const auto& pathBounds = m_pathBounds[indexOf(type)];
+    const float k = static_cast<float>(pixelSize) / 24.0f;
+
+    // Geometry plus stroke, with a pixel either side for antialiasing
+    const int width = static_cast<int>(std::ceil(pathBounds.getWidth() * k + strokePixels)) + 2;
+    const int height = static_cast<int>(std::ceil(pathBounds.getHeight() * k + strokePixels)) + 2;
+
+    if (!m_atlas.isValid())
+        m_atlas = juce::Image(juce::Image::SingleChannel, kAtlasSize, kAtlasSize, true);
+
+    auto cell = allocate(width, height);
+    if (cell.isEmpty())
+    {
+        // Full: start over, the icons still in use come back on their next draw
+        clearAtlas();
+        cell = allocate(width, height);
+
+        if (cell.isEmpty())
+            return nullptr;
+    }
+
+    {
+        juce::Graphics atlasGraphics(m_atlas);
+        atlasGraphics.reduceClipRegion(cell);
+        atlasGraphics.setColour(juce::Colours::white);
+
+        const auto transform = juce::AffineTransform::scale(k).translated(
+            static_cast<float>(cell.getX()) + (static_cast<float>(width) - pathBounds.getWidth() * k) * 0.5f - pathBounds.getX() * k,
+            static_cast<float>(cell.getY()) + (static_cast<float>(height) - pathBounds.getHeight() * k) * 0.5f - pathBounds.getY() * k);
+
+        if (strokePixels > 0.0f)
+            atlasGraphics.strokePath(path,
+                                     juce::PathStrokeType(strokePixels, juce::PathStrokeType::curved, juce::PathStrokeType::rounded),
+                                     transform);
+        else
+            atlasGraphics.fillPath(path, transform);
+    }
+
+    return &(m_masks[key] = m_atlas.getClippedImage(cell));
+}
+
+juce::Rectangle<int> IconCache::allocate(int width, int height)
+{
+    if (width > kAtlasSize || height > kAtlasSize)
+        return {};
+
+    if (m_shelfX + width > kAtlasSize)
+    {
+        m_shelfY += m_shelfHeight;
+        m_shelfX = 0;
+        m_shelfHeight = 0;
+    }
+
+    if (m_shelfY + height > kAtlasSize)
+        return {};
+
+    const juce::Rectangle<int> cell(m_shelfX, m_shelfY, width, height);
+    m_shelfX += width + kCellGutter;
+    m_shelfHeight = juce::jmax(m_shelfHeight, height + kCellGutter);
+    return cell;
+}
+
+uint64_t IconCache::makeKey(IconType type, int pixelSize, float strokePixels, float scale)
+{
+    // Stroke to 1/8 pixel and scale to 1/100: closer variants share a mask
+    const auto strokeKey = static_cast<uint64_t>(juce::jlimit(0, 0xFFFF, juce::roundToInt(strokePixels * 8.0f)));
+    const auto scaleKey = static_cast<uint64_t>(juce::jlimit(0, 0xFFFF, juce::roundToInt(scale * 100.0f)));
+
+    return static_cast<uint64_t>(type)
+         | (static_cast<uint64_t>(pixelSize) << 8)
+         | (strokeKey << 20)
+         | (scaleKey << 36);
+}
+
+} // namespace shmui
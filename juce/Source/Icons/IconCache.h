@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    IconCache.h
+    Created: shmui Icon Library
+
+    Pre-built icon paths and a shared rasterized icon atlas.
+
+    Usage:
+      juce::SharedResourcePointer<shmui::IconCache> icons;
+      icons->drawIcon(g, shmui::IconType::Play, bounds, juce::Colours::white);
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Icons.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Shared icon path cache and alpha atlas.
+ *
+ * Every icon's 24x24 path is built once. Icons are drawn by rasterizing
+ * them, the first time they are needed, into one single-channel atlas
+ * image, keyed by icon type, pixel size, stroke width and display scale.
+ * After that every draw is a tinted blit of the alpha mask instead of a
+ * path rebuild, transform and vector fill.
+ *
+ * Rendering matches Icons::drawIcon(): the icon is scaled to the smaller
+ * side of the bounds and centred, but snapped to whole physical pixels.
+ * Icons bigger than kMaxAtlasPixels, and all icons while the atlas is
+ * disabled, are drawn as vectors from the cached paths. When the atlas
+ * is full it is cleared and refilled with the icons in use.
+ *
+ * Shared through juce::SharedResourcePointer; shmui::Button keeps one
+ * alive so the atlas persists while buttons exist. Message thread only.
+ */
+class IconCache
+{
+public:
+    //==============================================================================
+    /** Atlas edge length in pixels. */
+    static constexpr int kAtlasSize = 1024;
+
+    /** Largest icon (physical pixels) kept in the atlas. */
+    static constexpr int kMaxAtlasPixels = 128;
+
+    //==============================================================================
+    IconCache();
+    ~IconCache() = default;
+
+    /**
+     * @brief Get the pre-built path for an icon in the 24x24 viewbox.
+     */
+    const juce::Path& getPath(IconType type) const;
+
+    /**
+     * @brief Draw an icon (same parameters as Icons::drawIcon()).
+     */
+    void drawIcon(juce::Graphics& g,
+                  IconType type,
+                  juce::Rectangle<float> bounds,
+                  juce::Colour colour,
+                  float strokeWidth = 0.0f);
+
+    /**
+     * @brief Turn the atlas on or off (off draws every icon as a vector path).
+     */
+    void setAtlasEnabled(bool enabled);
+
+    /**
+     * @brief Check if icons are drawn from the atlas.
+     */
+    bool isAtlasEnabled() const { return m_atlasEnabled; }
+
+    /**
+     * @brief Number of icon variants currently rasterized.
+     */
+    int getNumCachedIcons() const { return static_cast<int>(m_masks.size()); }
+
+    /**
+     * @brief Drop all rasterized icons.
+     */
+    void clearAtlas();
+
+private:
+    //==============================================================================
+    const juce::Image* findOrRasterize(IconType type, int pixelSize, float strokePixels, float scale);
+    juce::Rectangle<int> allocate(int width, int height);
+    void drawVector(juce::Graphics& g, IconType type, juce::Rectangle<float> bounds,
+                    juce::Colour colour, float strokeWidth) const;
+
+    static uint64_t makeKey(IconType type, int pixelSize, float strokePixels, float scale);
+
+    //==============================================================================
+    std::array<juce::Path, static_cast<size_t>(IconType::NumIcons)> m_paths;
+    std::array<juce::Rectangle<float>, static_cast<size_t>(IconType::NumIcons)> m_pathBounds;
+
+    juce::Image m_atlas;
+    std::unordered_map<uint64_t, juce::Image> m_masks;             // Sub-images of the atlas
+    bool m_atlasEnabled = true;
+
+    // Shelf packing: rows of cells, filled left to right
+    int m_shelfX = 0;
+    int m_shelfY = 0;
+    int m_shelfHeight = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(IconCache)
+};
+
+} // namespace shmui
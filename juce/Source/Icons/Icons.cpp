@@ -11,6 +11,7 @@
 */
 
 #include "Icons.h"
+#include "IconCache.h"
 
 namespace shmui
 {
@@ -823,24 +824,9 @@ void drawIcon(juce::Graphics& g,
               juce::Colour colour,
               float strokeWidth)
 {
-    juce::Path path = getIcon(type, std::min(bounds.getWidth(), bounds.getHeight()));
-
-    // Center the path in bounds
-    auto pathBounds = path.getBounds();
-    float offsetX = bounds.getX() + (bounds.getWidth() - pathBounds.getWidth()) * 0.5f - pathBounds.getX();
-    float offsetY = bounds.getY() + (bounds.getHeight() - pathBounds.getHeight()) * 0.5f - pathBounds.getY();
-    path.applyTransform(juce::AffineTransform::translation(offsetX, offsetY));
-
-    g.setColour(colour);
-
-    if (strokeWidth > 0.0f)
-    {
-        g.strokePath(path, juce::PathStrokeType(strokeWidth, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
-    }
-    else
-    {
-        g.fillPath(path);
-    }
+    // Cached paths and atlas; stays alive while any shmui::Button holds it
+    const juce::SharedResourcePointer<IconCache> cache;
+    cache->drawIcon(g, type, bounds, colour, strokeWidth);
 }
 
 juce::String getIconName(IconType type)
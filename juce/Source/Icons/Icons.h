@@ -128,6 +128,10 @@ juce::Path getIcon(IconType type, float size = 24.0f);
 /**
  * @brief Draw an icon to a graphics context.
  *
+ * Drawn through the shared IconCache (a tinted blit from the icon atlas
+ * for typical sizes); components drawing many icons can hold a
+ * juce::SharedResourcePointer<IconCache> and call it directly.
+ *
  * @param g Graphics context to draw to
  * @param type Icon type to draw
  * @param bounds Bounding rectangle for the icon
@@ -10,19 +10,35 @@
     - Audio visualization components (waveform, spectrum, orb, matrix)
     - Button system with style variants (Primary, Secondary, Ghost, etc.)
     - Transport controls (play/pause/stop/record)
-    - Level meters (VU, PPM, Peak)
+    - Level meters (VU, PPM, Peak, True Peak)
     - Waveform editor with trim/fade
     - Icon library (Transport, Audio, Mixer, Files, Edit, UI, Arrows, Status)
 
     Components:
     - AudioAnalyzer: Core audio analysis (FFT, RMS, frequency bands)
+    - TruePeakDetector: ITU-R BS.1770 oversampled true-peak (dBTP)
+    - Ballistics: VU/PPM timing and its per-sample integrator (PeakIntegrator)
+    - LoudnessAnalyzer: EBU R128 loudness (momentary, short-term, integrated, LRA)
+    - MeterHub: Per-block peak/RMS/true-peak/clip snapshot for all tracks
+    - StereoSampleRing: Lock-free stereo audio ring for phase displays
+    - LevelLogger / LevelLogReader: Long-term peak/RMS/loudness log (min/max pyramid files)
+    - DynamicRangeAnalyzer: DR score, PLR and crest factor, live or over files
     - WaveformVisualizer: Multiple waveform display variants
     - WaveformEditor: Advanced waveform with trim/fade/seek
     - BarVisualizer: Frequency band display with state animations
     - OrbVisualizer: OpenGL shader-based 3D orb
+    - OrbSoftwareRenderer: Multithreaded CPU fallback for the orb shader
+    - OrbRenderService: One shared GL context for many orbs
+    - QuadRenderService: One shared GL context for bar, LED and meter quads
     - MatrixDisplay: LED-style matrix display with animations
-    - LevelMeter: Professional VU/PPM meter with peak hold
+    - LevelMeter: Professional VU/PPM/true-peak meter with peak hold and DR readout
+    - LoudnessMeter: EBU R128 LUFS meter with integrated/LRA readouts
+    - MeterBridge: Any-channel-count meter bridge with groups and labels
+    - CorrelationMeter: Stereo phase correlation meter
+    - Goniometer: Stereo vectorscope / Lissajous with persistence
+    - TimeReadout: Time display drawn from a shared digit atlas
     - TransportBar: Full transport control strip
+    - ProfilerOverlay: Live table of the slowest paint/frame/analyzer scopes
 
     Controls:
     - Button: Base button with style/size variants
@@ -35,6 +51,7 @@
 
     Icons:
     - shmui::Icons::getIcon() / shmui::Icons::drawIcon()
+    - IconCache: paths built once, icons blitted tinted from a shared atlas
     - Transport, Audio, Mixer, Files, Edit, UI, Arrows, Status categories
 
     Usage:
@@ -42,10 +59,16 @@
     2. Create visualization/control components
     3. Connect AudioAnalyzer to your audio source
     4. Use callbacks for user interaction
+    5. Define SHMUI_ENABLE_PROFILING=1 to time paint/frame/analyzer calls
+       (see Utils/Profiling.h and ProfilerOverlay)
 
     Threading:
     - AudioAnalyzer is thread-safe for audio/UI communication
+    - MeterHub publishes one snapshot per audio block for any number of readers
+    - LevelLogger writes on its own thread; the audio thread only queues records
     - UI components should be used on the message thread
+    - Animated components share one vblank-driven FrameClock instead of
+      a juce::Timer each, and pause while they cannot be seen
     - Use juce::MessageManager::callAsync for cross-thread updates
 
     Sync to Orpheus SDK:
@@ -59,10 +82,18 @@
 //==============================================================================
 // Icons
 #include "Icons/Icons.h"
+#include "Icons/IconCache.h"
 
 //==============================================================================
 // Core Audio
 #include "Audio/AudioAnalyzer.h"
+#include "Audio/TruePeakDetector.h"
+#include "Audio/Ballistics.h"
+#include "Audio/LoudnessAnalyzer.h"
+#include "Audio/MeterHub.h"
+#include "Audio/StereoSampleRing.h"
+#include "Audio/LevelLogger.h"
+#include "Audio/DynamicRangeAnalyzer.h"
 
 //==============================================================================
 // Controls (Button System)
@@ -80,18 +111,31 @@
 #include "Components/WaveformVisualizer.h"
 #include "Components/WaveformEditor.h"
 #include "Components/BarVisualizer.h"
+#include "Components/OrbSoftwareRenderer.h"
+#include "Components/OrbRenderService.h"
+#include "Components/QuadRenderService.h"
 #include "Components/OrbVisualizer.h"
 #include "Components/MatrixDisplay.h"
 #include "Components/LevelMeter.h"
+#include "Components/LoudnessMeter.h"
+#include "Components/MeterBridge.h"
+#include "Components/CorrelationMeter.h"
+#include "Components/Goniometer.h"
 #include "Components/AudioPlayerControls.h"
 #include "Components/ScrubBar.h"
+#include "Components/TimeReadout.h"
 #include "Components/TransportBar.h"
+#include "Components/ProfilerOverlay.h"
 
 //==============================================================================
 // Utilities
 #include "Utils/AgentState.h"
 #include "Utils/Interpolation.h"
 #include "Utils/ColorUtils.h"
+#include "Utils/FrameClock.h"
+#include "Utils/Profiling.h"
+#include "Utils/TimeFormat.h"
+#include "Utils/DigitAtlas.h"
 
 namespace shmui
 {
@@ -267,6 +267,126 @@ inline float invertLuminance(float luminance, bool inverted)
     return inverted ? (1.0f - luminance) : luminance;
 }
 
+//==============================================================================
+// Colour Lookup Tables
+
+/**
+ * @brief Colour ramp baked into a table, indexed by a normalized value.
+ *
+ * Visualizers that colour every bar, LED or pixel by a value build the
+ * table once (when their colours change) and then map values with a
+ * single load instead of evaluating colorRamp(), lerpColour() or
+ * withAlpha() per element. Entry i holds the ramp at i / (Size - 1);
+ * values are clamped to 0-1 and rounded to the nearest entry.
+ *
+ * Both the premultiplied pixel (for writing into ARGB images) and the
+ * unpremultiplied colour (for juce::Graphics) are stored. With 256
+ * entries an alpha ramp matches withAlpha() exactly.
+ *
+ * @tparam Size Number of entries (256 for 8-bit ramps, 1024 for smooth images)
+ */
+template <int Size = 256>
+class ColourLUT
+{
+public:
+    static_assert(Size >= 2, "A colour table needs at least two entries");
+
+    static constexpr int kSize = Size;
+
+    /**
+     * @brief Fill the table from any ramp function.
+     *
+     * @param colourAt Callable taking the position (0-1) and returning a juce::Colour
+     */
+    template <typename ColourFunction>
+    void build(ColourFunction&& colourAt)
+    {
+        for (int i = 0; i < Size; ++i)
+        {
+            const auto colour = colourAt(static_cast<float>(i) / (Size - 1));
+            colours[static_cast<size_t>(i)] = colour;
+            pixels[static_cast<size_t>(i)] = colour.getPixelARGB();
+        }
+    }
+
+    /** Fill the table with colorRamp() over four colours. */
+    void buildRamp(const juce::Colour& color1, const juce::Colour& color2,
+                   const juce::Colour& color3, const juce::Colour& color4)
+    {
+        build([&](float t) { return colorRamp(t, color1, color2, color3, color4); });
+    }
+
+    /** Fill the table with orbColorRamp() at a fixed opacity. */
+    void buildOrbRamp(const juce::Colour& primaryColor, const juce::Colour& secondaryColor, float opacity = 1.0f)
+    {
+        const float alpha = juce::jlimit(0.0f, 1.0f, opacity);
+        build([&](float t) { return orbColorRamp(t, primaryColor, secondaryColor).withAlpha(alpha); });
+    }
+
+    /** Fill the table from a gradient's colours between positions 0 and 1. */
+    void buildGradient(const juce::ColourGradient& gradient)
+    {
+        build([&](float t) { return gradient.getColourAtPosition(static_cast<double>(t)); });
+    }
+
+    /** Fill the table with lerpColour() between two colours. */
+    void buildLerp(const juce::Colour& from, const juce::Colour& to)
+    {
+        build([&](float t) { return lerpColour(from, to, t); });
+    }
+
+    /** Fill the table with a colour faded from transparent (0) to opaque (1). */
+    void buildAlphaRamp(const juce::Colour& colour)
+    {
+        build([&](float t) { return colour.withAlpha(t); });
+    }
+
+    /** Get the entry for a normalized value. */
+    static int getIndex(float value)
+    {
+        return static_cast<int>(juce::jlimit(0.0f, 1.0f, value) * (Size - 1) + 0.5f);
+    }
+
+    /** Get the unpremultiplied colour for a normalized value. */
+    juce::Colour getColour(float value) const { return colours[static_cast<size_t>(getIndex(value))]; }
+
+    /** Get the premultiplied pixel for a normalized value. */
+    juce::PixelARGB getPixel(float value) const { return pixels[static_cast<size_t>(getIndex(value))]; }
+
+    /**
+     * @brief Map a run of values to premultiplied pixels.
+     *
+     * Indices are computed in blocks with FloatVectorOperations, leaving
+     * one table load per pixel. Suited to spectrogram columns and image
+     * lines of an ARGB juce::Image (pixelStride 4).
+     *
+     * @param values Normalized values
+     * @param dest Output pixels
+     * @param numValues Number of values
+     */
+    void mapToPixels(const float* values, juce::PixelARGB* dest, int numValues) const
+    {
+        constexpr int kBlock = 256;
+        float scaled[kBlock];
+
+        for (int start = 0; start < numValues; start += kBlock)
+        {
+            const int n = std::min(kBlock, numValues - start);
+
+            juce::FloatVectorOperations::clip(scaled, values + start, 0.0f, 1.0f, n);
+            juce::FloatVectorOperations::multiply(scaled, static_cast<float>(Size - 1), n);
+            juce::FloatVectorOperations::add(scaled, 0.5f, n);
+
+            for (int i = 0; i < n; ++i)
+                dest[start + i] = pixels[static_cast<size_t>(scaled[i])];
+        }
+    }
+
+private:
+    std::array<juce::Colour, Size> colours{};
+    std::array<juce::PixelARGB, Size> pixels{};
+};
+
 } // namespace ColorUtils
 
 } // namespace shmui
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    DigitAtlas.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Digit atlas implementation.
+
+  ==============================================================================
+*/
+
+#include "DigitAtlas.h"
+#include <cmath>
+
+namespace shmui
+{
+
+namespace
+{
+    /** Transparent border around each rasterized glyph for antialiasing. */
+    constexpr int kGlyphPadding = 1;
+
+    juce::Font makeFont(float height, bool bold)
+    {
+        return juce::Font(height, bold ? juce::Font::bold : juce::Font::plain);
+    }
+}
+
+//==============================================================================
+int DigitAtlas::getGlyphIndex(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+
+    switch (c)
+    {
+        case ':':   return 10;
+        case '.':   return 11;
+        case '-':   return 12;
+        case '/':   return 13;
+        case ' ':   return 14;
+        case 's':   return 15;
+        default:    return -1;
+    }
+}
+
+//==============================================================================
+DigitAtlas::Face& DigitAtlas::getFace(float fontHeight, bool bold)
+{
+    // Heights to 1/8 pixel
+    const auto key = (static_cast<uint32_t>(juce::jlimit(0, 0x7FFFFF, juce::roundToInt(fontHeight * 8.0f))) << 1)
+                   | (bold ? 1u : 0u);
+
+    auto& face = m_faces[key];
+    if (face != nullptr)
+        return *face;
+
+    face = std::make_unique<Face>();
+    face->height = fontHeight;
+    face->bold = bold;
+
+    const auto font = makeFont(fontHeight, bold);
+    float digitAdvance = 0.0f;
+
+    for (int i = 0; i < kNumGlyphs; ++i)
+    {
+        face->advances[static_cast<size_t>(i)] = font.getStringWidthFloat(juce::String::charToString(kGlyphs[i]));
+
+        if (i < 10)
+            digitAdvance = juce::jmax(digitAdvance, face->advances[static_cast<size_t>(i)]);
+    }
+
+    // Tabular digits, so a running time never shifts
+    for (int i = 0; i < 10; ++i)
+        face->advances[static_cast<size_t>(i)] = digitAdvance;
+
+    return *face;
+}
+
+const std::array<juce::Image, DigitAtlas::kNumGlyphs>& DigitAtlas::getGlyphs(Face& face, float scale)
+{
+    const int scaleKey = juce::roundToInt(scale * 100.0f);
+
+    const auto found = face.glyphs.find(scaleKey);
+    if (found != face.glyphs.end())
+        return found->second;
+
+    auto& glyphs = face.glyphs[scaleKey];
+
+    // One strip per face and scale, each cell padded on every side
+    const int cellHeight = static_cast<int>(std::ceil(face.height * scale)) + kGlyphPadding * 2;
+    std::array<int, kNumGlyphs> cellWidths {};
+    int stripWidth = 0;
+
+    for (size_t i = 0; i < cellWidths.size(); ++i)
+    {
+        cellWidths[i] = static_cast<int>(std::ceil(face.advances[i] * scale)) + kGlyphPadding * 2;
+        stripWidth += cellWidths[i];
+    }
+
+    juce::Image strip(juce::Image::SingleChannel, stripWidth, cellHeight, true);
+
+    {
+        juce::Graphics stripGraphics(strip);
+        stripGraphics.setColour(juce::Colours::white);
+        stripGraphics.setFont(makeFont(face.height * scale, face.bold));
+
+        int x = 0;
+        for (size_t i = 0; i < cellWidths.size(); ++i)
+        {
+            const juce::Rectangle<int> cell(x, 0, cellWidths[i], cellHeight);
+            stripGraphics.drawText(juce::String::charToString(kGlyphs[i]),
+                                   cell.reduced(kGlyphPadding).toFloat(),
+                                   juce::Justification::centred, false);
+
+            glyphs[i] = strip.getClippedImage(cell);
+            x += cellWidths[i];
+        }
+    }
+
+    return glyphs;
+}
+
+//==============================================================================
+DigitLayout DigitAtlas::layout(const TimeText& text, juce::Rectangle<float> area,
+                               juce::Justification justification, float fontHeight, bool bold)
+{
+    DigitLayout result;
+    result.text = text;
+    result.fontHeight = fontHeight;
+    result.bold = bold;
+    result.height = fontHeight;
+
+    const auto& face = getFace(fontHeight, bold);
+    const float width = getTextWidth(text, fontHeight, bold);
+
+    const auto placed = justification.appliedToRectangle(juce::Rectangle<float>(width, fontHeight), area);
+    result.top = placed.getY();
+
+    float x = placed.getX();
+    for (int i = 0; i < text.length; ++i)
+    {
+        result.cellX[static_cast<size_t>(i)] = x;
+
+        const int glyph = getGlyphIndex(text.chars[i]);
+        x += glyph >= 0 ? face.advances[static_cast<size_t>(glyph)] : 0.0f;
+    }
+
+    result.cellX[static_cast<size_t>(text.length)] = x;
+    return result;
+}
+
+float DigitAtlas::getTextWidth(const TimeText& text, float fontHeight, bool bold)
+{
+    const auto& face = getFace(fontHeight, bold);
+
+    float width = 0.0f;
+    for (int i = 0; i < text.length; ++i)
+    {
+        const int glyph = getGlyphIndex(text.chars[i]);
+        width += glyph >= 0 ? face.advances[static_cast<size_t>(glyph)] : 0.0f;
+    }
+
+    return width;
+}
+
+void DigitAtlas::draw(juce::Graphics& g, const DigitLayout& layout, juce::Colour colour)
+{
+    if (layout.text.length == 0 || layout.fontHeight <= 0.0f)
+        return;
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto& face = getFace(layout.fontHeight, layout.bold);
+    const auto& glyphs = getGlyphs(face, scale);
+    const auto clip = g.getClipBounds().toFloat();
+
+    g.setColour(colour);
+
+    for (int i = 0; i < layout.text.length; ++i)
+    {
+        const int glyph = getGlyphIndex(layout.text.chars[i]);
+        if (glyph < 0 || glyph == getGlyphIndex(' '))
+            continue;
+
+        const auto cell = layout.getCell(i);
+        if (!clip.intersects(cell.expanded(1.0f)))
+            continue;
+
+        const auto& image = glyphs[static_cast<size_t>(glyph)];
+
+        // Centre the glyph on its cell, on whole physical pixels so the blit is 1:1
+        const float x = std::round(cell.getCentreX() * scale - static_cast<float>(image.getWidth()) * 0.5f);
+        const float y = std::round(cell.getCentreY() * scale - static_cast<float>(image.getHeight()) * 0.5f);
+
+        g.drawImageTransformed(image, juce::AffineTransform::translation(x, y).scaled(1.0f / scale), true);
+    }
+}
+
+void DigitAtlas::drawText(juce::Graphics& g, const TimeText& text, juce::Rectangle<float> area,
+                          juce::Justification justification, juce::Colour colour, float fontHeight, bool bold)
+{
+    draw(g, layout(text, area, justification, fontHeight, bold), colour);
+}
+
+//==============================================================================
+juce::Rectangle<int> DigitAtlas::getChangedArea(const DigitLayout& before, const DigitLayout& after)
+{
+    const bool sameFont = before.top == after.top && before.height == after.height
+                       && before.fontHeight == after.fontHeight && before.bold == after.bold;
+
+    juce::Rectangle<float> changed;
+
+    auto add = [&changed](juce::Rectangle<float> cell)
+    {
+        changed = changed.isEmpty() ? cell : changed.getUnion(cell);
+    };
+
+    const int numCells = juce::jmax(before.text.length, after.text.length);
+
+    for (int i = 0; i < numCells; ++i)
+    {
+        const bool inBefore = i < before.text.length;
+        const bool inAfter = i < after.text.length;
+
+        if (sameFont && inBefore && inAfter
+            && before.text.chars[i] == after.text.chars[i]
+            && before.getCell(i) == after.getCell(i))
+            continue;
+
+        if (inBefore)
+            add(before.getCell(i));
+        if (inAfter)
+            add(after.getCell(i));
+    }
+
+    if (changed.isEmpty())
+        return {};
+
+    // A pixel either side for antialiased edges
+    return changed.getSmallestIntegerContainer().expanded(1);
+}
+
+} // namespace shmui
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    DigitAtlas.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Pre-rasterized glyphs for time readouts.
+
+    Usage:
+      juce::SharedResourcePointer<shmui::DigitAtlas> digits;
+      shmui::TimeText text;
+      shmui::TimeFormat::appendClock(text, seconds);
+      digits->drawText(g, text, bounds, juce::Justification::centred,
+                       juce::Colours::white, 14.0f, false);
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TimeFormat.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Where each character of a TimeText sits in a component.
+ *
+ * Character i covers cellX[i] to cellX[i + 1] horizontally and
+ * top to top + height vertically.
+ */
+struct DigitLayout
+{
+    TimeText text;
+    std::array<float, TimeText::kMaxChars + 1> cellX {};
+    float top = 0.0f;
+    float height = 0.0f;
+    float fontHeight = 0.0f;
+    bool bold = false;
+
+    /** Bounds of character i. */
+    juce::Rectangle<float> getCell(int index) const
+    {
+        return { cellX[static_cast<size_t>(index)], top,
+                 cellX[static_cast<size_t>(index + 1)] - cellX[static_cast<size_t>(index)], height };
+    }
+};
+
+//==============================================================================
+/**
+ * @brief Shared alpha atlas of the characters used by time readouts.
+ *
+ * For each font height, weight and display scale the glyphs in kGlyphs
+ * are rasterized once into one single-channel strip image. Drawing a
+ * time is then a tinted blit per character, with no string, glyph
+ * arrangement or path work per frame.
+ *
+ * Digits all get the advance of the widest digit, so a running clock
+ * keeps its characters in place and only the cells whose character
+ * changed have to be repainted (see getChangedArea()). Characters that
+ * are not in kGlyphs take no space and are not drawn.
+ *
+ * Shared through juce::SharedResourcePointer. Message thread only.
+ */
+class DigitAtlas
+{
+public:
+    //==============================================================================
+    /** Every character the atlas can draw. */
+    static constexpr const char* kGlyphs = "0123456789:.-/ s";
+    static constexpr int kNumGlyphs = 16;
+
+    //==============================================================================
+    DigitAtlas() = default;
+    ~DigitAtlas() = default;
+
+    /**
+     * @brief Place text in an area.
+     *
+     * @param text Characters to place
+     * @param area Area to justify the text in
+     * @param justification How to justify it
+     * @param fontHeight Font height in logical pixels
+     * @param bold Bold weight
+     */
+    DigitLayout layout(const TimeText& text, juce::Rectangle<float> area, juce::Justification justification,
+                       float fontHeight, bool bold);
+
+    /**
+     * @brief Width of text in logical pixels.
+     */
+    float getTextWidth(const TimeText& text, float fontHeight, bool bold);
+
+    /**
+     * @brief Draw laid out text in one colour.
+     *
+     * Cells outside the graphics clip region are skipped.
+     */
+    void draw(juce::Graphics& g, const DigitLayout& layout, juce::Colour colour);
+
+    /**
+     * @brief Lay out and draw text in one call.
+     */
+    void drawText(juce::Graphics& g, const TimeText& text, juce::Rectangle<float> area,
+                  juce::Justification justification, juce::Colour colour, float fontHeight, bool bold);
+
+    /**
+     * @brief Area that must be repainted to go from one layout to another.
+     *
+     * The union of every cell whose character or position differs,
+     * padded for antialiasing. Empty when nothing changed.
+     */
+    static juce::Rectangle<int> getChangedArea(const DigitLayout& before, const DigitLayout& after);
+
+    /**
+     * @brief Index of a character in kGlyphs, or -1.
+     */
+    static int getGlyphIndex(char c);
+
+    /**
+     * @brief Drop all rasterized glyphs.
+     */
+    void clear() { m_faces.clear(); }
+
+private:
+    //==============================================================================
+    struct Face
+    {
+        float height = 0.0f;
+        bool bold = false;
+        std::array<float, kNumGlyphs> advances {};                   // Logical pixels
+        std::unordered_map<int, std::array<juce::Image, kNumGlyphs>> glyphs;   // By scale * 100
+    };
+
+    Face& getFace(float fontHeight, bool bold);
+    const std::array<juce::Image, kNumGlyphs>& getGlyphs(Face& face, float scale);
+
+    //==============================================================================
+    std::unordered_map<uint32_t, std::unique_ptr<Face>> m_faces;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DigitAtlas)
+};
+
+} // namespace shmui
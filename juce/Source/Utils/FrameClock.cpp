@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    FrameClock.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Shared frame clock implementation.
+
+  ==============================================================================
+*/
+
+#include "FrameClock.h"
+#include "Profiling.h"
+#include <algorithm>
+
+namespace shmui
+{
+
+namespace
+{
+    /** Longest vblank gap before the fallback timer starts ticking. */
+    constexpr double kVBlankTimeoutMs = 1.5 * 1000.0 / FrameClock::kFallbackHz;
+}
+
+//==============================================================================
+FrameClockClient::FrameClockClient() = default;
+
+FrameClockClient::~FrameClockClient()
+{
+    stopFrames();
+}
+
+void FrameClockClient::startFrames()
+{
+    if (m_receivingFrames)
+        return;
+
+    m_receivingFrames = true;
+    m_lastFrameMs = juce::Time::getMillisecondCounterHiRes();
+    m_clock->addClient(*this);
+}
+
+void FrameClockClient::stopFrames()
+{
+    if (!m_receivingFrames)
+        return;
+
+    m_receivingFrames = false;
+    m_clock->removeClient(*this);
+}
+
+void FrameClockClient::setMaxFrameRate(double framesPerSecond)
+{
+    m_minIntervalMs = framesPerSecond > 0.0 ? 1000.0 / framesPerSecond : 0.0;
+}
+
+//==============================================================================
+FrameClock::FrameClock() = default;
+
+FrameClock::~FrameClock()
+{
+    stopTimer();
+}
+
+bool FrameClock::isVBlankDriven() const
+{
+    return m_vblank != nullptr
+        && juce::Time::getMillisecondCounterHiRes() - m_lastVBlankMs < kVBlankTimeoutMs;
+}
+
+FrameClock::Stats FrameClock::getStats() const
+{
+    Stats stats;
+    stats.numRunning = m_numRunning;
+    stats.numSuspended = m_numSuspended;
+    stats.numFrames = m_numFrames;
+    stats.vblankDriven = isVBlankDriven();
+    return stats;
+}
+
+bool FrameClock::isComponentVisible(const juce::Component& component)
+{
+    // isShowing() covers hidden parents and minimised windows
+    if (!component.isShowing() || component.getWidth() <= 0 || component.getHeight() <= 0)
+        return false;
+
+    return !getVisibleArea(component, component).isEmpty();
+}
+
+juce::Rectangle<int> FrameClock::getVisibleArea(const juce::Component& component, const juce::Component& target)
+{
+    // Clip the bounds by every parent in turn (scrolled out of a viewport, collapsed panel)
+    auto visible = component.getLocalBounds();
+    const juce::Component* child = &component;
+
+    for (auto* parent = component.getParentComponent(); parent != nullptr; parent = parent->getParentComponent())
+    {
+        visible = parent->getLocalArea(child, visible).getIntersection(parent->getLocalBounds());
+        if (visible.isEmpty())
+            return {};
+
+        child = parent;
+    }
+
+    return target.getLocalArea(child, visible);
+}
+
+void FrameClock::addClient(FrameClockClient& client)
+{
+    m_clients.push_back(&client);
+    ++m_numActive;
+
+    if (m_timerHz == 0)
+        m_lastTickMs = juce::Time::getMillisecondCounterHiRes();
+
+    setTimerRate(kFallbackHz);
+    updateVBlankSource();
+}
+
+void FrameClock::removeClient(FrameClockClient& client)
+{
+    const auto it = std::find(m_clients.begin(), m_clients.end(), &client);
+    if (it == m_clients.end())
+        return;
+
+    // The client list is being walked by tick(); compact it afterwards
+    if (m_ticking)
+        *it = nullptr;
+    else
+        m_clients.erase(it);
+
+    --m_numActive;
+
+    if (&client == m_vblankClient)
+    {
+        m_vblankClient = nullptr;
+        m_vblankComponent = nullptr;
+
+        // Not from inside the vblank callback; updateVBlankSource() drops it later
+        if (!m_ticking)
+            m_vblank.reset();
+    }
+
+    if (m_numActive == 0)
+    {
+        setTimerRate(0);
+        m_numRunning = 0;
+        m_numSuspended = 0;
+    }
+}
+
+void FrameClock::setTimerRate(int hz)
+{
+    if (hz == m_timerHz)
+        return;
+
+    m_timerHz = hz;
+
+    if (hz > 0)
+        startTimerHz(hz);
+    else
+        stopTimer();
+}
+
+//==============================================================================
+void FrameClock::timerCallback()
+{
+    // Frames are coming from the display
+    if (m_vblank != nullptr && juce::Time::getMillisecondCounterHiRes() - m_lastVBlankMs < kVBlankTimeoutMs)
+        return;
+
+    updateVBlankSource();
+    tick();
+}
+
+void FrameClock::updateVBlankSource()
+{
+    if (m_ticking || (m_vblankComponent != nullptr && isComponentVisible(*m_vblankComponent)))
+        return;
+
+    m_vblank.reset();
+    m_vblankClient = nullptr;
+    m_vblankComponent = nullptr;
+
+    // Any client on screen will do: all clients are ticked from its vblank
+    for (auto* client : m_clients)
+    {
+        auto* component = client->getFrameComponent();
+
+        if (component != nullptr && isComponentVisible(*component))
+        {
+            m_vblankClient = client;
+            m_vblankComponent = component;
+            m_vblank = std::make_unique<juce::VBlankAttachment>(component, [this]
+            {
+                m_lastVBlankMs = juce::Time::getMillisecondCounterHiRes();
+                tick();
+            });
+            return;
+        }
+    }
+}
+
+void FrameClock::tick()
+{
+    SHMUI_PROFILE_SCOPE("FrameClock::tick");
+
+    if (m_ticking || m_numActive == 0)
+        return;
+
+    // A client may delete the last other client (and so the clock) while ticking
+    const juce::SharedResourcePointer<FrameClock> keepAlive;
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double frameMs = nowMs - m_lastTickMs;
+    m_lastTickMs = nowMs;
+
+    m_ticking = true;
+    ++m_numFrames;
+
+    int numRunning = 0;
+    int numSuspended = 0;
+
+    // Clients started during this tick get their first frame next time
+    const size_t count = m_clients.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto* client = m_clients[i];
+        if (client == nullptr)
+            continue;
+
+        // Skipped without touching m_lastFrameMs, so the first frame back
+        // covers the whole time the client was out of sight
+        if (!client->m_runsWhenHidden)
+        {
+            const auto* component = client->getFrameComponent();
+            client->m_suspended = component != nullptr && !isComponentVisible(*component);
+
+            if (client->m_suspended)
+            {
+                ++numSuspended;
+                continue;
+            }
+        }
+
+        ++numRunning;
+
+        // Half a frame of slack keeps a 30 Hz client in step with a 60 Hz display
+        const double elapsedMs = nowMs - client->m_lastFrameMs;
+        if (elapsedMs + frameMs * 0.5 < client->m_minIntervalMs)
+            continue;
+
+        client->m_lastFrameMs = nowMs;
+
+        if (!client->advanceFrame(elapsedMs * 0.001))
+            client->stopFrames();
+    }
+
+    m_ticking = false;
+    m_clients.erase(std::remove(m_clients.begin(), m_clients.end(), nullptr), m_clients.end());
+
+    m_numRunning = numRunning;
+    m_numSuspended = numSuspended;
+
+    // Only watch for a client to show again while everything is out of sight
+    if (m_numActive > 0)
+        setTimerRate(numRunning > 0 ? kFallbackHz : kSuspendedHz);
+}
+
+} // namespace shmui
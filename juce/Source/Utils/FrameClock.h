@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+    FrameClock.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    One display-synchronised frame clock for every animated shmui
+    component, in place of a juce::Timer per component. Components that
+    cannot be seen are suspended until they show again.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+namespace shmui
+{
+
+class FrameClock;
+
+//==============================================================================
+/**
+ * @brief Base for anything animated by the shared FrameClock.
+ *
+ * Call startFrames() when there is something to animate; advanceFrame()
+ * is then called once per display refresh with the real time since the
+ * previous call. Return false from advanceFrame() when idle to drop out
+ * of the clock until startFrames() is called again. Destroying the client
+ * unsubscribes it.
+ *
+ * A client that draws into a component (see getFrameComponent()) is
+ * suspended while that component cannot be seen: not showing (hidden, in a closed tab, minimised window), zero
+ * size, or clipped away entirely by its parents. It gets no frames, so
+ * no animation or analyzer polling runs; the first frame after it shows
+ * again carries the whole suspended time in deltaSeconds, so time-based
+ * state fast-forwards instead of resuming where it stopped.
+ *
+ * Message thread only.
+ */
+class FrameClockClient
+{
+public:
+    //==============================================================================
+    FrameClockClient();
+    virtual ~FrameClockClient();
+
+    /**
+     * @brief Advance one frame.
+     *
+     * @param deltaSeconds Real time since this client's previous frame
+     *                     (or since startFrames() for the first one)
+     * @return False to stop receiving frames
+     */
+    virtual bool advanceFrame(double deltaSeconds) = 0;
+
+    /**
+     * @brief Get the component this client animates.
+     *
+     * The clock suspends the client while this component cannot be seen
+     * and may take its frames from this component's vblank. Clients
+     * usually inherit this class privately, so the clock cannot find the
+     * component by casting. Return nullptr for clients that draw nothing;
+     * they get every frame.
+     */
+    virtual juce::Component* getFrameComponent() = 0;
+
+    /**
+     * @brief Start receiving frames (no-op if already running).
+     */
+    void startFrames();
+
+    /**
+     * @brief Stop receiving frames.
+     */
+    void stopFrames();
+
+    /**
+     * @brief Check if the client is receiving frames.
+     */
+    bool isReceivingFrames() const { return m_receivingFrames; }
+
+    /**
+     * @brief Limit this client to a maximum frame rate (0 = every display frame).
+     *
+     * Frames in between are skipped; deltaSeconds covers the skipped time.
+     */
+    void setMaxFrameRate(double framesPerSecond);
+
+    /**
+     * @brief Keep receiving frames while not visible (default false).
+     *
+     * For clients that record over time, such as a level history.
+     */
+    void setRunsWhenHidden(bool shouldRun) { m_runsWhenHidden = shouldRun; }
+
+    /**
+     * @brief Check if frames are paused because the component cannot be seen.
+     */
+    bool isFrameSuspended() const { return m_suspended; }
+
+private:
+    friend class FrameClock;
+
+    juce::SharedResourcePointer<FrameClock> m_clock;
+    double m_lastFrameMs = 0.0;
+    double m_minIntervalMs = 0.0;
+    bool m_receivingFrames = false;
+    bool m_runsWhenHidden = false;
+    bool m_suspended = false;
+
+    JUCE_DECLARE_NON_COPYABLE(FrameClockClient)
+};
+
+//==============================================================================
+/**
+ * @brief Shared frame scheduler.
+ *
+ * Ticks every running FrameClockClient once per frame, in one message
+ * callback, with a delta time measured on the high-resolution counter.
+ * Frames come from a juce::VBlankAttachment on a showing client's
+ * frame component, so animation is locked to the display refresh; while no
+ * client is on screen (or the platform gives no vblank) a fallback timer
+ * at kFallbackHz takes over. Because all clients are advanced in the same
+ * callback, their repaint() calls are coalesced into one paint pass per
+ * window instead of one per component timer at unrelated phases.
+ *
+ * Before each client's frame the clock checks that the client can be
+ * seen (see FrameClockClient); while every client is suspended the
+ * fallback timer slows to kSuspendedHz, just fast enough to notice one
+ * showing again.
+ *
+ * The clock is a juce::SharedResourcePointer owned by its clients: it is
+ * created with the first client and deleted with the last. Nothing runs
+ * while no client is receiving frames. To profile, hold a
+ * juce::SharedResourcePointer<FrameClock> and read getStats().
+ */
+class FrameClock : private juce::Timer
+{
+public:
+    //==============================================================================
+    /** Timer rate used while no vblank source is available. */
+    static constexpr int kFallbackHz = 60;
+
+    /** Timer rate while every client is suspended. */
+    static constexpr int kSuspendedHz = 10;
+
+    /** Client counts as of the last frame. */
+    struct Stats
+    {
+        int numRunning = 0;          ///< Clients ticked (or waiting for their frame rate)
+        int numSuspended = 0;        ///< Clients paused because they cannot be seen
+        uint64_t numFrames = 0;      ///< Frames since the clock was created
+        bool vblankDriven = false;   ///< Frames come from the display refresh
+    };
+
+    //==============================================================================
+    FrameClock();
+    ~FrameClock() override;
+
+    /**
+     * @brief Number of clients receiving frames (running or suspended).
+     */
+    int getNumActiveClients() const { return m_numActive; }
+
+    /**
+     * @brief Running and suspended client counts.
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Check if frames currently come from the display vblank.
+     */
+    bool isVBlankDriven() const;
+
+    /**
+     * @brief Check if a component can currently be seen.
+     *
+     * False if it is not showing, has no area, or lies entirely outside
+     * one of its parents' bounds.
+     */
+    static bool isComponentVisible(const juce::Component& component);
+
+    /**
+     * @brief Get the part of a component not clipped away by its parents.
+     *
+     * The component's bounds, cut down by each parent in turn, in the
+     * coordinates of target (any component in the same hierarchy). Empty
+     * if nothing of it lies inside its parents. Does not check isShowing().
+     */
+    static juce::Rectangle<int> getVisibleArea(const juce::Component& component, const juce::Component& target);
+
+    //==============================================================================
+    /**
+     * @brief Run the timer callback once, as if the fallback timer fired.
+     *
+     * For self-checks, which run without a message loop. Ticks the clients
+     * unless vblank frames are arriving.
+     */
+    void tickForTesting() { timerCallback(); }
+
+private:
+    friend class FrameClockClient;
+
+    //==============================================================================
+    void addClient(FrameClockClient& client);
+    void removeClient(FrameClockClient& client);
+    void tick();
+    void timerCallback() override;
+    void updateVBlankSource();
+    void setTimerRate(int hz);
+
+    //==============================================================================
+    std::vector<FrameClockClient*> m_clients;                   // nullptr entries are removed after a tick
+    int m_numActive = 0;
+    bool m_ticking = false;
+    int m_timerHz = 0;
+
+    // Stats from the last frame
+    int m_numRunning = 0;
+    int m_numSuspended = 0;
+    uint64_t m_numFrames = 0;
+
+    // Vblank source: one showing client component drives the clock
+    FrameClockClient* m_vblankClient = nullptr;
+    juce::Component* m_vblankComponent = nullptr;
+    std::unique_ptr<juce::VBlankAttachment> m_vblank;
+    double m_lastVBlankMs = 0.0;
+    double m_lastTickMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameClock)
+};
+
+} // namespace shmui
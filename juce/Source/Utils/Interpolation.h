@@ -13,7 +13,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace shmui
 {
@@ -156,6 +159,86 @@ inline float smootherstep(float edge0, float edge1, float x)
     return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
 }
 
+//==============================================================================
+// Batch Smoothing and Easing
+//
+// Array versions of the helpers above for components that animate many
+// values at once (spectrum bins, meter channels). Each is one plain loop
+// without branches, which the compiler vectorizes; the arrays may alias
+// (current == target is allowed).
+
+/**
+ * @brief Smooth every value toward its target with a shared factor.
+ *
+ * current[i] += (target[i] - current[i]) * factor
+ */
+inline void smooth(float* current, const float* target, float factor, int numValues)
+{
+    for (int i = 0; i < numValues; ++i)
+        current[i] += (target[i] - current[i]) * factor;
+}
+
+/**
+ * @brief Smooth every value toward its target with its own factor.
+ */
+inline void smooth(float* current, const float* target, const float* factors, int numValues)
+{
+    for (int i = 0; i < numValues; ++i)
+        current[i] += (target[i] - current[i]) * factors[i];
+}
+
+/**
+ * @brief Frame-rate independent smoothing of every value (see the scalar smoothDelta()).
+ */
+inline void smoothDelta(float* current, const float* target, float factor,
+                        float deltaTime, int numValues, float targetFps = 60.0f)
+{
+    const float adjustedFactor = 1.0f - std::pow(1.0f - factor, deltaTime * targetFps);
+    smooth(current, target, adjustedFactor, numValues);
+}
+
+/**
+ * @brief Smooth with separate factors for rising and falling values.
+ *
+ * Meter-style ballistics: values move toward a higher target with the
+ * attack factor and toward a lower one with the release factor.
+ */
+inline void smoothAttackRelease(float* current, const float* target,
+                                float attack, float release, int numValues)
+{
+    for (int i = 0; i < numValues; ++i)
+    {
+        const float delta = target[i] - current[i];
+        current[i] += delta * (delta > 0.0f ? attack : release);
+    }
+}
+
+/**
+ * @brief Interpolate two arrays with a shared factor: dest[i] = lerp(a[i], b[i], t).
+ */
+inline void lerp(float* dest, const float* a, const float* b, float t, int numValues)
+{
+    for (int i = 0; i < numValues; ++i)
+        dest[i] = a[i] + (b[i] - a[i]) * t;
+}
+
+/**
+ * @brief Apply an easing function to every value in place.
+ *
+ * Single-expression easings vectorize; the in-out ones (and other
+ * functions with two branches) only do on GCC with -fno-trapping-math.
+ *
+ * @param values Progress values (0-1)
+ * @param numValues Number of values
+ * @param easing Any of the easing functions above, or a callable float(float)
+ */
+template <typename EasingFunction>
+inline void ease(float* values, int numValues, EasingFunction&& easing)
+{
+    for (int i = 0; i < numValues; ++i)
+        values[i] = easing(values[i]);
+}
+
 //==============================================================================
 // Clamping Utilities
 
@@ -209,6 +292,164 @@ inline float cosineWave(float time, float frequency, float amplitude = 1.0f, flo
     return std::cos(time * frequency) * amplitude + offset;
 }
 
+//==============================================================================
+// Fast Math
+//
+// Approximations for per-element visual work (band levels, spectrogram
+// cells, animation phases). Each is branch-free apart from selects, so
+// loops over arrays auto-vectorize. Error bounds are measured over the
+// stated range against double-precision references.
+// Not for audio processing or for anything that is measured and reported.
+
+namespace FastMathDetail
+{
+    inline uint32_t floatToBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline float bitsToFloat(uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+/**
+ * @brief Fast base-2 logarithm.
+ *
+ * Exponent from the float bits plus a degree-5 minimax polynomial on the
+ * mantissa. Absolute error below 2e-5 for positive normal x.
+ * 0 and denormals return about -127; negative x is undefined.
+ */
+inline float fastLog2(float x)
+{
+    const uint32_t bits = FastMathDetail::floatToBits(x);
+    const float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    const float m = FastMathDetail::bitsToFloat((bits & 0x007FFFFFu) | 0x3F800000u) - 1.0f;
+
+    return exponent + m * (1.4419658f + m * (-0.70966476f + m * (0.41760310f
+                         + m * (-0.19628001f + m * 0.046390274f))));
+}
+
+/**
+ * @brief Fast base-10 logarithm (absolute error below 1e-5, see fastLog2).
+ */
+inline float fastLog10(float x)
+{
+    return fastLog2(x) * 0.30102999566f;
+}
+
+/**
+ * @brief Fast linear gain to decibels, 20 * log10(gain).
+ *
+ * Absolute error below 2e-4 dB for positive normal gains. 0 returns
+ * about -765 dB, so callers that clamp to a floor need no zero check.
+ */
+inline float fastGainToDb(float gain)
+{
+    return fastLog2(gain) * 6.0205999133f;
+}
+
+/**
+ * @brief Convert a run of linear gains to decibels with fastGainToDb().
+ */
+inline void fastGainToDb(const float* gains, float* dest, int numValues)
+{
+    for (int i = 0; i < numValues; ++i)
+        dest[i] = fastGainToDb(gains[i]);
+}
+
+/**
+ * @brief Fast 2^x.
+ *
+ * Degree-5 minimax polynomial on the fraction, scaled through the
+ * exponent bits. Relative error below 2e-7; x is clamped to -126..127.
+ * Loops vectorize where std::floor() does (SSE4.1 / NEON; GCC also
+ * needs -fno-trapping-math). A single call is no faster than a current
+ * libm expf(), so only use it in loops over arrays.
+ */
+inline float fastExp2(float x)
+{
+    x = std::min(127.0f, std::max(-126.0f, x));
+
+    const float whole = std::floor(x);
+    const float f = x - whole;
+    const float scale = FastMathDetail::bitsToFloat(static_cast<uint32_t>(static_cast<int32_t>(whole) + 127) << 23);
+
+    return scale * (1.0f + f * (0.69315131f + f * (0.24016447f + f * (0.055799834f
+                              + f * (0.0090171426f + f * 0.0018670768f)))));
+}
+
+/**
+ * @brief Fast e^x (relative error below 5e-6 for |x| < 80, see fastExp2).
+ */
+inline float fastExp(float x)
+{
+    return fastExp2(x * 1.4426950409f);
+}
+
+/**
+ * @brief Fast sin(2 * pi * cycles).
+ *
+ * Reduces to a quarter cycle, then evaluates a degree-7 odd minimax
+ * polynomial. Absolute error below 1e-6 for |cycles| < 2^31, since
+ * removing whole cycles is exact in float. Prefer this over fastSin()
+ * when a phase is already kept in cycles.
+ */
+inline float fastSinCycles(float cycles)
+{
+    // Whole cycles removed in two exact steps (-1 .. 1, then -0.5 .. 0.5),
+    // then folded to -0.25 .. 0.25 with the same sine
+    float offset = cycles - static_cast<float>(static_cast<int32_t>(cycles));
+    offset -= static_cast<float>(static_cast<int32_t>(offset + std::copysign(0.5f, offset)));
+
+    const float r = std::copysign(0.25f - std::abs(std::abs(offset) - 0.25f), offset);
+
+    const float r2 = r * r;
+    return r * (6.2831641f + r2 * (-41.337144f + r2 * (81.340843f + r2 * -70.994200f)));
+}
+
+/**
+ * @brief Fast sine of an angle in radians.
+ *
+ * Absolute error below 2e-6 for |x| < 2 pi and below 1.5e-4 for |x| < 1000;
+ * beyond that the error grows with the float spacing of x / (2 pi).
+ */
+inline float fastSin(float x)
+{
+    return fastSinCycles(x * 0.15915494309f);
+}
+
+/**
+ * @brief Fast cosine of an angle in radians (same bounds as fastSin()).
+ */
+inline float fastCos(float x)
+{
+    return fastSinCycles(x * 0.15915494309f + 0.25f);
+}
+
+/**
+ * @brief Fast 1 / sqrt(x).
+ *
+ * Bit-level estimate refined by two Newton steps. Relative error below
+ * 5e-6 for positive normal x; 0 returns a large finite value, so
+ * x * fastRsqrt(x) is 0 for x = 0. std::sqrt() is a single instruction
+ * on current CPUs; use this where the reciprocal is what is needed.
+ */
+inline float fastRsqrt(float x)
+{
+    const float half = 0.5f * x;
+    float y = FastMathDetail::bitsToFloat(0x5F375A86u - (FastMathDetail::floatToBits(x) >> 1));
+
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return y;
+}
+
 //==============================================================================
 // Seeded Random Number Generator
 
@@ -225,13 +466,24 @@ public:
     /** Generate next random value in 0-1 range */
     float next()
     {
-        state = (state + 0x9e3779b9);
-        uint32_t t = state ^ (state >> 16);
-        t = t * 0x21f0aaad;
-        t = t ^ (t >> 15);
-        t = t * 0x735a2d97;
-        t = t ^ (t >> 15);
-        return static_cast<float>(t) / static_cast<float>(0xFFFFFFFF);
+        state = (state + kIncrement);
+        return toUnit(mix(state));
+    }
+
+    /**
+     * @brief Fill an array with the next numValues values.
+     *
+     * Gives exactly the values of numValues calls to next(). Each state
+     * is computed from the start state, so the loop vectorizes.
+     */
+    void fill(float* dest, int numValues)
+    {
+        const uint32_t start = state;
+
+        for (int i = 0; i < numValues; ++i)
+            dest[i] = toUnit(mix(start + static_cast<uint32_t>(i + 1) * kIncrement));
+
+        state = start + static_cast<uint32_t>(numValues) * kIncrement;
     }
 
     /** Reset with new seed */
@@ -241,6 +493,23 @@ public:
     }
 
 private:
+    static constexpr uint32_t kIncrement = 0x9e3779b9;
+
+    static uint32_t mix(uint32_t t)
+    {
+        t = t ^ (t >> 16);
+        t = t * 0x21f0aaad;
+        t = t ^ (t >> 15);
+        t = t * 0x735a2d97;
+        t = t ^ (t >> 15);
+        return t;
+    }
+
+    static float toUnit(uint32_t t)
+    {
+        return static_cast<float>(t) / static_cast<float>(0xFFFFFFFF);
+    }
+
     uint32_t state;
 };
 
@@ -258,6 +527,28 @@ inline float seededRandom(float seed)
     return x - std::floor(x);
 }
 
+/**
+ * @brief Fast stateless random value from a seed.
+ *
+ * Hashes the seed's float bits with the SeedRandom mixer instead of the
+ * sine trick in seededRandom(): no transcendental call, vectorizes, and
+ * stays well distributed for large seeds, where seededRandom() depends on
+ * std::sin being exact far from zero. Different values than seededRandom().
+ *
+ * @param seed Input seed value
+ * @return Pseudo-random value 0-1 (exclusive)
+ */
+inline float fastSeededRandom(float seed)
+{
+    uint32_t t = FastMathDetail::floatToBits(seed);
+    t = t ^ (t >> 16);
+    t = t * 0x21f0aaad;
+    t = t ^ (t >> 15);
+    t = t * 0x735a2d97;
+    t = t ^ (t >> 15);
+    return static_cast<float>(t >> 8) * (1.0f / 16777216.0f);
+}
+
 } // namespace Interpolation
 
 } // namespace shmui
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    Profiling.cpp
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Per-thread scope counters.
+
+  ==============================================================================
+*/
+
+#include "Profiling.h"
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace shmui
+{
+namespace Profiling
+{
+
+namespace
+{
+    struct Counter
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+    };
+
+    /** Counters written by one thread only; read by anyone. */
+    struct ThreadCounters
+    {
+        std::atomic<bool> inUse{false};
+        std::atomic<uint32_t> epoch{0};
+        std::array<Counter, kMaxSites> counters;
+    };
+
+    std::array<std::atomic<const char*>, kMaxSites> siteNames{};
+    std::atomic<int> numSites{0};
+
+    std::array<ThreadCounters, kMaxThreads> threadPool;
+    std::atomic<uint32_t> currentEpoch{1};
+
+    /** Claims a pool block for the thread and gives it back when the thread exits. */
+    struct ThreadSlot
+    {
+        ThreadSlot()
+        {
+            for (auto& candidate : threadPool)
+            {
+                bool expected = false;
+                if (candidate.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    block = &candidate;
+                    return;
+                }
+            }
+        }
+
+        ~ThreadSlot()
+        {
+            if (block != nullptr)
+                block->inUse.store(false, std::memory_order_release);
+        }
+
+        ThreadCounters* block = nullptr;
+    };
+}
+
+//==============================================================================
+int registerSite(const char* name)
+{
+    // Sites with the same name (say, one per translation unit) share counters
+    const int existing = juce::jmin(numSites.load(std::memory_order_acquire), kMaxSites);
+
+    for (int i = 0; i < existing; ++i)
+    {
+        const char* existingName = siteNames[static_cast<size_t>(i)].load(std::memory_order_acquire);
+        if (existingName != nullptr && std::strcmp(existingName, name) == 0)
+            return i;
+    }
+
+    const int index = numSites.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kMaxSites)
+        return -1;
+
+    siteNames[static_cast<size_t>(index)].store(name, std::memory_order_release);
+    return index;
+}
+
+void record(int site, uint64_t elapsedNs) noexcept
+{
+    if (site < 0)
+        return;
+
+    thread_local ThreadSlot slot;
+    auto* block = slot.block;
+    if (block == nullptr)
+        return;
+
+    // Only this thread writes the block, so plain load/store pairs are enough
+    const uint32_t epoch = currentEpoch.load(std::memory_order_acquire);
+    if (block->epoch.load(std::memory_order_relaxed) != epoch)
+    {
+        for (auto& counter : block->counters)
+        {
+            counter.count.store(0, std::memory_order_relaxed);
+            counter.totalNs.store(0, std::memory_order_relaxed);
+            counter.maxNs.store(0, std::memory_order_relaxed);
+        }
+
+        block->epoch.store(epoch, std::memory_order_release);
+    }
+
+    auto& counter = block->counters[static_cast<size_t>(site)];
+    counter.count.store(counter.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    counter.totalNs.store(counter.totalNs.load(std::memory_order_relaxed) + elapsedNs, std::memory_order_relaxed);
+
+    if (elapsedNs > counter.maxNs.load(std::memory_order_relaxed))
+        counter.maxNs.store(elapsedNs, std::memory_order_relaxed);
+}
+
+void getEntries(std::vector<Entry>& out)
+{
+    const int sites = juce::jmin(numSites.load(std::memory_order_acquire), kMaxSites);
+    const uint32_t epoch = currentEpoch.load(std::memory_order_acquire);
+
+    out.clear();
+    out.reserve(static_cast<size_t>(sites));
+
+    for (int i = 0; i < sites; ++i)
+    {
+        Entry entry;
+
+        // A site counted before its name is published is skipped until next time
+        const char* name = siteNames[static_cast<size_t>(i)].load(std::memory_order_acquire);
+        if (name == nullptr)
+            continue;
+
+        entry.name = name;
+
+        // Blocks still on an older epoch hold totals from before reset()
+        for (const auto& block : threadPool)
+        {
+            if (block.epoch.load(std::memory_order_acquire) != epoch)
+                continue;
+
+            const auto& counter = block.counters[static_cast<size_t>(i)];
+            entry.count += counter.count.load(std::memory_order_relaxed);
+            entry.totalNs += counter.totalNs.load(std::memory_order_relaxed);
+            entry.maxNs = juce::jmax(entry.maxNs, counter.maxNs.load(std::memory_order_relaxed));
+        }
+
+        out.push_back(entry);
+    }
+}
+
+void reset() noexcept
+{
+    currentEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+uint64_t nowNs() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace Profiling
+} // namespace shmui
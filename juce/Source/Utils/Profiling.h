@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    Profiling.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Compile-time switchable scope timing for paint(), frame and analyzer
+    calls. Build with SHMUI_ENABLE_PROFILING=1 to turn it on; otherwise
+    SHMUI_PROFILE_SCOPE expands to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#ifndef SHMUI_ENABLE_PROFILING
+ #define SHMUI_ENABLE_PROFILING 0
+#endif
+
+namespace shmui
+{
+
+/**
+ * @brief Lock-free per-thread scope timing.
+ *
+ * Each SHMUI_PROFILE_SCOPE site registers once and then records count,
+ * total and maximum nanoseconds into counters owned by the calling
+ * thread, so the audio thread and the message thread never contend and
+ * nothing is allocated or locked while recording. Counter blocks come
+ * from a fixed pool of kMaxThreads; a thread that finds the pool empty
+ * simply goes uncounted. A block freed by an exiting thread keeps its
+ * totals and is reused by the next new thread.
+ *
+ * getEntries() sums all threads; it runs on any thread but allocates, so
+ * call it from the UI. Totals read while other threads are recording are
+ * a few calls stale at most.
+ */
+namespace Profiling
+{
+
+//==============================================================================
+/** Most distinct SHMUI_PROFILE_SCOPE sites; later ones are ignored. */
+constexpr int kMaxSites = 256;
+
+/** Most threads counted at once. */
+constexpr int kMaxThreads = 32;
+
+/** True when built with SHMUI_ENABLE_PROFILING. */
+constexpr bool isEnabled() { return SHMUI_ENABLE_PROFILING != 0; }
+
+//==============================================================================
+/**
+ * @brief Totals for one profiled scope, summed over threads.
+ */
+struct Entry
+{
+    const char* name = "";
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+
+    /** Mean time per call in nanoseconds. */
+    double getMeanNs() const { return count > 0 ? static_cast<double>(totalNs) / static_cast<double>(count) : 0.0; }
+};
+
+//==============================================================================
+/**
+ * @brief Register a scope name (string literal) and get its site index.
+ *
+ * @return Site index, or -1 once kMaxSites sites exist
+ */
+int registerSite(const char* name);
+
+/**
+ * @brief Add one timed call to a site on the calling thread.
+ */
+void record(int site, uint64_t elapsedNs) noexcept;
+
+/**
+ * @brief Current totals for every site that has been called.
+ *
+ * @param out Filled with one entry per site (reuses its storage)
+ */
+void getEntries(std::vector<Entry>& out);
+
+/**
+ * @brief Zero all totals (each thread clears its own counters on its next call).
+ */
+void reset() noexcept;
+
+/**
+ * @brief Monotonic clock used for the timings, in nanoseconds.
+ */
+uint64_t nowNs() noexcept;
+
+//==============================================================================
+/**
+ * @brief Times its own lifetime into a site.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(int siteIndex) noexcept : site(siteIndex), startNs(nowNs()) {}
+    ~ScopedTimer() { record(site, nowNs() - startNs); }
+
+private:
+    const int site;
+    const uint64_t startNs;
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedTimer)
+};
+
+} // namespace Profiling
+} // namespace shmui
+
+//==============================================================================
+/**
+ * Time the rest of the enclosing scope under a name (string literal).
+ * The site registers on first use; afterwards each call costs two clock
+ * reads and a few relaxed atomic updates. Expands to nothing unless
+ * SHMUI_ENABLE_PROFILING is 1.
+ */
+#if SHMUI_ENABLE_PROFILING
+ #define SHMUI_PROFILE_SCOPE(name) \
+    static const int JUCE_JOIN_MACRO(shmuiProfileSite_, __LINE__) = ::shmui::Profiling::registerSite(name); \
+    const ::shmui::Profiling::ScopedTimer JUCE_JOIN_MACRO(shmuiProfileTimer_, __LINE__)(JUCE_JOIN_MACRO(shmuiProfileSite_, __LINE__))
+#else
+ #define SHMUI_PROFILE_SCOPE(name)
+#endif
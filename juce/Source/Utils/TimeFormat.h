@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+    TimeFormat.h
+    Created: Shmui-to-JUCE Audio Visualization Port
+
+    Allocation-free time formatting for the transport readouts.
+    Text is written into a fixed character buffer so position displays
+    can be refreshed at frame rate without building juce::Strings.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace shmui
+{
+
+//==============================================================================
+/**
+ * @brief Transport time display format.
+ */
+enum class TimeDisplayFormat
+{
+    MinutesSeconds,     ///< MM:SS.mmm
+    Bars,               ///< Bar.Beat.Tick
+    Samples,            ///< Sample count
+    Timecode            ///< HH:MM:SS:FF
+};
+
+//==============================================================================
+/**
+ * @brief Fixed-size character buffer holding one formatted time.
+ *
+ * Only uses the characters in DigitAtlas::kGlyphs.
+ */
+struct TimeText
+{
+    static constexpr int kMaxChars = 31;
+
+    char chars[kMaxChars + 1] = {};
+    int length = 0;
+
+    void clear()
+    {
+        length = 0;
+        chars[0] = 0;
+    }
+
+    void append(char c)
+    {
+        if (length < kMaxChars)
+        {
+            chars[length++] = c;
+            chars[length] = 0;
+        }
+    }
+
+    void append(const char* text)
+    {
+        while (*text != 0)
+            append(*text++);
+    }
+
+    /** Append a decimal number, zero padded to at least minDigits. */
+    void appendNumber(int64_t value, int minDigits = 1)
+    {
+        if (value < 0)
+        {
+            append('-');
+            value = -value;
+        }
+
+        char digits[20];
+        int numDigits = 0;
+
+        do
+        {
+            digits[numDigits++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        while (value > 0 && numDigits < 20);
+
+        for (int i = numDigits; i < minDigits; ++i)
+            append('0');
+
+        while (numDigits > 0)
+            append(digits[--numDigits]);
+    }
+
+    juce::String toString() const { return juce::String(chars, static_cast<size_t>(length)); }
+
+    bool operator==(const TimeText& other) const
+    {
+        return length == other.length && std::memcmp(chars, other.chars, static_cast<size_t>(length)) == 0;
+    }
+
+    bool operator!=(const TimeText& other) const { return !(*this == other); }
+};
+
+//==============================================================================
+/**
+ * @brief Settings for the musical and frame-based display formats.
+ */
+struct TimeFormatSettings
+{
+    TimeDisplayFormat format = TimeDisplayFormat::MinutesSeconds;
+    double sampleRate = 48000.0;    ///< For Samples
+    double tempoBPM = 120.0;        ///< For Bars
+    int beatsPerBar = 4;            ///< For Bars
+    int framesPerSecond = 30;       ///< For Timecode
+};
+
+/**
+ * @brief Time formatting into TimeText (appends, never allocates).
+ */
+namespace TimeFormat
+{
+
+/** Ticks per beat in the Bars format. */
+constexpr int kTicksPerBeat = 480;
+
+/**
+ * @brief Append a sample count.
+ */
+inline void appendSamples(TimeText& text, int64_t samples)
+{
+    text.appendNumber(samples);
+}
+
+/**
+ * @brief Append a time in seconds in the given display format.
+ */
+inline void appendTime(TimeText& text, double seconds, const TimeFormatSettings& settings)
+{
+    if (!std::isfinite(seconds))
+        seconds = 0.0;
+
+    switch (settings.format)
+    {
+        case TimeDisplayFormat::Timecode:
+        {
+            const int fps = juce::jmax(1, settings.framesPerSecond);
+            const auto totalFrames = static_cast<int64_t>(std::floor(std::abs(seconds) * fps));
+            const auto totalSeconds = totalFrames / fps;
+
+            if (seconds < 0.0)
+                text.append('-');
+
+            text.appendNumber(totalSeconds / 3600, 2);
+            text.append(':');
+            text.appendNumber((totalSeconds / 60) % 60, 2);
+            text.append(':');
+            text.appendNumber(totalSeconds % 60, 2);
+            text.append(':');
+            text.appendNumber(totalFrames % fps, 2);
+            break;
+        }
+
+        case TimeDisplayFormat::Bars:
+        {
+            const int beatsPerBar = juce::jmax(1, settings.beatsPerBar);
+            const double totalBeats = seconds * settings.tempoBPM / 60.0;
+            const double wholeBeats = std::floor(totalBeats);
+            const auto beatIndex = static_cast<int64_t>(wholeBeats);
+
+            // Floor division so bars before the start count down from 0
+            auto bar = beatIndex / beatsPerBar;
+            auto beat = beatIndex % beatsPerBar;
+            if (beat < 0)
+            {
+                beat += beatsPerBar;
+                --bar;
+            }
+
+            text.appendNumber(bar + 1);
+            text.append('.');
+            text.appendNumber(beat + 1);
+            text.append('.');
+            text.appendNumber(juce::jmin(kTicksPerBeat - 1, static_cast<int>((totalBeats - wholeBeats) * kTicksPerBeat)), 3);
+            break;
+        }
+
+        case TimeDisplayFormat::Samples:
+            appendSamples(text, static_cast<int64_t>(seconds * settings.sampleRate));
+            break;
+
+        case TimeDisplayFormat::MinutesSeconds:
+        default:
+        {
+            const auto totalMs = static_cast<int64_t>(std::llround(std::abs(seconds) * 1000.0));
+
+            if (seconds < 0.0 && totalMs > 0)
+                text.append('-');
+
+            text.appendNumber(totalMs / 60000);
+            text.append(':');
+            text.appendNumber((totalMs / 1000) % 60, 2);
+            text.append('.');
+            text.appendNumber(totalMs % 1000, 3);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Append a player clock: M:SS, H:MM:SS past an hour, "--:--" if unknown.
+ */
+inline void appendClock(TimeText& text, double seconds)
+{
+    if (!std::isfinite(seconds) || seconds < 0.0)
+    {
+        text.append("--:--");
+        return;
+    }
+
+    const auto totalSeconds = static_cast<int64_t>(seconds);
+    const auto hours = totalSeconds / 3600;
+
+    if (hours > 0)
+    {
+        text.appendNumber(hours);
+        text.append(':');
+        text.appendNumber((totalSeconds / 60) % 60, 2);
+    }
+    else
+    {
+        text.appendNumber(totalSeconds / 60);
+    }
+
+    text.append(':');
+    text.appendNumber(totalSeconds % 60, 2);
+}
+
+/**
+ * @brief Append a clip length: "12.3s" under a minute, M:SS above.
+ */
+inline void appendDuration(TimeText& text, double seconds)
+{
+    if (!std::isfinite(seconds) || seconds < 0.0)
+        seconds = 0.0;
+
+    if (seconds < 60.0)
+    {
+        const auto tenths = static_cast<int64_t>(std::llround(seconds * 10.0));
+        text.appendNumber(tenths / 10);
+        text.append('.');
+        text.appendNumber(tenths % 10);
+        text.append('s');
+    }
+    else
+    {
+        const auto totalSeconds = static_cast<int64_t>(seconds);
+        text.appendNumber(totalSeconds / 60);
+        text.append(':');
+        text.appendNumber(totalSeconds % 60, 2);
+    }
+}
+
+} // namespace TimeFormat
+
+} // namespace shmui